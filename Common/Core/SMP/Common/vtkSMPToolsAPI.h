@@ -228,6 +228,42 @@ public:
     }
   }
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+  T TransformReduce(InputIt inBegin, InputIt inEnd, T init, BinaryOp reduce, UnaryOp transform)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+      case BackendType::TBB:
+        return this->TBBBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  T Scan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op, bool inclusive)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Scan(inBegin, inEnd, outBegin, init, op, inclusive);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Scan(inBegin, inEnd, outBegin, init, op, inclusive);
+      case BackendType::TBB:
+        return this->TBBBackend->Scan(inBegin, inEnd, outBegin, init, op, inclusive);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Scan(inBegin, inEnd, outBegin, init, op, inclusive);
+    }
+    return init;
+  }
+
   // disable copying
   vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
   void operator=(vtkSMPToolsAPI const&) = delete;
@@ -101,6 +101,14 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+  T TransformReduce(InputIt inBegin, InputIt inEnd, T init, BinaryOp reduce, UnaryOp transform);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  T Scan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op, bool inclusive);
+
   //--------------------------------------------------------------------------------
   vtkSMPToolsImpl()
     : NestedActivated(true)
@@ -16,7 +16,9 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm> // For std::min, std::max
+#include <iterator>  // For std::advance
+#include <vector>    // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -102,6 +104,187 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+// The reduce and scan primitives split their range in blocks whose number
+// only depends on the size of the range, and combine the blocks in order.
+// Their results are then the same whatever the number of threads, even for
+// floating point or non-commutative operations.
+inline vtkIdType GetNumberOfReduceBlocks(vtkIdType size)
+{
+  const vtkIdType minimumBlockSize = 1024;
+  const vtkIdType maximumNumberOfBlocks = 256;
+  return std::max(vtkIdType(1), std::min(maximumNumberOfBlocks, size / minimumBlockSize));
+}
+
+//--------------------------------------------------------------------------------
+inline vtkIdType GetReduceBlockBegin(vtkIdType block, vtkIdType numberOfBlocks, vtkIdType size)
+{
+  return size / numberOfBlocks * block + std::min(block, size % numberOfBlocks);
+}
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+class TransformReduceCall
+{
+  InputIt In;
+  vtkIdType Size;
+  BinaryOp& Reduce;
+  UnaryOp& Transform;
+  std::vector<T>& Partials;
+
+public:
+  TransformReduceCall(
+    InputIt _in, vtkIdType _size, BinaryOp& _reduce, UnaryOp& _transform, std::vector<T>& _partials)
+    : In(_in)
+    , Size(_size)
+    , Reduce(_reduce)
+    , Transform(_transform)
+    , Partials(_partials)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType numberOfBlocks = static_cast<vtkIdType>(this->Partials.size());
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = GetReduceBlockBegin(block, numberOfBlocks, this->Size);
+      const vtkIdType last = GetReduceBlockBegin(block + 1, numberOfBlocks, this->Size);
+      InputIt itIn(this->In);
+      std::advance(itIn, first);
+      T value = this->Transform(*itIn);
+      for (vtkIdType it = first + 1; it < last; ++it)
+      {
+        ++itIn;
+        value = this->Reduce(value, this->Transform(*itIn));
+      }
+      this->Partials[block] = value;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename T>
+struct IdentityFunctor
+{
+  template <typename U>
+  T operator()(const U& value) const
+  {
+    return value;
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Second pass of a scan: each block is scanned from the reduction of all the
+// values before it. The input and output ranges may be the same.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class ScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  vtkIdType Size;
+  BinaryOp& Op;
+  const std::vector<T>& Starts;
+  bool Inclusive;
+
+public:
+  ScanCall(InputIt _in, OutputIt _out, vtkIdType _size, BinaryOp& _op,
+    const std::vector<T>& _starts, bool _inclusive)
+    : In(_in)
+    , Out(_out)
+    , Size(_size)
+    , Op(_op)
+    , Starts(_starts)
+    , Inclusive(_inclusive)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType numberOfBlocks = static_cast<vtkIdType>(this->Starts.size());
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = GetReduceBlockBegin(block, numberOfBlocks, this->Size);
+      const vtkIdType last = GetReduceBlockBegin(block + 1, numberOfBlocks, this->Size);
+      InputIt itIn(this->In);
+      OutputIt itOut(this->Out);
+      std::advance(itIn, first);
+      std::advance(itOut, first);
+      T running = this->Starts[block];
+      for (vtkIdType it = first; it < last; ++it)
+      {
+        T value = *itIn;
+        if (this->Inclusive)
+        {
+          running = this->Op(running, value);
+          *itOut = running;
+        }
+        else
+        {
+          *itOut = running;
+          running = this->Op(running, value);
+        }
+        ++itIn;
+        ++itOut;
+      }
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Parallel reduce and scan on top of the For of a backend.
+template <typename Backend, typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T BlockTransformReduce(
+  Backend& backend, InputIt inBegin, InputIt inEnd, T init, BinaryOp reduce, UnaryOp transform)
+{
+  const vtkIdType size = static_cast<vtkIdType>(std::distance(inBegin, inEnd));
+  if (size <= 0)
+  {
+    return init;
+  }
+  const vtkIdType numberOfBlocks = GetNumberOfReduceBlocks(size);
+  std::vector<T> partials(numberOfBlocks, init);
+  TransformReduceCall<InputIt, T, BinaryOp, UnaryOp> exec(
+    inBegin, size, reduce, transform, partials);
+  backend.For(0, numberOfBlocks, 1, exec);
+  T result = init;
+  for (const T& partial : partials)
+  {
+    result = reduce(result, partial);
+  }
+  return result;
+}
+
+//--------------------------------------------------------------------------------
+template <typename Backend, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T BlockScan(Backend& backend, InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init,
+  BinaryOp op, bool inclusive)
+{
+  const vtkIdType size = static_cast<vtkIdType>(std::distance(inBegin, inEnd));
+  if (size <= 0)
+  {
+    return init;
+  }
+  const vtkIdType numberOfBlocks = GetNumberOfReduceBlocks(size);
+  std::vector<T> starts(numberOfBlocks, init);
+  IdentityFunctor<T> identity;
+  TransformReduceCall<InputIt, T, BinaryOp, IdentityFunctor<T>> reduceExec(
+    inBegin, size, op, identity, starts);
+  backend.For(0, numberOfBlocks, 1, reduceExec);
+  // turn the reductions of the blocks into the values the blocks start from
+  T total = init;
+  for (T& start : starts)
+  {
+    T blockTotal = start;
+    start = total;
+    total = op(total, blockTotal);
+  }
+  ScanCall<InputIt, OutputIt, T, BinaryOp> scanExec(
+    inBegin, outBegin, size, op, starts, inclusive);
+  backend.For(0, numberOfBlocks, 1, scanExec);
+  return total;
+}
+
 VTK_ABI_NAMESPACE_END
 
 } // namespace smp
@@ -20,9 +20,10 @@
 #include <functional> // For std::bind
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
-#include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
-#include "SMP/STDThread/vtkSMPThreadPool.h" // For vtkSMPThreadPool
-#include "vtkCommonCoreModule.h"            // For export macro
+#include "SMP/Common/vtkSMPToolsInternal.h"         // For common vtk smp class
+#include "SMP/STDThread/vtkSMPThreadPool.h"         // For vtkSMPThreadPool
+#include "SMP/STDThread/vtkSMPWorkStealingRanges.h" // For vtkSMPWorkStealingRanges
+#include "vtkCommonCoreModule.h"                    // For export macro
 
 namespace vtk
 {
@@ -54,18 +55,33 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
   {
     int threadNumber = GetNumberOfThreadsSTDThread();
 
-    if (grain <= 0)
+    // The range is split in units of grain values. Without a grain, the
+    // units are small and the workers take adaptive pieces of several units.
+    const bool adaptive = grain <= 0;
+    if (adaptive)
     {
-      vtkIdType estimateGrain = (last - first) / (threadNumber * 4);
+      vtkIdType estimateGrain = n / (threadNumber * 32);
       grain = (estimateGrain > 0) ? estimateGrain : 1;
     }
+    const vtkIdType numberOfUnits = (n - 1) / grain + 1;
 
+    // A nested proxy may get fewer threads than requested.
     auto proxy = vtkSMPThreadPool::GetInstance().AllocateThreads(threadNumber);
+    const int numberOfWorkers = static_cast<int>(
+      (std::min)(static_cast<vtkIdType>(proxy.GetThreads().size()), numberOfUnits));
 
-    for (vtkIdType from = first; from < last; from += grain)
+    // One job per thread of the proxy, which balance their work by stealing
+    // it from each other.
+    vtkSMPWorkStealingRanges ranges(numberOfUnits, numberOfWorkers, adaptive);
+    for (int worker = 0; worker < numberOfWorkers; ++worker)
     {
-      const auto to = (std::min)(from + grain, last);
-      proxy.DoJob([&fi, from, to] { fi.Execute(from, to); });
+      proxy.DoJob([&fi, &ranges, worker, first, last, grain] {
+        vtkIdType begin, end;
+        while (ranges.Next(worker, begin, end))
+        {
+          fi.Execute(first + begin * grain, (std::min)(first + end * grain, last));
+        }
+      });
     }
 
     proxy.Join();
@@ -127,6 +143,24 @@ void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::STDThread>::TransformReduce(
+  InputIt inBegin, InputIt inEnd, T init, BinaryOp reduce, UnaryOp transform)
+{
+  return BlockTransformReduce(*this, inBegin, inEnd, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::STDThread>::Scan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op, bool inclusive)
+{
+  return BlockScan(*this, inBegin, inEnd, outBegin, init, op, inclusive);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int);
@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPWorkStealingRanges.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "SMP/STDThread/vtkSMPWorkStealingRanges.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+namespace
+{
+// With adaptive pieces, a worker takes this fraction of what remains in its
+// part: large pieces first to limit the overhead, small ones at the end to
+// balance the load.
+const vtkIdType AdaptivePieceDivisor = 8;
+
+vtkIdType GetPieceSize(vtkIdType size, bool adaptive)
+{
+  return adaptive ? std::max(vtkIdType(1), size / AdaptivePieceDivisor) : 1;
+}
+}
+
+struct vtkSMPWorkStealingRanges::WorkerRange
+{
+  std::mutex Mutex;
+  vtkIdType Begin = 0;
+  vtkIdType End = 0;
+  // Number of units left, read without locking to choose a victim
+  std::atomic<vtkIdType> Size{ 0 };
+  // Keep the ranges of different workers on different cache lines
+  char Padding[64];
+};
+
+//------------------------------------------------------------------------------
+vtkSMPWorkStealingRanges::vtkSMPWorkStealingRanges(
+  vtkIdType numberOfUnits, int numberOfWorkers, bool adaptive)
+  : NumberOfWorkers(std::max(numberOfWorkers, 1))
+  , Adaptive(adaptive)
+  , Ranges(new WorkerRange[std::max(numberOfWorkers, 1)])
+{
+  for (int worker = 0; worker < this->NumberOfWorkers; ++worker)
+  {
+    WorkerRange& range = this->Ranges[worker];
+    range.Begin = numberOfUnits * worker / this->NumberOfWorkers;
+    range.End = numberOfUnits * (worker + 1) / this->NumberOfWorkers;
+    range.Size = range.End - range.Begin;
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSMPWorkStealingRanges::~vtkSMPWorkStealingRanges() = default;
+
+//------------------------------------------------------------------------------
+bool vtkSMPWorkStealingRanges::Next(int worker, vtkIdType& begin, vtkIdType& end)
+{
+  WorkerRange& own = this->Ranges[worker];
+  {
+    std::lock_guard<std::mutex> lock(own.Mutex);
+    if (own.Begin < own.End)
+    {
+      begin = own.Begin;
+      end = begin + GetPieceSize(own.End - own.Begin, this->Adaptive);
+      own.Begin = end;
+      own.Size = own.End - own.Begin;
+      return true;
+    }
+  }
+  return this->Steal(worker, begin, end);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPWorkStealingRanges::Steal(int worker, vtkIdType& begin, vtkIdType& end)
+{
+  while (true)
+  {
+    // the victim is the worker with the most work left
+    int victim = -1;
+    vtkIdType largest = 0;
+    for (int other = 0; other < this->NumberOfWorkers; ++other)
+    {
+      const vtkIdType size = this->Ranges[other].Size.load(std::memory_order_relaxed);
+      if (other != worker && size > largest)
+      {
+        largest = size;
+        victim = other;
+      }
+    }
+    if (victim < 0)
+    {
+      return false;
+    }
+
+    // take the back half of its range, the victim keeps working on the front
+    vtkIdType stolenBegin, stolenEnd;
+    {
+      WorkerRange& range = this->Ranges[victim];
+      std::lock_guard<std::mutex> lock(range.Mutex);
+      const vtkIdType size = range.End - range.Begin;
+      if (size <= 0)
+      {
+        continue; // the victim finished meanwhile, look for another one
+      }
+      stolenEnd = range.End;
+      stolenBegin = range.End - (size + 1) / 2;
+      range.End = stolenBegin;
+      range.Size = range.End - range.Begin;
+    }
+
+    begin = stolenBegin;
+    end = begin + GetPieceSize(stolenEnd - stolenBegin, this->Adaptive);
+    WorkerRange& own = this->Ranges[worker];
+    std::lock_guard<std::mutex> lock(own.Mutex);
+    own.Begin = end;
+    own.End = stolenEnd;
+    own.Size = own.End - own.Begin;
+    return true;
+  }
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
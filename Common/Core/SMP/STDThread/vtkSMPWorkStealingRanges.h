@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPWorkStealingRanges.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMPWorkStealingRanges
+ * @brief   Work-stealing scheduling of a range of units.
+ *
+ * vtkSMPWorkStealingRanges distributes a range of work units between the
+ * workers of a parallel For of the STDThread backend. Each worker owns a
+ * contiguous part of the range and takes pieces from its front. A worker
+ * whose part is empty steals the back half of the largest remaining part of
+ * the other workers, so that irregular work is balanced dynamically.
+ */
+
+#ifndef vtkSMPWorkStealingRanges_h
+#define vtkSMPWorkStealingRanges_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <memory> // For std::unique_ptr
+#include <mutex>  // For std::mutex
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+class VTKCOMMONCORE_EXPORT vtkSMPWorkStealingRanges
+{
+public:
+  /**
+   * Split numberOfUnits units between numberOfWorkers workers. When adaptive
+   * is true, the pieces taken by a worker from its own part get smaller as
+   * this part gets depleted, otherwise each piece is a single unit.
+   */
+  vtkSMPWorkStealingRanges(vtkIdType numberOfUnits, int numberOfWorkers, bool adaptive);
+  ~vtkSMPWorkStealingRanges();
+  vtkSMPWorkStealingRanges(const vtkSMPWorkStealingRanges&) = delete;
+  vtkSMPWorkStealingRanges& operator=(const vtkSMPWorkStealingRanges&) = delete;
+
+  /**
+   * Get the next piece [begin, end) of units to execute by the given worker,
+   * stealing work from the other workers when its own part is empty. Returns
+   * false when there is no work left.
+   */
+  bool Next(int worker, vtkIdType& begin, vtkIdType& end);
+
+  int GetNumberOfWorkers() const { return this->NumberOfWorkers; }
+
+private:
+  struct WorkerRange;
+
+  bool Steal(int worker, vtkIdType& begin, vtkIdType& end);
+
+  int NumberOfWorkers;
+  bool Adaptive;
+  std::unique_ptr<WorkerRange[]> Ranges;
+};
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+/* VTK-HeaderTest-Exclude: vtkSMPWorkStealingRanges.h */
@@ -105,6 +105,25 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::TransformReduce(
+  InputIt inBegin, InputIt inEnd, T init, BinaryOp reduce, UnaryOp transform)
+{
+  // same blocks as the threaded backends, so that the results match
+  return BlockTransformReduce(*this, inBegin, inEnd, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::Scan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op, bool inclusive)
+{
+  return BlockScan(*this, inBegin, inEnd, outBegin, init, op, inclusive);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
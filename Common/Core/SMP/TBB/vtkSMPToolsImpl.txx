@@ -190,6 +190,24 @@ void vtkSMPToolsImpl<BackendType::TBB>::Sort(
   tbb::parallel_sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::TransformReduce(
+  InputIt inBegin, InputIt inEnd, T init, BinaryOp reduce, UnaryOp transform)
+{
+  return BlockTransformReduce(*this, inBegin, inEnd, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::Scan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op, bool inclusive)
+{
+  return BlockScan(*this, inBegin, inEnd, outBegin, init, op, inclusive);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
@@ -0,0 +1,268 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayRangeCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the ranges computed in a single pass by vtkDataArray against ranges
+// computed here, whatever the number of threads and of components, and that
+// the cached ranges survive a change of lookup table and can be set by hand.
+
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkVariantArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Fill an array with values of both signs, some of which are infinite or NaN.
+void FillArray(vtkDataArray* array, int numComps, vtkIdType numTuples, bool specialValues)
+{
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      double value = ((i * 37 + c * 11) % 201) - 100.0 + 0.25 * c;
+      if (specialValues && i % 97 == c)
+      {
+        value = (i % 2) ? std::numeric_limits<double>::infinity()
+                        : -std::numeric_limits<double>::infinity();
+      }
+      else if (specialValues && i % 89 == c)
+      {
+        value = std::numeric_limits<double>::quiet_NaN();
+      }
+      array->SetComponent(i, c, value);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compute the range of a component, or of the magnitude if comp is -1.
+void ExpectedRange(vtkDataArray* array, int comp, bool finite, double range[2])
+{
+  range[0] = VTK_DOUBLE_MAX;
+  range[1] = VTK_DOUBLE_MIN;
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+  {
+    double value = 0.0;
+    if (comp >= 0)
+    {
+      value = array->GetComponent(i, comp);
+    }
+    else
+    {
+      for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+      {
+        value += array->GetComponent(i, c) * array->GetComponent(i, c);
+      }
+    }
+    if (std::isnan(value) || (finite && std::isinf(value)))
+    {
+      continue;
+    }
+    range[0] = std::min(range[0], value);
+    range[1] = std::max(range[1], value);
+  }
+  if (comp < 0)
+  {
+    range[0] = std::sqrt(range[0]);
+    range[1] = std::sqrt(range[1]);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool CheckRanges(vtkDataArray* array, const char* name)
+{
+  bool success = true;
+  const int numComps = array->GetNumberOfComponents();
+  for (int comp = (numComps > 1 ? -1 : 0); comp < numComps; ++comp)
+  {
+    double expected[2];
+    double range[2];
+    ::ExpectedRange(array, comp, false, expected);
+    array->GetRange(range, comp);
+    if (range[0] != expected[0] || range[1] != expected[1])
+    {
+      std::cerr << name << ": wrong range for component " << comp << ": " << range[0] << ", "
+                << range[1] << " instead of " << expected[0] << ", " << expected[1] << std::endl;
+      success = false;
+    }
+    ::ExpectedRange(array, comp, true, expected);
+    array->GetFiniteRange(range, comp);
+    if (range[0] != expected[0] || range[1] != expected[1])
+    {
+      std::cerr << name << ": wrong finite range for component " << comp << ": " << range[0]
+                << ", " << range[1] << " instead of " << expected[0] << ", " << expected[1]
+                << std::endl;
+      success = false;
+    }
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool HasCachedRanges(vtkDataArray* array)
+{
+  vtkInformation* info = array->GetInformation();
+  vtkInformationVector* ranges = info->Get(vtkAbstractArray::PER_COMPONENT());
+  vtkInformationVector* finiteRanges = info->Get(vtkAbstractArray::PER_FINITE_COMPONENT());
+  if (!ranges || !finiteRanges)
+  {
+    return false;
+  }
+  for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+  {
+    if (!ranges->GetInformationObject(comp)->Has(vtkDataArray::COMPONENT_RANGE()) ||
+      !finiteRanges->GetInformationObject(comp)->Has(vtkDataArray::COMPONENT_RANGE()))
+    {
+      return false;
+    }
+  }
+  return array->GetNumberOfComponents() == 1 ||
+    (info->Has(vtkDataArray::L2_NORM_RANGE()) && info->Has(vtkDataArray::L2_NORM_FINITE_RANGE()));
+}
+
+//------------------------------------------------------------------------------
+bool TestComputedRanges()
+{
+  bool success = true;
+  for (int numThreads : { 1, 4 })
+  {
+    vtkSMPTools::Initialize(numThreads);
+    for (int numComps : { 1, 2, 3, 4, 6, 9 })
+    {
+      vtkNew<vtkFloatArray> floatArray;
+      ::FillArray(floatArray, numComps, 10000, true);
+      success = ::CheckRanges(floatArray, "vtkFloatArray") && success;
+
+      vtkNew<vtkSOADataArrayTemplate<double>> soaArray;
+      ::FillArray(soaArray, numComps, 5000, true);
+      success = ::CheckRanges(soaArray, "vtkSOADataArrayTemplate<double>") && success;
+
+      vtkNew<vtkIntArray> intArray;
+      ::FillArray(intArray, numComps, 3000, false);
+      success = ::CheckRanges(intArray, "vtkIntArray") && success;
+
+      // all the ranges are computed by the first request
+      intArray->Modified();
+      double range[2];
+      intArray->GetRange(range, numComps - 1);
+      if (!::HasCachedRanges(intArray))
+      {
+        std::cerr << "The ranges of " << numComps << " components are not all cached."
+                  << std::endl;
+        success = false;
+      }
+    }
+  }
+  vtkSMPTools::Initialize();
+
+  vtkNew<vtkFloatArray> empty;
+  empty->SetNumberOfComponents(3);
+  const double* range = empty->GetRange(-1);
+  if (range[0] != VTK_DOUBLE_MAX || range[1] != VTK_DOUBLE_MIN)
+  {
+    std::cerr << "Wrong range for an empty array." << std::endl;
+    success = false;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool TestCache()
+{
+  bool success = true;
+  vtkNew<vtkFloatArray> array;
+  ::FillArray(array, 3, 1000, true);
+  array->GetRange(0);
+
+  // a new lookup table does not change the values
+  vtkMTimeType mtime = array->GetMTime();
+  vtkNew<vtkLookupTable> lut;
+  array->SetLookupTable(lut);
+  if (array->GetMTime() <= mtime || !::HasCachedRanges(array))
+  {
+    std::cerr << "Setting the lookup table drops the ranges." << std::endl;
+    success = false;
+  }
+
+  array->Modified();
+  vtkInformation* info = array->GetInformation();
+  if (info->Has(vtkAbstractArray::PER_COMPONENT()) || info->Has(vtkDataArray::L2_NORM_RANGE()))
+  {
+    std::cerr << "Modifying the array keeps the ranges." << std::endl;
+    success = false;
+  }
+
+  // ranges set by hand are kept when the others are computed
+  const double seeded[2] = { -1000.0, 1000.0 };
+  const double seededNorm[2] = { 0.0, 2000.0 };
+  array->SetRange(seeded, 1);
+  array->SetRange(seededNorm, -1);
+  array->SetFiniteRange(seeded, 2);
+  double range[2];
+  double expected[2];
+  array->GetRange(range, 0);
+  ::ExpectedRange(array, 0, false, expected);
+  if (range[0] != expected[0] || range[1] != expected[1])
+  {
+    std::cerr << "Wrong range next to a range set by hand." << std::endl;
+    success = false;
+  }
+  array->GetRange(range, 1);
+  if (range[0] != seeded[0] || range[1] != seeded[1])
+  {
+    std::cerr << "The range set by hand is not kept." << std::endl;
+    success = false;
+  }
+  array->GetRange(range, -1);
+  if (range[0] != seededNorm[0] || range[1] != seededNorm[1])
+  {
+    std::cerr << "The range of the magnitude set by hand is not kept." << std::endl;
+    success = false;
+  }
+  array->GetFiniteRange(range, 2);
+  if (range[0] != seeded[0] || range[1] != seeded[1])
+  {
+    std::cerr << "The finite range set by hand is not kept." << std::endl;
+    success = false;
+  }
+
+  // other per-component keys do not hide the ranges
+  array->Modified();
+  vtkNew<vtkVariantArray> values;
+  array->GetProminentComponentValues(0, values);
+  success = ::CheckRanges(array, "vtkFloatArray with prominent values") && success;
+  return success;
+}
+}
+
+int TestDataArrayRangeCache(int, char*[])
+{
+  bool success = ::TestComputedRanges();
+  success = ::TestCache() && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
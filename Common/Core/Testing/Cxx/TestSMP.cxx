@@ -19,11 +19,14 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <functional>
 #include <numeric>
 #include <set>
+#include <string>
 #include <vector>
 
 static const int Target = 10000;
@@ -184,6 +187,124 @@ bool myComp(double a, double b)
   return (a < b);
 }
 
+// Check that the STDThread backend calls the functor on each index of the range
+// exactly once, whatever the cost of the indices, the grain and the nesting.
+bool VisitedOnce(const std::vector<std::atomic<int>>& visits, const char* name)
+{
+  for (size_t i = 0; i < visits.size(); ++i)
+  {
+    if (visits[i].load() != 1)
+    {
+      cerr << "Error: " << name << " visited index " << i << " " << visits[i].load()
+           << " times!" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int doTestWorkStealing()
+{
+  // Heavily skewed cost: the first indices are much more expensive than the
+  // others, the workers must steal them without running any index twice.
+  {
+    const vtkIdType n = 10007;
+    std::vector<std::atomic<int>> visits(n);
+    std::atomic<double> sink(0.0);
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() {
+      vtkSMPTools::For(0, n, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          double value = 0.0;
+          const int cost = i < n / 100 ? 20000 : 1;
+          for (int k = 0; k < cost; ++k)
+          {
+            value += 1.0 / (k + i + 1);
+          }
+          sink.store(value);
+          ++visits[i];
+        }
+      });
+    });
+    if (!VisitedOnce(visits, "vtkSMPTools::For with a skewed cost"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Explicit grains, larger than the range or not dividing it, on a range not
+  // divisible by the number of threads: each call covers a single grain
+  // starting at a multiple of the grain, except the last one which is shorter.
+  const vtkIdType first = 3;
+  for (const vtkIdType n : { vtkIdType(1), vtkIdType(37), vtkIdType(1001) })
+  {
+    for (const vtkIdType grain : { vtkIdType(1), vtkIdType(7), vtkIdType(64), n + 5 })
+    {
+      std::vector<std::atomic<int>> visits(n);
+      std::atomic<bool> validPieces(true);
+      vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() {
+        vtkSMPTools::For(first, first + n, grain, [&](vtkIdType begin, vtkIdType end) {
+          if (grain < n &&
+            ((begin - first) % grain != 0 || end - begin != std::min(grain, first + n - begin)))
+          {
+            validPieces = false;
+          }
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            ++visits[i - first];
+          }
+        });
+      });
+      if (!VisitedOnce(visits, "vtkSMPTools::For with an explicit grain"))
+      {
+        return EXIT_FAILURE;
+      }
+      if (!validPieces)
+      {
+        cerr << "Error: vtkSMPTools::For with a grain of " << grain << " on " << n
+             << " values did not split the range in grains!" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Nested For, with and without nested parallelism. Without it, the inner For
+  // runs in a single call on the thread of the outer one.
+  for (const bool enabled : { true, false })
+  {
+    const vtkIdType outerSize = 8;
+    const vtkIdType innerSize = 1000;
+    std::vector<std::atomic<int>> visits(outerSize * innerSize);
+    std::atomic<int> innerCalls(0);
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4, "STDThread", enabled }, [&]() {
+      vtkSMPTools::For(0, outerSize, 1, [&](vtkIdType outerBegin, vtkIdType outerEnd) {
+        for (vtkIdType outer = outerBegin; outer < outerEnd; ++outer)
+        {
+          vtkSMPTools::For(0, innerSize, [&](vtkIdType begin, vtkIdType end) {
+            ++innerCalls;
+            for (vtkIdType i = begin; i < end; ++i)
+            {
+              ++visits[outer * innerSize + i];
+            }
+          });
+        }
+      });
+    });
+    if (!VisitedOnce(
+          visits, enabled ? "nested vtkSMPTools::For" : "serial nested vtkSMPTools::For"))
+    {
+      return EXIT_FAILURE;
+    }
+    if (!enabled && innerCalls != outerSize)
+    {
+      cerr << "Error: without nested parallelism the inner vtkSMPTools::For was split in "
+           << innerCalls << " calls!" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
 int doTestSMP()
 {
   std::cout << "Testing SMP Tools with " << vtkSMPTools::GetBackend() << " backend." << std::endl;
@@ -491,6 +612,110 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test reduce, with enough values to be split in several blocks
+  std::vector<vtkIdType> counts(100000);
+  for (size_t i = 0; i < counts.size(); ++i)
+  {
+    counts[i] = static_cast<vtkIdType>(i % 7);
+  }
+  const vtkIdType expectedSum = std::accumulate(counts.begin(), counts.end(), vtkIdType(10));
+  if (vtkSMPTools::Reduce(counts.begin(), counts.end(), vtkIdType(10)) != expectedSum)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Reduce!" << endl;
+    return EXIT_FAILURE;
+  }
+  if (vtkSMPTools::Reduce(counts.begin(), counts.begin(), vtkIdType(10)) != 10)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Reduce applied on an empty range!" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // the values are combined in order, the operation does not need to be commutative
+  std::vector<std::string> words = { "a", "b", "c", "d", "e" };
+  if (vtkSMPTools::Reduce(words.begin(), words.end(), std::string(">")) != ">abcde")
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Reduce with a non-commutative operation!"
+         << endl;
+    return EXIT_FAILURE;
+  }
+
+  const vtkIdType numberOfOdds = vtkSMPTools::TransformReduce(counts.begin(), counts.end(),
+    vtkIdType(0), std::plus<vtkIdType>(), [](vtkIdType x) { return x % 2; });
+  if (numberOfOdds !=
+    std::count_if(counts.begin(), counts.end(), [](vtkIdType x) { return x % 2 == 1; }))
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::TransformReduce!" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // the rounding of a floating point reduction does not depend on the backend
+  std::vector<double> fractions(counts.size());
+  for (size_t i = 0; i < fractions.size(); ++i)
+  {
+    fractions[i] = 1.0 / static_cast<double>(i + 1);
+  }
+  const double fractionSum = vtkSMPTools::Reduce(fractions.begin(), fractions.end(), 0.0);
+  const std::string backend = vtkSMPTools::GetBackend();
+  vtkSMPTools::SetBackend("Sequential");
+  const double sequentialFractionSum =
+    vtkSMPTools::Reduce(fractions.begin(), fractions.end(), 0.0);
+  vtkSMPTools::SetBackend(backend.c_str());
+  if (fractionSum != sequentialFractionSum)
+  {
+    cerr << "Error: vtkSMPTools::Reduce depends on the backend!" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test scans, in place and out of place
+  std::vector<vtkIdType> offsets(counts.size());
+  vtkIdType exclusiveTotal =
+    vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), vtkIdType(10));
+  std::vector<vtkIdType> inclusive(counts);
+  vtkIdType inclusiveTotal = vtkSMPTools::InclusiveScan(
+    inclusive.begin(), inclusive.end(), inclusive.begin(), std::plus<vtkIdType>(), vtkIdType(10));
+  vtkIdType running = 10;
+  for (size_t i = 0; i < counts.size(); ++i)
+  {
+    if (offsets[i] != running || inclusive[i] != running + counts[i])
+    {
+      cerr << "Error: Invalid output for vtkSMPTools scans at " << i << "!" << endl;
+      return EXIT_FAILURE;
+    }
+    running += counts[i];
+  }
+  if (exclusiveTotal != expectedSum || inclusiveTotal != expectedSum)
+  {
+    cerr << "Error: Invalid total returned by vtkSMPTools scans!" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test compaction
+  std::vector<vtkIdType> indices(counts.size());
+  vtkIdType numberOfIndices = vtkSMPTools::CompactIndices(
+    5, static_cast<vtkIdType>(counts.size()), indices.begin(), [&](vtkIdType i) {
+      return counts[i] == 3;
+    });
+  std::vector<vtkIdType> expectedIndices;
+  for (vtkIdType i = 5; i < static_cast<vtkIdType>(counts.size()); ++i)
+  {
+    if (counts[i] == 3)
+    {
+      expectedIndices.push_back(i);
+    }
+  }
+  if (numberOfIndices != static_cast<vtkIdType>(expectedIndices.size()) ||
+    !std::equal(expectedIndices.begin(), expectedIndices.end(), indices.begin()))
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::CompactIndices!" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test the work stealing of the STDThread backend
+  if (std::string(vtkSMPTools::GetBackend()) == "STDThread")
+  {
+    return doTestWorkStealing();
+  }
   return EXIT_SUCCESS;
 }
 
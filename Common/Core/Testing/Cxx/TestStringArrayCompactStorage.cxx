@@ -0,0 +1,219 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStringArrayCompactStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that a vtkStringArray with compact storage holds the same values as
+// one with a vtkStdString per value, that appending, copying and looking
+// up values keep the compact storage, and that threads can read the values
+// through GetValue() without converting the storage.
+
+#include "vtkCharArray.h"
+#include "vtkCommand.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkTestErrorObserver.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+std::string Value(vtkStringArray* array, vtkIdType id)
+{
+  return std::string(array->GetValueData(id), array->GetValueSize(id));
+}
+
+//------------------------------------------------------------------------------
+bool CheckValues(vtkStringArray* array, const std::vector<std::string>& expected,
+  bool compact, const char* name)
+{
+  if (array->GetCompactStorage() != compact)
+  {
+    std::cerr << name << ": wrong storage." << std::endl;
+    return false;
+  }
+  if (array->GetNumberOfValues() != static_cast<vtkIdType>(expected.size()))
+  {
+    std::cerr << name << ": " << array->GetNumberOfValues() << " values instead of "
+              << expected.size() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    if (::Value(array, i) != expected[i] || array->GetValue(i) != expected[i])
+    {
+      std::cerr << name << ": wrong value " << i << ": \"" << ::Value(array, i)
+                << "\" instead of \"" << expected[i] << "\"" << std::endl;
+      return false;
+    }
+  }
+  if (array->GetCompactStorage() != compact)
+  {
+    std::cerr << name << ": reading the values changed the storage." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestStringArrayCompactStorage(int, char*[])
+{
+  bool success = true;
+  std::vector<std::string> expected = { "alpha", "", "beta", "gamma delta", "", "beta" };
+
+  // appending
+  vtkNew<vtkStringArray> array;
+  array->CompactStorageOn();
+  for (const std::string& value : expected)
+  {
+    array->InsertNextValue(value);
+  }
+  success = ::CheckValues(array, expected, true, "InsertNextValue") && success;
+  if (array->GetCharactersArray()->GetNumberOfValues() != 24 ||
+    array->GetOffsetsArray()->GetNumberOfValues() != 7 || array->GetDataSize() != 30)
+  {
+    std::cerr << "Wrong compact storage size." << std::endl;
+    success = false;
+  }
+
+  // inserting past the end pads with empty strings
+  array->InsertValue(8, "epsilon");
+  expected.insert(expected.end(), { "", "", "epsilon" });
+  success = ::CheckValues(array, expected, true, "InsertValue") && success;
+  if (array->GetVariantValue(3).ToString() != "gamma delta")
+  {
+    std::cerr << "Wrong variant value." << std::endl;
+    success = false;
+  }
+
+  // lookup
+  vtkNew<vtkIdList> ids;
+  array->LookupValue("beta", ids);
+  if (ids->GetNumberOfIds() != 2 || array->LookupValue("epsilon") != 8 ||
+    array->LookupValue("zeta") != -1)
+  {
+    std::cerr << "Wrong lookup." << std::endl;
+    success = false;
+  }
+  success = ::CheckValues(array, expected, true, "LookupValue") && success;
+
+  // copies, from and to both storages, including the array itself
+  vtkNew<vtkStringArray> copy;
+  copy->DeepCopy(array);
+  success = ::CheckValues(copy, expected, true, "DeepCopy") && success;
+  vtkNew<vtkStringArray> standard;
+  standard->InsertTuples(0, array->GetNumberOfTuples(), 0, array);
+  success = ::CheckValues(standard, expected, false, "InsertTuples") && success;
+  copy->Initialize();
+  copy->InsertTuples(0, standard->GetNumberOfTuples(), 0, standard);
+  success = ::CheckValues(copy, expected, true, "InsertTuples (compact)") && success;
+  for (vtkIdType i = 0; i < 3; ++i)
+  {
+    array->InsertNextTuple(i, array);
+    expected.push_back(expected[i]);
+  }
+  success = ::CheckValues(array, expected, true, "InsertNextTuple") && success;
+
+  // resizing
+  array->SetNumberOfValues(4);
+  array->InsertNextValue("zeta");
+  array->SetNumberOfValues(6);
+  expected.resize(4);
+  expected.insert(expected.end(), { "zeta", "" });
+  success = ::CheckValues(array, expected, true, "SetNumberOfValues") && success;
+  array->Reset();
+  array->InsertNextValue("eta");
+  success = ::CheckValues(array, { "eta" }, true, "Reset") && success;
+  array->Squeeze();
+  array->Resize(0);
+  success = ::CheckValues(array, {}, true, "Resize") && success;
+
+  // the arrays of a reader are used without copy
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkCharArray> characters;
+  const std::string text = "onetwothree";
+  for (const vtkIdType offset : { 0, 3, 6, 11 })
+  {
+    offsets->InsertNextValue(offset);
+  }
+  for (const char c : text)
+  {
+    characters->InsertNextValue(c);
+  }
+  if (!array->SetCompactData(offsets, characters) || array->GetCharactersArray() != characters ||
+    array->GetOffsetsArray() != offsets)
+  {
+    std::cerr << "The compact data is not used." << std::endl;
+    success = false;
+  }
+  success = ::CheckValues(array, { "one", "two", "three" }, true, "SetCompactData") && success;
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  copy->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  offsets->SetValue(1, 12);
+  if (copy->SetCompactData(offsets, characters) ||
+    errorObserver->CheckErrorMessage("The offsets do not fit the characters.") != 0)
+  {
+    std::cerr << "Wrong offsets are accepted." << std::endl;
+    success = false;
+  }
+  offsets->SetValue(1, 3);
+
+  // the values held by a vtkStdString
+  array->SetValue(1, "four");
+  success = ::CheckValues(array, { "one", "four", "three" }, false, "SetValue") && success;
+  if (array->GetValue(2) != "three" || characters->GetNumberOfValues() != 11)
+  {
+    std::cerr << "Wrong conversion from compact storage." << std::endl;
+    success = false;
+  }
+  array->SetCompactStorage(true);
+  success = ::CheckValues(array, { "one", "four", "three" }, true, "SetCompactStorage") && success;
+
+  // concurrent reads keep the compact storage and its characters
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    array->InsertNextValue("value " + std::to_string(i));
+  }
+  const char* data = array->GetValueData(3);
+  const vtkStringArray* constArray = array;
+  std::atomic<int> numWrongValues(0);
+  vtkSMPTools::For(0, array->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (constArray->GetValue(i) != ::Value(array, i) || array->GetValue(i) != ::Value(array, i))
+      {
+        ++numWrongValues;
+      }
+    }
+  });
+  if (numWrongValues != 0 || !array->GetCompactStorage() || array->GetValueData(3) != data ||
+    constArray->GetValue(3) != "value 0")
+  {
+    std::cerr << "Wrong GetValue() on compact storage." << std::endl;
+    success = false;
+  }
+  array->SetValue(3, "modified");
+  if (constArray->GetValue(3) != "modified" || array->GetValue(3) != "modified")
+  {
+    std::cerr << "The values read by GetValue() are not updated." << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,219 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStringArrayDictionaryEncoding.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that a dictionary encoded vtkStringArray holds the same values as one
+// with a vtkStdString per value, that appending, copying and looking up values
+// keep the encoding, and that lookup tables map each distinct value once.
+
+#include "vtkCommand.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkStringArray.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+std::string Value(vtkStringArray* array, vtkIdType id)
+{
+  return std::string(array->GetValueData(id), array->GetValueSize(id));
+}
+
+//------------------------------------------------------------------------------
+bool CheckValues(vtkStringArray* array, const std::vector<std::string>& expected,
+  bool encoded, const char* name)
+{
+  if (array->GetDictionaryEncoding() != encoded)
+  {
+    std::cerr << name << ": wrong encoding." << std::endl;
+    return false;
+  }
+  if (array->GetNumberOfValues() != static_cast<vtkIdType>(expected.size()))
+  {
+    std::cerr << name << ": " << array->GetNumberOfValues() << " values instead of "
+              << expected.size() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    if (::Value(array, i) != expected[i] || array->GetValue(i) != expected[i])
+    {
+      std::cerr << name << ": wrong value " << i << ": \"" << ::Value(array, i)
+                << "\" instead of \"" << expected[i] << "\"" << std::endl;
+      return false;
+    }
+  }
+  if (array->GetDictionaryEncoding() != encoded)
+  {
+    std::cerr << name << ": reading the values changed the encoding." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestStringArrayDictionaryEncoding(int, char*[])
+{
+  bool success = true;
+  std::vector<std::string> expected = { "steel", "wood", "steel", "", "glass", "wood", "steel" };
+
+  // appending
+  vtkNew<vtkStringArray> array;
+  array->DictionaryEncodingOn();
+  for (const std::string& value : expected)
+  {
+    array->InsertNextValue(value);
+  }
+  success = ::CheckValues(array, expected, true, "InsertNextValue") && success;
+  if (array->GetDictionary()->GetNumberOfValues() != 4 ||
+    array->GetCodesArray()->GetNumberOfValues() != 7 || array->GetCodesArray()->GetValue(2) != 0)
+  {
+    std::cerr << "Wrong dictionary." << std::endl;
+    success = false;
+  }
+
+  // setting and inserting past the end keep the encoding
+  array->SetValue(3, "wood");
+  array->InsertValue(9, "glass");
+  expected[3] = "wood";
+  expected.insert(expected.end(), { "", "", "glass" });
+  success = ::CheckValues(array, expected, true, "SetValue") && success;
+
+  // lookup
+  vtkNew<vtkIdList> ids;
+  array->LookupValue("wood", ids);
+  if (ids->GetNumberOfIds() != 3 || ids->GetId(1) != 3 || array->LookupValue("glass") != 4 ||
+    array->LookupValue("stone") != -1)
+  {
+    std::cerr << "Wrong lookup." << std::endl;
+    success = false;
+  }
+
+  // copies, from and to other storages
+  vtkNew<vtkStringArray> copy;
+  copy->DeepCopy(array);
+  success = ::CheckValues(copy, expected, true, "DeepCopy") && success;
+  vtkNew<vtkStringArray> standard;
+  standard->InsertTuples(0, array->GetNumberOfTuples(), 0, array);
+  success = ::CheckValues(standard, expected, false, "InsertTuples") && success;
+  array->InsertNextTuple(1, standard);
+  expected.push_back(expected[1]);
+  success = ::CheckValues(array, expected, true, "InsertNextTuple") && success;
+
+  // conversions
+  standard->SetDictionaryEncoding(true);
+  success = ::CheckValues(standard, { expected.begin(), expected.end() - 1 }, true,
+              "SetDictionaryEncoding") &&
+    success;
+  standard->SetCompactStorage(true);
+  success = ::CheckValues(standard, { expected.begin(), expected.end() - 1 }, false,
+              "SetCompactStorage") &&
+    success;
+  if (!standard->GetCompactStorage() || !standard->TryDictionaryEncoding(0.5) ||
+    standard->GetCompactStorage())
+  {
+    std::cerr << "Wrong conversion from compact storage." << std::endl;
+    success = false;
+  }
+  vtkNew<vtkStringArray> distinct;
+  for (const char* value : { "a", "b", "c", "a" })
+  {
+    distinct->InsertNextValue(value);
+  }
+  if (distinct->TryDictionaryEncoding(0.5) || !distinct->TryDictionaryEncoding(0.75))
+  {
+    std::cerr << "Wrong encoding of values which are mostly distinct." << std::endl;
+    success = false;
+  }
+  array->SetDictionaryEncoding(false);
+  success = ::CheckValues(array, expected, false, "SetDictionaryEncoding(false)") && success;
+
+  // resizing
+  copy->SetNumberOfValues(2);
+  copy->SetNumberOfValues(3);
+  success = ::CheckValues(copy, { "steel", "wood", "" }, true, "SetNumberOfValues") && success;
+  copy->Reset();
+  copy->InsertNextValue("stone");
+  copy->Squeeze();
+  success = ::CheckValues(copy, { "stone" }, true, "Reset") && success;
+
+  // the arrays of a reader are used without copy
+  vtkNew<vtkIntArray> codes;
+  vtkNew<vtkStringArray> dictionary;
+  dictionary->InsertNextValue("low");
+  dictionary->InsertNextValue("high");
+  for (const int code : { 1, 0, 0, 1 })
+  {
+    codes->InsertNextValue(code);
+  }
+  if (!copy->SetDictionaryData(codes, dictionary) || copy->GetCodesArray() != codes ||
+    copy->GetDictionary() != dictionary)
+  {
+    std::cerr << "The dictionary data is not used." << std::endl;
+    success = false;
+  }
+  success = ::CheckValues(copy, { "high", "low", "low", "high" }, true, "SetDictionaryData") &&
+    success;
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  standard->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  codes->SetValue(1, 2);
+  if (standard->SetDictionaryData(codes, dictionary) ||
+    errorObserver->CheckErrorMessage("The codes do not fit the dictionary.") != 0)
+  {
+    std::cerr << "Wrong codes are accepted." << std::endl;
+    success = false;
+  }
+  codes->SetValue(1, 0);
+
+  // annotations are mapped once per distinct value
+  vtkNew<vtkLookupTable> lut;
+  lut->IndexedLookupOn();
+  lut->SetNumberOfTableValues(2);
+  lut->SetTableValue(0, 1.0, 0.0, 0.0);
+  lut->SetTableValue(1, 0.0, 0.0, 1.0);
+  lut->SetAnnotation(vtkVariant("low"), "low");
+  lut->SetAnnotation(vtkVariant("high"), "high");
+  vtkNew<vtkStringArray> plain;
+  for (vtkIdType i = 0; i < copy->GetNumberOfValues(); ++i)
+  {
+    plain->InsertNextValue(::Value(copy, i));
+  }
+  vtkUnsignedCharArray* colors = lut->MapScalars(copy, VTK_COLOR_MODE_MAP_SCALARS, -1);
+  vtkUnsignedCharArray* expectedColors = lut->MapScalars(plain, VTK_COLOR_MODE_MAP_SCALARS, -1);
+  for (vtkIdType i = 0; i < colors->GetNumberOfValues(); ++i)
+  {
+    if (colors->GetValue(i) != expectedColors->GetValue(i))
+    {
+      std::cerr << "Wrong color component " << i << "." << std::endl;
+      success = false;
+      break;
+    }
+  }
+  if (colors->GetValue(0) != 0 || colors->GetValue(2) != 255 || colors->GetValue(4) != 255)
+  {
+    std::cerr << "Wrong colors." << std::endl;
+    success = false;
+  }
+  colors->Delete();
+  expectedColors->Delete();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
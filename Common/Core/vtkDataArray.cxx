@@ -426,14 +426,116 @@ bool hasValidKey(InfoType info, KeyType key, double range[2])
 template <typename InfoType, typename KeyType, typename ComponentKeyType>
 bool hasValidKey(InfoType info, KeyType key, ComponentKeyType ckey, double range[2], int comp)
 {
-  if (info->Has(key))
+  // The per-component information may hold other keys, such as the
+  // DISCRETE_VALUES of vtkAbstractArray::GetProminentComponentValues().
+  vtkInformationVector* infoVec = info->Get(key);
+  if (infoVec && comp < infoVec->GetNumberOfInformationObjects())
   {
-    info->Get(key)->GetInformationObject(comp)->Get(ckey, range);
-    return true;
+    vtkInformation* compInfo = infoVec->GetInformationObject(comp);
+    if (compInfo->Has(ckey))
+    {
+      compInfo->Get(ckey, range);
+      return true;
+    }
   }
   return false;
 }
 
+// Set the range of a component in a per-component information vector,
+// keeping the other keys of the vector.
+void setComponentRange(vtkInformation* info, vtkInformationInformationVectorKey* key,
+  int numComps, int comp, const double range[2])
+{
+  vtkInformationVector* infoVec = info->Get(key);
+  if (!infoVec)
+  {
+    infoVec = vtkInformationVector::New();
+    info->Set(key, infoVec);
+    infoVec->FastDelete();
+  }
+  if (infoVec->GetNumberOfInformationObjects() < numComps)
+  {
+    infoVec->SetNumberOfInformationObjects(numComps);
+  }
+  infoVec->GetInformationObject(comp)->Set(vtkDataArray::COMPONENT_RANGE(), range, 2);
+}
+
+// Wrap the DoComputeAllRanges call for vtkArrayDispatch:
+struct AllRangesDispatchWrapper
+{
+  bool Success;
+  double* Ranges;
+  double* FiniteRanges;
+  double* NormRange;
+  double* FiniteNormRange;
+
+  AllRangesDispatchWrapper(
+    double* ranges, double* finiteRanges, double* normRange, double* finiteNormRange)
+    : Success(false)
+    , Ranges(ranges)
+    , FiniteRanges(finiteRanges)
+    , NormRange(normRange)
+    , FiniteNormRange(finiteNormRange)
+  {
+  }
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    this->Success = vtkDataArrayPrivate::DoComputeAllRanges(
+      array, this->Ranges, this->FiniteRanges, this->NormRange, this->FiniteNormRange);
+  }
+};
+
+// Compute in a single pass the ranges of the components, their finite ranges
+// and the ranges of the L2 norm, so that switching between the components,
+// the magnitude or the finite values of an array does not scan it again. The
+// ranges which are already cached, e.g. set by a reader, are kept. Returns
+// false if the array is empty, or if it cannot be dispatched, in which case
+// the virtual Compute*Range methods have to be used.
+bool cacheAllRanges(vtkDataArray* array)
+{
+  const int numComps = array->GetNumberOfComponents();
+  std::vector<double> ranges(numComps * 2);
+  std::vector<double> finiteRanges(numComps * 2);
+  double normRange[2];
+  double finiteNormRange[2];
+  AllRangesDispatchWrapper worker(ranges.data(), finiteRanges.data(), normRange, finiteNormRange);
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker) || !worker.Success)
+  {
+    return false;
+  }
+
+  vtkInformation* info = array->GetInformation();
+  double cached[2];
+  for (int i = 0; i < numComps; ++i)
+  {
+    if (!hasValidKey(
+          info, vtkAbstractArray::PER_COMPONENT(), vtkDataArray::COMPONENT_RANGE(), cached, i))
+    {
+      setComponentRange(info, vtkAbstractArray::PER_COMPONENT(), numComps, i, &ranges[i * 2]);
+    }
+    if (!hasValidKey(info, vtkAbstractArray::PER_FINITE_COMPONENT(),
+          vtkDataArray::COMPONENT_RANGE(), cached, i))
+    {
+      setComponentRange(
+        info, vtkAbstractArray::PER_FINITE_COMPONENT(), numComps, i, &finiteRanges[i * 2]);
+    }
+  }
+  if (numComps > 1)
+  {
+    if (!info->Has(vtkDataArray::L2_NORM_RANGE()))
+    {
+      info->Set(vtkDataArray::L2_NORM_RANGE(), normRange, 2);
+    }
+    if (!info->Has(vtkDataArray::L2_NORM_FINITE_RANGE()))
+    {
+      info->Set(vtkDataArray::L2_NORM_FINITE_RANGE(), finiteNormRange, 2);
+    }
+  }
+  return true;
+}
+
 } // end anon namespace
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1032,7 +1134,9 @@ void vtkDataArray::SetLookupTable(vtkLookupTable* lut)
     {
       this->LookupTable->Register(this);
     }
-    this->Modified();
+    // The values are unchanged: keep the cached ranges, which are typically
+    // used to rescale the new lookup table.
+    this->vtkObject::Modified();
   }
 }
 
@@ -1625,8 +1729,15 @@ void vtkDataArray::ComputeFiniteRange(
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, rkey, range))
     {
-      this->ComputeFiniteVectorRange(range);
-      info->Set(rkey, range, 2);
+      if (cacheAllRanges(this))
+      {
+        hasValidKey(info, rkey, range);
+      }
+      else
+      {
+        this->ComputeFiniteVectorRange(range);
+        info->Set(rkey, range, 2);
+      }
     }
     return;
   }
@@ -1647,19 +1758,24 @@ void vtkDataArray::ComputeFiniteRange(
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, PER_FINITE_COMPONENT(), rkey, range, comp))
     {
+      if (cacheAllRanges(this))
+      {
+        hasValidKey(info, PER_FINITE_COMPONENT(), rkey, range, comp);
+        return;
+      }
       const bool computed = this->ComputeFiniteScalarRange(allCompRanges.data());
       if (computed)
       {
-        // construct the keys and add them to the info object
-        vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set(PER_FINITE_COMPONENT(), infoVec);
-
-        infoVec->SetNumberOfInformationObjects(this->NumberOfComponents);
+        // add the keys which are not set yet to the info object
+        double cached[2];
         for (int i = 0; i < this->NumberOfComponents; ++i)
         {
-          infoVec->GetInformationObject(i)->Set(rkey, allCompRanges.data() + (i * 2), 2);
+          if (!hasValidKey(info, PER_FINITE_COMPONENT(), rkey, cached, i))
+          {
+            setComponentRange(
+              info, PER_FINITE_COMPONENT(), this->NumberOfComponents, i, &allCompRanges[i * 2]);
+          }
         }
-        infoVec->FastDelete();
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -1707,8 +1823,15 @@ void vtkDataArray::ComputeRange(
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, rkey, range))
     {
-      this->ComputeVectorRange(range);
-      info->Set(rkey, range, 2);
+      if (cacheAllRanges(this))
+      {
+        hasValidKey(info, rkey, range);
+      }
+      else
+      {
+        this->ComputeVectorRange(range);
+        info->Set(rkey, range, 2);
+      }
     }
     return;
   }
@@ -1729,19 +1852,24 @@ void vtkDataArray::ComputeRange(
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, PER_COMPONENT(), rkey, range, comp))
     {
+      if (cacheAllRanges(this))
+      {
+        hasValidKey(info, PER_COMPONENT(), rkey, range, comp);
+        return;
+      }
       const bool computed = this->ComputeScalarRange(allCompRanges.data());
       if (computed)
       {
-        // construct the keys and add them to the info object
-        vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set(PER_COMPONENT(), infoVec);
-
-        infoVec->SetNumberOfInformationObjects(this->NumberOfComponents);
+        // add the keys which are not set yet to the info object
+        double cached[2];
         for (int i = 0; i < this->NumberOfComponents; ++i)
         {
-          infoVec->GetInformationObject(i)->Set(rkey, allCompRanges.data() + (i * 2), 2);
+          if (!hasValidKey(info, PER_COMPONENT(), rkey, cached, i))
+          {
+            setComponentRange(
+              info, PER_COMPONENT(), this->NumberOfComponents, i, &allCompRanges[i * 2]);
+          }
         }
-        infoVec->FastDelete();
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -1751,6 +1879,38 @@ void vtkDataArray::ComputeRange(
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkDataArray::SetRange(const double range[2], int comp)
+{
+  if (comp >= this->NumberOfComponents)
+  { // Ignore requests for nonexistent components.
+    return;
+  }
+  if (comp < 0 && this->NumberOfComponents > 1)
+  {
+    this->GetInformation()->Set(L2_NORM_RANGE(), range, 2);
+    return;
+  }
+  setComponentRange(this->GetInformation(), PER_COMPONENT(), this->NumberOfComponents,
+    std::max(comp, 0), range);
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArray::SetFiniteRange(const double range[2], int comp)
+{
+  if (comp >= this->NumberOfComponents)
+  { // Ignore requests for nonexistent components.
+    return;
+  }
+  if (comp < 0 && this->NumberOfComponents > 1)
+  {
+    this->GetInformation()->Set(L2_NORM_FINITE_RANGE(), range, 2);
+    return;
+  }
+  setComponentRange(this->GetInformation(), PER_FINITE_COMPONENT(), this->NumberOfComponents,
+    std::max(comp, 0), range);
+}
+
 //------------------------------------------------------------------------------
 // call modified on superclass
 void vtkDataArray::Modified()
@@ -350,7 +350,11 @@ public:
    * of the magnitude (L2 norm) over all components will be provided. The
    * range is computed and then cached, and will not be re-computed on
    * subsequent calls to GetRange() unless the array is modified or the
-   * requested component changes.
+   * requested component changes. For the common array types, the ranges of
+   * all the components, of their finite values and of the magnitude are
+   * computed in the same pass and cached together, so that they can then be
+   * requested without another pass. Changing the lookup table of the array
+   * keeps the cached ranges.
    *
    * The version of this method with `ghosts` and `ghostsToSkip` allows to skip
    * values in the computation of the range. At a given id, if `ghosts[id] & ghostsToSkip != 0`,
@@ -465,6 +469,19 @@ public:
    */
   void GetFiniteRange(double range[2]) { this->GetFiniteRange(range, 0); }
 
+  ///@{
+  /**
+   * Set the range of the data array values for the given component, as if it
+   * was computed by GetRange() or GetFiniteRange(). If comp is -1, set the
+   * range of the magnitude (L2 norm) over all components. This allows readers
+   * which know the range of an array, e.g. from the metadata of a file, to
+   * spare the pass over the values. The range is not checked, and is removed
+   * when the array is modified, so it must be set once the values are.
+   */
+  void SetRange(const double range[2], int comp);
+  void SetFiniteRange(const double range[2], int comp);
+  ///@}
+
   ///@{
   /**
    * These methods return the Min and Max possible range of the native
@@ -29,6 +29,7 @@
 #include <array>
 #include <cassert> // for assert()
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace vtkDataArrayPrivate
@@ -344,6 +345,138 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+// Compute in a single pass the ranges of all the values and of the finite
+// values of each component and, for arrays with several components, the
+// ranges of the L2 norm of all the tuples and of the tuples with a finite
+// norm. As in MagnitudeAllValuesMinAndMax, the norms are computed at double
+// precision. NumComps is vtk::detail::DynamicTupleSize for any number of
+// components, which are then held by vectors.
+template <int NumComps, typename ArrayT, typename APIType = typename vtk::GetAPIType<ArrayT>>
+class AllRangesMinAndMax
+{
+private:
+  using ValuesT = typename std::conditional<NumComps == vtk::detail::DynamicTupleSize,
+    std::vector<APIType>, std::array<APIType, 2 * NumComps>>::type;
+  struct Ranges
+  {
+    ValuesT Values;
+    ValuesT FiniteValues;
+    // squared norms of all the tuples, then of the finite ones
+    std::array<double, 4> SquaredNorms;
+  };
+  ArrayT* Array;
+  const int NumberOfComponents;
+  Ranges ReducedRanges;
+  vtkSMPThreadLocal<Ranges> TLRanges;
+
+  static void Resize(std::vector<APIType>& values, int size) { values.resize(size); }
+  template <size_t Size>
+  static void Resize(std::array<APIType, Size>&, int) {}
+
+  void InitializeRanges(Ranges& ranges)
+  {
+    AllRangesMinAndMax::Resize(ranges.Values, 2 * this->NumberOfComponents);
+    AllRangesMinAndMax::Resize(ranges.FiniteValues, 2 * this->NumberOfComponents);
+    for (int i = 0, j = 0; i < this->NumberOfComponents; ++i, j += 2)
+    {
+      ranges.Values[j] = ranges.FiniteValues[j] = vtkTypeTraits<APIType>::Max();
+      ranges.Values[j + 1] = ranges.FiniteValues[j + 1] = vtkTypeTraits<APIType>::Min();
+    }
+    for (int j = 0; j < 4; j += 2)
+    {
+      ranges.SquaredNorms[j] = vtkTypeTraits<double>::Max();
+      ranges.SquaredNorms[j + 1] = vtkTypeTraits<double>::Min();
+    }
+  }
+
+public:
+  AllRangesMinAndMax(ArrayT* array)
+    : Array(array)
+    , NumberOfComponents(NumComps == vtk::detail::DynamicTupleSize
+          ? array->GetNumberOfComponents()
+          : NumComps)
+  {
+    this->InitializeRanges(this->ReducedRanges);
+  }
+  void Initialize() { this->InitializeRanges(this->TLRanges.Local()); }
+  void Reduce()
+  {
+    for (auto itr = this->TLRanges.begin(); itr != this->TLRanges.end(); ++itr)
+    {
+      const Ranges& ranges = *itr;
+      Ranges& reduced = this->ReducedRanges;
+      for (int i = 0, j = 0; i < this->NumberOfComponents; ++i, j += 2)
+      {
+        reduced.Values[j] = detail::min(reduced.Values[j], ranges.Values[j]);
+        reduced.Values[j + 1] = detail::max(reduced.Values[j + 1], ranges.Values[j + 1]);
+        reduced.FiniteValues[j] = detail::min(reduced.FiniteValues[j], ranges.FiniteValues[j]);
+        reduced.FiniteValues[j + 1] =
+          detail::max(reduced.FiniteValues[j + 1], ranges.FiniteValues[j + 1]);
+      }
+      for (int j = 0; j < 4; j += 2)
+      {
+        reduced.SquaredNorms[j] = detail::min(reduced.SquaredNorms[j], ranges.SquaredNorms[j]);
+        reduced.SquaredNorms[j + 1] =
+          detail::max(reduced.SquaredNorms[j + 1], ranges.SquaredNorms[j + 1]);
+      }
+    }
+  }
+  template <typename T>
+  void CopyRanges(T* ranges, T* finiteRanges, T* normRange, T* finiteNormRange)
+  {
+    const Ranges& reduced = this->ReducedRanges;
+    for (int j = 0; j < 2 * this->NumberOfComponents; ++j)
+    {
+      ranges[j] = static_cast<T>(reduced.Values[j]);
+      finiteRanges[j] = static_cast<T>(reduced.FiniteValues[j]);
+    }
+    if (this->NumberOfComponents > 1)
+    {
+      normRange[0] = static_cast<T>(std::sqrt(reduced.SquaredNorms[0]));
+      normRange[1] = static_cast<T>(std::sqrt(reduced.SquaredNorms[1]));
+      finiteNormRange[0] = static_cast<T>(std::sqrt(reduced.SquaredNorms[2]));
+      finiteNormRange[1] = static_cast<T>(std::sqrt(reduced.SquaredNorms[3]));
+    }
+  }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
+    Ranges& ranges = this->TLRanges.Local();
+    // the dynamic number of components is more than one
+    const bool norms = (NumComps != 1);
+    for (const auto tuple : tuples)
+    {
+      double squaredSum = 0.0;
+      size_t j = 0;
+      for (const APIType value : tuple)
+      {
+        vtkMathUtilities::UpdateRange(ranges.Values[j], ranges.Values[j + 1], value);
+        if (!detail::isinf(value))
+        {
+          vtkMathUtilities::UpdateRange(ranges.FiniteValues[j], ranges.FiniteValues[j + 1], value);
+        }
+        if (norms)
+        {
+          const double dValue = static_cast<double>(value);
+          squaredSum += dValue * dValue;
+        }
+        j += 2;
+      }
+      if (norms)
+      {
+        ranges.SquaredNorms[0] = detail::min(ranges.SquaredNorms[0], squaredSum);
+        ranges.SquaredNorms[1] = detail::max(ranges.SquaredNorms[1], squaredSum);
+        if (!detail::isinf(squaredSum))
+        {
+          ranges.SquaredNorms[2] = detail::min(ranges.SquaredNorms[2], squaredSum);
+          ranges.SquaredNorms[3] = detail::max(ranges.SquaredNorms[3], squaredSum);
+        }
+      }
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 template <int NumComps>
 struct ComputeScalarRange
@@ -635,6 +768,71 @@ bool DoComputeVectorRange(ArrayT* array, RangeValueType range[2], FiniteValues,
   return true;
 }
 
+//----------------------------------------------------------------------------
+template <int NumComps>
+struct ComputeAllRanges
+{
+  template <class ArrayT, typename RangeValueType>
+  bool operator()(ArrayT* array, RangeValueType* ranges, RangeValueType* finiteRanges,
+    RangeValueType* normRange, RangeValueType* finiteNormRange)
+  {
+    AllRangesMinAndMax<NumComps, ArrayT> minmax(array);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
+    minmax.CopyRanges(ranges, finiteRanges, normRange, finiteNormRange);
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Compute the ranges of DoComputeScalarRange with AllValues and FiniteValues
+// and, for arrays with several components, the ranges of DoComputeVectorRange
+// with AllValues and FiniteValues, in a single pass over the array. normRange
+// and finiteNormRange are left unchanged for arrays with a single component.
+template <typename ArrayT, typename RangeValueType>
+bool DoComputeAllRanges(ArrayT* array, RangeValueType* ranges, RangeValueType* finiteRanges,
+  RangeValueType normRange[2], RangeValueType finiteNormRange[2])
+{
+  const int numComp = array->GetNumberOfComponents();
+  for (int i = 0, j = 0; i < numComp; ++i, j += 2)
+  {
+    ranges[j] = finiteRanges[j] = vtkTypeTraits<RangeValueType>::Max();
+    ranges[j + 1] = finiteRanges[j + 1] = vtkTypeTraits<RangeValueType>::Min();
+  }
+  if (numComp > 1)
+  {
+    normRange[0] = finiteNormRange[0] = vtkTypeTraits<RangeValueType>::Max();
+    normRange[1] = finiteNormRange[1] = vtkTypeTraits<RangeValueType>::Min();
+  }
+
+  // do this after we make sure range is max to min
+  if (array->GetNumberOfTuples() == 0)
+  {
+    return false;
+  }
+
+  if (numComp == 1)
+  {
+    return ComputeAllRanges<1>()(array, ranges, finiteRanges, normRange, finiteNormRange);
+  }
+  else if (numComp == 2)
+  {
+    return ComputeAllRanges<2>()(array, ranges, finiteRanges, normRange, finiteNormRange);
+  }
+  else if (numComp == 3)
+  {
+    return ComputeAllRanges<3>()(array, ranges, finiteRanges, normRange, finiteNormRange);
+  }
+  else if (numComp == 4)
+  {
+    return ComputeAllRanges<4>()(array, ranges, finiteRanges, normRange, finiteNormRange);
+  }
+  else
+  {
+    return ComputeAllRanges<vtk::detail::DynamicTupleSize>()(
+      array, ranges, finiteRanges, normRange, finiteNormRange);
+  }
+}
+
 VTK_ABI_NAMESPACE_END
 } // end namespace vtkDataArrayPrivate
 #endif // VTK_GDA_TEMPLATE_EXTERN
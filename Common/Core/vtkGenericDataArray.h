@@ -441,6 +441,8 @@ bool DoComputeVectorRange(
 template <typename A, typename R>
 bool DoComputeVectorRange(
   A*, R[2], FiniteValues, const unsigned char* ghosts, unsigned char ghostsToSkip);
+template <typename A, typename R>
+bool DoComputeAllRanges(A*, R*, R*, R[2], R[2]);
 VTK_ABI_NAMESPACE_END
 } // namespace vtkDataArrayPrivate
 
@@ -499,7 +501,9 @@ VTK_ABI_NAMESPACE_END
   template VTKCOMMONCORE_EXPORT bool DoComputeVectorRange(ArrayType*, ValueType[2],                \
     vtkDataArrayPrivate::AllValues, const unsigned char*, unsigned char);                          \
   template VTKCOMMONCORE_EXPORT bool DoComputeVectorRange(ArrayType*, ValueType[2],                \
-    vtkDataArrayPrivate::FiniteValues, const unsigned char*, unsigned char);
+    vtkDataArrayPrivate::FiniteValues, const unsigned char*, unsigned char);                       \
+  template VTKCOMMONCORE_EXPORT bool DoComputeAllRanges(                                           \
+    ArrayType*, ValueType*, ValueType*, ValueType[2], ValueType[2]);
 
 #ifdef VTK_USE_SCALED_SOA_ARRAYS
 
@@ -552,6 +556,8 @@ bool DoComputeVectorRange(
 template <typename A, typename R>
 bool DoComputeVectorRange(
   A*, R[2], FiniteValues, const unsigned char* ghosts, unsigned char ghostsToSkip);
+template <typename A, typename R>
+bool DoComputeAllRanges(A*, R*, R*, R[2], R[2]);
 VTK_ABI_NAMESPACE_END
 } // namespace vtkDataArrayPrivate
 
@@ -563,7 +569,9 @@ VTK_ABI_NAMESPACE_END
   extern template VTKCOMMONCORE_EXPORT bool DoComputeVectorRange(ArrayType*, ValueType[2],         \
     vtkDataArrayPrivate::AllValues, const unsigned char*, unsigned char);                          \
   extern template VTKCOMMONCORE_EXPORT bool DoComputeVectorRange(ArrayType*, ValueType[2],         \
-    vtkDataArrayPrivate::FiniteValues, const unsigned char*, unsigned char);
+    vtkDataArrayPrivate::FiniteValues, const unsigned char*, unsigned char);                       \
+  extern template VTKCOMMONCORE_EXPORT bool DoComputeAllRanges(                                    \
+    ArrayType*, ValueType*, ValueType*, ValueType[2], ValueType[2]);
 
 #ifdef VTK_USE_SCALED_SOA_ARRAYS
 
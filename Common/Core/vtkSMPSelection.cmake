@@ -91,11 +91,13 @@ if (VTK_SMP_ENABLE_STDTHREAD)
   list(APPEND vtk_smp_sources
     "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.cxx"
     "${vtk_smp_implementation_dir}/vtkSMPThreadLocalBackend.cxx"
-    "${vtk_smp_implementation_dir}/vtkSMPThreadPool.cxx")
+    "${vtk_smp_implementation_dir}/vtkSMPThreadPool.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPWorkStealingRanges.cxx")
   list(APPEND vtk_smp_nowrap_headers
     "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.h"
     "${vtk_smp_implementation_dir}/vtkSMPThreadLocalBackend.h"
-    "${vtk_smp_implementation_dir}/vtkSMPThreadPool.h")
+    "${vtk_smp_implementation_dir}/vtkSMPThreadPool.h"
+    "${vtk_smp_implementation_dir}/vtkSMPWorkStealingRanges.h")
   list(APPEND vtk_smp_templates
     "${vtk_smp_implementation_dir}/vtkSMPToolsImpl.txx")
 endif()
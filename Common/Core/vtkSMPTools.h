@@ -34,10 +34,13 @@
 #include "vtkObject.h"
 
 #include "SMP/Common/vtkSMPToolsAPI.h"
-#include "vtkSMPThreadLocal.h" // For Initialized
+#include "SMP/Common/vtkSMPToolsInternal.h" // For the reduce and scan helpers
+#include "vtkSMPThreadLocal.h"                 // For Initialized
 
-#include <functional>  // For std::function
+#include <functional>  // For std::function, std::plus
+#include <iterator>    // For std::advance
 #include <type_traits> // For std:::enable_if
+#include <vector>      // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -603,6 +606,162 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A convenience method for reducing data. It is a drop in replacement for
+   * std::reduce(): it returns the combination of init and all the values of
+   * the range with the binary operation (std::plus by default). The
+   * operation must be associative, but it does not need to be commutative:
+   * the values are combined in order. The range is split in blocks whose
+   * number only depends on its size, so that the result does not depend on
+   * the number of threads nor on the backend, even with floating point
+   * values.
+   *
+   * Usage example:
+   * \code
+   * const auto range = vtk::DataArrayValueRange<1>(array);
+   * double sum = vtkSMPTools::Reduce(range.cbegin(), range.cend(), 0.0);
+   * \endcode
+   */
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp reduce)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(
+      begin, end, init, reduce, vtk::detail::smp::IdentityFunctor<T>());
+  }
+
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  ///@}
+
+  /**
+   * A convenience method for transforming and reducing data. It is a drop in
+   * replacement for std::transform_reduce(): each value of the range is
+   * transformed with the unary operation, and the results are combined with
+   * init using the binary operation, with the same guarantees as Reduce().
+   *
+   * Usage example:
+   * \code
+   * // number of kept cells
+   * vtkIdType count = vtkSMPTools::TransformReduce(flags.begin(), flags.end(), vtkIdType(0),
+   *   std::plus<vtkIdType>(), [](unsigned char flag) { return flag ? 1 : 0; });
+   * \endcode
+   */
+  template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+  static T TransformReduce(
+    Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, transform);
+  }
+
+  ///@{
+  /**
+   * Convenience methods for computing prefix sums. They are drop in
+   * replacements for std::inclusive_scan() and std::exclusive_scan(), with
+   * the same guarantees as Reduce(): the i-th output value is the combination
+   * of init and of the first i+1 (inclusive) or i (exclusive) input values.
+   * The output range may be the input range. Unlike the standard functions,
+   * they return the combination of init and all the input values, which is
+   * typically the size of the array whose offsets were computed.
+   *
+   * Usage example:
+   * \code
+   * // turn the number of points of each cell into offsets
+   * vtkIdType connectivitySize = vtkSMPTools::ExclusiveScan(
+   *   counts.begin(), counts.end(), offsets.begin(), vtkIdType(0));
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  static T InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op, T init)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Scan(begin, end, outBegin, init, op, true);
+  }
+
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Scan(begin, end, outBegin, init, op, false);
+  }
+
+  template <typename InputIt, typename OutputIt, typename T>
+  static T ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, outBegin, init, std::plus<T>());
+  }
+  ///@}
+
+  /**
+   * A convenience method for stream compaction. It writes in increasing
+   * order, starting at out, the indices i of [first, last) for which
+   * pred(i) is true, and returns their number. The output must be large
+   * enough for last - first indices. The predicate is evaluated twice for
+   * each index, once to count the selected indices and once to write them.
+   *
+   * Usage example:
+   * \code
+   * // ids of the kept cells
+   * keptCells->SetNumberOfIds(numCells);
+   * vtkIdType numKeptCells = vtkSMPTools::CompactIndices(0, numCells,
+   *   keptCells->GetPointer(0), [&](vtkIdType cellId) { return flags[cellId] != 0; });
+   * keptCells->Resize(numKeptCells);
+   * \endcode
+   */
+  template <typename OutputIt, typename Predicate>
+  static vtkIdType CompactIndices(vtkIdType first, vtkIdType last, OutputIt out, Predicate pred)
+  {
+    const vtkIdType size = last - first;
+    if (size <= 0)
+    {
+      return 0;
+    }
+    const vtkIdType numberOfBlocks = vtk::detail::smp::GetNumberOfReduceBlocks(size);
+    std::vector<vtkIdType> offsets(numberOfBlocks, 0);
+    vtkSMPTools::For(0, numberOfBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const vtkIdType blockEnd =
+          first + vtk::detail::smp::GetReduceBlockBegin(block + 1, numberOfBlocks, size);
+        vtkIdType count = 0;
+        for (vtkIdType i = first +
+               vtk::detail::smp::GetReduceBlockBegin(block, numberOfBlocks, size);
+             i < blockEnd; ++i)
+        {
+          count += pred(i) ? 1 : 0;
+        }
+        offsets[block] = count;
+      }
+    });
+    const vtkIdType total =
+      vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), vtkIdType(0));
+    vtkSMPTools::For(0, numberOfBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const vtkIdType blockEnd =
+          first + vtk::detail::smp::GetReduceBlockBegin(block + 1, numberOfBlocks, size);
+        OutputIt itOut(out);
+        std::advance(itOut, offsets[block]);
+        for (vtkIdType i = first +
+               vtk::detail::smp::GetReduceBlockBegin(block, numberOfBlocks, size);
+             i < blockEnd; ++i)
+        {
+          if (pred(i))
+          {
+            *itOut = i;
+            ++itOut;
+          }
+        }
+      }
+    });
+    return total;
+  }
 };
 
 VTK_ABI_NAMESPACE_END
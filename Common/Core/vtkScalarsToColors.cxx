@@ -16,6 +16,8 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkCharArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkStringArray.h"
 #include "vtkTemplateAliasMacro.h"
@@ -291,6 +293,7 @@ vtkUnsignedCharArray* vtkScalarsToColors::MapScalars(
   vtkUnsignedCharArray* newColors;
 
   vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(scalars);
+  vtkStringArray* stringArray = vtkArrayDownCast<vtkStringArray>(scalars);
 
   // map scalars through lookup table only if needed
   if ((colorMode == VTK_COLOR_MODE_DEFAULT &&
@@ -300,6 +303,34 @@ vtkUnsignedCharArray* vtkScalarsToColors::MapScalars(
     newColors = this->ConvertToRGBA(
       dataArray, scalars->GetNumberOfComponents(), dataArray->GetNumberOfTuples());
   }
+  else if (numberOfComponents == 1 && stringArray && stringArray->GetDictionaryEncoding())
+  {
+    // Map each distinct value once, then copy the colors of the codes
+    vtkStringArray* dictionary = stringArray->GetDictionary();
+    const vtkIdType numDistinct = dictionary->GetNumberOfValues();
+    vtkNew<vtkStringArray> distinct;
+    distinct->SetNumberOfValues(numDistinct);
+    for (vtkIdType i = 0; i < numDistinct; ++i)
+    {
+      const vtkIdType size = dictionary->GetValueSize(i);
+      distinct->SetValue(i, vtkStdString(dictionary->GetValueData(i), static_cast<size_t>(size)));
+    }
+    vtkUnsignedCharArray* distinctColors =
+      this->MapScalars(distinct.GetPointer(), colorMode, component, outputFormat);
+
+    const vtkIdType numValues = stringArray->GetNumberOfValues();
+    const int* codes = stringArray->GetCodesArray()->GetPointer(0);
+    const unsigned char* colors = distinctColors->GetPointer(0);
+    newColors = vtkUnsignedCharArray::New();
+    newColors->SetNumberOfComponents(outputFormat);
+    newColors->SetNumberOfTuples(numValues);
+    unsigned char* output = newColors->GetPointer(0);
+    for (vtkIdType i = 0; i < numValues; ++i)
+    {
+      std::copy_n(colors + codes[i] * outputFormat, outputFormat, output + i * outputFormat);
+    }
+    distinctColors->Delete();
+  }
   else
   {
     newColors = vtkUnsignedCharArray::New();
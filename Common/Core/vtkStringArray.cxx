@@ -27,11 +27,19 @@
 #include "vtkCharArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSortDataArray.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -43,6 +51,20 @@ VTK_ABI_NAMESPACE_BEGIN
 namespace
 {
 auto DefaultDeleteFunction = [](void* ptr) { delete[] reinterpret_cast<vtkStdString*>(ptr); };
+
+// Copy a value of the array, without converting its storage.
+vtkStdString ValueString(const vtkStringArray* array, vtkIdType id)
+{
+  return vtkStdString(array->GetValueData(id), static_cast<size_t>(array->GetValueSize(id)));
+}
+
+// Compare a value of the array with a string without copying the value.
+bool ValueEquals(const vtkStringArray* array, vtkIdType id, const vtkStdString& value)
+{
+  const size_t size = static_cast<size_t>(array->GetValueSize(id));
+  return size == value.size() &&
+    (size == 0 || std::memcmp(array->GetValueData(id), value.data(), size) == 0);
+}
 }
 
 //------------------------------------------------------------------------------
@@ -74,6 +96,115 @@ public:
   bool Rebuild;
 };
 
+//------------------------------------------------------------------------------
+// The codes of a dictionary encoded vtkStringArray, its distinct values, and
+// the code of each distinct value.
+class vtkStringArrayDictionary
+{
+public:
+  vtkStringArrayDictionary()
+    : Codes(vtkIntArray::New())
+    , Values(vtkStringArray::New())
+    , NumberOfIndexedValues(0)
+  {
+    this->Values->SetCompactStorage(true);
+  }
+  vtkStringArrayDictionary(vtkIntArray* codes, vtkStringArray* values)
+    : Codes(codes)
+    , Values(values)
+    , NumberOfIndexedValues(0)
+  {
+    this->Codes->Register(nullptr);
+    this->Values->Register(nullptr);
+  }
+  ~vtkStringArrayDictionary()
+  {
+    this->Codes->UnRegister(nullptr);
+    this->Values->UnRegister(nullptr);
+  }
+
+  // Return the code of a value, adding the value to the dictionary if needed.
+  int GetCode(const char* data, vtkIdType size)
+  {
+    this->UpdateIndex();
+    auto inserted = this->Index.emplace(std::string(data, static_cast<size_t>(size)),
+      static_cast<int>(this->Values->GetNumberOfValues()));
+    if (inserted.second)
+    {
+      this->Values->InsertNextValue(inserted.first->first);
+      ++this->NumberOfIndexedValues;
+    }
+    return inserted.first->second;
+  }
+
+  // Return the code of a value, or -1 if it is not in the dictionary.
+  int FindCode(const std::string& value)
+  {
+    this->UpdateIndex();
+    auto found = this->Index.find(value);
+    return found == this->Index.end() ? -1 : found->second;
+  }
+
+  vtkIntArray* Codes;
+  vtkStringArray* Values;
+
+private:
+  // The values given to SetDictionaryData() are indexed when first needed.
+  void UpdateIndex()
+  {
+    const vtkIdType numValues = this->Values->GetNumberOfValues();
+    for (; this->NumberOfIndexedValues < numValues; ++this->NumberOfIndexedValues)
+    {
+      const vtkIdType i = this->NumberOfIndexedValues;
+      this->Index.emplace(std::string(this->Values->GetValueData(i),
+                            static_cast<size_t>(this->Values->GetValueSize(i))),
+        static_cast<int>(i));
+    }
+  }
+
+  std::unordered_map<std::string, int> Index;
+  vtkIdType NumberOfIndexedValues;
+};
+
+//------------------------------------------------------------------------------
+// The values of an array with compact storage or dictionary encoding read by
+// GetValue(), as one vtkStdString each. A value is only copied when it is
+// first read, under a mutex so that threads can read the array concurrently,
+// and the copies are released when the array is modified. The compact storage
+// or the encoding is kept.
+class vtkStringArrayValueCache
+{
+public:
+  vtkStdString& GetValue(const vtkStringArray* array, vtkIdType id)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto value = this->Values.find(id);
+    if (value == this->Values.end())
+    {
+      vtkStdString copy(array->GetValueData(id), static_cast<size_t>(array->GetValueSize(id)));
+      value = this->Values.emplace(id, std::move(copy)).first;
+      this->Empty.store(false, std::memory_order_relaxed);
+    }
+    return value->second;
+  }
+
+  void Release()
+  {
+    if (!this->Empty.load(std::memory_order_relaxed))
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      std::unordered_map<vtkIdType, vtkStdString>().swap(this->Values);
+      this->Empty.store(true, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::mutex Mutex;
+  std::atomic<bool> Empty{ true };
+  // node based, so that the references returned by GetValue() stay valid
+  std::unordered_map<vtkIdType, vtkStdString> Values;
+};
+
 vtkStandardNewMacro(vtkStringArray);
 vtkStandardExtendedNewMacro(vtkStringArray);
 
@@ -84,6 +215,10 @@ vtkStringArray::vtkStringArray()
   this->Array = nullptr;
   this->DeleteFunction = DefaultDeleteFunction;
   this->Lookup = nullptr;
+  this->Characters = nullptr;
+  this->Offsets = nullptr;
+  this->Dictionary = nullptr;
+  this->ValueCache = new vtkStringArrayValueCache;
 }
 
 //------------------------------------------------------------------------------
@@ -95,6 +230,8 @@ vtkStringArray::~vtkStringArray()
     this->DeleteFunction(this->Array);
   }
   delete this->Lookup;
+  this->ReleaseEncodedStorage();
+  delete this->ValueCache;
 }
 
 //------------------------------------------------------------------------------
@@ -114,6 +251,7 @@ vtkArrayIterator* vtkStringArray::NewIterator()
 // from the suppled array.
 void vtkStringArray::SetArray(vtkStdString* array, vtkIdType size, int save, int deleteMethod)
 {
+  this->ReleaseEncodedStorage();
   if (this->Array && this->DeleteFunction)
   {
     vtkDebugMacro(<< "Deleting the array...");
@@ -165,6 +303,33 @@ void vtkStringArray::SetArrayFreeFunction(void (*callback)(void*))
 
 vtkTypeBool vtkStringArray::Allocate(vtkIdType sz, vtkIdType)
 {
+  if (this->Dictionary)
+  {
+    delete this->Dictionary;
+    this->Dictionary = new vtkStringArrayDictionary;
+    if (!this->Dictionary->Codes->Allocate(sz))
+    {
+      return 0;
+    }
+    this->Size = std::max(this->Size, sz);
+    this->MaxId = -1;
+    this->DataChanged();
+    return 1;
+  }
+  if (this->Characters)
+  {
+    if (!this->Offsets->Allocate(sz + 1))
+    {
+      return 0;
+    }
+    this->Offsets->InsertNextValue(0);
+    this->Characters->Reset();
+    this->Size = std::max(this->Size, sz);
+    this->MaxId = -1;
+    this->DataChanged();
+    return 1;
+  }
+
   if (sz > this->Size)
   {
     if (this->DeleteFunction)
@@ -192,6 +357,18 @@ vtkTypeBool vtkStringArray::Allocate(vtkIdType sz, vtkIdType)
 
 void vtkStringArray::Initialize()
 {
+  if (this->Characters)
+  {
+    // keep the compact storage
+    this->Characters->Initialize();
+    this->Offsets->Initialize();
+  }
+  if (this->Dictionary)
+  {
+    // keep the dictionary encoding
+    delete this->Dictionary;
+    this->Dictionary = new vtkStringArrayDictionary;
+  }
   if (this->DeleteFunction)
   {
     this->DeleteFunction(this->Array);
@@ -241,6 +418,9 @@ void vtkStringArray::DeepCopy(vtkAbstractArray* aa)
     this->DeleteFunction(this->Array);
   }
 
+  this->Array = nullptr;
+  this->ReleaseEncodedStorage();
+
   this->Superclass::DeepCopy(aa); // copy information objects.
 
   // Copy the given array into new memory.
@@ -248,6 +428,23 @@ void vtkStringArray::DeepCopy(vtkAbstractArray* aa)
   this->MaxId = fa->GetMaxId();
   this->Size = fa->GetSize();
   this->DeleteFunction = DefaultDeleteFunction;
+  if (fa->Characters)
+  {
+    this->Characters = vtkCharArray::New();
+    this->Characters->DeepCopy(fa->Characters);
+    this->Offsets = vtkIdTypeArray::New();
+    this->Offsets->DeepCopy(fa->Offsets);
+    this->DataChanged();
+    return;
+  }
+  if (fa->Dictionary)
+  {
+    this->Dictionary = new vtkStringArrayDictionary;
+    this->Dictionary->Codes->DeepCopy(fa->Dictionary->Codes);
+    this->Dictionary->Values->DeepCopy(fa->Dictionary->Values);
+    this->DataChanged();
+    return;
+  }
   this->Array = new vtkStdString[this->Size];
 
   for (int i = 0; i < this->Size; ++i)
@@ -332,6 +529,477 @@ void vtkStringArray::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Array: (null)\n";
   }
+  os << indent << "CompactStorage: " << (this->Characters ? "On" : "Off") << "\n";
+  if (this->Characters)
+  {
+    os << indent << "Offsets: " << this->Offsets << "\n";
+    os << indent << "Characters: " << this->Characters << "\n";
+  }
+  os << indent << "DictionaryEncoding: " << (this->Dictionary ? "On" : "Off") << "\n";
+  if (this->Dictionary)
+  {
+    os << indent << "Codes: " << this->Dictionary->Codes << "\n";
+    os << indent << "Dictionary: " << this->Dictionary->Values->GetNumberOfValues()
+       << " values\n";
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::SetCompactStorage(bool compact)
+{
+  if (compact == this->GetCompactStorage())
+  {
+    return;
+  }
+  if (!compact)
+  {
+    this->ExpandStorage();
+    return;
+  }
+
+  const vtkIdType numValues = this->MaxId + 1;
+  vtkIdType numChars = 0;
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    numChars += this->GetValueSize(i);
+  }
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numValues + 1);
+  vtkNew<vtkCharArray> characters;
+  characters->SetNumberOfValues(numChars);
+  vtkIdType* offset = offsets->GetPointer(0);
+  char* chars = characters->GetPointer(0);
+  offset[0] = 0;
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    const vtkIdType size = this->GetValueSize(i);
+    std::copy(this->GetValueData(i), this->GetValueData(i) + size, chars + offset[i]);
+    offset[i + 1] = offset[i] + size;
+  }
+
+  if (this->DeleteFunction)
+  {
+    this->DeleteFunction(this->Array);
+  }
+  this->Array = nullptr;
+  this->DeleteFunction = DefaultDeleteFunction;
+  this->ReleaseEncodedStorage();
+  this->Offsets = offsets;
+  this->Offsets->Register(this);
+  this->Characters = characters;
+  this->Characters->Register(this);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringArray::SetCompactData(vtkIdTypeArray* offsets, vtkCharArray* characters)
+{
+  if (!offsets || !characters || offsets->GetNumberOfValues() == 0 ||
+    offsets->GetNumberOfComponents() != 1 || characters->GetNumberOfComponents() != 1)
+  {
+    vtkErrorMacro("The offsets must hold at least one value, and both arrays one component.");
+    return false;
+  }
+  const vtkIdType numValues = offsets->GetNumberOfValues() - 1;
+  const vtkIdType* offset = offsets->GetPointer(0);
+  if (offset[0] != 0 || offset[numValues] > characters->GetNumberOfValues() ||
+    !std::is_sorted(offset, offset + numValues + 1))
+  {
+    vtkErrorMacro("The offsets do not fit the characters.");
+    return false;
+  }
+
+  offsets->Register(this);
+  characters->Register(this);
+  if (this->DeleteFunction)
+  {
+    this->DeleteFunction(this->Array);
+  }
+  this->Array = nullptr;
+  this->DeleteFunction = DefaultDeleteFunction;
+  this->ReleaseEncodedStorage();
+  this->Offsets = offsets;
+  this->Characters = characters;
+  this->Size = numValues;
+  this->MaxId = numValues - 1;
+  this->DataChanged();
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkIdTypeArray* vtkStringArray::GetOffsetsArray()
+{
+  if (!this->Characters)
+  {
+    return nullptr;
+  }
+  this->TruncateEncodedStorage(this->MaxId + 1);
+  return this->Offsets;
+}
+
+//------------------------------------------------------------------------------
+vtkCharArray* vtkStringArray::GetCharactersArray()
+{
+  if (!this->Characters)
+  {
+    return nullptr;
+  }
+  this->TruncateEncodedStorage(this->MaxId + 1);
+  return this->Characters;
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::SetDictionaryEncoding(bool encode)
+{
+  if (encode == this->GetDictionaryEncoding())
+  {
+    return;
+  }
+  if (!encode)
+  {
+    this->ExpandStorage();
+    return;
+  }
+  this->EncodeWithDictionary(VTK_ID_MAX);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringArray::TryDictionaryEncoding(double maximumDistinctFraction)
+{
+  if (this->Dictionary)
+  {
+    return true;
+  }
+  const double maxNumberOfDistinctValues = maximumDistinctFraction * (this->MaxId + 1);
+  if (!(maxNumberOfDistinctValues >= 1.0))
+  {
+    return false;
+  }
+  return this->EncodeWithDictionary(static_cast<vtkIdType>(
+    std::min(maxNumberOfDistinctValues, static_cast<double>(VTK_ID_MAX))));
+}
+
+//------------------------------------------------------------------------------
+// Encode the values unless there are more than maxNumberOfDistinctValues of
+// them.
+bool vtkStringArray::EncodeWithDictionary(vtkIdType maxNumberOfDistinctValues)
+{
+  const vtkIdType numValues = this->MaxId + 1;
+  vtkStringArrayDictionary* dictionary = new vtkStringArrayDictionary;
+  dictionary->Codes->SetNumberOfValues(numValues);
+  int* codes = dictionary->Codes->GetPointer(0);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    codes[i] = dictionary->GetCode(this->GetValueData(i), this->GetValueSize(i));
+    if (dictionary->Values->GetNumberOfValues() > maxNumberOfDistinctValues)
+    {
+      delete dictionary;
+      return false;
+    }
+  }
+
+  if (this->DeleteFunction)
+  {
+    this->DeleteFunction(this->Array);
+  }
+  this->Array = nullptr;
+  this->DeleteFunction = DefaultDeleteFunction;
+  this->ReleaseEncodedStorage();
+  this->Dictionary = dictionary;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringArray::SetDictionaryData(vtkIntArray* codes, vtkStringArray* dictionary)
+{
+  if (!codes || !dictionary || dictionary == this || codes->GetNumberOfComponents() != 1)
+  {
+    vtkErrorMacro("The codes must have one component, and the dictionary be another array.");
+    return false;
+  }
+  const int* code = codes->GetPointer(0);
+  const vtkIdType numValues = codes->GetNumberOfValues();
+  const vtkIdType numCodes = dictionary->GetNumberOfValues();
+  if (std::any_of(code, code + numValues, [numCodes](int c) { return c < 0 || c >= numCodes; }))
+  {
+    vtkErrorMacro("The codes do not fit the dictionary.");
+    return false;
+  }
+
+  vtkStringArrayDictionary* newDictionary = new vtkStringArrayDictionary(codes, dictionary);
+  if (this->DeleteFunction)
+  {
+    this->DeleteFunction(this->Array);
+  }
+  this->Array = nullptr;
+  this->DeleteFunction = DefaultDeleteFunction;
+  this->ReleaseEncodedStorage();
+  this->Dictionary = newDictionary;
+  this->Size = numValues;
+  this->MaxId = numValues - 1;
+  this->DataChanged();
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkIntArray* vtkStringArray::GetCodesArray()
+{
+  if (!this->Dictionary)
+  {
+    return nullptr;
+  }
+  this->TruncateEncodedStorage(this->MaxId + 1);
+  return this->Dictionary->Codes;
+}
+
+//------------------------------------------------------------------------------
+vtkStringArray* vtkStringArray::GetDictionary()
+{
+  return this->Dictionary ? this->Dictionary->Values : nullptr;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringArray::GetValueData(vtkIdType id) const
+{
+  if (this->Characters)
+  {
+    return this->Characters->GetPointer(0) + this->Offsets->GetValue(id);
+  }
+  if (this->Dictionary)
+  {
+    return this->Dictionary->Values->GetValueData(this->Dictionary->Codes->GetValue(id));
+  }
+  return this->Array[id].data();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkStringArray::GetValueSize(vtkIdType id) const
+{
+  if (this->Characters)
+  {
+    return this->Offsets->GetValue(id + 1) - this->Offsets->GetValue(id);
+  }
+  if (this->Dictionary)
+  {
+    return this->Dictionary->Values->GetValueSize(this->Dictionary->Codes->GetValue(id));
+  }
+  return static_cast<vtkIdType>(this->Array[id].size());
+}
+
+//------------------------------------------------------------------------------
+// Convert the compact storage or the dictionary encoding to one
+// vtkStdString per value.
+void vtkStringArray::ExpandStorage()
+{
+  if (!this->Characters && !this->Dictionary)
+  {
+    return;
+  }
+  const vtkIdType numValues = this->MaxId + 1;
+  const vtkIdType size = std::max(this->Size, numValues);
+  vtkStdString* array = nullptr;
+  if (size > 0)
+  {
+    array = new vtkStdString[size];
+    for (vtkIdType i = 0; i < numValues; ++i)
+    {
+      array[i].assign(this->GetValueData(i), static_cast<size_t>(this->GetValueSize(i)));
+    }
+  }
+  this->ReleaseEncodedStorage();
+  this->Array = array;
+  this->Size = array ? size : 0;
+  this->DeleteFunction = DefaultDeleteFunction;
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::ReleaseEncodedStorage()
+{
+  this->ValueCache->Release();
+  if (this->Characters)
+  {
+    this->Characters->UnRegister(this);
+    this->Characters = nullptr;
+    this->Offsets->UnRegister(this);
+    this->Offsets = nullptr;
+  }
+  delete this->Dictionary;
+  this->Dictionary = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Make the compact storage or the dictionary encoding hold exactly numValues
+// values, which must not be more than it holds.
+void vtkStringArray::TruncateEncodedStorage(vtkIdType numValues)
+{
+  this->ValueCache->Release();
+  if (this->Dictionary)
+  {
+    if (this->Dictionary->Codes->GetNumberOfValues() != numValues)
+    {
+      this->Dictionary->Codes->SetNumberOfValues(numValues);
+    }
+    return;
+  }
+  if (this->Offsets->GetNumberOfValues() == 0)
+  {
+    this->Offsets->InsertNextValue(0);
+  }
+  if (this->Offsets->GetNumberOfValues() != numValues + 1)
+  {
+    this->Offsets->SetNumberOfValues(numValues + 1);
+  }
+  const vtkIdType numChars = this->Offsets->GetValue(numValues);
+  if (this->Characters->GetNumberOfValues() != numChars)
+  {
+    this->Characters->SetNumberOfValues(numChars);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::InsertNextEncodedValue(const char* data, vtkIdType size)
+{
+  this->TruncateEncodedStorage(this->MaxId + 1);
+  if (this->Dictionary)
+  {
+    this->Dictionary->Codes->InsertNextValue(this->Dictionary->GetCode(data, size));
+  }
+  else
+  {
+    const vtkIdType end = this->Offsets->GetValue(this->MaxId + 1);
+    if (size > 0)
+    {
+      // A value of this array would be freed when the characters grow.
+      const char* chars = this->Characters->GetPointer(0);
+      std::less<const char*> before;
+      if (!before(data, chars) && before(data, chars + end))
+      {
+        const std::string value(data, static_cast<size_t>(size));
+        this->InsertNextEncodedValue(value.data(), size);
+        return;
+      }
+      std::copy(data, data + size, this->Characters->WritePointer(end, size));
+    }
+    this->Offsets->InsertNextValue(end + size);
+  }
+  ++this->MaxId;
+  this->Size = std::max(this->Size, this->MaxId + 1);
+  this->DataElementChanged(this->MaxId);
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::InsertEncodedValue(vtkIdType id, const char* data, vtkIdType size)
+{
+  this->ValueCache->Release();
+  if (id <= this->MaxId && this->Dictionary)
+  {
+    this->Dictionary->Codes->SetValue(id, this->Dictionary->GetCode(data, size));
+    this->DataElementChanged(id);
+    return;
+  }
+  if (id <= this->MaxId)
+  {
+    vtkStdString value(data, static_cast<size_t>(size));
+    this->ExpandStorage();
+    this->InsertValue(id, value);
+    return;
+  }
+  if (id > this->MaxId + 1)
+  {
+    this->SetNumberOfValues(id);
+  }
+  this->InsertNextEncodedValue(data, size);
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::SetEncodedValue(vtkIdType id, const vtkStdString& value)
+{
+  this->ValueCache->Release();
+  if (this->Dictionary)
+  {
+    this->Dictionary->Codes->SetValue(
+      id, this->Dictionary->GetCode(value.data(), static_cast<vtkIdType>(value.size())));
+  }
+  else
+  {
+    this->ExpandStorage();
+    this->Array[id] = value;
+  }
+  this->DataChanged();
+}
+
+//------------------------------------------------------------------------------
+// Insert a value of a string array, without converting the source storage.
+void vtkStringArray::InsertValueFrom(vtkIdType id, vtkStringArray* source, vtkIdType srcId)
+{
+  const char* data = source->GetValueData(srcId);
+  const vtkIdType size = source->GetValueSize(srcId);
+  if (this->Characters || this->Dictionary)
+  {
+    this->InsertEncodedValue(id, data, size);
+  }
+  else
+  {
+    this->InsertValue(id, vtkStdString(data, static_cast<size_t>(size)));
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringArray::SetNumberOfValues(vtkIdType numValues)
+{
+  if (!this->Characters && !this->Dictionary)
+  {
+    return this->Superclass::SetNumberOfValues(numValues);
+  }
+  numValues = std::max<vtkIdType>(numValues, 0);
+  this->TruncateEncodedStorage(std::min(numValues, this->MaxId + 1));
+  if (this->Dictionary)
+  {
+    vtkIntArray* codes = this->Dictionary->Codes;
+    const vtkIdType numCodes = codes->GetNumberOfValues();
+    if (numCodes < numValues)
+    {
+      // empty strings
+      const int code = this->Dictionary->GetCode("", 0);
+      codes->SetNumberOfValues(numValues);
+      std::fill_n(codes->GetPointer(numCodes), numValues - numCodes, code);
+    }
+  }
+  else if (this->Offsets->GetNumberOfValues() < numValues + 1)
+  {
+    const vtkIdType numOffsets = this->Offsets->GetNumberOfValues();
+    // empty strings
+    const vtkIdType end = this->Offsets->GetValue(numOffsets - 1);
+    this->Offsets->SetNumberOfValues(numValues + 1);
+    std::fill_n(this->Offsets->GetPointer(numOffsets), numValues + 1 - numOffsets, end);
+  }
+  this->MaxId = numValues - 1;
+  this->Size = std::max(this->Size, numValues);
+  this->DataChanged();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkStringArray::Squeeze()
+{
+  if (this->Dictionary)
+  {
+    this->TruncateEncodedStorage(this->MaxId + 1);
+    this->Dictionary->Codes->Squeeze();
+    this->Dictionary->Values->Squeeze();
+    this->Size = this->MaxId + 1;
+    return;
+  }
+  if (this->Characters)
+  {
+    this->TruncateEncodedStorage(this->MaxId + 1);
+    this->Offsets->Squeeze();
+    this->Characters->Squeeze();
+    this->Size = this->MaxId + 1;
+    return;
+  }
+  this->ResizeAndExtend(this->MaxId + 1);
 }
 
 //------------------------------------------------------------------------------
@@ -342,6 +1010,8 @@ vtkStdString* vtkStringArray::ResizeAndExtend(vtkIdType sz)
   vtkStdString* newArray;
   vtkIdType newSize;
 
+  this->ExpandStorage();
+
   if (sz > this->Size)
   {
     // Requested size is bigger than current size.  Allocate enough
@@ -417,6 +1087,19 @@ vtkTypeBool vtkStringArray::Resize(vtkIdType sz)
     return 1;
   }
 
+  if (this->Characters || this->Dictionary)
+  {
+    // the characters, the offsets and the codes grow when values are appended
+    if (newSize < this->MaxId + 1)
+    {
+      this->TruncateEncodedStorage(newSize);
+      this->MaxId = newSize - 1;
+    }
+    this->Size = newSize;
+    this->DataChanged();
+    return 1;
+  }
+
   newArray = new vtkStdString[newSize];
   if (!newArray)
   {
@@ -454,6 +1137,7 @@ vtkTypeBool vtkStringArray::Resize(vtkIdType sz)
 //------------------------------------------------------------------------------
 vtkStdString* vtkStringArray::WritePointer(vtkIdType id, vtkIdType number)
 {
+  this->ExpandStorage();
   vtkIdType newSize = id + number;
   if (newSize > this->Size)
   {
@@ -470,6 +1154,11 @@ vtkStdString* vtkStringArray::WritePointer(vtkIdType id, vtkIdType number)
 //------------------------------------------------------------------------------
 void vtkStringArray::InsertValue(vtkIdType id, vtkStdString f)
 {
+  if (this->Characters || this->Dictionary)
+  {
+    this->InsertEncodedValue(id, f.data(), static_cast<vtkIdType>(f.size()));
+    return;
+  }
   if (id >= this->Size)
   {
     if (!this->ResizeAndExtend(id + 1))
@@ -488,6 +1177,11 @@ void vtkStringArray::InsertValue(vtkIdType id, vtkStdString f)
 //------------------------------------------------------------------------------
 vtkIdType vtkStringArray::InsertNextValue(vtkStdString f)
 {
+  if (this->Characters || this->Dictionary)
+  {
+    this->InsertNextEncodedValue(f.data(), static_cast<vtkIdType>(f.size()));
+    return this->MaxId;
+  }
   this->InsertValue(++this->MaxId, f);
   this->DataElementChanged(this->MaxId);
   return this->MaxId;
@@ -502,6 +1196,16 @@ int vtkStringArray::GetDataTypeSize() const
 //------------------------------------------------------------------------------
 unsigned long vtkStringArray::GetActualMemorySize() const
 {
+  if (this->Characters)
+  {
+    return this->Characters->GetActualMemorySize() + this->Offsets->GetActualMemorySize();
+  }
+  if (this->Dictionary)
+  {
+    return this->Dictionary->Codes->GetActualMemorySize() +
+      this->Dictionary->Values->GetActualMemorySize();
+  }
+
   size_t totalSize = 0;
   size_t numPrims = static_cast<size_t>(this->GetSize());
 
@@ -517,6 +1221,21 @@ unsigned long vtkStringArray::GetActualMemorySize() const
 //------------------------------------------------------------------------------
 vtkIdType vtkStringArray::GetDataSize() const
 {
+  if (this->Characters)
+  {
+    const vtkIdType numValues = this->MaxId + 1;
+    return this->Offsets->GetValue(numValues) - this->Offsets->GetValue(0) + numValues;
+  }
+  if (this->Dictionary)
+  {
+    vtkIdType size = 0;
+    for (vtkIdType i = 0; i <= this->MaxId; ++i)
+    {
+      size += this->GetValueSize(i) + 1;
+    }
+    return size;
+  }
+
   size_t size = 0;
   size_t numStrs = static_cast<size_t>(this->GetMaxId() + 1);
   for (size_t i = 0; i < numStrs; i++)
@@ -545,7 +1264,7 @@ void vtkStringArray::SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source
   vtkIdType locj = j * sa->GetNumberOfComponents();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
   {
-    this->SetValue(loci + cur, sa->GetValue(locj + cur));
+    this->SetValue(loci + cur, ::ValueString(sa, locj + cur));
   }
   this->DataChanged();
 }
@@ -566,7 +1285,7 @@ void vtkStringArray::InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* sou
   vtkIdType locj = j * sa->GetNumberOfComponents();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
   {
-    this->InsertValue(loci + cur, sa->GetValue(locj + cur));
+    this->InsertValueFrom(loci + cur, sa, locj + cur);
   }
   this->DataChanged();
 }
@@ -601,7 +1320,7 @@ void vtkStringArray::InsertTuples(vtkIdList* dstIds, vtkIdList* srcIds, vtkAbstr
     vtkIdType dstLoc = dstIds->GetId(idIndex) * this->NumberOfComponents;
     while (numComp-- > 0)
     {
-      this->InsertValue(dstLoc++, sa->GetValue(srcLoc++));
+      this->InsertValueFrom(dstLoc++, sa, srcLoc++);
     }
   }
 
@@ -634,7 +1353,7 @@ void vtkStringArray::InsertTuplesStartingAt(
     vtkIdType dstLoc = (dstStart + idIndex) * this->NumberOfComponents;
     while (numComp-- > 0)
     {
-      this->InsertValue(dstLoc++, sa->GetValue(srcLoc++));
+      this->InsertValueFrom(dstLoc++, sa, srcLoc++);
     }
   }
 
@@ -673,7 +1392,7 @@ void vtkStringArray::InsertTuples(
     vtkIdType dstLoc = (dstStart + i) * this->NumberOfComponents;
     while (numComp-- > 0)
     {
-      this->InsertValue(dstLoc++, sa->GetValue(srcLoc++));
+      this->InsertValueFrom(dstLoc++, sa, srcLoc++);
     }
   }
 
@@ -696,7 +1415,7 @@ vtkIdType vtkStringArray::InsertNextTuple(vtkIdType j, vtkAbstractArray* source)
   vtkIdType locj = j * sa->GetNumberOfComponents();
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
   {
-    this->InsertNextValue(sa->GetValue(locj + cur));
+    this->InsertValueFrom(this->MaxId + 1, sa, locj + cur);
   }
   this->DataChanged();
   return (this->GetNumberOfTuples() - 1);
@@ -705,14 +1424,28 @@ vtkIdType vtkStringArray::InsertNextTuple(vtkIdType j, vtkAbstractArray* source)
 //------------------------------------------------------------------------------
 const vtkStdString& vtkStringArray::GetValue(vtkIdType id) const
 {
+  if (this->Characters || this->Dictionary)
+  {
+    return this->ValueCache->GetValue(this, id);
+  }
   return this->Array[id];
 }
 
 vtkStdString& vtkStringArray::GetValue(vtkIdType id)
 {
+  if (this->Characters || this->Dictionary)
+  {
+    return this->ValueCache->GetValue(this, id);
+  }
   return this->Array[id];
 }
 
+//------------------------------------------------------------------------------
+vtkVariant vtkStringArray::GetVariantValue(vtkIdType id)
+{
+  return vtkVariant(::ValueString(this, id));
+}
+
 //------------------------------------------------------------------------------
 void vtkStringArray::GetTuples(vtkIdList* indices, vtkAbstractArray* aa)
 {
@@ -734,7 +1467,7 @@ void vtkStringArray::GetTuples(vtkIdList* indices, vtkAbstractArray* aa)
   for (vtkIdType i = 0; i < indices->GetNumberOfIds(); ++i)
   {
     vtkIdType index = indices->GetId(i);
-    output->SetValue(i, this->GetValue(index));
+    output->SetValue(i, ::ValueString(this, index));
   }
 }
 
@@ -759,7 +1492,7 @@ void vtkStringArray::GetTuples(vtkIdType startIndex, vtkIdType endIndex, vtkAbst
   for (vtkIdType i = 0; i < (endIndex - startIndex) + 1; ++i)
   {
     vtkIdType index = startIndex + i;
-    output->SetValue(i, this->GetValue(index));
+    output->SetValue(i, ::ValueString(this, index));
   }
 }
 
@@ -783,7 +1516,7 @@ void vtkStringArray::UpdateLookup()
     std::vector<std::pair<vtkStdString, vtkIdType>> v;
     for (vtkIdType i = 0; i < numComps * numTuples; i++)
     {
-      v.emplace_back(this->Array[i], i);
+      v.emplace_back(::ValueString(this, i), i);
     }
     std::sort(v.begin(), v.end());
     for (vtkIdType i = 0; i < numComps * numTuples; i++)
@@ -811,6 +1544,14 @@ void vtkStringArray::LookupValue(vtkVariant var, vtkIdList* ids)
 //------------------------------------------------------------------------------
 vtkIdType vtkStringArray::LookupValue(const vtkStdString& value)
 {
+  if (this->Dictionary)
+  {
+    // compare codes, without sorting the values
+    const int code = this->Dictionary->FindCode(value);
+    const int* codes = this->Dictionary->Codes->GetPointer(0);
+    const int* found = std::find(codes, codes + this->MaxId + 1, code);
+    return code < 0 || found == codes + this->MaxId + 1 ? -1 : found - codes;
+  }
   this->UpdateLookup();
 
   // First look into the cached updates, to see if there were any
@@ -828,8 +1569,7 @@ vtkIdType vtkStringArray::LookupValue(const vtkStdString& value)
     if (value == cached->first)
     {
       // Check that the value in the original array hasn't changed.
-      vtkStdString currentValue = this->GetValue(cached->second);
-      if (value == currentValue)
+      if (::ValueEquals(this, cached->second, value))
       {
         return cached->second;
       }
@@ -860,8 +1600,7 @@ vtkIdType vtkStringArray::LookupValue(const vtkStdString& value)
     {
       // Check that the value in the original array hasn't changed.
       vtkIdType index = this->Lookup->IndexArray->GetId(offset);
-      vtkStdString currentValue = this->GetValue(index);
-      if (value == currentValue)
+      if (::ValueEquals(this, index, value))
       {
         return index;
       }
@@ -881,8 +1620,21 @@ vtkIdType vtkStringArray::LookupValue(const vtkStdString& value)
 //------------------------------------------------------------------------------
 void vtkStringArray::LookupValue(const vtkStdString& value, vtkIdList* ids)
 {
-  this->UpdateLookup();
   ids->Reset();
+  if (this->Dictionary)
+  {
+    const int code = this->Dictionary->FindCode(value);
+    const int* codes = this->Dictionary->Codes->GetPointer(0);
+    for (vtkIdType i = 0; code >= 0 && i <= this->MaxId; ++i)
+    {
+      if (codes[i] == code)
+      {
+        ids->InsertNextId(i);
+      }
+    }
+    return;
+  }
+  this->UpdateLookup();
 
   // First look into the cached updates, to see if there were any
   // cached changes. Find an equivalent element in the set of cached
@@ -894,8 +1646,7 @@ void vtkStringArray::LookupValue(const vtkStdString& value, vtkIdList* ids)
   while (cached.first != cached.second)
   {
     // Check that the value in the original array hasn't changed.
-    vtkStdString currentValue = this->GetValue(cached.first->second);
-    if (cached.first->first == currentValue)
+    if (::ValueEquals(this, cached.first->second, cached.first->first))
     {
       ids->InsertNextId(cached.first->second);
     }
@@ -916,8 +1667,7 @@ void vtkStringArray::LookupValue(const vtkStdString& value, vtkIdList* ids)
   {
     // Check that the value in the original array hasn't changed.
     vtkIdType index = this->Lookup->IndexArray->GetId(offset);
-    vtkStdString currentValue = this->GetValue(index);
-    if (*found.first == currentValue)
+    if (::ValueEquals(this, index, *found.first))
     {
       ids->InsertNextId(index);
     }
@@ -930,6 +1680,7 @@ void vtkStringArray::LookupValue(const vtkStdString& value, vtkIdList* ids)
 //------------------------------------------------------------------------------
 void vtkStringArray::DataChanged()
 {
+  this->ValueCache->Release();
   if (this->Lookup)
   {
     this->Lookup->Rebuild = true;
@@ -939,6 +1690,7 @@ void vtkStringArray::DataChanged()
 //------------------------------------------------------------------------------
 void vtkStringArray::DataElementChanged(vtkIdType id)
 {
+  this->ValueCache->Release();
   if (this->Lookup)
   {
     if (this->Lookup->Rebuild)
@@ -955,7 +1707,7 @@ void vtkStringArray::DataElementChanged(vtkIdType id)
     else
     {
       // Insert this change into the set of cached updates
-      std::pair<const vtkStdString, vtkIdType> value(this->GetValue(id), id);
+      std::pair<const vtkStdString, vtkIdType> value(::ValueString(this, id), id);
       this->Lookup->CachedUpdates.insert(value);
     }
   }
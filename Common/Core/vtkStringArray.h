@@ -20,6 +20,28 @@
  * Points and cells may sometimes have associated data that are stored
  * as strings, e.g. labels for information visualization projects.
  * This class provides a clean way to store and access those strings.
+ *
+ * By default each value is held by a vtkStdString. With SetCompactStorage(),
+ * the values are instead stored one after the other, without terminating
+ * character, in a single vtkCharArray, and an offsets vtkIdTypeArray gives
+ * where each one starts, as in vtkCellArray or Apache Arrow string arrays.
+ * This spares the allocation and the header of one string per value, which
+ * dominate the memory of large tables of short strings. Appending values,
+ * reading them, through GetValueData() and GetValueSize() or GetValue(),
+ * copying tuples and looking values up keep the compact storage, while the
+ * methods which write values through a vtkStdString (SetValue(),
+ * GetPointer(), WritePointer(), NewIterator()...) convert the array back to
+ * one vtkStdString per value first. GetValue() copies each value it reads to
+ * a vtkStdString, until the array is modified.
+ *
+ * With SetDictionaryEncoding(), the array instead stores each distinct value
+ * once, in a dictionary, and an integer code per value, the index of the
+ * value in the dictionary. This suits columns with few distinct values
+ * repeated many times, such as categories or labels: besides the memory,
+ * algorithms can work on the codes, e.g. count or color each distinct value
+ * once, instead of comparing strings. Setting values keeps the dictionary
+ * encoding as well.
+ *
  * @par Thanks:
  * Andy Wilson (atwilso@sandia.gov) wrote this class.
  */
@@ -32,7 +54,12 @@
 #include "vtkStdString.h"        // needed for vtkStdString definition
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkCharArray;
+class vtkIdTypeArray;
+class vtkIntArray;
+class vtkStringArrayDictionary;
 class vtkStringArrayLookup;
+class vtkStringArrayValueCache;
 
 class VTKCOMMONCORE_EXPORT vtkStringArray : public vtkAbstractArray
 {
@@ -80,7 +107,7 @@ public:
    * Free any unnecessary memory.
    * Resize object to just fit data requirement. Reclaims extra memory.
    */
-  void Squeeze() override { this->ResizeAndExtend(this->MaxId + 1); }
+  void Squeeze() override;
 
   /**
    * Resize the array while conserving the data.
@@ -170,24 +197,49 @@ public:
    */
   vtkTypeBool Allocate(vtkIdType sz, vtkIdType ext = 1000) override;
 
+  ///@{
   /**
    * Read-access of string at a particular index.
+   * An array with compact storage or dictionary encoding keeps its storage:
+   * the value is copied to a vtkStdString when it is first read, which is
+   * thread safe, and the returned reference is valid until the array is
+   * modified. Modifying this copy does not modify the array, use SetValue()
+   * instead. GetValueData() and GetValueSize() read values without copying
+   * them.
    */
   const vtkStdString& GetValue(vtkIdType id) const
     VTK_EXPECTS(0 <= id && id < this->GetNumberOfValues());
+  vtkStdString& GetValue(vtkIdType id) VTK_EXPECTS(0 <= id && id < this->GetNumberOfValues());
+  ///@}
 
+  ///@{
   /**
-   * Get the string at a particular index.
+   * Get the characters and the number of characters of the string at a
+   * particular index, whatever the storage of the array. The characters of
+   * an array with compact storage are not followed by a terminating
+   * character. They are valid until the array is modified. These methods
+   * never convert the storage of the array and are thread safe.
    */
-  vtkStdString& GetValue(vtkIdType id) VTK_EXPECTS(0 <= id && id < this->GetNumberOfValues());
+  VTK_WRAPEXCLUDE const char* GetValueData(vtkIdType id) const
+    VTK_EXPECTS(0 <= id && id < this->GetNumberOfValues());
+  vtkIdType GetValueSize(vtkIdType id) const
+    VTK_EXPECTS(0 <= id && id < this->GetNumberOfValues());
+  ///@}
 
   /**
    * Set the data at a particular index. Does not do range checking. Make sure
    * you use the method SetNumberOfValues() before inserting data.
+   * An array with compact storage is first converted to one vtkStdString
+   * per value, while a dictionary encoded array stays encoded.
    */
   void SetValue(vtkIdType id, vtkStdString value)
     VTK_EXPECTS(0 <= id && id < this->GetNumberOfValues())
   {
+    if (this->Characters || this->Dictionary)
+    {
+      this->SetEncodedValue(id, value);
+      return;
+    }
     this->Array[id] = value;
     this->DataChanged();
   }
@@ -204,6 +256,12 @@ public:
     this->SetNumberOfValues(this->NumberOfComponents * number);
   }
 
+  /**
+   * Specify the number of values for this object to hold. New values are
+   * empty strings in compact storage or dictionary encoding.
+   */
+  bool SetNumberOfValues(vtkIdType numValues) override;
+
   /**
    * Return the number of values in the array.
    */
@@ -217,10 +275,20 @@ public:
 
   /**
    * Insert data at a specified position in the array.
+   * Inserting past the end of an array with compact storage or dictionary
+   * encoding appends the value, after empty strings if there is a gap.
+   * Replacing a value of an array with compact storage converts it to one
+   * vtkStdString per value first.
    */
   void InsertValue(vtkIdType id, vtkStdString f) VTK_EXPECTS(0 <= id);
   void InsertValue(vtkIdType id, const char* val) VTK_EXPECTS(0 <= id) VTK_EXPECTS(val != nullptr);
 
+  /**
+   * Retrieve a value from the array as a variant, without converting the
+   * storage of the array.
+   */
+  vtkVariant GetVariantValue(vtkIdType valueIdx) override;
+
   /**
    * Set a value in the array form a variant.
    * Insert a value into the array from a variant.
@@ -243,19 +311,31 @@ public:
    * Get the address of a particular data index. Make sure data is allocated
    * for the number of items requested. Set MaxId according to the number of
    * data values requested.
+   * An array with compact storage or dictionary encoding is first converted
+   * to one vtkStdString per value.
    */
   vtkStdString* WritePointer(vtkIdType id, vtkIdType number);
 
   /**
    * Get the address of a particular data index. Performs no checks
    * to verify that the memory has been allocated etc.
+   * An array with compact storage or dictionary encoding is first converted
+   * to one vtkStdString per value.
    */
-  vtkStdString* GetPointer(vtkIdType id) { return this->Array + id; }
+  vtkStdString* GetPointer(vtkIdType id)
+  {
+    if (this->Characters || this->Dictionary)
+    {
+      this->ExpandStorage();
+    }
+    return this->Array + id;
+  }
   void* GetVoidPointer(vtkIdType id) override { return this->GetPointer(id); }
 
   /**
    * Deep copy of another string array.  Will complain and change nothing
-   * if the array passed in is not a vtkStringArray.
+   * if the array passed in is not a vtkStringArray. The storage or the
+   * encoding of the other array is copied as well.
    */
   void DeepCopy(vtkAbstractArray* aa) override;
 
@@ -270,6 +350,7 @@ public:
    * If the delete method is VTK_DATA_ARRAY_USER_DEFINED
    * a custom free function can be assigned to be called using SetArrayFreeFunction,
    * if no custom function is assigned we will default to delete[].
+   * The array no longer uses compact storage or dictionary encoding.
    */
   void SetArray(
     vtkStdString* array, vtkIdType size, int save, int deleteMethod = VTK_DATA_ARRAY_DELETE);
@@ -305,6 +386,8 @@ public:
 
   /**
    * Returns a vtkArrayIteratorTemplate<vtkStdString>.
+   * An array with compact storage or dictionary encoding is first converted
+   * to one vtkStdString per value.
    */
   VTK_NEWINSTANCE vtkArrayIterator* NewIterator() override;
 
@@ -353,6 +436,77 @@ public:
    */
   void ClearLookup() override;
 
+  ///@{
+  /**
+   * Set/Get whether the values are stored in a single array of characters
+   * and an array of offsets rather than by one vtkStdString each. Turning
+   * the compact storage on or off converts the values which are already in
+   * the array. Off by default.
+   */
+  void SetCompactStorage(bool compact);
+  bool GetCompactStorage() const { return this->Characters != nullptr; }
+  vtkBooleanMacro(CompactStorage, bool);
+  ///@}
+
+  /**
+   * Use the given arrays as compact storage, without copying them: the
+   * characters of value i are characters[offsets[i]] to
+   * characters[offsets[i + 1] - 1], without terminating character, so that
+   * offsets holds one more value than the array, starting with 0. The arrays
+   * are shared with the caller, e.g. a reader which filled them, and are
+   * modified when values are appended. Returns false and changes nothing if
+   * the offsets do not fit the characters.
+   */
+  bool SetCompactData(vtkIdTypeArray* offsets, vtkCharArray* characters);
+
+  ///@{
+  /**
+   * Return the offsets and the characters of an array with compact
+   * storage, as described in SetCompactData(), or nullptr otherwise.
+   */
+  vtkIdTypeArray* GetOffsetsArray();
+  vtkCharArray* GetCharactersArray();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get whether the array stores its distinct values once, in a
+   * dictionary, and the code of each value in the dictionary. Turning the
+   * encoding on or off converts the values which are already in the array.
+   * Off by default.
+   */
+  void SetDictionaryEncoding(bool encode);
+  bool GetDictionaryEncoding() const { return this->Dictionary != nullptr; }
+  vtkBooleanMacro(DictionaryEncoding, bool);
+  ///@}
+
+  /**
+   * Turn the dictionary encoding on if the number of distinct values is at
+   * most the given fraction of the number of values, e.g. for readers which
+   * do not know the values in advance. Returns whether the array is
+   * dictionary encoded.
+   */
+  bool TryDictionaryEncoding(double maximumDistinctFraction);
+
+  /**
+   * Use the given codes and dictionary as dictionary encoding, without
+   * copying them: value i is dictionary->GetValue(codes[i]). The arrays are
+   * shared with the caller, and new values are appended to the dictionary.
+   * Returns false and changes nothing if a code is not an index of the
+   * dictionary.
+   */
+  bool SetDictionaryData(vtkIntArray* codes, vtkStringArray* dictionary);
+
+  ///@{
+  /**
+   * Return the codes and the dictionary of a dictionary encoded array, or
+   * nullptr otherwise. The dictionary may hold values which are no longer
+   * used by any code, and must not be modified.
+   */
+  vtkIntArray* GetCodesArray();
+  vtkStringArray* GetDictionary();
+  ///@}
+
 protected:
   vtkStringArray();
   ~vtkStringArray() override;
@@ -368,6 +522,23 @@ private:
 
   vtkStringArrayLookup* Lookup;
   void UpdateLookup();
+
+  // Compact storage and dictionary encoding, see SetCompactStorage() and
+  // SetDictionaryEncoding(). After a Reset(), Offsets may hold more than
+  // MaxId + 2 values and the codes more than MaxId + 1, the extra ones are
+  // discarded by TruncateEncodedStorage().
+  vtkCharArray* Characters;
+  vtkIdTypeArray* Offsets;
+  vtkStringArrayDictionary* Dictionary;
+  vtkStringArrayValueCache* ValueCache;
+  void ExpandStorage();
+  void ReleaseEncodedStorage();
+  void TruncateEncodedStorage(vtkIdType numValues);
+  void InsertNextEncodedValue(const char* data, vtkIdType size);
+  void InsertEncodedValue(vtkIdType id, const char* data, vtkIdType size);
+  void SetEncodedValue(vtkIdType id, const vtkStdString& value);
+  bool EncodeWithDictionary(vtkIdType maxNumberOfDistinctValues);
+  void InsertValueFrom(vtkIdType id, vtkStringArray* source, vtkIdType srcId);
 };
 
 VTK_ABI_NAMESPACE_END
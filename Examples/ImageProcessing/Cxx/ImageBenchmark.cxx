@@ -111,7 +111,7 @@ const char* HelpText =
   "  resize:kernelsize=1        Test vtkImageResize.\n"
   "  convolve:kernelsize=3      Test vtkImageConvolve.\n"
   "  separable:kernelsize=3     Test vtkImageSeparableConvolution.\n"
-  "  gaussian:kernelsize=3      Test vtkImageGaussianSmooth.\n"
+  "  gaussian:kernelsize=3      Test vtkImageGaussianSmooth (see below).\n"
   "  bspline:degree=3           Test vtkImageBSplineCoefficients.\n"
   "  fft                        Test vtkImageFFT.\n"
   "  histogram:stencil          Test vtkImageHistogram.\n"
@@ -122,6 +122,12 @@ const char* HelpText =
   "  kernel=nearest|linear|cubic|sinc|bspline   The interpolator to use.\n"
   "  kernelsize=4               The kernelsize (sinc, bspline only).\n"
   "  rotation=0/0/0/0           Rotation angle (degrees) and axis.\n"
+  "  slab=1                     Number of slices to average (thick slab).\n"
+  "\n"
+  "The gaussian filter takes the following options:\n"
+  "  kernelsize=3               Kernel size, standard deviation is (N-1)/4.\n"
+  "  method=kernel|box          Convolve with a kernel, or with box filters.\n"
+  "  passes=3                   The number of box filters (box only).\n"
   "\n"
   "The colormap filter takes the following options:\n"
   "  components=3               Output components (3=RGB, 4=RGBA).\n"
@@ -152,8 +158,16 @@ const char* DefaultFilters[] = {
   "reslice:kernel=bspline:rotation=60/0/1/1",
   "reslice:kernel=sinc:rotation=60/0/1/1",
   "reslice:kernel=sinc:rotation=60/0/1/1:stencil",
+  "reslice:kernel=linear:rotation=60/0/1/1:slab=8",
+  "reslice:kernel=cubic:rotation=60/0/1/1:slab=8",
 
   "gaussian:kernelsize=3",
+  "gaussian:kernelsize=9",
+  "gaussian:kernelsize=33",
+  "gaussian:kernelsize=3:method=box",
+  "gaussian:kernelsize=9:method=box",
+  "gaussian:kernelsize=33:method=box",
+  "gaussian:kernelsize=33:method=box:passes=5",
   "convolve:kernelsize=3",
   "separable:kernelsize=3",
   "resize:kernelsize=3",
@@ -254,6 +268,7 @@ static void PrintInfo(vtkThreadedImageAlgorithm* filter, std::ostream& os)
     {
       os << ((k % 4 == 0) ? " " : "") << axes[k] << (k != 15 ? "," : "\n");
     }
+    os << "SlabNumberOfSlices: " << reslice->GetSlabNumberOfSlices() << "\n";
   }
   vtkImageResize* resize = vtkImageResize::SafeDownCast(filter);
   if (resize)
@@ -295,6 +310,8 @@ static void PrintInfo(vtkThreadedImageAlgorithm* filter, std::ostream& os)
     os << "StandardDeviations: " << f[0] << "," << f[1] << "," << f[2] << "\n";
     f = gaussian->GetRadiusFactors();
     os << "RadiusFactors: " << f[0] << "," << f[1] << "," << f[2] << "\n";
+    os << "SmoothingMethod: " << gaussian->GetSmoothingMethodAsString() << "\n";
+    os << "NumberOfBoxPasses: " << gaussian->GetNumberOfBoxPasses() << "\n";
   }
   vtkImageMapToColors* colors = vtkImageMapToColors::SafeDownCast(filter);
   if (colors)
@@ -369,6 +386,7 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
     bool mask = false;
     std::string kernel;
     int kernelsize = 0;
+    int slab = 1;
     double rotation[4] = { 0.0, 0.0, 0.0, 0.0 };
 
     for (size_t k = 1; k < args.size(); k++)
@@ -426,6 +444,22 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
           return nullptr;
         }
       }
+      else if (key == "slab")
+      {
+        if (n == std::string::npos || n + 1 == args[k].size() || args[k][n + 1] < '0' ||
+          args[k][n + 1] > '9')
+        {
+          std::cerr << "reslice slab should be slab=N\n";
+          return nullptr;
+        }
+        std::string num = args[k].substr(n + 1);
+        slab = std::atoi(num.c_str());
+        if (slab < 1)
+        {
+          std::cerr << "reslice slab must be at least 1\n";
+          return nullptr;
+        }
+      }
       else
       {
         std::cerr << "reslice does not take option " << key << "\n";
@@ -537,6 +571,8 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
       filter->SetResliceAxes(matrix);
     }
 
+    filter->SetSlabNumberOfSlices(slab);
+
     filter->SetOutputExtent(0, size[0] - 1, 0, size[1] - 1, 0, size[2] - 1);
 
     filter->Register(nullptr);
@@ -747,25 +783,76 @@ static vtkThreadedImageAlgorithm* CreateFilter(const std::string& filterName, co
     vtkSmartPointer<vtkImageGaussianSmooth> filter = vtkSmartPointer<vtkImageGaussianSmooth>::New();
 
     int kernelsize = 3;
+    std::string method;
+    int passes = 0;
 
-    if (args.size() > 1)
+    for (size_t k = 1; k < args.size(); k++)
     {
-      size_t n = args[1].find('=');
-      if (args[1].substr(0, n) != "kernelsize" || n == std::string::npos ||
-        n + 1 == args[1].size() || args[1][n + 1] < '1' || args[1][n + 1] > '9' || args.size() > 2)
+      size_t n = args[k].find('=');
+      std::string key = args[k].substr(0, n);
+      if (key == "kernelsize")
       {
-        std::cerr << "gaussian options: kernelsize=N\n";
-        return nullptr;
+        if (n == std::string::npos || n + 1 == args[k].size() || args[k][n + 1] < '1' ||
+          args[k][n + 1] > '9')
+        {
+          std::cerr << "gaussian kernelsize should be kernelsize=N\n";
+          return nullptr;
+        }
+        std::string num = args[k].substr(n + 1);
+        kernelsize = std::atoi(num.c_str());
+        if (kernelsize % 2 != 1)
+        {
+          std::cerr << "gaussian kernelsize must be odd\n";
+          return nullptr;
+        }
       }
-      std::string num = args[1].substr(n + 1);
-      kernelsize = std::atoi(num.c_str());
-      if (kernelsize % 2 != 1)
+      else if (key == "method")
+      {
+        if (n == std::string::npos || n + 1 == args[k].size())
+        {
+          std::cerr << "gaussian method should be method=name\n";
+          return nullptr;
+        }
+        method = args[k].substr(n + 1);
+      }
+      else if (key == "passes")
+      {
+        if (n == std::string::npos || n + 1 == args[k].size() || args[k][n + 1] < '1' ||
+          args[k][n + 1] > '9')
+        {
+          std::cerr << "gaussian passes should be passes=N\n";
+          return nullptr;
+        }
+        std::string num = args[k].substr(n + 1);
+        passes = std::atoi(num.c_str());
+      }
+      else
       {
-        std::cerr << "gaussian kernelsize must be odd\n";
+        std::cerr << "gaussian does not take option " << key << "\n";
         return nullptr;
       }
     }
 
+    // if method not set but passes is set, default to box
+    if (passes > 0 && method.empty())
+    {
+      method = "box";
+    }
+
+    if (method == "box")
+    {
+      filter->SetSmoothingMethodToBoxFilters();
+      if (passes > 0)
+      {
+        filter->SetNumberOfBoxPasses(passes);
+      }
+    }
+    else if (method != "kernel" && !method.empty())
+    {
+      std::cerr << "gaussian method " << method << " not recognized\n";
+      return nullptr;
+    }
+
     double stdev = (kernelsize - 1.0) * 0.25;
     if (size[2] > 1)
     {
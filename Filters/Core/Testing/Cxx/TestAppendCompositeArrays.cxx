@@ -0,0 +1,209 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendCompositeArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkAppendPolyData and vtkAppendFilter append the points, cells
+// and attributes of their inputs in order, whatever the number of threads, and
+// that with UseCompositeArrays the output arrays are views with the same values.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Add a point and a cell array whose values identify the dataset.
+void AddArrays(vtkDataSet* dataSet, int index)
+{
+  vtkNew<vtkFloatArray> pointArray;
+  pointArray->SetName("PointArray");
+  for (vtkIdType ptId = 0; ptId < dataSet->GetNumberOfPoints(); ++ptId)
+  {
+    pointArray->InsertNextValue(index * 100000 + ptId);
+  }
+  dataSet->GetPointData()->AddArray(pointArray);
+  vtkNew<vtkFloatArray> cellArray;
+  cellArray->SetName("CellArray");
+  cellArray->SetNumberOfComponents(2);
+  for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+  {
+    cellArray->InsertNextTuple2(index, cellId);
+  }
+  dataSet->GetCellData()->AddArray(cellArray);
+}
+
+//------------------------------------------------------------------------------
+// The points and point values of the inputs must follow each other in the
+// output, in the order of the inputs. So must the cells of unstructured grids,
+// polydata cells being grouped by kind.
+bool CheckAppended(vtkDataSet* output, vtkAlgorithm* append)
+{
+  const bool checkCells = vtkUnstructuredGrid::SafeDownCast(output) != nullptr;
+  vtkDataArray* pointArray = output->GetPointData()->GetArray("PointArray");
+  vtkDataArray* cellArray = output->GetCellData()->GetArray("CellArray");
+  vtkIdType ptOffset = 0;
+  vtkIdType cellOffset = 0;
+  for (int i = 0; i < append->GetNumberOfInputConnections(0); ++i)
+  {
+    vtkDataSet* input = vtkDataSet::SafeDownCast(append->GetInputDataObject(0, i));
+    for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+    {
+      double x[3], expectedX[3];
+      output->GetPoint(ptOffset + ptId, x);
+      input->GetPoint(ptId, expectedX);
+      if (x[0] != expectedX[0] || x[1] != expectedX[1] || x[2] != expectedX[2] ||
+        pointArray->GetComponent(ptOffset + ptId, 0) != i * 100000 + ptId)
+      {
+        std::cerr << "Wrong point " << ptId << " of input " << i << std::endl;
+        return false;
+      }
+    }
+    for (vtkIdType cellId = 0; checkCells && cellId < input->GetNumberOfCells(); ++cellId)
+    {
+      if (output->GetCellType(cellOffset + cellId) != input->GetCellType(cellId) ||
+        cellArray->GetComponent(cellOffset + cellId, 0) != i ||
+        cellArray->GetComponent(cellOffset + cellId, 1) != cellId)
+      {
+        std::cerr << "Wrong cell " << cellId << " of input " << i << std::endl;
+        return false;
+      }
+    }
+    ptOffset += input->GetNumberOfPoints();
+    cellOffset += input->GetNumberOfCells();
+  }
+  if (output->GetNumberOfPoints() != ptOffset || output->GetNumberOfCells() != cellOffset)
+  {
+    std::cerr << "Wrong number of points or cells" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestAppendPolyData()
+{
+  bool success = true;
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < 5; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(i, 0.0, 0.0);
+    sphere->SetThetaResolution(8 + i);
+    sphere->Update();
+    vtkNew<vtkPolyData> input;
+    input->DeepCopy(sphere->GetOutput());
+    if (i % 2)
+    {
+      // lines, and 32 bit cell arrays
+      vtkNew<vtkCellArray> lines;
+      lines->Use32BitStorage();
+      const vtkIdType line[3] = { 0, 1, 2 };
+      lines->InsertNextCell(3, line);
+      input->SetLines(lines);
+    }
+    ::AddArrays(input, i);
+    append->AddInputData(input);
+  }
+
+  success &= vtkSMPTestUtilities::CompareThreads(append, "vtkAppendPolyData");
+  vtkNew<vtkPolyData> expected;
+  expected->DeepCopy(append->GetOutput());
+  success &= ::CheckAppended(expected, append);
+
+  append->UseCompositeArraysOn();
+  append->Update();
+  vtkPolyData* output = append->GetOutput();
+  if (!vtkSMPTestUtilities::SameDataSets(output, expected))
+  {
+    std::cerr << "The composite arrays of the appended polydata differ." << std::endl;
+    success = false;
+  }
+  if (vtkFloatArray::SafeDownCast(output->GetPoints()->GetData()) ||
+    vtkFloatArray::SafeDownCast(output->GetPointData()->GetArray("PointArray")))
+  {
+    std::cerr << "The points and point data of the polydata are copied." << std::endl;
+    success = false;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool TestAppendFilter()
+{
+  bool success = true;
+  vtkNew<vtkAppendFilter> append;
+  const int cellTypes[3] = { VTK_HEXAHEDRON, VTK_TETRA, VTK_QUADRATIC_WEDGE };
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellTypes[i]);
+    source->SetBlocksDimensions(4, 3, 2);
+    source->Update();
+    vtkNew<vtkUnstructuredGrid> input;
+    input->DeepCopy(source->GetOutput());
+    ::AddArrays(input, i);
+    append->AddInputData(input);
+  }
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(5, 4, 3);
+  image->SetOrigin(10.0, 0.0, 0.0);
+  ::AddArrays(image, 3);
+  append->AddInputData(image);
+
+  success &= vtkSMPTestUtilities::CompareThreads(append, "vtkAppendFilter");
+  vtkNew<vtkUnstructuredGrid> expected;
+  expected->DeepCopy(append->GetOutput());
+  success &= ::CheckAppended(expected, append);
+
+  append->UseCompositeArraysOn();
+  append->Update();
+  vtkUnstructuredGrid* output = append->GetOutput();
+  if (!vtkSMPTestUtilities::SameDataSets(output, expected))
+  {
+    std::cerr << "The composite arrays of the appended grid differ." << std::endl;
+    success = false;
+  }
+  if (vtkFloatArray::SafeDownCast(output->GetPointData()->GetArray("PointArray")) ||
+    vtkFloatArray::SafeDownCast(output->GetCellData()->GetArray("CellArray")))
+  {
+    std::cerr << "The attributes of the grid are copied." << std::endl;
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestAppendCompositeArrays(int, char*[])
+{
+  bool success = ::TestAppendPolyData();
+  success = ::TestAppendFilter() && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -251,9 +251,8 @@ bool UpdateAndTestCleanPolyData(vtkSmartPointer<vtkCleanPolyData> clean, int num
 
   return true;
 }
-}
 
-int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+bool TestDegeneratedCells(bool threaded)
 {
   auto lines = ConstructLines();
   auto polys = ConstructPolys();
@@ -261,6 +260,7 @@ int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 
   // First test degenerate conversions without merging
   vtkSmartPointer<vtkCleanPolyData> clean = vtkSmartPointer<vtkCleanPolyData>::New();
+  clean->SetThreadedMerging(threaded);
   clean->PointMergingOff();
   clean->ConvertLinesToPointsOn();
   clean->ConvertPolysToLinesOn();
@@ -269,19 +269,19 @@ int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
   clean->SetInputData(lines);
   if (!UpdateAndTestCleanPolyData(clean, 4, 1, 5, 0, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(polys);
   if (!UpdateAndTestCleanPolyData(clean, 5, 2, 3, 2, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(strips);
   if (!UpdateAndTestCleanPolyData(clean, 7, 1, 2, 2, 2))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   // Now test degenerate elimination without merging
@@ -292,19 +292,19 @@ int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
   clean->SetInputData(lines);
   if (!UpdateAndTestCleanPolyData(clean, 4, 0, 5, 0, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(polys);
   if (!UpdateAndTestCleanPolyData(clean, 5, 0, 0, 2, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(strips);
   if (!UpdateAndTestCleanPolyData(clean, 7, 0, 0, 0, 2))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   // Now test degenerate conversion with merging
@@ -316,19 +316,19 @@ int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
   clean->SetInputData(lines);
   if (!UpdateAndTestCleanPolyData(clean, 3, 3, 3, 0, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(polys);
   if (!UpdateAndTestCleanPolyData(clean, 3, 3, 3, 1, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(strips);
   if (!UpdateAndTestCleanPolyData(clean, 4, 2, 2, 2, 1))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   // Now test degenerate elimination with merging
@@ -339,20 +339,35 @@ int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
   clean->SetInputData(lines);
   if (!UpdateAndTestCleanPolyData(clean, 3, 0, 3, 0, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(polys);
   if (!UpdateAndTestCleanPolyData(clean, 3, 0, 0, 1, 0))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
   clean->SetInputData(strips);
   if (!UpdateAndTestCleanPolyData(clean, 4, 0, 0, 0, 1))
   {
-    return EXIT_FAILURE;
+    return false;
   }
 
+  return true;
+}
+}
+
+int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  if (!TestDegeneratedCells(false))
+  {
+    return EXIT_FAILURE;
+  }
+  if (!TestDegeneratedCells(true))
+  {
+    std::cerr << "Failure with ThreadedMerging on." << std::endl;
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
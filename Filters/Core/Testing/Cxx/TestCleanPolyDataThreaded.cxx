@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCleanPolyDataThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded implementation of vtkCleanPolyData produces the
+// same output as the serial implementation.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCleanPolyData.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+namespace
+{
+// Explode the triangles of a sphere so that each triangle has its own
+// points, and add a few lines and degenerate triangles. Point data holds the
+// input point id, so that the point each output point originates from can
+// be checked.
+vtkSmartPointer<vtkPolyData> ConstructInput()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkPolyData* sphereOutput = sphere->GetOutput();
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkFloatArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType ids[3];
+  vtkCellArray* inPolys = sphereOutput->GetPolys();
+  for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 0; i < npts && i < 3; ++i)
+    {
+      ids[i] = points->InsertNextPoint(sphereOutput->GetPoint(pts[i]));
+    }
+    polys->InsertNextCell(3, ids);
+    cellScalars->InsertNextValue(static_cast<float>(cellScalars->GetNumberOfTuples()));
+  }
+  // Degenerate triangles (become a line and a vertex) and lines.
+  ids[0] = 0;
+  ids[1] = 1;
+  ids[2] = 1;
+  polys->InsertNextCell(3, ids);
+  ids[1] = 0;
+  polys->InsertNextCell(3, ids);
+  for (vtkIdType i = 0; i < 50; ++i)
+  {
+    ids[0] = 7 * i;
+    ids[1] = 7 * i + 3;
+    lines->InsertNextCell(2, ids);
+  }
+  const vtkIdType numCells = polys->GetNumberOfCells() + lines->GetNumberOfCells();
+  for (vtkIdType i = cellScalars->GetNumberOfTuples(); i < numCells; ++i)
+  {
+    cellScalars->InsertNextValue(static_cast<float>(i));
+  }
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfTuples(points->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    pointIds->SetValue(i, i);
+  }
+
+  vtkSmartPointer<vtkPolyData> polydata = vtkSmartPointer<vtkPolyData>::New();
+  polydata->SetPoints(points);
+  polydata->SetLines(lines);
+  polydata->SetPolys(polys);
+  polydata->GetPointData()->AddArray(pointIds);
+  polydata->GetCellData()->AddArray(cellScalars);
+  return polydata;
+}
+
+bool CompareCells(vtkCellArray* ca0, vtkCellArray* ca1, vtkPoints* pts0, vtkPoints* pts1,
+  bool sameIds, const char* name)
+{
+  if (ca0->GetNumberOfCells() != ca1->GetNumberOfCells())
+  {
+    std::cerr << "Different number of " << name << ": " << ca0->GetNumberOfCells() << " vs "
+              << ca1->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  vtkIdType npts0, npts1;
+  const vtkIdType *ids0, *ids1;
+  for (vtkIdType cellId = 0; cellId < ca0->GetNumberOfCells(); ++cellId)
+  {
+    ca0->GetCellAtId(cellId, npts0, ids0);
+    ca1->GetCellAtId(cellId, npts1, ids1);
+    if (npts0 != npts1)
+    {
+      std::cerr << "Different size of cell " << cellId << " in " << name << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < npts0; ++i)
+    {
+      double x0[3], x1[3];
+      pts0->GetPoint(ids0[i], x0);
+      pts1->GetPoint(ids1[i], x1);
+      if ((sameIds && ids0[i] != ids1[i]) || x0[0] != x1[0] || x0[1] != x1[1] || x0[2] != x1[2])
+      {
+        std::cerr << "Different point " << i << " of cell " << cellId << " in " << name
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareOutputs(vtkPolyData* serial, vtkPolyData* threaded, bool sameIds)
+{
+  if (serial->GetNumberOfPoints() != threaded->GetNumberOfPoints())
+  {
+    std::cerr << "Different number of points: " << serial->GetNumberOfPoints() << " vs "
+              << threaded->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  if (!CompareCells(serial->GetVerts(), threaded->GetVerts(), serial->GetPoints(),
+        threaded->GetPoints(), sameIds, "verts") ||
+    !CompareCells(serial->GetLines(), threaded->GetLines(), serial->GetPoints(),
+      threaded->GetPoints(), sameIds, "lines") ||
+    !CompareCells(serial->GetPolys(), threaded->GetPolys(), serial->GetPoints(),
+      threaded->GetPoints(), sameIds, "polys"))
+  {
+    return false;
+  }
+
+  vtkDataArray* cellScalars0 = serial->GetCellData()->GetArray("CellScalars");
+  vtkDataArray* cellScalars1 = threaded->GetCellData()->GetArray("CellScalars");
+  if (!cellScalars1 || cellScalars0->GetNumberOfTuples() != cellScalars1->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong cell data" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < cellScalars0->GetNumberOfTuples(); ++i)
+  {
+    if (cellScalars0->GetComponent(i, 0) != cellScalars1->GetComponent(i, 0))
+    {
+      std::cerr << "Different cell data for cell " << i << std::endl;
+      return false;
+    }
+  }
+
+  // Point data must come from the same input points.
+  vtkDataArray* pointIds0 = serial->GetPointData()->GetArray("PointIds");
+  vtkDataArray* pointIds1 = threaded->GetPointData()->GetArray("PointIds");
+  if (!pointIds1 || pointIds0->GetNumberOfTuples() != pointIds1->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong point data" << std::endl;
+    return false;
+  }
+  if (sameIds)
+  {
+    for (vtkIdType i = 0; i < pointIds0->GetNumberOfTuples(); ++i)
+    {
+      if (pointIds0->GetComponent(i, 0) != pointIds1->GetComponent(i, 0))
+      {
+        std::cerr << "Different point data for point " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestCleanPolyDataThreaded(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkSmartPointer<vtkPolyData> input = ConstructInput();
+
+  for (int merging = 0; merging < 2; ++merging)
+  {
+    vtkNew<vtkCleanPolyData> serial;
+    serial->SetInputData(input);
+    serial->SetPointMerging(merging);
+    serial->Update();
+
+    vtkNew<vtkCleanPolyData> threaded;
+    threaded->SetInputData(input);
+    threaded->SetPointMerging(merging);
+    threaded->ThreadedMergingOn();
+    threaded->Update();
+
+    if (merging && serial->GetOutput()->GetNumberOfPoints() >= input->GetNumberOfPoints())
+    {
+      std::cerr << "Points were not merged" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!CompareOutputs(serial->GetOutput(), threaded->GetOutput(), true))
+    {
+      std::cerr << "Failure with PointMerging " << merging << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    threaded->PreservePointOrderOff();
+    threaded->Update();
+    if (!CompareOutputs(serial->GetOutput(), threaded->GetOutput(), false))
+    {
+      std::cerr << "Failure with PointMerging " << merging << " and PreservePointOrder off"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,276 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityParallelLabeling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkConnectivityFilter and vtkPolyDataConnectivityFilter extract
+// the same regions and cells with ParallelLabeling on, in all the extraction
+// modes, with and without scalar connectivity.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Random point scalars, and the ids of the input points and cells to match
+// the outputs.
+void AddArrays(vtkDataSet* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkFloatArray> scalars;
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("InputPointIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    scalars->InsertNextValue(random->GetNextRangeValue(0.0, 1.0));
+    pointIds->InsertNextValue(i);
+  }
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("InputCellIds");
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->AddArray(pointIds);
+  input->GetCellData()->AddArray(cellIds);
+}
+
+//------------------------------------------------------------------------------
+// A grid of triangles with random holes, and a few vertices and lines.
+vtkSmartPointer<vtkPolyData> PolyDataInput()
+{
+  const int dim = 40;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2);
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < dim - 1; ++j)
+  {
+    for (int i = 0; i < dim - 1; ++i)
+    {
+      const vtkIdType p = j * dim + i;
+      const double r = random->GetNextValue();
+      if (r < 0.55)
+      {
+        const vtkIdType tri1[3] = { p, p + 1, p + dim + 1 };
+        const vtkIdType tri2[3] = { p, p + dim + 1, p + dim };
+        polys->InsertNextCell(3, tri1);
+        polys->InsertNextCell(3, tri2);
+      }
+      else if (r < 0.6)
+      {
+        const vtkIdType line[2] = { p, p + 1 };
+        lines->InsertNextCell(2, line);
+      }
+      else if (r < 0.65)
+      {
+        verts->InsertNextCell(1, &p);
+      }
+    }
+  }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->SetPolys(polys);
+  ::AddArrays(input);
+  return input;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> ImageInput()
+{
+  vtkSmartPointer<vtkImageData> input = vtkSmartPointer<vtkImageData>::New();
+  input->SetDimensions(14, 13, 12);
+  ::AddArrays(input);
+  return input;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType GetId(vtkDataArray* array, vtkIdType i)
+{
+  return static_cast<vtkIdType>(array->GetComponent(i, 0));
+}
+
+//------------------------------------------------------------------------------
+// Compare the cells, their points and the point region ids of the outputs.
+bool SameOutputs(vtkPointSet* output, vtkPointSet* expected, vtkIdType numInputPts)
+{
+  if (output->GetNumberOfCells() != expected->GetNumberOfCells() ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of cells or points" << std::endl;
+    return false;
+  }
+
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("InputCellIds");
+  vtkDataArray* expectedCellIds = expected->GetCellData()->GetArray("InputCellIds");
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("InputPointIds");
+  vtkDataArray* expectedPointIds = expected->GetPointData()->GetArray("InputPointIds");
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkIdList> expectedCellPts;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, cellPts);
+    expected->GetCellPoints(cellId, expectedCellPts);
+    bool same = ::GetId(cellIds, cellId) == ::GetId(expectedCellIds, cellId) &&
+      cellPts->GetNumberOfIds() == expectedCellPts->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < cellPts->GetNumberOfIds(); ++i)
+    {
+      same = ::GetId(pointIds, cellPts->GetId(i)) ==
+        ::GetId(expectedPointIds, expectedCellPts->GetId(i));
+    }
+    if (!same)
+    {
+      std::cerr << "Wrong cell " << cellId << std::endl;
+      return false;
+    }
+  }
+
+  // the points are not in the same order, compare the region ids of the
+  // input points
+  vtkDataArray* regionIds = output->GetPointData()->GetArray("RegionId");
+  vtkDataArray* expectedRegionIds = expected->GetPointData()->GetArray("RegionId");
+  if (!regionIds != !expectedRegionIds)
+  {
+    std::cerr << "Wrong point region ids" << std::endl;
+    return false;
+  }
+  if (regionIds)
+  {
+    std::vector<vtkIdType> regions(numInputPts, -1);
+    std::vector<vtkIdType> expectedRegions(numInputPts, -1);
+    for (vtkIdType ptId = 0; ptId < expected->GetNumberOfPoints(); ++ptId)
+    {
+      regions[::GetId(pointIds, ptId)] = ::GetId(regionIds, ptId);
+      expectedRegions[::GetId(expectedPointIds, ptId)] = ::GetId(expectedRegionIds, ptId);
+    }
+    if (regions != expectedRegions)
+    {
+      std::cerr << "Wrong point region ids" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename FilterT>
+bool TestModes(FilterT* filter, vtkDataSet* input)
+{
+  filter->SetInputData(input);
+  filter->AddSpecifiedRegion(1);
+  filter->AddSpecifiedRegion(3);
+  filter->SetClosestPoint(5.2, 7.9, 0.0);
+
+  vtkSmartPointer<vtkPointSet> expected;
+  const int modes[6] = { VTK_EXTRACT_ALL_REGIONS, VTK_EXTRACT_LARGEST_REGION,
+    VTK_EXTRACT_SPECIFIED_REGIONS, VTK_EXTRACT_CELL_SEEDED_REGIONS,
+    VTK_EXTRACT_POINT_SEEDED_REGIONS, VTK_EXTRACT_CLOSEST_POINT_REGION };
+  for (int scalarConnectivity = 0; scalarConnectivity < 2; ++scalarConnectivity)
+  {
+    filter->SetScalarConnectivity(scalarConnectivity);
+    filter->SetScalarRange(0.3, 0.6);
+    for (int mode : modes)
+    {
+      filter->SetExtractionMode(mode);
+      filter->InitializeSeedList();
+      filter->AddSeed(mode == VTK_EXTRACT_CELL_SEEDED_REGIONS ? 5 : 17);
+      filter->AddSeed(mode == VTK_EXTRACT_CELL_SEEDED_REGIONS ? 400 : 250);
+      filter->SetColorRegions(1);
+
+      filter->ParallelLabelingOff();
+      filter->Update();
+      const int numRegions = filter->GetNumberOfExtractedRegions();
+      expected.TakeReference(filter->GetOutput()->NewInstance());
+      expected->DeepCopy(filter->GetOutput());
+
+      filter->ParallelLabelingOn();
+      filter->Update();
+      if (filter->GetNumberOfExtractedRegions() != numRegions ||
+        !::SameOutputs(filter->GetOutput(), expected, input->GetNumberOfPoints()))
+      {
+        std::cerr << "Different parallel labeling in mode " << filter->GetExtractionModeAsString()
+                  << " with scalar connectivity " << scalarConnectivity << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestConnectivityParallelLabeling(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+  bool success = true;
+
+  auto polyData = ::PolyDataInput();
+  vtkNew<vtkPolyDataConnectivityFilter> polyDataFilter;
+  success &= ::TestModes(polyDataFilter.Get(), polyData);
+
+  // the region sizes must be the same as well
+  polyDataFilter->SetExtractionModeToAllRegions();
+  polyDataFilter->ParallelLabelingOff();
+  polyDataFilter->Update();
+  vtkNew<vtkIdTypeArray> regionSizes;
+  regionSizes->DeepCopy(polyDataFilter->GetRegionSizes());
+  polyDataFilter->ParallelLabelingOn();
+  polyDataFilter->Update();
+  vtkIdTypeArray* parallelRegionSizes = polyDataFilter->GetRegionSizes();
+  if (parallelRegionSizes->GetNumberOfValues() != regionSizes->GetNumberOfValues() ||
+    !std::equal(regionSizes->Begin(), regionSizes->End(), parallelRegionSizes->Begin()))
+  {
+    std::cerr << "Wrong region sizes" << std::endl;
+    success = false;
+  }
+
+  polyDataFilter->FullScalarConnectivityOn();
+  success &= ::TestModes(polyDataFilter.Get(), polyData);
+
+  vtkNew<vtkConnectivityFilter> filter;
+  success &= ::TestModes(filter.Get(), polyData);
+  success &= ::TestModes(filter.Get(), ::ImageInput());
+
+  vtkSMPTools::Initialize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
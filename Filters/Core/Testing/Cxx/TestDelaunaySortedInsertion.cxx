@@ -0,0 +1,318 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunaySortedInsertion.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Triangulate random points with vtkDelaunay2D and vtkDelaunay3D, with and
+// without SpatiallySortedPointInsertion, and check that the triangulations
+// match. With coincident points, vtkDelaunay3D keeps the first one inserted,
+// which depends on the insertion order: check that it triangulates the points
+// it keeps.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkDelaunay2D.h"
+#include "vtkDelaunay3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTetra.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> RandomPoints(vtkIdType numPoints, int dimension)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    double x[3] = { 0.0, 0.0, 0.0 };
+    for (int j = 0; j < dimension; ++j)
+    {
+      x[j] = random->GetNextRangeValue(-1.0, 1.0);
+    }
+    points->SetPoint(i, x);
+  }
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  return polyData;
+}
+
+//------------------------------------------------------------------------------
+// Cells as sorted lists of point ids, sorted, to compare triangulations
+// whatever the order of their cells.
+std::vector<std::vector<vtkIdType>> SortedCells(vtkCellArray* cells)
+{
+  std::vector<std::vector<vtkIdType>> sortedCells;
+  auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    std::vector<vtkIdType> cell(pts, pts + npts);
+    std::sort(cell.begin(), cell.end());
+    sortedCells.push_back(cell);
+  }
+  std::sort(sortedCells.begin(), sortedCells.end());
+  return sortedCells;
+}
+
+//------------------------------------------------------------------------------
+double TotalVolume(vtkUnstructuredGrid* grid)
+{
+  double volume = 0.0;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    grid->GetCellPoints(cellId, npts, pts);
+    double x[4][3];
+    for (int i = 0; i < 4; ++i)
+    {
+      grid->GetPoint(pts[i], x[i]);
+    }
+    volume += std::abs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]));
+  }
+  return volume;
+}
+
+//------------------------------------------------------------------------------
+bool Test2D()
+{
+  auto input = ::RandomPoints(5000, 2);
+  vtkNew<vtkDelaunay2D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->Update();
+  auto expected = ::SortedCells(delaunay->GetOutput()->GetPolys());
+
+  delaunay->SpatiallySortedPointInsertionOn();
+  delaunay->Update();
+  if (::SortedCells(delaunay->GetOutput()->GetPolys()) != expected)
+  {
+    std::cerr << "The 2D triangulations do not match." << std::endl;
+    return false;
+  }
+
+  // the spatial order takes precedence over the random one
+  delaunay->RandomPointInsertionOn();
+  delaunay->Update();
+  if (::SortedCells(delaunay->GetOutput()->GetPolys()) != expected)
+  {
+    std::cerr << "The 2D triangulations do not match with RandomPointInsertion." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Points of a tilted plane, triangulated in their best fitting plane: the
+// points are sorted in the projection plane.
+bool TestProjected2D()
+{
+  auto input = ::RandomPoints(5000, 2);
+  vtkPoints* points = input->GetPoints();
+  const double c = std::cos(1.0);
+  const double s = std::sin(1.0);
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    points->SetPoint(i, x[0], c * x[1], s * x[1]);
+  }
+  vtkNew<vtkDelaunay2D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->SetProjectionPlaneMode(VTK_BEST_FITTING_PLANE);
+  delaunay->Update();
+  auto expected = ::SortedCells(delaunay->GetOutput()->GetPolys());
+
+  delaunay->SpatiallySortedPointInsertionOn();
+  delaunay->Update();
+  if (::SortedCells(delaunay->GetOutput()->GetPolys()) != expected)
+  {
+    std::cerr << "The projected 2D triangulations do not match." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool Test3D()
+{
+  auto input = ::RandomPoints(2000, 3);
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->Update();
+  vtkNew<vtkUnstructuredGrid> expected;
+  expected->ShallowCopy(delaunay->GetOutput());
+
+  delaunay->SpatiallySortedPointInsertionOn();
+  delaunay->Update();
+  vtkUnstructuredGrid* output = delaunay->GetOutput();
+  if (output->GetNumberOfCells() != expected->GetNumberOfCells() ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << "The 3D triangulations have " << output->GetNumberOfCells() << " and "
+              << expected->GetNumberOfCells() << " tetrahedra." << std::endl;
+    return false;
+  }
+  double volume = ::TotalVolume(output);
+  double expectedVolume = ::TotalVolume(expected);
+  if (std::abs(volume - expectedVolume) > 1e-8 * expectedVolume)
+  {
+    std::cerr << "The 3D triangulations have volumes " << volume << " and " << expectedVolume
+              << std::endl;
+    return false;
+  }
+  if (::SortedCells(output->GetCells()) != ::SortedCells(expected->GetCells()))
+  {
+    std::cerr << "The 3D triangulations do not match." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The points used by the cells of a grid.
+std::vector<vtkIdType> UsedPoints(vtkUnstructuredGrid* grid)
+{
+  std::vector<char> used(grid->GetNumberOfPoints(), 0);
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    grid->GetCellPoints(cellId, npts, pts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      used[pts[i]] = 1;
+    }
+  }
+  std::vector<vtkIdType> usedPoints;
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    if (used[ptId])
+    {
+      usedPoints.push_back(ptId);
+    }
+  }
+  return usedPoints;
+}
+
+//------------------------------------------------------------------------------
+// Random points followed by a copy of every fourth one, moved by much less
+// than the tolerance of the locator. Each triangulation uses the point of
+// each pair which is inserted first, and is the triangulation of these
+// points.
+bool Test3DCoincident()
+{
+  const vtkIdType numPoints = 2000;
+  auto input = ::RandomPoints(numPoints, 3);
+  vtkPoints* points = input->GetPoints();
+  for (vtkIdType i = 0; i < numPoints; i += 4)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    points->InsertNextPoint(x[0] + 1e-4, x[1] - 1e-4, x[2] + 1e-4);
+  }
+
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  for (int sorted = 0; sorted < 2; ++sorted)
+  {
+    delaunay->SetSpatiallySortedPointInsertion(sorted);
+    delaunay->Update();
+    vtkUnstructuredGrid* output = delaunay->GetOutput();
+
+    // a single point of each pair is used: the given order uses the
+    // original points, the sorted order uses some of the copies instead
+    auto usedPoints = ::UsedPoints(output);
+    auto numberOfCopies = std::count_if(
+      usedPoints.begin(), usedPoints.end(), [](vtkIdType id) { return id >= numPoints; });
+    std::vector<char> usedGroups(numPoints, 0);
+    for (vtkIdType ptId : usedPoints)
+    {
+      usedGroups[ptId < numPoints ? ptId : 4 * (ptId - numPoints)] = 1;
+    }
+    if (usedPoints.size() != static_cast<size_t>(numPoints) ||
+      std::count(usedGroups.begin(), usedGroups.end(), 1) != numPoints ||
+      (numberOfCopies == 0) == (sorted != 0))
+    {
+      std::cerr << "Wrong points used by the 3D triangulation of coincident points: "
+                << usedPoints.size() << " points of which " << numberOfCopies << " copies."
+                << std::endl;
+      return false;
+    }
+
+    // the used points on their own are triangulated the same way
+    vtkNew<vtkPoints> subsetPoints;
+    subsetPoints->SetDataTypeToDouble();
+    for (vtkIdType ptId : usedPoints)
+    {
+      subsetPoints->InsertNextPoint(points->GetPoint(ptId));
+    }
+    vtkNew<vtkPolyData> subset;
+    subset->SetPoints(subsetPoints);
+    vtkNew<vtkDelaunay3D> subsetDelaunay;
+    subsetDelaunay->SetInputData(subset);
+    subsetDelaunay->Update();
+    vtkNew<vtkCellArray> expected;
+    auto iter = vtk::TakeSmartPointer(subsetDelaunay->GetOutput()->GetCells()->NewIterator());
+    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      iter->GetCurrentCell(npts, pts);
+      expected->InsertNextCell(static_cast<int>(npts));
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        expected->InsertCellPoint(usedPoints[pts[i]]);
+      }
+    }
+    if (::SortedCells(output->GetCells()) != ::SortedCells(expected))
+    {
+      std::cerr << "The 3D triangulation of coincident points does not match the one of the "
+                << "used points." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestDelaunaySortedInsertion(int, char*[])
+{
+  bool success = true;
+  // the insertion order must not depend on the number of threads
+  const int numbersOfThreads[2] = { 1, 4 };
+  for (int numberOfThreads : numbersOfThreads)
+  {
+    vtkSMPTools::Initialize(numberOfThreads);
+    success &= ::Test2D();
+    success &= ::TestProjected2D();
+    success &= ::Test3D();
+    success &= ::Test3DCoincident();
+  }
+  vtkSMPTools::Initialize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFeatureEdgesThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkFeatureEdges extracts the same edges whatever the number of
+// threads, with and without merging the points, and the expected edges on the
+// boundary of a plane and on a mesh with a non-manifold fin.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFeatureEdges.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A bumpy grid of triangles and quads with holes, strips and lines, and a
+// fin of triangles sharing an edge of the grid.
+vtkSmartPointer<vtkPolyData> MakeInput(int dim, int finSize)
+{
+  vtkSmartPointer<vtkPolyData> input = vtkSMPTestUtilities::MakeRandomGrid(dim, 0.5, 1,
+    [dim](vtkIdType p, double r, vtkCellArray*, vtkCellArray* lines, vtkCellArray* polys,
+      vtkCellArray* strips) {
+      if (r < 0.4)
+      {
+        const vtkIdType tri1[3] = { p, p + 1, p + dim + 1 };
+        const vtkIdType tri2[3] = { p, p + dim + 1, p + dim };
+        polys->InsertNextCell(3, tri1);
+        polys->InsertNextCell(3, tri2);
+      }
+      else if (r < 0.75)
+      {
+        const vtkIdType quad[4] = { p, p + 1, p + dim + 1, p + dim };
+        polys->InsertNextCell(4, quad);
+      }
+      else if (r < 0.85)
+      {
+        const vtkIdType strip[4] = { p, p + dim, p + 1, p + dim + 1 };
+        strips->InsertNextCell(4, strip);
+      }
+      else if (r < 0.9)
+      {
+        const vtkIdType line[3] = { p, p + 1, p + dim + 1 };
+        lines->InsertNextCell(3, line);
+      }
+    });
+  for (int k = 0; k < finSize; ++k)
+  {
+    const vtkIdType tri[3] = { 0, 1, input->GetPoints()->InsertNextPoint(0.5, -1.0, 1.0 + k) };
+    input->GetPolys()->InsertNextCell(3, tri);
+  }
+  vtkSMPTestUtilities::AddCellIds(input, "CellIds");
+  return input;
+}
+
+//------------------------------------------------------------------------------
+// The lines must go through the same coordinates, with the same cell data.
+bool SameLines(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfLines() != expected->GetNumberOfLines() ||
+    !vtkSMPTestUtilities::SameArrays(output->GetCellData()->GetArray("CellIds"),
+      expected->GetCellData()->GetArray("CellIds"), "CellIds") ||
+    !vtkSMPTestUtilities::SameArrays(output->GetCellData()->GetArray("Edge Types"),
+      expected->GetCellData()->GetArray("Edge Types"), "Edge Types"))
+  {
+    return false;
+  }
+  vtkIdType npts, expectedNpts;
+  const vtkIdType* pts;
+  const vtkIdType* expectedPts;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfLines(); ++cellId)
+  {
+    output->GetLines()->GetCellAtId(cellId, npts, pts);
+    expected->GetLines()->GetCellAtId(cellId, expectedNpts, expectedPts);
+    for (vtkIdType i = 0; i < 2; ++i)
+    {
+      double x[3], expectedX[3];
+      output->GetPoint(pts[i], x);
+      expected->GetPoint(expectedPts[i], expectedX);
+      if (npts != 2 || expectedNpts != 2 || x[0] != expectedX[0] || x[1] != expectedX[1] ||
+        x[2] != expectedX[2])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestFeatureEdgesThreads(int, char*[])
+{
+  bool success = true;
+  vtkNew<vtkFeatureEdges> edges;
+  vtkNew<vtkPolyData> expected;
+
+  edges->SetInputData(::MakeInput(80, 3));
+  edges->ExtractAllEdgeTypesOn();
+  for (int featureEdges = 0; featureEdges < 2; ++featureEdges)
+  {
+    edges->SetFeatureEdges(featureEdges);
+    edges->MergePointsOn();
+    success &= vtkSMPTestUtilities::CompareThreads(edges, "vtkFeatureEdges");
+    expected->DeepCopy(edges->GetOutput());
+
+    edges->MergePointsOff();
+    edges->Update();
+    if (!::SameLines(edges->GetOutput(), expected))
+    {
+      std::cerr << "Wrong edges without merging the points." << std::endl;
+      success = false;
+    }
+  }
+
+  // The boundary of a 10x10 plane is made of 40 edges and points.
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(10, 10);
+  edges->SetInputConnection(plane->GetOutputPort());
+  edges->ExtractAllEdgeTypesOff();
+  edges->BoundaryEdgesOn();
+  edges->Update();
+  if (edges->GetOutput()->GetNumberOfLines() != 40 || edges->GetOutput()->GetNumberOfPoints() != 40)
+  {
+    std::cerr << "Expected 40 boundary edges, got " << edges->GetOutput()->GetNumberOfLines()
+              << std::endl;
+    success = false;
+  }
+
+  // The fin makes the first edge of the grid non-manifold, extracted once.
+  edges->SetInputData(::MakeInput(2, 3));
+  edges->BoundaryEdgesOff();
+  edges->NonManifoldEdgesOn();
+  edges->Update();
+  if (edges->GetOutput()->GetNumberOfLines() != 1)
+  {
+    std::cerr << "Expected 1 non-manifold edge, got " << edges->GetOutput()->GetNumberOfLines()
+              << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
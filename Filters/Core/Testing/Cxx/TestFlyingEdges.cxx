@@ -15,21 +15,170 @@
 
 // Description
 // This test creates a wavelet dataset and creates isosurfaces using
-// vtkFlyingEdges3D
+// vtkFlyingEdges3D. It first checks that the contiguous rows of scalars,
+// whose x-edges are classified by a vectorized kernel, give the same
+// contours as the strided rows of a component of a two component array.
 
 #include "vtkActor.h"
+#include "vtkDataArray.h"
+#include "vtkFlyingEdges2D.h"
 #include "vtkFlyingEdges3D.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkPolyDataMapper.h"
 #include "vtkRTAnalyticSource.h"
 #include "vtkRegressionTestImage.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderWindowInteractor.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
 #include "vtkTesting.h"
 
+#include <cmath>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// An image of the given scalar type, with a smooth field of integral values
+// between 10 and 90, in a one component array or in the first component of a
+// two component array. Floating point scalars also get NaN and infinite
+// values.
+vtkSmartPointer<vtkImageData> MakeImage(int dataType, int nz, bool strided)
+{
+  const int dims[3] = { 24, 20, nz };
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  vtkSmartPointer<vtkDataArray> scalars =
+    vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(dataType));
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfComponents(strided ? 2 : 1);
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkIdType ptId = 0;
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i, ++ptId)
+      {
+        double value =
+          std::round(50.0 + 40.0 * std::sin(0.3 * i) * std::cos(0.25 * j) * std::cos(0.2 * k));
+        if (dataType == VTK_FLOAT && ptId % 97 == 0)
+        {
+          value = vtkMath::Nan();
+        }
+        else if (dataType == VTK_FLOAT && ptId % 89 == 0)
+        {
+          value = vtkMath::Inf();
+        }
+        else if (dataType == VTK_FLOAT && ptId % 83 == 0)
+        {
+          value = vtkMath::NegInf();
+        }
+        scalars->SetComponent(ptId, 0, value);
+        if (strided)
+        {
+          scalars->SetComponent(ptId, 1, 100.0 - value);
+        }
+      }
+    }
+  }
+  image->GetPointData()->SetScalars(scalars);
+  return image;
+}
+
+//------------------------------------------------------------------------------
+// The points of the contours of the scalars interpolated between NaN or
+// infinite values are NaN, which are equal here.
+bool SamePoints(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of points" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < expected->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    expected->GetPoint(ptId, y);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (x[i] != y[i] && !(std::isnan(x[i]) && std::isnan(y[i])))
+      {
+        std::cerr << "Wrong point " << ptId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Contour the contiguous and the strided scalars, for isovalues that are not
+// integral, outside of the range of the scalar type, NaN and infinite.
+template <class TFilter>
+bool TestClassification(int dataType, int nz)
+{
+  vtkSmartPointer<vtkImageData> contiguous = MakeImage(dataType, nz, false);
+  vtkSmartPointer<vtkImageData> strided = MakeImage(dataType, nz, true);
+  vtkDataArray* scalars = contiguous->GetPointData()->GetScalars();
+  std::vector<double> values = { 50.5, 33.3, 50.0, -0.25, scalars->GetDataTypeMax() + 0.5,
+    scalars->GetDataTypeMin() - 0.5, 1e10, -1e10 };
+  if (dataType == VTK_FLOAT)
+  {
+    values.insert(values.end(), { vtkMath::Nan(), vtkMath::Inf(), vtkMath::NegInf(), 1e39 });
+  }
+
+  vtkNew<TFilter> contour;
+  contour->ComputeScalarsOn();
+  contour->SetArrayComponent(0);
+  vtkNew<vtkPolyData> expected;
+  for (double value : values)
+  {
+    contour->SetValue(0, value);
+    contour->SetInputData(strided);
+    contour->Update();
+    expected->DeepCopy(contour->GetOutput());
+    contour->SetInputData(contiguous);
+    contour->Update();
+    vtkPolyData* output = contour->GetOutput();
+    if (!SamePoints(output, expected) ||
+      !vtkSMPTestUtilities::SameCells(output->GetLines(), expected->GetLines(), "Lines") ||
+      !vtkSMPTestUtilities::SameCells(output->GetPolys(), expected->GetPolys(), "Polys"))
+    {
+      std::cerr << "Different contours of contiguous and strided " << scalars->GetDataTypeAsString()
+                << " scalars at " << value << " with " << contour->GetClassName() << std::endl;
+      return false;
+    }
+    if (value == 50.5 && output->GetNumberOfCells() == 0)
+    {
+      std::cerr << contour->GetClassName() << " produced no cells." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
 int TestFlyingEdges(int argc, char* argv[])
 {
+  const int dataTypes[] = { VTK_CHAR, VTK_SIGNED_CHAR, VTK_UNSIGNED_CHAR, VTK_SHORT,
+    VTK_UNSIGNED_SHORT, VTK_INT, VTK_UNSIGNED_INT, VTK_FLOAT };
+  for (int dataType : dataTypes)
+  {
+    if (!::TestClassification<vtkFlyingEdges2D>(dataType, 1) ||
+      !::TestClassification<vtkFlyingEdges3D>(dataType, 16))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
   // Create the sample dataset
   vtkNew<vtkRTAnalyticSource> wavelet;
   wavelet->SetWholeExtent(-63, 64, -63, 64, -63, 64);
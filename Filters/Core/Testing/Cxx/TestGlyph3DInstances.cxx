@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DInstances.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Glyph random points with vtkGlyph3D, check that the output does not depend
+// on the number of threads, that the string arrays are passed to the glyphs,
+// and that the instances output with OutputInstances describe the same
+// glyphs.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> RandomInput(vtkIdType numPoints)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    double x[3], v[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetNextRangeValue(-10.0, 10.0);
+      v[j] = random->GetNextRangeValue(-1.0, 1.0);
+    }
+    points->InsertNextPoint(x);
+    vectors->InsertNextTuple(v);
+    scalars->InsertNextValue(random->GetNextRangeValue(0.5, 2.0));
+    labels->InsertNextValue("point " + std::to_string(i));
+  }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->AddArray(labels);
+  return input;
+}
+
+//------------------------------------------------------------------------------
+// Check that the glyph points and cells have the label of their input point.
+bool CheckLabels(vtkPolyData* glyphs, vtkPolyData* input)
+{
+  vtkStringArray* inLabels =
+    vtkArrayDownCast<vtkStringArray>(input->GetPointData()->GetAbstractArray("Labels"));
+  vtkStringArray* labels =
+    vtkArrayDownCast<vtkStringArray>(glyphs->GetPointData()->GetAbstractArray("Labels"));
+  vtkStringArray* cellLabels =
+    vtkArrayDownCast<vtkStringArray>(glyphs->GetCellData()->GetAbstractArray("Labels"));
+  vtkDataArray* ids = glyphs->GetPointData()->GetArray("InputPointIds");
+  if (!labels || !cellLabels || labels->GetNumberOfValues() != glyphs->GetNumberOfPoints() ||
+    cellLabels->GetNumberOfValues() != glyphs->GetNumberOfCells())
+  {
+    std::cerr << "Wrong Labels arrays" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < glyphs->GetNumberOfPoints(); ++ptId)
+  {
+    const vtkIdType inPtId = static_cast<vtkIdType>(ids->GetTuple1(ptId));
+    if (labels->GetValue(ptId) != inLabels->GetValue(inPtId))
+    {
+      std::cerr << "Wrong label for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < glyphs->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    glyphs->GetCellPoints(cellId, npts, pts);
+    const vtkIdType inPtId = static_cast<vtkIdType>(ids->GetTuple1(pts[0]));
+    if (cellLabels->GetValue(cellId) != inLabels->GetValue(inPtId))
+    {
+      std::cerr << "Wrong label for cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Check that the instances transform the source into the glyphs.
+bool CheckInstances(vtkPolyData* instances, vtkPolyData* glyphs)
+{
+  vtkDataArray* matrices = instances->GetFieldData()->GetArray("GlyphMatrix");
+  vtkDataArray* ids = instances->GetFieldData()->GetArray("InputPointIds");
+  vtkDataArray* glyphIds = glyphs->GetPointData()->GetArray("InputPointIds");
+  const vtkIdType numSourcePts = instances->GetNumberOfPoints();
+  if (!matrices || !ids || matrices->GetNumberOfComponents() != 16 ||
+    matrices->GetNumberOfTuples() * numSourcePts != glyphs->GetNumberOfPoints() ||
+    instances->GetNumberOfCells() * matrices->GetNumberOfTuples() != glyphs->GetNumberOfCells())
+  {
+    std::cerr << "Wrong instances" << std::endl;
+    return false;
+  }
+
+  for (vtkIdType instance = 0; instance < matrices->GetNumberOfTuples(); ++instance)
+  {
+    vtkNew<vtkTransform> transform;
+    transform->SetMatrix(matrices->GetTuple(instance));
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+    {
+      // the matrices include the source transform
+      double x[3], glyphX[3];
+      transform->TransformPoint(instances->GetPoint(i), x);
+      const vtkIdType glyphPtId = instance * numSourcePts + i;
+      glyphs->GetPoint(glyphPtId, glyphX);
+      if (std::sqrt(vtkMath::Distance2BetweenPoints(x, glyphX)) > 1e-4 ||
+        ids->GetTuple1(instance) != glyphIds->GetTuple1(glyphPtId))
+      {
+        std::cerr << "Instance " << instance << " does not match its glyph." << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestGlyph3DInstances(int, char*[])
+{
+  auto input = ::RandomInput(2000);
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.1);
+  sphere->Update();
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceData(sphere->GetOutput());
+  glyph->SetColorModeToColorByScalar();
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+
+  bool success = true;
+  vtkNew<vtkPolyData> expected;
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateX(30.0);
+  sourceTransform->Scale(1.0, 2.0, 3.0);
+  for (vtkTransform* transform : { static_cast<vtkTransform*>(nullptr), sourceTransform.Get() })
+  {
+    glyph->SetSourceTransform(transform);
+    glyph->OutputInstancesOff();
+
+    success &= vtkSMPTestUtilities::CompareThreads(glyph, "vtkGlyph3D");
+    expected->DeepCopy(glyph->GetOutput());
+    if (expected->GetNumberOfPoints() != input->GetNumberOfPoints() * 50 ||
+      expected->GetNumberOfPolys() != input->GetNumberOfPoints() * 96)
+    {
+      std::cerr << "Wrong number of glyph points or cells" << std::endl;
+      success = false;
+    }
+    success &= ::CheckLabels(expected, input);
+
+    glyph->OutputInstancesOn();
+    glyph->Update();
+    success &= ::CheckInstances(glyph->GetOutput(), expected);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
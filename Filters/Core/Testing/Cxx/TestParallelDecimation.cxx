@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParallelDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the parallel decimation of vtkDecimatePro and vtkQuadricDecimation:
+// the target reduction must be reached, the output must not depend on the
+// number of threads for a fixed number of partitions, a closed surface
+// must remain closed, and coincident (but distinct) points must not be merged.
+
+#include <vtkAppendPolyData.h>
+#include <vtkDecimatePro.h>
+#include <vtkFeatureEdges.h>
+#include <vtkNew.h>
+#include <vtkPlaneSource.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataConnectivityFilter.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkTriangleFilter.h>
+
+namespace
+{
+const double TARGET_REDUCTION = 0.8;
+const int NUMBER_OF_PARTITIONS = 4;
+
+bool SameOutput(vtkPolyData* output0, vtkPolyData* output1)
+{
+  if (output0->GetNumberOfPoints() != output1->GetNumberOfPoints() ||
+    output0->GetNumberOfPolys() != output1->GetNumberOfPolys())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < output0->GetNumberOfPoints(); ++i)
+  {
+    double x0[3], x1[3];
+    output0->GetPoint(i, x0);
+    output1->GetPoint(i, x1);
+    if (x0[0] != x1[0] || x0[1] != x1[1] || x0[2] != x1[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkIdType NumberOfOpenEdges(vtkPolyData* polyData)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(polyData);
+  edges->BoundaryEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->NonManifoldEdgesOn();
+  edges->ManifoldEdgesOff();
+  edges->Update();
+  return edges->GetOutput()->GetNumberOfLines();
+}
+
+int NumberOfRegions(vtkPolyData* polyData)
+{
+  vtkNew<vtkPolyDataConnectivityFilter> connectivity;
+  connectivity->SetInputData(polyData);
+  connectivity->SetExtractionModeToAllRegions();
+  connectivity->Update();
+  return connectivity->GetNumberOfExtractedRegions();
+}
+
+template <typename DecimatorT>
+vtkSmartPointer<vtkPolyData> Decimate(vtkPolyData* input)
+{
+  vtkNew<DecimatorT> decimator;
+  decimator->SetInputData(input);
+  decimator->SetTargetReduction(TARGET_REDUCTION);
+  decimator->ParallelDecimationOn();
+  decimator->SetNumberOfPartitions(NUMBER_OF_PARTITIONS);
+  decimator->Update();
+  return decimator->GetOutput();
+}
+
+template <typename DecimatorT>
+bool TestDecimator(vtkPolyData* input, const char* name, bool checkClosed)
+{
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  vtkSmartPointer<vtkPolyData> outputs[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    // Use a single thread, then the default number of threads.
+    vtkSMPTools::Initialize(i == 0 ? 1 : 0);
+    outputs[i] = Decimate<DecimatorT>(input);
+  }
+
+  const vtkIdType numOutTris = outputs[0]->GetNumberOfPolys();
+  if (numOutTris > (1.0 - TARGET_REDUCTION) * numTris + 1 || numOutTris == 0)
+  {
+    std::cerr << name << ": wrong number of triangles, " << numOutTris << " from " << numTris
+              << std::endl;
+    return false;
+  }
+  if (!SameOutput(outputs[0], outputs[1]))
+  {
+    std::cerr << name << ": output depends on the number of threads" << std::endl;
+    return false;
+  }
+  if (checkClosed && NumberOfOpenEdges(outputs[0]) != 0)
+  {
+    std::cerr << name << ": output is not a closed surface" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Two adjacent planes that do not share their points along their common
+// edge: the decimation must not weld them together.
+template <typename DecimatorT>
+bool TestSeam(const char* name)
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkNew<vtkPlaneSource> plane;
+    plane->SetOrigin(i, 0.0, 0.0);
+    plane->SetPoint1(i + 1.0, 0.0, 0.0);
+    plane->SetPoint2(i, 1.0, 0.0);
+    plane->SetResolution(100, 100);
+    vtkNew<vtkTriangleFilter> triangles;
+    triangles->SetInputConnection(plane->GetOutputPort());
+    append->AddInputConnection(triangles->GetOutputPort());
+  }
+  append->Update();
+
+  vtkSmartPointer<vtkPolyData> output = Decimate<DecimatorT>(append->GetOutput());
+  const int numRegions = NumberOfRegions(output);
+  if (numRegions != 2)
+  {
+    std::cerr << name << ": expected 2 disconnected regions, got " << numRegions << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestParallelDecimation(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  bool success = TestDecimator<vtkQuadricDecimation>(input, "vtkQuadricDecimation", true);
+  success &= TestDecimator<vtkDecimatePro>(input, "vtkDecimatePro", false);
+  success &= TestSeam<vtkQuadricDecimation>("vtkQuadricDecimation");
+  success &= TestSeam<vtkDecimatePro>("vtkDecimatePro");
+  vtkSMPTools::Initialize(0);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStripperPartitioned.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the partitioned stripping of vtkStripper covers the same
+// triangles and line segments as the serial stripping, with the same
+// original cell ids, whatever the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkStripper.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A grid of triangles with a few quads, holes and lines.
+vtkSmartPointer<vtkPolyData> MakeInput(int dim)
+{
+  return vtkSMPTestUtilities::MakeRandomGrid(dim, 1.0, 1,
+    [dim](vtkIdType p, double r, vtkCellArray*, vtkCellArray* lines, vtkCellArray* polys,
+      vtkCellArray*) {
+      if (r < 0.7)
+      {
+        const vtkIdType tri1[3] = { p, p + 1, p + dim + 1 };
+        const vtkIdType tri2[3] = { p, p + dim + 1, p + dim };
+        polys->InsertNextCell(3, tri1);
+        polys->InsertNextCell(3, tri2);
+      }
+      else if (r < 0.8)
+      {
+        const vtkIdType quad[4] = { p, p + 1, p + dim + 1, p + dim };
+        polys->InsertNextCell(4, quad);
+      }
+      else if (r < 0.9)
+      {
+        const vtkIdType line1[2] = { p, p + 1 };
+        const vtkIdType line2[2] = { p + 1, p + dim + 1 };
+        lines->InsertNextCell(2, line1);
+        lines->InsertNextCell(2, line2);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+// The triangles of the strips and the segments of the poly-lines with the
+// original cell id of the triangles, as sorted point ids, in sorted order.
+std::vector<std::array<vtkIdType, 4>> GetSimplices(vtkPolyData* output)
+{
+  std::vector<std::array<vtkIdType, 4>> simplices;
+  vtkDataArray* cellIds = output->GetFieldData()->GetArray("vtkOriginalCellIds");
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* strips = output->GetStrips();
+  vtkIdType triangleId = output->GetNumberOfLines() + output->GetNumberOfPolys();
+  for (strips->InitTraversal(); strips->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 2; i < npts; ++i, ++triangleId)
+    {
+      std::array<vtkIdType, 4> triangle = { { pts[i - 2], pts[i - 1], pts[i],
+        static_cast<vtkIdType>(cellIds->GetComponent(triangleId, 0)) } };
+      std::sort(triangle.begin(), triangle.begin() + 3);
+      simplices.push_back(triangle);
+    }
+  }
+  vtkCellArray* lines = output->GetLines();
+  for (lines->InitTraversal(); lines->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 1; i < npts; ++i)
+    {
+      simplices.push_back({ { -1, std::min(pts[i - 1], pts[i]), std::max(pts[i - 1], pts[i]),
+        -1 } });
+    }
+  }
+  std::sort(simplices.begin(), simplices.end());
+  return simplices;
+}
+}
+
+int TestStripperPartitioned(int, char*[])
+{
+  bool success = true;
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputData(::MakeInput(80));
+  stripper->PassThroughCellIdsOn();
+  stripper->Update();
+  const vtkIdType numStrips = stripper->GetOutput()->GetNumberOfStrips();
+  const vtkIdType numPolys = stripper->GetOutput()->GetNumberOfPolys();
+  const auto simplices = ::GetSimplices(stripper->GetOutput());
+
+  stripper->PartitionedStrippingOn();
+  stripper->SetPartitionSize(500);
+  success &= vtkSMPTestUtilities::CompareThreads(stripper, "vtkStripper");
+  vtkPolyData* output = stripper->GetOutput();
+  if (output->GetNumberOfStrips() <= numStrips || output->GetNumberOfPolys() != numPolys ||
+    ::GetSimplices(output) != simplices)
+  {
+    std::cerr << "The partitioned strips do not cover the input cells." << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
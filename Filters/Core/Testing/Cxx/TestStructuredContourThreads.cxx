@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStructuredContourThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkMarchingCubes, vtkGridSynchronizedTemplates3D and
+// vtkRectilinearSynchronizedTemplates produce the same contours whatever the
+// number of threads, including isovalues equal to some of the scalars, that the
+// contour points have the isovalues as scalars and that the point data is
+// interpolated along the edges.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGridSynchronizedTemplates3D.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkMarchingCubes.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkStructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Contour with one and four threads, the scalars of the contour points must be
+// the isovalues.
+bool TestThreads(vtkPolyDataAlgorithm* contour, const char* name, const double values[3])
+{
+  bool success = vtkSMPTestUtilities::CompareThreads(contour, name);
+  vtkPolyData* output = contour->GetOutput();
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  if (output->GetNumberOfPolys() == 0 || !scalars)
+  {
+    std::cerr << name << " produced no cells." << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    const double value = scalars->GetComponent(ptId, 0);
+    if (value != values[0] && value != values[1] && value != values[2])
+    {
+      std::cerr << name << " generated a point of value " << value << std::endl;
+      return false;
+    }
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+// The second component of the array interpolated along the edges of the
+// structured grid is the z coordinate of the point.
+bool InterpolatedZ(vtkPolyData* output)
+{
+  vtkDataArray* pointArray = output->GetPointData()->GetArray("PointArray");
+  for (vtkIdType ptId = 0; pointArray && ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    if (std::abs(pointArray->GetComponent(ptId, 1) - x[2]) > 1e-4)
+    {
+      std::cerr << "Wrong interpolated array at point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return pointArray != nullptr;
+}
+}
+
+int TestStructuredContourThreads(int, char*[])
+{
+  bool success = true;
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-20, 20, -16, 18, -24, 25);
+  // integer scalars, so that many of them are equal to the isovalues
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(source->GetOutputPort());
+  cast->SetOutputScalarTypeToShort();
+  cast->Update();
+  vtkImageData* image = cast->GetOutput();
+  const double values[3] = { 100.0, 150.0, 200.0 };
+
+  vtkNew<vtkMarchingCubes> marchingCubes;
+  marchingCubes->SetInputData(image);
+  marchingCubes->SetNumberOfContours(3);
+  for (int i = 0; i < 3; ++i)
+  {
+    marchingCubes->SetValue(i, values[i]);
+  }
+  marchingCubes->ComputeGradientsOn();
+  success = ::TestThreads(marchingCubes, "vtkMarchingCubes", values) && success;
+
+  // A structured grid and a rectilinear grid with the same scalars, and an
+  // array to interpolate.
+  int extent[6];
+  image->GetExtent(extent);
+  vtkNew<vtkFloatArray> pointArray;
+  pointArray->SetName("PointArray");
+  pointArray->SetNumberOfComponents(2);
+  vtkNew<vtkPoints> points;
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    image->GetPoint(ptId, x);
+    pointArray->InsertNextTuple2(ptId, x[2]);
+    x[0] += 0.1 * std::sin(x[1]);
+    points->InsertNextPoint(x);
+  }
+  vtkNew<vtkStructuredGrid> grid;
+  grid->SetExtent(extent);
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(image->GetPointData()->GetScalars());
+  grid->GetPointData()->AddArray(pointArray);
+
+  vtkNew<vtkRectilinearGrid> rectilinearGrid;
+  rectilinearGrid->SetExtent(extent);
+  vtkNew<vtkDoubleArray> coordinates[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (int i = extent[2 * axis]; i <= extent[2 * axis + 1]; ++i)
+    {
+      coordinates[axis]->InsertNextValue(i + 0.01 * i * i);
+    }
+  }
+  rectilinearGrid->SetXCoordinates(coordinates[0]);
+  rectilinearGrid->SetYCoordinates(coordinates[1]);
+  rectilinearGrid->SetZCoordinates(coordinates[2]);
+  rectilinearGrid->GetPointData()->SetScalars(image->GetPointData()->GetScalars());
+  rectilinearGrid->GetPointData()->AddArray(pointArray);
+
+  vtkNew<vtkGridSynchronizedTemplates3D> gridContour;
+  gridContour->SetInputData(grid);
+  vtkNew<vtkRectilinearSynchronizedTemplates> rectilinearContour;
+  rectilinearContour->SetInputData(rectilinearGrid);
+  for (int i = 0; i < 3; ++i)
+  {
+    gridContour->SetValue(i, values[i]);
+    rectilinearContour->SetValue(i, values[i]);
+  }
+  success = ::TestThreads(gridContour, "vtkGridSynchronizedTemplates3D", values) && success;
+  success = ::InterpolatedZ(gridContour->GetOutput()) && success;
+  success =
+    ::TestThreads(rectilinearContour, "vtkRectilinearSynchronizedTemplates", values) && success;
+
+  // polygons instead of triangles
+  gridContour->GenerateTrianglesOff();
+  gridContour->ComputeGradientsOn();
+  rectilinearContour->GenerateTrianglesOff();
+  rectilinearContour->ComputeGradientsOn();
+  success =
+    ::TestThreads(gridContour, "vtkGridSynchronizedTemplates3D (polygons)", values) && success;
+  success = ::TestThreads(
+              rectilinearContour, "vtkRectilinearSynchronizedTemplates (polygons)", values) &&
+    success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTriangleFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkTriangleFilter produces the same cells and cell data whatever
+// the number of threads, the expected number of simplices of each kind, and
+// that each simplex uses the points of the cell it subdivides.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkTriangleFilter.h"
+
+#include <cstdlib>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A planar grid of poly-vertices, poly-lines, triangles, quads, concave and
+// degenerate polygons, and triangle strips.
+vtkSmartPointer<vtkPolyData> MakeInput(int dim, vtkIdType& numTriangles)
+{
+  numTriangles = 0;
+  vtkSmartPointer<vtkPolyData> input = vtkSMPTestUtilities::MakeRandomGrid(dim, 0.0, 2,
+    [dim, &numTriangles](vtkIdType p, double r, vtkCellArray* verts, vtkCellArray* lines,
+      vtkCellArray* polys, vtkCellArray* strips) {
+      if (r < 0.1)
+      {
+        const vtkIdType polyVertex[3] = { p, p + 1, p + 2 };
+        verts->InsertNextCell(3, polyVertex);
+      }
+      else if (r < 0.2)
+      {
+        const vtkIdType polyLine[4] = { p, p + 1, p + 2, p + dim + 2 };
+        lines->InsertNextCell(4, polyLine);
+      }
+      else if (r < 0.3)
+      {
+        // concave, L-shaped hexagon
+        const vtkIdType hexagon[6] = { p, p + 2, p + dim + 2, p + dim + 1, p + 2 * dim + 1,
+          p + 2 * dim };
+        polys->InsertNextCell(6, hexagon);
+        numTriangles += 4;
+      }
+      else if (r < 0.35)
+      {
+        // degenerate polygons produce no triangle
+        const vtkIdType degenerate[4] = { p, p, p, p };
+        polys->InsertNextCell(4, degenerate);
+      }
+      else if (r < 0.6)
+      {
+        const vtkIdType quad[4] = { p, p + 1, p + dim + 1, p + dim };
+        polys->InsertNextCell(4, quad);
+        numTriangles += 2;
+      }
+      else if (r < 0.7)
+      {
+        const vtkIdType triangle[3] = { p, p + 1, p + dim + 1 };
+        polys->InsertNextCell(3, triangle);
+        numTriangles += 1;
+      }
+      else
+      {
+        const vtkIdType strip[6] = { p, p + dim, p + 1, p + dim + 1, p + 2, p + dim + 2 };
+        strips->InsertNextCell(6, strip);
+        numTriangles += 4;
+      }
+    });
+  vtkSMPTestUtilities::AddCellIds(input, "CellIds");
+  return input;
+}
+
+//------------------------------------------------------------------------------
+// Each output cell must only use points of the input cell it is generated from.
+bool FromInputCells(vtkPolyData* output, vtkPolyData* input)
+{
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  vtkNew<vtkIdList> pts;
+  vtkNew<vtkIdList> inputPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, pts);
+    input->GetCellPoints(static_cast<vtkIdType>(cellIds->GetTuple1(cellId)), inputPts);
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+    {
+      if (inputPts->IsId(pts->GetId(i)) < 0)
+      {
+        std::cerr << "Cell " << cellId << " is not part of its input cell" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestTriangleFilterThreads(int, char*[])
+{
+  bool success = true;
+  vtkIdType numTriangles;
+  vtkSmartPointer<vtkPolyData> input = ::MakeInput(60, numTriangles);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputData(input);
+
+  for (int passVerts = 0; passVerts < 2; ++passVerts)
+  {
+    triangles->SetPassVerts(passVerts);
+    triangles->SetPassLines(passVerts);
+    success &= vtkSMPTestUtilities::CompareThreads(triangles, "vtkTriangleFilter");
+    vtkPolyData* output = triangles->GetOutput();
+    success &= ::FromInputCells(output, input);
+
+    // each poly-vertex point makes a vertex, each poly-line segment a line
+    const vtkIdType numVerts = passVerts ? 3 * input->GetNumberOfVerts() : 0;
+    const vtkIdType numLines = passVerts ? 3 * input->GetNumberOfLines() : 0;
+    if (output->GetNumberOfVerts() != numVerts || output->GetNumberOfLines() != numLines ||
+      output->GetNumberOfPolys() != numTriangles || output->GetNumberOfStrips() != 0 ||
+      output->GetCellData()->GetNumberOfTuples() != output->GetNumberOfCells())
+    {
+      std::cerr << "Expected " << numVerts << " vertices, " << numLines << " lines and "
+                << numTriangles << " triangles, got " << output->GetNumberOfVerts() << ", "
+                << output->GetNumberOfLines() << " and " << output->GetNumberOfPolys()
+                << std::endl;
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTubeFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tube random polylines with vtkTubeFilter, check the number of strips and
+// points of the tubes, that the output does not depend on the number of
+// threads and that the tubes generated concurrently are exactly the ones of the
+// serial traversal. The polylines sharing points are tubed serially when their
+// normals are generated, concurrently when they are given.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkTubeFilter.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Record whether the tubes are generated concurrently, or force the serial
+// traversal.
+class vtkCheckedTubeFilter : public vtkTubeFilter
+{
+public:
+  static vtkCheckedTubeFilter* New();
+  vtkTypeMacro(vtkCheckedTubeFilter, vtkTubeFilter);
+
+  bool Serial = false;
+  bool Concurrent = false;
+
+protected:
+  vtkCheckedTubeFilter() = default;
+  ~vtkCheckedTubeFilter() override = default;
+
+  bool GenerateTubesInParallel(vtkIdType firstCellId, vtkCellArray* inLines, vtkPoints* inPts,
+    vtkPointData* pd, vtkCellData* cd, vtkPointData* outPD, vtkCellData* outCD, vtkPoints* newPts,
+    vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+    vtkDataArray* inNormals, bool generateNormals) override
+  {
+    this->Concurrent = !this->Serial &&
+      this->Superclass::GenerateTubesInParallel(firstCellId, inLines, inPts, pd, cd, outPD, outCD,
+        newPts, newNormals, newTCoords, newStrips, inScalars, range, inVectors, maxSpeed,
+        inNormals, generateNormals);
+    return this->Concurrent;
+  }
+
+private:
+  vtkCheckedTubeFilter(const vtkCheckedTubeFilter&) = delete;
+  void operator=(const vtkCheckedTubeFilter&) = delete;
+};
+
+vtkStandardNewMacro(vtkCheckedTubeFilter);
+
+//------------------------------------------------------------------------------
+// Random polylines, optionally starting at the same point and with normals,
+// none of which is parallel to a segment since the coordinates increase along
+// each polyline.
+vtkSmartPointer<vtkPolyData> RandomLines(int numLines, bool sharePoints, bool normals)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> lineIds;
+  lineIds->SetName("LineIds");
+  for (int line = 0; line < numLines; ++line)
+  {
+    const int numPts = 2 + line % 50;
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetNextRangeValue(-10.0, 10.0);
+    }
+    lines->InsertNextCell(numPts);
+    for (int i = 0; i < numPts; ++i)
+    {
+      if (sharePoints && line > 0 && i == 0)
+      {
+        lines->InsertCellPoint(0); // all the polylines start at the same point
+        continue;
+      }
+      for (int j = 0; j < 3; ++j)
+      {
+        x[j] += random->GetNextRangeValue(0.1, 1.0);
+      }
+      lines->InsertCellPoint(points->InsertNextPoint(x));
+      scalars->InsertNextValue(random->GetNextRangeValue(0.5, 2.0));
+    }
+    lineIds->InsertNextValue(line);
+  }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->SetLines(lines);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetCellData()->AddArray(lineIds);
+  if (normals)
+  {
+    vtkNew<vtkFloatArray> pointNormals;
+    pointNormals->SetNumberOfComponents(3);
+    pointNormals->SetNumberOfTuples(points->GetNumberOfPoints());
+    for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+    {
+      pointNormals->SetTuple3(ptId, 0.6, -0.8, 0.0);
+    }
+    input->GetPointData()->SetNormals(pointNormals);
+  }
+  return input;
+}
+}
+
+int TestTubeFilterThreads(int, char*[])
+{
+  const int numLines = 500;
+  const int numSides = 6;
+  vtkIdType numLinePoints = 0;
+  for (int line = 0; line < numLines; ++line)
+  {
+    numLinePoints += 2 + line % 50;
+  }
+
+  // the polylines sharing points are tubed serially when their normals are
+  // generated
+  bool success = true;
+  for (int input = 0; input < 3; ++input)
+  {
+    const bool sharePoints = input > 0;
+    const bool concurrent = input != 1;
+    vtkSmartPointer<vtkPolyData> lines = ::RandomLines(numLines, sharePoints, input == 2);
+    vtkNew<vtkCheckedTubeFilter> tube;
+    vtkNew<vtkCheckedTubeFilter> serialTube;
+    serialTube->Serial = true;
+    for (vtkCheckedTubeFilter* filter : { tube.Get(), serialTube.Get() })
+    {
+      filter->SetInputData(lines);
+      filter->SetNumberOfSides(numSides);
+      filter->SetVaryRadiusToVaryRadiusByScalar();
+      filter->SetGenerateTCoordsToUseLength();
+    }
+
+    for (int config = 0; config < 4; ++config)
+    {
+      const int capping = config % 2;
+      const bool sidesShareVertices = config < 2;
+      const int onRatio = config == 3 ? 2 : 1;
+      for (vtkCheckedTubeFilter* filter : { tube.Get(), serialTube.Get() })
+      {
+        filter->SetCapping(capping);
+        filter->SetSidesShareVertices(sidesShareVertices);
+        filter->SetOnRatio(onRatio);
+      }
+      success &= vtkSMPTestUtilities::CompareThreads(tube, "vtkTubeFilter");
+      serialTube->Update();
+      if (tube->Concurrent != concurrent || serialTube->Concurrent)
+      {
+        std::cerr << "Wrong traversal of input " << input << std::endl;
+        success = false;
+      }
+      if (!vtkSMPTestUtilities::SameDataSets(tube->GetOutput(), serialTube->GetOutput()))
+      {
+        std::cerr << "The tubes of input " << input << " for configuration " << config
+                  << " differ from the serial ones" << std::endl;
+        success = false;
+      }
+
+      // Each polyline is tubed by one strip per side shown, plus the two caps,
+      // with its points repeated around the tube, twice when the sides do not
+      // share them, plus the points of the caps.
+      vtkPolyData* output = tube->GetOutput();
+      const vtkIdType numStrips = numLines * ((numSides + onRatio - 1) / onRatio + 2 * capping);
+      const vtkIdType numPoints = numSides * (sidesShareVertices ? 1 : 2) * numLinePoints +
+        numLines * 2 * numSides * capping;
+      if (output->GetNumberOfStrips() != numStrips || output->GetNumberOfPoints() != numPoints)
+      {
+        std::cerr << "Wrong output for configuration " << config << ": "
+                  << output->GetNumberOfStrips() << " strips and " << output->GetNumberOfPoints()
+                  << " points instead of " << numStrips << " and " << numPoints << std::endl;
+        success = false;
+      }
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
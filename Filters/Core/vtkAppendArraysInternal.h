@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAppendArraysInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAppendArraysInternal
+ * @brief   copy or view the cells and attributes of appended inputs
+ *
+ * vtkAppendArraysInternal gathers the helpers shared by vtkAppendPolyData and
+ * vtkAppendFilter to append their inputs. Each input is copied at its own
+ * offset into pre-sized output arrays, so that the inputs can be copied
+ * concurrently with vtkSMPTools, the point ids of the cells being shifted by
+ * the offset of the input points. With UseCompositeArrays, the output
+ * attribute arrays are instead replaced by vtkCompositeArray views over the
+ * input arrays.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkAppendPolyData vtkAppendFilter vtkCompositeArray
+ */
+
+#ifndef vtkAppendArraysInternal_h
+#define vtkAppendArraysInternal_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCompositeArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Copy the cells of an input into a pre-sized output cell array, starting at
+// a cell and a connectivity offset, with the point ids shifted.
+struct vtkAppendCopyCells
+{
+  // Call this signature:
+  template <typename DstCellStateT>
+  void operator()(DstCellStateT& dst, vtkCellArray* src, vtkIdType cellOffset,
+    vtkIdType connectivityOffset, vtkIdType pointOffset) const
+  { // dispatch on src:
+    src->Visit(*this, dst, cellOffset, connectivityOffset, pointOffset);
+  }
+
+  // Above signature calls this operator in Visit:
+  template <typename SrcCellStateT, typename DstCellStateT>
+  void operator()(SrcCellStateT& src, DstCellStateT& dst, vtkIdType cellOffset,
+    vtkIdType connectivityOffset, vtkIdType pointOffset) const
+  {
+    // the first offset of the input is the last one of the previous input
+    this->CopyWithOffset(src.GetOffsets(), 1, dst.GetOffsets(), cellOffset + 1, connectivityOffset);
+    this->CopyWithOffset(src.GetConnectivity(), 0, dst.GetConnectivity(), connectivityOffset,
+      pointOffset);
+  }
+
+  template <typename SrcArrayT, typename DstArrayT>
+  void CopyWithOffset(SrcArrayT* srcArray, vtkIdType srcBegin, DstArrayT* dstArray,
+    vtkIdType dstBegin, vtkIdType offset) const
+  {
+    using SrcValueType = vtk::GetAPIType<SrcArrayT>;
+    using DstValueType = vtk::GetAPIType<DstArrayT>;
+
+    const auto srcRange = vtk::DataArrayValueRange<1>(srcArray, srcBegin);
+    auto dstRange = vtk::DataArrayValueRange<1>(dstArray, dstBegin, dstBegin + srcRange.size());
+    const DstValueType dOffset = static_cast<DstValueType>(offset);
+    std::transform(srcRange.cbegin(), srcRange.cend(), dstRange.begin(),
+      [&](SrcValueType x) -> DstValueType { return static_cast<DstValueType>(x) + dOffset; });
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy n tuples of an array into another one, starting at destStart.
+struct vtkAppendCopyTuples
+{
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T* src, Array2T* dest, vtkIdType srcStart, vtkIdType n,
+    vtkIdType destStart) const
+  {
+    const auto srcTuples = vtk::DataArrayTupleRange(src, srcStart, srcStart + n);
+    auto dstTuples = vtk::DataArrayTupleRange(dest, destStart, destStart + n);
+    std::copy(srcTuples.cbegin(), srcTuples.cend(), dstTuples.begin());
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy n tuples of the input arrays into the pre-sized output arrays. The
+// data arrays can be copied concurrently, the other arrays (e.g. string
+// arrays) are copied one input at a time.
+inline void vtkAppendCopyAttributes(vtkDataSetAttributes::FieldList& list, int index,
+  vtkDataSetAttributes* in, vtkIdType inStart, vtkIdType n, vtkDataSetAttributes* out,
+  vtkIdType outStart)
+{
+  static std::mutex abstractArraysMutex;
+  list.TransformData(index, in, out,
+    [&](vtkAbstractArray* inArray, vtkAbstractArray* outArray)
+    {
+      vtkDataArray* inData = vtkDataArray::FastDownCast(inArray);
+      vtkDataArray* outData = vtkDataArray::FastDownCast(outArray);
+      if (inData && outData)
+      {
+        vtkAppendCopyTuples worker;
+        if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(
+              inData, outData, worker, inStart, n, outStart))
+        {
+          worker(inData, outData, inStart, n, outStart);
+        }
+      }
+      else
+      {
+        std::lock_guard<std::mutex> lock(abstractArraysMutex);
+        outArray->InsertTuples(outStart, n, inStart, inArray);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+// A vtkCompositeArray of the given type viewing the arrays end to end, or
+// nullptr if it cannot address all their values.
+inline vtkSmartPointer<vtkDataArray> vtkAppendConcatenateArrays(
+  int dataType, const std::vector<vtkDataArray*>& arrays)
+{
+  vtkIdType numValues = 0;
+  for (vtkDataArray* array : arrays)
+  {
+    numValues += array->GetNumberOfValues();
+  }
+  if (arrays.empty() || numValues > VTK_INT_MAX)
+  {
+    return nullptr;
+  }
+  switch (dataType)
+  {
+    vtkTemplateMacro(return vtk::ConcatenateDataArrays<VTK_TT>(arrays));
+  }
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Replace the output arrays by views over the matching input arrays. The
+// unnamed and non numeric arrays cannot be replaced and are copied. So are the
+// ghost, global ids and pedigree ids arrays, which are downcast to their
+// concrete type by their users, e.g. GetCellGhostArray().
+inline void vtkAppendConcatenateAttributes(vtkDataSetAttributes::FieldList& list,
+  const std::vector<vtkDataSetAttributes*>& inputs, vtkDataSetAttributes* out,
+  vtkIdType numTuples)
+{
+  std::map<vtkAbstractArray*, std::vector<vtkAbstractArray*>> inArrays;
+  for (int i = 0; i < static_cast<int>(inputs.size()); ++i)
+  {
+    list.TransformData(i, inputs[i], out,
+      [&](vtkAbstractArray* inArray, vtkAbstractArray* outArray)
+      { inArrays[outArray].push_back(inArray); });
+  }
+  for (const auto& arrays : inArrays)
+  {
+    vtkAbstractArray* outArray = arrays.first;
+    std::vector<vtkDataArray*> dataArrays;
+    for (vtkAbstractArray* inArray : arrays.second)
+    {
+      if (vtkDataArray* inData = vtkDataArray::FastDownCast(inArray))
+      {
+        dataArrays.push_back(inData);
+      }
+    }
+    const bool isSpecialArray = outArray == out->GetGlobalIds() ||
+      outArray == out->GetPedigreeIds() ||
+      (outArray->GetName() &&
+        strcmp(outArray->GetName(), vtkDataSetAttributes::GhostArrayName()) == 0);
+    vtkSmartPointer<vtkDataArray> composite;
+    if (!isSpecialArray && outArray->GetName() && dataArrays.size() == arrays.second.size())
+    {
+      composite = vtkAppendConcatenateArrays(outArray->GetDataType(), dataArrays);
+    }
+    if (composite)
+    {
+      composite->SetName(outArray->GetName());
+      composite->CopyComponentNames(outArray);
+      out->AddArray(composite); // replaces outArray
+      continue;
+    }
+    outArray->SetNumberOfTuples(numTuples);
+    vtkIdType outStart = 0;
+    for (vtkAbstractArray* inArray : arrays.second)
+    {
+      outArray->InsertTuples(outStart, inArray->GetNumberOfTuples(), 0, inArray);
+      outStart += inArray->GetNumberOfTuples();
+    }
+  }
+}
+} // anonymous namespace
+
+#endif // vtkAppendArraysInternal_h
+// VTK-HeaderTest-Exclude: vtkAppendArraysInternal.h
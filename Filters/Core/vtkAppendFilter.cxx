@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkAppendFilter.h"
 
+#include "vtkAppendArraysInternal.h"
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
@@ -25,12 +26,17 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendFilter);
@@ -43,6 +49,7 @@ vtkAppendFilter::vtkAppendFilter()
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Tolerance = 0.0;
   this->ToleranceIsAbsolute = true;
+  this->UseCompositeArrays = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -157,9 +164,6 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // Now we can allocate memory
-  output->Allocate(totalNumCells);
-
   vtkSmartPointer<vtkPoints> newPts = vtkSmartPointer<vtkPoints>::New();
 
   // set precision for the points in the output
@@ -226,6 +230,35 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // Without merging, the inputs are copied concurrently, unless they have
+  // polyhedra whose face streams are inserted one cell at a time.
+  bool appendInParallel = !reallyMergePoints;
+  inputs->InitTraversal(iter);
+  while (appendInParallel && (dataSet = inputs->GetNextDataSet(iter)))
+  {
+    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    appendInParallel = !ug || !ug->GetFaces();
+  }
+  if (appendInParallel)
+  {
+    if (this->AppendInParallel(inputs, newPts, output))
+    {
+      output->GetPointData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+      output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+      this->AppendArrays(vtkDataObject::POINT, inputVector, nullptr, output, totalNumPts);
+      this->UpdateProgress(0.75);
+      this->AppendArrays(
+        vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
+      this->UpdateProgress(1.0);
+      output->SetPoints(newPts);
+      output->Squeeze();
+    }
+    return 1;
+  }
+
+  // Now we can allocate memory
+  output->Allocate(totalNumCells);
+
   // If we aren't merging points, we need to allocate the points here.
   if (!reallyMergePoints)
   {
@@ -390,8 +423,8 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
+  this->AppendArrays(vtkDataObject::POINT, inputVector,
+    reallyMergePoints ? globalIndices : nullptr, output, newPts->GetNumberOfPoints());
   this->UpdateProgress(0.75);
   this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
   this->UpdateProgress(1.0);
@@ -405,6 +438,177 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+bool vtkAppendFilter::AppendInParallel(
+  vtkDataSetCollection* inputs, vtkPoints* newPts, vtkUnstructuredGrid* output)
+{
+  // where the points and cells of each input go in the output
+  std::vector<vtkDataSet*> dataSets;
+  std::vector<vtkIdType> pointOffsets(1, 0);
+  std::vector<vtkIdType> cellOffsets(1, 0);
+  std::vector<vtkDataArray*> inPoints;
+  vtkCollectionSimpleIterator iter;
+  vtkDataSet* dataSet;
+  for (inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
+  {
+    // the first call builds what the concurrent calls need, e.g. the cells
+    // of a polydata
+    if (dataSet->GetNumberOfCells() > 0)
+    {
+      dataSet->GetCellType(0);
+      dataSet->GetCellSize(0);
+    }
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(dataSet);
+    if (ps && ps->GetPoints() && ps->GetPoints()->GetDataType() == newPts->GetDataType())
+    {
+      inPoints.push_back(ps->GetPoints()->GetData());
+    }
+    dataSets.push_back(dataSet);
+    pointOffsets.push_back(pointOffsets.back() + dataSet->GetNumberOfPoints());
+    cellOffsets.push_back(cellOffsets.back() + dataSet->GetNumberOfCells());
+  }
+  const vtkIdType numPts = pointOffsets.back();
+  const vtkIdType numCells = cellOffsets.back();
+
+  // The input of a point or a cell, given the offsets of the inputs.
+  auto findInput = [](const std::vector<vtkIdType>& offsets, vtkIdType id) {
+    return static_cast<std::size_t>(
+      std::upper_bound(offsets.begin(), offsets.end(), id) - offsets.begin() - 1);
+  };
+
+  vtkSmartPointer<vtkDataArray> compositePoints;
+  if (this->UseCompositeArrays && inPoints.size() == dataSets.size())
+  {
+    compositePoints = vtkAppendConcatenateArrays(newPts->GetDataType(), inPoints);
+  }
+  if (compositePoints)
+  {
+    newPts->SetData(compositePoints);
+  }
+  else
+  {
+    newPts->SetNumberOfPoints(numPts);
+    vtkDataArray* outPoints = newPts->GetData();
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (std::size_t input = findInput(pointOffsets, begin); begin < end; ++input)
+      {
+        const vtkIdType inBegin = begin - pointOffsets[input];
+        const vtkIdType n = std::min(end, pointOffsets[input + 1]) - begin;
+        vtkPointSet* ps = vtkPointSet::SafeDownCast(dataSets[input]);
+        if (ps && ps->GetPoints())
+        {
+          vtkDataArray* inArray = ps->GetPoints()->GetData();
+          vtkAppendCopyTuples worker;
+          if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(
+                inArray, outPoints, worker, inBegin, n, begin))
+          {
+            worker(inArray, outPoints, inBegin, n, begin);
+          }
+        }
+        else
+        {
+          double x[3];
+          for (vtkIdType i = 0; i < n; ++i)
+          {
+            dataSets[input]->GetPoint(inBegin + i, x);
+            outPoints->SetTuple(begin + i, x);
+          }
+        }
+        begin += n;
+      }
+    });
+  }
+  this->UpdateProgress(0.25);
+
+  // The cell types and sizes, then the offsets and the connectivity.
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkIdType* cellOffset = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    std::size_t input = findInput(cellOffsets, begin);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      while (cellOffsets[input + 1] <= cellId)
+      {
+        ++input;
+      }
+      const vtkIdType inCellId = cellId - cellOffsets[input];
+      types->SetValue(cellId, static_cast<unsigned char>(dataSets[input]->GetCellType(inCellId)));
+      cellOffset[cellId] = dataSets[input]->GetCellSize(inCellId);
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return false;
+  }
+  cellOffset[numCells] = 0;
+  const vtkIdType connectivitySize =
+    vtkSMPTools::ExclusiveScan(cellOffset, cellOffset + numCells + 1, cellOffset, vtkIdType(0));
+  this->UpdateProgress(0.4);
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connectivitySize);
+  vtkIdType* cellPoints = connectivity->GetPointer(0);
+  vtkSMPThreadLocalObject<vtkIdList> localIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    vtkIdList* ids = localIds.Local();
+    std::size_t input = findInput(cellOffsets, begin);
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      while (cellOffsets[input + 1] <= cellId)
+      {
+        ++input;
+      }
+      dataSets[input]->GetCellPoints(cellId - cellOffsets[input], npts, pts, ids);
+      vtkIdType* outPts = cellPoints + cellOffset[cellId];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        outPts[i] = pts[i] + pointOffsets[input];
+      }
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return false;
+  }
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(types, cells);
+  this->UpdateProgress(0.5);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector** inputVector)
 {
@@ -455,31 +659,50 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
     }
   }
 
+  // Without global ids, the tuples of each input are copied at once, or
+  // viewed through composite arrays.
+  const bool composite = this->UseCompositeArrays && globalIds == nullptr;
   vtkDataSetAttributes* outputData = output->GetAttributes(attributesType);
-  outputData->CopyAllocate(fieldList, totalNumberOfElements);
+  outputData->CopyAllocate(fieldList, composite ? 0 : totalNumberOfElements);
 
-  // copy arrays.
-  int inputIndex;
-  vtkIdType offset = 0;
-  for (inputIndex = 0, dataSet = nullptr, inputs->InitTraversal(iter);
-       (dataSet = inputs->GetNextDataSet(iter));)
+  std::vector<vtkDataSetAttributes*> inputsData;
+  std::vector<vtkIdType> offsets(1, 0);
+  for (dataSet = nullptr, inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
   {
     if (auto inputData = dataSet->GetAttributes(attributesType))
     {
-      const auto numberOfInputTuples = inputData->GetNumberOfTuples();
-      if (globalIds != nullptr)
+      inputsData.push_back(inputData);
+      offsets.push_back(offsets.back() + inputData->GetNumberOfTuples());
+    }
+  }
+
+  // copy arrays.
+  const int numInputs = static_cast<int>(inputsData.size());
+  if (composite)
+  {
+    vtkAppendConcatenateAttributes(fieldList, inputsData, outputData, totalNumberOfElements);
+  }
+  else if (globalIds == nullptr)
+  {
+    outputData->SetNumberOfTuples(totalNumberOfElements);
+    vtkSMPTools::For(0, numInputs, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType inputIndex = begin; inputIndex < end; ++inputIndex)
       {
-        for (vtkIdType id = 0; id < numberOfInputTuples; ++id)
-        {
-          fieldList.CopyData(inputIndex, inputData, id, outputData, globalIds[offset + id]);
-        }
+        vtkAppendCopyAttributes(fieldList, static_cast<int>(inputIndex), inputsData[inputIndex],
+          0, inputsData[inputIndex]->GetNumberOfTuples(), outputData, offsets[inputIndex]);
       }
-      else
+    });
+  }
+  else
+  {
+    for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+    {
+      vtkDataSetAttributes* inputData = inputsData[inputIndex];
+      for (vtkIdType id = 0; id < inputData->GetNumberOfTuples(); ++id)
       {
-        fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
+        fieldList.CopyData(
+          inputIndex, inputData, id, outputData, globalIds[offsets[inputIndex] + id]);
       }
-      offset += numberOfInputTuples;
-      ++inputIndex;
     }
   }
 }
@@ -521,5 +744,6 @@ void vtkAppendFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MergePoints:" << (this->MergePoints ? "On" : "Off") << "\n";
   os << indent << "OutputPointsPrecision: " << this->OutputPointsPrecision << "\n";
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "UseCompositeArrays: " << (this->UseCompositeArrays ? "On" : "Off") << "\n";
 }
 VTK_ABI_NAMESPACE_END
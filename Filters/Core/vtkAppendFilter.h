@@ -29,6 +29,11 @@
  * "GlobalPointIds"), then two points are merged if they share the same point global id,
  * without checking for coincident point.
  *
+ * When points are not merged, the inputs are copied in parallel with
+ * vtkSMPTools, unless they have polyhedra. With UseCompositeArrays on, the
+ * output points, point data and cell data are vtkCompositeArray views over
+ * the input arrays instead of copies.
+ *
  * @sa
  * vtkAppendPolyData
  */
@@ -42,6 +47,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDataSetAttributes;
 class vtkDataSetCollection;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkAppendFilter : public vtkUnstructuredGridAlgorithm
 {
@@ -113,6 +119,22 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * If on, the output points and attribute arrays are vtkCompositeArray
+   * views over the input arrays instead of copies, to append many inputs
+   * without doubling the memory. The views are read-only and keep the input
+   * arrays alive, later changes of the inputs show through the output. The
+   * points are only viewed when they are not merged and all the inputs are
+   * point sets with points of the output precision and no polyhedra, the
+   * point data when points are not merged. Cells are always copied. The
+   * default is off.
+   */
+  vtkSetMacro(UseCompositeArrays, vtkTypeBool);
+  vtkGetMacro(UseCompositeArrays, vtkTypeBool);
+  vtkBooleanMacro(UseCompositeArrays, vtkTypeBool);
+  ///@}
+
 protected:
   vtkAppendFilter();
   ~vtkAppendFilter() override;
@@ -137,6 +159,8 @@ protected:
   // the diagonal of the bounding box of the input.
   bool ToleranceIsAbsolute;
 
+  vtkTypeBool UseCompositeArrays;
+
 private:
   vtkAppendFilter(const vtkAppendFilter&) = delete;
   void operator=(const vtkAppendFilter&) = delete;
@@ -145,6 +169,11 @@ private:
   // Caller must delete the returned vtkDataSetCollection.
   vtkDataSetCollection* GetNonEmptyInputs(vtkInformationVector** inputVector);
 
+  // Copy the points and cells of the inputs concurrently, without merging
+  // points. The inputs must not have polyhedra.
+  bool AppendInParallel(vtkDataSetCollection* inputs, vtkPoints* newPts,
+    vtkUnstructuredGrid* output);
+
   void AppendArrays(int attributesType, vtkInformationVector** inputVector, vtkIdType* globalIds,
     vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
 };
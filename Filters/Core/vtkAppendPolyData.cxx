@@ -15,6 +15,7 @@
 #include "vtkAppendPolyData.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendArraysInternal.h"
 #include "vtkArrayDispatch.h"
 #include "vtkAssume.h"
 #include "vtkCellArray.h"
@@ -26,21 +27,42 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendPolyData);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Where an input goes in the output: its first point, its first cell and
+// connectivity id in each of the verts, lines, polys and strips cell arrays,
+// and its index in the point and cell field lists.
+struct InputOffsets
+{
+  vtkPolyData* Input;
+  vtkIdType Point;
+  vtkIdType Cell[4];
+  vtkIdType Connectivity[4];
+  int PointDataIndex;
+  int CellDataIndex;
+};
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 vtkAppendPolyData::vtkAppendPolyData()
 {
   this->ParallelStreaming = 0;
   this->UserManagedInputs = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->UseCompositeArrays = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -125,13 +147,12 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 {
   int idx;
   vtkPolyData* ds;
-  vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkCellArray *inVerts, *newVerts;
-  vtkCellArray *inLines, *newLines;
-  vtkCellArray *inPolys, *newPolys;
+  vtkCellArray* newVerts;
+  vtkCellArray* newLines;
+  vtkCellArray* newPolys;
   vtkIdType sizePolys, numPolys;
-  vtkCellArray *inStrips, *newStrips;
+  vtkCellArray* newStrips;
   vtkIdType numPts, numCells;
   vtkPointData* inPD = nullptr;
   vtkCellData* inCD = nullptr;
@@ -286,8 +307,6 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->SetNumberOfPoints(numPts);
-
   newVerts = vtkCellArray::New();
   bool allocated = newVerts->AllocateExact(numVerts, sizeVerts);
 
@@ -329,83 +348,156 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
   outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
+  // The cell data can only be a view over the input cell data when the
+  // output has a single cell type, otherwise the cell data of each input is
+  // split by cell type in the output.
+  const bool compositePointData = this->UseCompositeArrays;
+  const bool compositeCellData = this->UseCompositeArrays &&
+    (numVerts == numCells || numLines == numCells || numPolys == numCells ||
+      numStrips == numCells);
+
   // Allocate the point and cell data
-  outputPD->CopyAllocate(ptList, numPts);
-  outputCD->CopyAllocate(cellList, numCells);
-
-  // loop over all input sets
-  vtkIdType ptOffset = 0;
-  vtkIdType vertOffset = 0;
-  vtkIdType linesOffset = numVerts;
-  vtkIdType polysOffset = numVerts + numLines;
-  vtkIdType stripsOffset = numVerts + numLines + numPolys;
-  countPD = countCD = 0;
-  int checkAbortInterval = std::min(numInputs / 10 + 1, 1000);
+  outputPD->CopyAllocate(ptList, compositePointData ? 0 : numPts);
+  outputCD->CopyAllocate(cellList, compositeCellData ? 0 : numCells);
+
+  // Find where each input goes in the output to copy the inputs in parallel
+  std::vector<InputOffsets> offsets;
+  offsets.reserve(numInputs);
+  InputOffsets offset = {};
+  std::vector<vtkDataArray*> inPoints;
+  std::vector<vtkDataSetAttributes*> inPointData;
+  std::vector<vtkDataSetAttributes*> inCellData;
   for (idx = 0; idx < numInputs; ++idx)
   {
-    if (idx % checkAbortInterval == 0 && this->CheckAbort())
+    ds = inputs[idx];
+    if (ds == nullptr || (ds->GetNumberOfPoints() <= 0 && ds->GetNumberOfCells() <= 0))
     {
-      break;
+      continue; // no input, just skip
     }
-    this->UpdateProgress(0.2 + 0.8 * idx / numInputs);
-    ds = inputs[idx];
-    // this check is not necessary, but I'll put it in anyway
-    if (ds != nullptr)
+    offset.Input = ds;
+    offsets.push_back(offset);
+    if (ds->GetNumberOfPoints() > 0)
     {
-      numPts = ds->GetNumberOfPoints();
-      numCells = ds->GetNumberOfCells();
-      if (numPts <= 0 && numCells <= 0)
+      inPoints.push_back(ds->GetPoints()->GetData());
+      inPointData.push_back(ds->GetPointData());
+      offset.Point += ds->GetNumberOfPoints();
+      ++offset.PointDataIndex;
+    }
+    if (ds->GetNumberOfCells() > 0)
+    {
+      inCellData.push_back(ds->GetCellData());
+      vtkCellArray* inCells[4] = { ds->GetVerts(), ds->GetLines(), ds->GetPolys(),
+        ds->GetStrips() };
+      for (int type = 0; type < 4; ++type)
       {
-        continue; // no input, just skip
+        offset.Cell[type] += inCells[type]->GetNumberOfCells();
+        offset.Connectivity[type] += inCells[type]->GetNumberOfConnectivityIds();
       }
+      ++offset.CellDataIndex;
+    }
+  }
 
-      inPD = ds->GetPointData();
-      inCD = ds->GetCellData();
-
-      inPts = ds->GetPoints();
-      inVerts = ds->GetVerts();
-      inLines = ds->GetLines();
-      inPolys = ds->GetPolys();
-      inStrips = ds->GetStrips();
+  vtkSmartPointer<vtkDataArray> compositePoints;
+  if (this->UseCompositeArrays)
+  {
+    compositePoints = vtkAppendConcatenateArrays(newPts->GetDataType(), inPoints);
+  }
+  if (compositePoints)
+  {
+    compositePoints->SetName(newPts->GetData()->GetName());
+    newPts->SetData(compositePoints);
+  }
+  else
+  {
+    newPts->SetNumberOfPoints(numPts);
+  }
+  vtkCellArray* newCells[4] = { newVerts, newLines, newPolys, newStrips };
+  const vtkIdType numTypeCells[4] = { numVerts, numLines, numPolys, numStrips };
+  const vtkIdType typeCellIds[4] = { 0, numVerts, numVerts + numLines,
+    numVerts + numLines + numPolys };
+  for (int type = 0; type < 4; ++type)
+  {
+    newCells[type]->GetOffsetsArray()->SetNumberOfValues(numTypeCells[type] + 1);
+    newCells[type]->GetConnectivityArray()->SetNumberOfValues(offset.Connectivity[type]);
+  }
+  if (!compositePointData)
+  {
+    outputPD->SetNumberOfTuples(numPts);
+  }
+  if (!compositeCellData)
+  {
+    outputCD->SetNumberOfTuples(numCells);
+  }
+  this->UpdateProgress(0.2);
 
-      if (ds->GetNumberOfPoints() > 0)
+  // Each input copies its points, cells and data at its offsets. The
+  // connectivity is shifted by the point offset of the input, and the cell
+  // offsets by the connectivity offset.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(offsets.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        // copy points directly
-        this->AppendData(newPts->GetData(), inPts->GetData(), ptOffset);
-        outputPD->CopyData(ptList, inPD, countPD, ptOffset, numPts, 0);
-        ++countPD;
-      }
+        if (i % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        const InputOffsets& inOffset = offsets[i];
+        vtkPolyData* input = inOffset.Input;
+        const vtkIdType inNumPts = input->GetNumberOfPoints();
+        if (inNumPts > 0 && !compositePoints)
+        {
+          // copy points directly
+          this->AppendData(newPts->GetData(), input->GetPoints()->GetData(), inOffset.Point);
+        }
+        if (inNumPts > 0 && !compositePointData)
+        {
+          vtkAppendCopyAttributes(ptList, inOffset.PointDataIndex, input->GetPointData(), 0,
+            inNumPts, outputPD, inOffset.Point);
+        }
+        if (input->GetNumberOfCells() <= 0)
+        {
+          continue;
+        }
 
-      if (ds->GetNumberOfCells() > 0)
-      {
-        // These are the cellIDs at which each of the cell types start.
-        vtkIdType vertsIndex = 0;
-        vtkIdType linesIndex = ds->GetNumberOfVerts();
-        vtkIdType polysIndex = linesIndex + ds->GetNumberOfLines();
-        vtkIdType stripsIndex = polysIndex + ds->GetNumberOfPolys();
-
-        // copy the cells
-        this->AppendCells(newVerts, inVerts, ptOffset);
-        this->AppendCells(newLines, inLines, ptOffset);
-        this->AppendCells(newPolys, inPolys, ptOffset);
-        this->AppendCells(newStrips, inStrips, ptOffset);
-
-        // copy cell data
-        outputCD->CopyData(cellList, inCD, countCD, vertOffset, ds->GetNumberOfVerts(), vertsIndex);
-        vertOffset += ds->GetNumberOfVerts();
-        outputCD->CopyData(
-          cellList, inCD, countCD, linesOffset, ds->GetNumberOfLines(), linesIndex);
-        linesOffset += ds->GetNumberOfLines();
-        outputCD->CopyData(
-          cellList, inCD, countCD, polysOffset, ds->GetNumberOfPolys(), polysIndex);
-        polysOffset += ds->GetNumberOfPolys();
-        outputCD->CopyData(
-          cellList, inCD, countCD, stripsOffset, ds->GetNumberOfStrips(), stripsIndex);
-        stripsOffset += ds->GetNumberOfStrips();
-        ++countCD;
+        vtkCellArray* inCells[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+          input->GetStrips() };
+        vtkIdType inCellId = 0;
+        for (int type = 0; type < 4; ++type)
+        {
+          const vtkIdType inNumCells = inCells[type]->GetNumberOfCells();
+          if (inNumCells <= 0)
+          {
+            continue;
+          }
+          newCells[type]->Visit(vtkAppendCopyCells{}, inCells[type], inOffset.Cell[type],
+            inOffset.Connectivity[type], inOffset.Point);
+          if (!compositeCellData)
+          {
+            vtkAppendCopyAttributes(cellList, inOffset.CellDataIndex, input->GetCellData(),
+              inCellId, inNumCells, outputCD, typeCellIds[type] + inOffset.Cell[type]);
+          }
+          inCellId += inNumCells;
+        }
       }
-      ptOffset += numPts;
-    }
+    });
+
+  if (compositePointData)
+  {
+    vtkAppendConcatenateAttributes(ptList, inPointData, outputPD, numPts);
+  }
+  if (compositeCellData)
+  {
+    vtkAppendConcatenateAttributes(cellList, inCellData, outputCD, numCells);
   }
 
   // Update ourselves and release memory
@@ -549,6 +641,7 @@ void vtkAppendPolyData::PrintSelf(ostream& os, vtkIndent indent)
   os << "ParallelStreaming:" << (this->ParallelStreaming ? "On" : "Off") << endl;
   os << "UserManagedInputs:" << (this->UserManagedInputs ? "On" : "Off") << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << endl;
+  os << indent << "UseCompositeArrays: " << (this->UseCompositeArrays ? "On" : "Off") << endl;
 }
 
 //------------------------------------------------------------------------------
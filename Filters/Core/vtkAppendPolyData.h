@@ -24,6 +24,11 @@
  * attributes available.  (For example, if one dataset has point scalars but
  * another does not, point scalars will not be appended.)
  *
+ * The inputs are copied in parallel with vtkSMPTools. With UseCompositeArrays
+ * on, the output points and point data are not copied but are
+ * vtkCompositeArray views over the input arrays, as well as the cell data
+ * when the output has a single type of cells.
+ *
  * @warning
  * The related filter vtkRemovePolyData enables the subtraction, or removal
  * of the cells of a vtkPolyData. Hence vtkRemovePolyData functions like the
@@ -121,6 +126,21 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * If on, the output points and attribute arrays are vtkCompositeArray
+   * views over the input arrays instead of copies, to append many inputs
+   * without doubling the memory. The views are read-only and keep the input
+   * arrays alive, later changes of the inputs show through the output. Cell
+   * data is only viewed when all the output cells are of the same type
+   * (verts, lines, polys or strips). Cells are always copied. The default
+   * is off.
+   */
+  vtkSetMacro(UseCompositeArrays, vtkTypeBool);
+  vtkGetMacro(UseCompositeArrays, vtkTypeBool);
+  vtkBooleanMacro(UseCompositeArrays, vtkTypeBool);
+  ///@}
+
   int ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
     VTK_SIZEHINT(inputs, numInputs);
 
@@ -131,6 +151,7 @@ protected:
   // Flag for selecting parallel streaming behavior
   vtkTypeBool ParallelStreaming;
   int OutputPointsPrecision;
+  vtkTypeBool UseCompositeArrays;
 
   // Usual data generation method
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -14,8 +14,12 @@
 =========================================================================*/
 #include "vtkCleanPolyData.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
@@ -25,9 +29,16 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <atomic>
+#include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCleanPolyData);
@@ -48,6 +59,91 @@ bool InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
   ptId = it->second;
   return false;
 }
+
+//------------------------------------------------------------------------------
+// The following are used by the threaded implementation.
+
+// Atomically lower value to candidate if candidate is smaller.
+void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current &&
+    !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+  {
+  }
+}
+
+// Merge the points sharing the same global id: each point is mapped to the
+// smallest point id with the same global id. The sort is threaded; the
+// final sweep over the sorted ids is cheap.
+void MergePointsWithGlobalIds(vtkIdTypeArray* globalIds, vtkIdType numPts, vtkIdType* mergeMap)
+{
+  using GlobalIdPair = std::pair<vtkIdType, vtkIdType>;
+  std::vector<GlobalIdPair> sorted(numPts);
+  const vtkIdType* gids = globalIds->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      sorted[ptId] = GlobalIdPair(gids[ptId], ptId);
+    }
+  });
+  vtkSMPTools::Sort(sorted.begin(), sorted.end());
+
+  vtkIdType repId = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (i == 0 || sorted[i].first != sorted[i - 1].first)
+    {
+      repId = sorted[i].second;
+    }
+    mergeMap[sorted[i].second] = repId;
+  }
+}
+
+// Visit the point ids of the cells in a batch, along with their (global)
+// position in the concatenated connectivity of verts, lines, polys and
+// strips. The position defines the order in which the serial algorithm
+// inserts points.
+template <typename FunctorT>
+void ForEachBatchPoint(
+  vtkCellArray* cellArrays[4], const vtkIdType connOffsets[4], const CellBatch& batch, FunctorT&& f)
+{
+  vtkCellArray* ca = cellArrays[batch.Type];
+  auto iter = vtk::TakeSmartPointer(ca->NewIterator());
+  vtkIdType pos = connOffsets[batch.Type] + ca->GetOffset(batch.BeginCellId);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = batch.BeginCellId; cellId < batch.EndCellId; ++cellId)
+  {
+    iter->GetCellAtId(cellId, npts, pts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      f(pos++, pts[i]);
+    }
+  }
+}
+
+// Gather the output point coordinates from their source input points.
+struct GatherPointsWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inPts, OutArrayT* outPts, const vtkIdType* srcIds)
+  {
+    using OutValueT = vtk::GetAPIType<OutArrayT>;
+    vtkSMPTools::For(0, outPts->GetNumberOfTuples(), [&](vtkIdType ptId, vtkIdType endPtId) {
+      const auto inTuples = vtk::DataArrayTupleRange<3>(inPts);
+      auto outTuples = vtk::DataArrayTupleRange<3>(outPts);
+      for (; ptId < endPtId; ++ptId)
+      {
+        const auto x = inTuples[srcIds[ptId]];
+        auto y = outTuples[ptId];
+        y[0] = static_cast<OutValueT>(x[0]);
+        y[1] = static_cast<OutValueT>(x[1]);
+        y[2] = static_cast<OutValueT>(x[2]);
+      }
+    });
+  }
+};
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -69,6 +165,8 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->Locator = nullptr;
   this->PieceInvariant = 1;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ThreadedMerging = 0;
+  this->PreservePointOrder = 1;
 }
 
 //------------------------------------------------------------------------------
@@ -152,6 +250,12 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+
+  if (this->ThreadedMerging)
+  {
+    return this->ThreadedRequestData(input, output);
+  }
+
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -678,6 +782,245 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// The threaded implementation proceeds as follows. First a merge map is
+// built (with a vtkStaticPointLocator, or from the global ids) mapping each
+// input point to a representative point. Then, for each representative,
+// the first position in the cell connectivity where one of its merged
+// points is used is computed. The serial algorithm inserts points in this
+// order, so this position determines both the output point ordering and
+// which input point provides the output coordinates and data. Finally the
+// cells are rewritten in parallel.
+int vtkCleanPolyData::ThreadedRequestData(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+  vtkIdTypeArray* globalIdsArray = vtkIdTypeArray::SafeDownCast(inputPD->GetGlobalIds());
+
+  // Subclasses may modify the points through OperateOnPoint(), so the
+  // points are computed up front through it, and used for both merging and
+  // output.
+  vtkNew<vtkDoubleArray> opPts;
+  opPts->SetNumberOfComponents(3);
+  opPts->SetNumberOfTuples(numPts);
+  double* x = opPts->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double inX[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      inPts->GetPoint(ptId, inX);
+      this->OperateOnPoint(inX, x + 3 * ptId);
+    }
+  });
+  vtkNew<vtkPoints> mergePts;
+  mergePts->SetData(opPts);
+
+  // Build the merge map.
+  std::vector<vtkIdType> mergeMap(numPts);
+  if (!this->PointMerging)
+  {
+    std::iota(mergeMap.begin(), mergeMap.end(), 0);
+  }
+  else if (globalIdsArray)
+  {
+    MergePointsWithGlobalIds(globalIdsArray, numPts, mergeMap.data());
+  }
+  else
+  {
+    vtkNew<vtkPolyData> mergeDS;
+    mergeDS->SetPoints(mergePts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(mergeDS);
+    locator->BuildLocator();
+    double tol =
+      (this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength());
+    locator->MergePoints(tol, mergeMap.data());
+  }
+  this->UpdateProgress(0.25);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Find the first use of each representative point in the connectivity.
+  vtkCellArray* cellArrays[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+    input->GetStrips() };
+  vtkIdType connOffsets[4];
+  vtkIdType offset = 0;
+  for (int type = 0; type < 4; ++type)
+  {
+    connOffsets[type] = offset;
+    offset += cellArrays[type]->GetNumberOfConnectivityIds();
+  }
+  CellBatches batches;
+  BuildCellBatches(cellArrays, batches);
+  const vtkIdType numBatches = static_cast<vtkIdType>(batches.size());
+
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType batchId, vtkIdType endBatchId) {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      ForEachBatchPoint(cellArrays, connOffsets, batches[batchId],
+        [&](vtkIdType pos, vtkIdType ptId) { AtomicMin(firstUse[mergeMap[ptId]], pos); });
+    }
+  });
+  auto isFirstUse = [&](vtkIdType pos, vtkIdType ptId) {
+    return firstUse[mergeMap[ptId]].load(std::memory_order_relaxed) == pos;
+  };
+  this->UpdateProgress(0.4);
+
+  // Number the output points. newIds is indexed by representative point id.
+  std::vector<vtkIdType> newIds(numPts);
+  vtkIdType numNewPts;
+  if (this->PreservePointOrder)
+  {
+    // Number the points in the order of their first use.
+    std::vector<vtkIdType> counts(numBatches, 0);
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType batchId, vtkIdType endBatchId) {
+      for (; batchId < endBatchId; ++batchId)
+      {
+        vtkIdType& count = counts[batchId];
+        ForEachBatchPoint(cellArrays, connOffsets, batches[batchId],
+          [&](vtkIdType pos, vtkIdType ptId) { count += isFirstUse(pos, ptId); });
+      }
+    });
+    numNewPts =
+      vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), counts.begin(), vtkIdType(0));
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType batchId, vtkIdType endBatchId) {
+      for (; batchId < endBatchId; ++batchId)
+      {
+        vtkIdType newId = counts[batchId];
+        ForEachBatchPoint(cellArrays, connOffsets, batches[batchId],
+          [&](vtkIdType pos, vtkIdType ptId) {
+            if (isFirstUse(pos, ptId))
+            {
+              newIds[mergeMap[ptId]] = newId++;
+            }
+          });
+      }
+    });
+  }
+  else
+  {
+    // Number the used representative points in increasing id order.
+    const vtkIdType numChunks = (numPts + CLEAN_BATCH_SIZE - 1) / CLEAN_BATCH_SIZE;
+    std::vector<vtkIdType> counts(numChunks, 0);
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+      for (; chunk < endChunk; ++chunk)
+      {
+        const vtkIdType endPtId = std::min(numPts, (chunk + 1) * CLEAN_BATCH_SIZE);
+        for (vtkIdType ptId = chunk * CLEAN_BATCH_SIZE; ptId < endPtId; ++ptId)
+        {
+          counts[chunk] += (firstUse[ptId].load(std::memory_order_relaxed) != VTK_ID_MAX);
+        }
+      }
+    });
+    numNewPts =
+      vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), counts.begin(), vtkIdType(0));
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+      for (; chunk < endChunk; ++chunk)
+      {
+        vtkIdType newId = counts[chunk];
+        const vtkIdType endPtId = std::min(numPts, (chunk + 1) * CLEAN_BATCH_SIZE);
+        for (vtkIdType ptId = chunk * CLEAN_BATCH_SIZE; ptId < endPtId; ++ptId)
+        {
+          if (firstUse[ptId].load(std::memory_order_relaxed) != VTK_ID_MAX)
+          {
+            newIds[ptId] = newId++;
+          }
+        }
+      }
+    });
+  }
+
+  // Map the input points to the output points, and record for each output
+  // point the input point it originates from.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType repId = mergeMap[ptId];
+      pointMap[ptId] =
+        (firstUse[repId].load(std::memory_order_relaxed) != VTK_ID_MAX ? newIds[repId] : -1);
+    }
+  });
+  std::vector<vtkIdType> srcIds(numNewPts);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType batchId, vtkIdType endBatchId) {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      ForEachBatchPoint(
+        cellArrays, connOffsets, batches[batchId], [&](vtkIdType pos, vtkIdType ptId) {
+          if (isFirstUse(pos, ptId))
+          {
+            srcIds[newIds[mergeMap[ptId]]] = ptId;
+          }
+        });
+    }
+  });
+  firstUse.reset();
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Produce the output points and point data.
+  vtkSmartPointer<vtkPoints> newPts = vtk::TakeSmartPointer(inPts->NewInstance());
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  GatherPointsWorker gatherWorker;
+  using Dispatcher =
+    vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(mergePts->GetData(), newPts->GetData(), gatherWorker, srcIds.data()))
+  {
+    gatherWorker(mergePts->GetData(), newPts->GetData(), srcIds.data());
+  }
+  output->SetPoints(newPts);
+
+  if (!this->PointMerging || globalIdsArray)
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD);
+  CopyAttributes(inputPD, outputPD, srcIds.data(), numNewPts);
+  this->UpdateProgress(0.75);
+
+  // Finally rewrite the cells.
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD);
+  CellCleaner cleaner;
+  cleaner.ConvertLinesToPoints = this->ConvertLinesToPoints != 0;
+  cleaner.ConvertPolysToLines = this->ConvertPolysToLines != 0;
+  cleaner.ConvertStripsToPolys = this->ConvertStripsToPolys != 0;
+  cleaner.RemoveAllDuplicates = false;
+  RebuildCells(input, pointMap.data(), cleaner, output);
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -750,6 +1093,8 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "PieceInvariant: " << (this->PieceInvariant ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "ThreadedMerging: " << (this->ThreadedMerging ? "On\n" : "Off\n");
+  os << indent << "PreservePointOrder: " << (this->PreservePointOrder ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -73,6 +73,16 @@
  * difference in the traversal order in the point merging process, the output
  * of the filters may be different.
  *
+ * @warning
+ * When ThreadedMerging is enabled, point merging and the rewriting of the
+ * cells are threaded with vtkSMPTools. Points are binned and merged with a
+ * vtkStaticPointLocator (the Locator is not used), or through their global
+ * ids if available. With a zero tolerance (or global ids, or point merging
+ * disabled), the output is identical to the serial output. With a non-zero
+ * tolerance, merged points may differ since the incremental merging of the
+ * serial path depends on the traversal order. OperateOnPoint() must be
+ * thread safe when ThreadedMerging is enabled.
+ *
  * @sa
  * vtkQuantizePolyDataPoints vtkStaticCleanPolyData
  * vtkStaticCleanUnstructuredGrid
@@ -161,6 +171,35 @@ public:
   vtkBooleanMacro(PointMerging, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded implementation of the filter. When on, point
+   * merging is performed with a vtkStaticPointLocator (or with the point
+   * global ids if present), and the cells are rewritten in parallel. The
+   * output cells and the output point coordinates and data are identical to
+   * those of the serial implementation when the merging tolerance is zero;
+   * see PreservePointOrder for the ordering of the output points. The
+   * Locator is ignored in this mode. By default, ThreadedMerging is off.
+   */
+  vtkSetMacro(ThreadedMerging, vtkTypeBool);
+  vtkGetMacro(ThreadedMerging, vtkTypeBool);
+  vtkBooleanMacro(ThreadedMerging, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * When ThreadedMerging is on, specify whether the output points are
+   * numbered in the order in which they are first used by the cells
+   * (traversing verts, lines, polys then strips), which is the ordering
+   * produced by the serial implementation. When off, the output points are
+   * numbered in increasing order of the input point ids they originate
+   * from, which is slightly cheaper to compute. By default, this is on.
+   */
+  vtkSetMacro(PreservePointOrder, vtkTypeBool);
+  vtkGetMacro(PreservePointOrder, vtkTypeBool);
+  vtkBooleanMacro(PreservePointOrder, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
@@ -222,6 +261,9 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  // Threaded implementation of RequestData(), used when ThreadedMerging is on.
+  int ThreadedRequestData(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
@@ -233,6 +275,8 @@ protected:
 
   vtkTypeBool PieceInvariant;
   int OutputPointsPrecision;
+  vtkTypeBool ThreadedMerging;
+  vtkTypeBool PreservePointOrder;
 
 private:
   vtkCleanPolyData(const vtkCleanPolyData&) = delete;
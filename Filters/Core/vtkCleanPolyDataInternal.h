@@ -0,0 +1,393 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCleanPolyDataInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCleanPolyDataInternal
+ * @brief   threaded rebuilding of polydata cells after point merging
+ *
+ * vtkCleanPolyDataInternal provides threaded machinery to rewrite the
+ * verts, lines, polys and strips of a vtkPolyData once a point map (mapping
+ * input point ids to output point ids) has been computed. Cells are
+ * processed in batches: a first threaded pass counts the output cells and
+ * connectivity generated by each batch, a prefix sum over the batches
+ * computes the output offsets, and a second threaded pass writes the output
+ * connectivity and cell data. The order of the output cells is identical to
+ * that of a serial traversal of the input cells (verts, lines, polys then
+ * strips).
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkCleanPolyData vtkStaticCleanPolyData
+ */
+
+#ifndef vtkCleanPolyDataInternal_h
+#define vtkCleanPolyDataInternal_h
+
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// The four types of cells found in a vtkPolyData, in the order in which
+// they are numbered.
+enum CleanCellType
+{
+  CLEAN_VERTS = 0,
+  CLEAN_LINES = 1,
+  CLEAN_POLYS = 2,
+  CLEAN_STRIPS = 3
+};
+
+// Number of cells processed by a batch in the threaded passes.
+const vtkIdType CLEAN_BATCH_SIZE = 1000;
+
+//------------------------------------------------------------------------------
+// Decides what a cell becomes once its points have been renumbered. Two
+// flavors are supported. vtkCleanPolyData only removes consecutive duplicate
+// points (plus the closing point of polygons and strips), and leaves cells
+// that were of reduced size on input untouched. vtkStaticCleanPolyData
+// removes every duplicate point of a cell.
+struct CellCleaner
+{
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+  bool RemoveAllDuplicates;
+
+  // Renumber the cell points through the point map into ids, and return the
+  // output type of the cell, or -1 if the cell is to be discarded.
+  template <typename IdT>
+  int Reduce(int inType, vtkIdType npts, const IdT* pts, const vtkIdType* pmap,
+    std::vector<vtkIdType>& ids) const
+  {
+    ids.clear();
+    if (this->RemoveAllDuplicates)
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        const vtkIdType ptId = pmap[pts[i]];
+        if (std::find(ids.begin(), ids.end(), ptId) == ids.end())
+        {
+          ids.push_back(ptId);
+        }
+      }
+    }
+    else
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        const vtkIdType ptId = pmap[pts[i]];
+        if (inType == CLEAN_VERTS || ids.empty() || ptId != ids.back())
+        {
+          ids.push_back(ptId);
+        }
+      }
+      if (((inType == CLEAN_POLYS && ids.size() > 2) ||
+            (inType == CLEAN_STRIPS && ids.size() > 1)) &&
+        ids.front() == ids.back())
+      {
+        ids.pop_back();
+      }
+    }
+
+    // Cells with enough points keep their type. Degenerate cells are
+    // converted to the type matching their number of points if requested
+    // (or, for vtkCleanPolyData, if the input cell was already that small).
+    static const vtkIdType minSize[4] = { 1, 2, 3, 4 };
+    const vtkIdType numIds = static_cast<vtkIdType>(ids.size());
+    if (numIds >= minSize[inType])
+    {
+      return inType;
+    }
+    if (numIds == 0)
+    {
+      return -1;
+    }
+    const int outType = static_cast<int>(numIds - 1);
+    const bool convert = (outType == CLEAN_VERTS
+        ? this->ConvertLinesToPoints
+        : (outType == CLEAN_LINES ? this->ConvertPolysToLines : this->ConvertStripsToPolys));
+    const bool unmodified = !this->RemoveAllDuplicates && numIds == npts;
+    return (convert || unmodified) ? outType : -1;
+  }
+};
+
+//------------------------------------------------------------------------------
+// A contiguous range of cells of one of the input cell arrays.
+struct CellBatch
+{
+  int Type;
+  vtkIdType BeginCellId;
+  vtkIdType EndCellId;
+};
+using CellBatches = std::vector<CellBatch>;
+
+// The number of output cells (and connectivity entries) of each output cell
+// type generated by a batch. The prefix sum over the batches turns them into
+// the batch's starting offsets.
+struct CellCounts
+{
+  vtkIdType NumCells[4] = { 0, 0, 0, 0 };
+  vtkIdType NumConn[4] = { 0, 0, 0, 0 };
+};
+
+struct AddCellCounts
+{
+  CellCounts operator()(const CellCounts& a, const CellCounts& b) const
+  {
+    CellCounts sum;
+    for (int type = 0; type < 4; ++type)
+    {
+      sum.NumCells[type] = a.NumCells[type] + b.NumCells[type];
+      sum.NumConn[type] = a.NumConn[type] + b.NumConn[type];
+    }
+    return sum;
+  }
+};
+
+// Split the cells of the four polydata cell arrays into batches.
+inline void BuildCellBatches(vtkCellArray* cellArrays[4], CellBatches& batches)
+{
+  batches.clear();
+  for (int type = 0; type < 4; ++type)
+  {
+    const vtkIdType numCells = cellArrays[type]->GetNumberOfCells();
+    for (vtkIdType begin = 0; begin < numCells; begin += CLEAN_BATCH_SIZE)
+    {
+      CellBatch batch;
+      batch.Type = type;
+      batch.BeginCellId = begin;
+      batch.EndCellId = std::min(begin + CLEAN_BATCH_SIZE, numCells);
+      batches.push_back(batch);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Copy attribute data from the source ids into the (already CopyAllocate'd)
+// output attributes. Numeric arrays are copied in parallel; other arrays
+// (e.g., string arrays) are copied serially.
+inline void CopyAttributes(vtkDataSetAttributes* inAttr, vtkDataSetAttributes* outAttr,
+  const vtkIdType* srcIds, vtkIdType num)
+{
+  ArrayList arrays;
+  arrays.AddArrays(num, inAttr, outAttr, 0.0, false);
+  vtkSMPTools::For(0, num, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      arrays.Copy(srcIds[id], id);
+    }
+  });
+
+  for (int i = 0; i < outAttr->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* outArray = outAttr->GetAbstractArray(i);
+    vtkAbstractArray* inArray =
+      (outArray->GetName() ? inAttr->GetAbstractArray(outArray->GetName()) : nullptr);
+    if (vtkArrayDownCast<vtkDataArray>(outArray) || inArray == nullptr)
+    {
+      continue;
+    }
+    outArray->SetNumberOfTuples(num);
+    for (vtkIdType id = 0; id < num; ++id)
+    {
+      outArray->SetTuple(id, srcIds[id], inArray);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Threaded rewrite of the input cells through the point map pmap. The
+// output verts, lines, polys and strips are placed into the output
+// polydata, and the input cell data is copied to the output cell data
+// (which must have been prepared with CopyAllocate()).
+struct RebuildCellsWorker
+{
+  vtkCellArray* InCells[4];
+  vtkIdType InCellOffset[4];
+  const vtkIdType* PointMap;
+  const CellCleaner& Cleaner;
+  const CellBatches& Batches;
+  std::vector<CellCounts> Counts;
+
+  // Output
+  vtkIdType* OutOffsets[4];
+  vtkIdType* OutConn[4];
+  vtkIdType OutCellOffset[4];
+  vtkIdType* CellMap;
+
+  RebuildCellsWorker(vtkPolyData* input, const vtkIdType* pmap, const CellCleaner& cleaner,
+    const CellBatches& batches)
+    : PointMap(pmap)
+    , Cleaner(cleaner)
+    , Batches(batches)
+    , Counts(batches.size())
+    , CellMap(nullptr)
+  {
+    this->InCells[CLEAN_VERTS] = input->GetVerts();
+    this->InCells[CLEAN_LINES] = input->GetLines();
+    this->InCells[CLEAN_POLYS] = input->GetPolys();
+    this->InCells[CLEAN_STRIPS] = input->GetStrips();
+    vtkIdType offset = 0;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->InCellOffset[type] = offset;
+      offset += this->InCells[type]->GetNumberOfCells();
+      this->OutOffsets[type] = nullptr;
+      this->OutConn[type] = nullptr;
+      this->OutCellOffset[type] = 0;
+    }
+  }
+
+  // Process a batch: count if counting is true, otherwise generate output.
+  void ProcessBatch(vtkIdType batchId, bool counting, std::vector<vtkIdType>& ids)
+  {
+    const CellBatch& batch = this->Batches[batchId];
+    CellCounts& counts = this->Counts[batchId];
+    vtkCellArray* ca = this->InCells[batch.Type];
+    auto iter = vtk::TakeSmartPointer(ca->NewIterator());
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = batch.BeginCellId; cellId < batch.EndCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      const int outType = this->Cleaner.Reduce(batch.Type, npts, pts, this->PointMap, ids);
+      if (outType < 0)
+      {
+        continue;
+      }
+      if (counting)
+      {
+        counts.NumCells[outType]++;
+        counts.NumConn[outType] += static_cast<vtkIdType>(ids.size());
+      }
+      else
+      {
+        const vtkIdType outCellId = counts.NumCells[outType]++;
+        const vtkIdType connOffset = counts.NumConn[outType];
+        this->OutOffsets[outType][outCellId] = connOffset;
+        std::copy(ids.begin(), ids.end(), this->OutConn[outType] + connOffset);
+        counts.NumConn[outType] += static_cast<vtkIdType>(ids.size());
+        this->CellMap[this->OutCellOffset[outType] + outCellId] =
+          this->InCellOffset[batch.Type] + cellId;
+      }
+    }
+  }
+
+  void Execute(vtkPolyData* input, vtkPolyData* output)
+  {
+    // Count the output generated by each batch.
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Batches.size()),
+      [&](vtkIdType batchId, vtkIdType endBatchId) {
+        std::vector<vtkIdType> ids;
+        for (; batchId < endBatchId; ++batchId)
+        {
+          this->ProcessBatch(batchId, true, ids);
+        }
+      });
+
+    // Prefix sum over the batches to determine where each batch writes its
+    // output.
+    const CellCounts total = vtkSMPTools::ExclusiveScan(this->Counts.begin(), this->Counts.end(),
+      this->Counts.begin(), CellCounts(), AddCellCounts());
+    const vtkIdType* numCells = total.NumCells;
+    const vtkIdType* numConn = total.NumConn;
+
+    // Allocate the output.
+    vtkSmartPointer<vtkCellArray> outCells[4];
+    vtkIdType totalNumCells = 0;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->OutCellOffset[type] = totalNumCells;
+      totalNumCells += numCells[type];
+      if (numCells[type] > 0)
+      {
+        vtkNew<vtkIdTypeArray> offsets;
+        offsets->SetNumberOfValues(numCells[type] + 1);
+        vtkNew<vtkIdTypeArray> conn;
+        conn->SetNumberOfValues(numConn[type]);
+        this->OutOffsets[type] = offsets->GetPointer(0);
+        this->OutOffsets[type][numCells[type]] = numConn[type];
+        this->OutConn[type] = conn->GetPointer(0);
+        outCells[type] = vtkSmartPointer<vtkCellArray>::New();
+        outCells[type]->SetData(offsets, conn);
+      }
+    }
+    std::vector<vtkIdType> cellMap(totalNumCells);
+    this->CellMap = cellMap.data();
+
+    // Now generate the output cells.
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Batches.size()),
+      [&](vtkIdType batchId, vtkIdType endBatchId) {
+        std::vector<vtkIdType> ids;
+        for (; batchId < endBatchId; ++batchId)
+        {
+          this->ProcessBatch(batchId, false, ids);
+        }
+      });
+
+    if (outCells[CLEAN_VERTS])
+    {
+      output->SetVerts(outCells[CLEAN_VERTS]);
+    }
+    if (outCells[CLEAN_LINES])
+    {
+      output->SetLines(outCells[CLEAN_LINES]);
+    }
+    if (outCells[CLEAN_POLYS])
+    {
+      output->SetPolys(outCells[CLEAN_POLYS]);
+    }
+    if (outCells[CLEAN_STRIPS])
+    {
+      output->SetStrips(outCells[CLEAN_STRIPS]);
+    }
+
+    CopyAttributes(input->GetCellData(), output->GetCellData(), cellMap.data(), totalNumCells);
+  }
+};
+
+// Convenience function wrapping RebuildCellsWorker.
+inline void RebuildCells(
+  vtkPolyData* input, const vtkIdType* pmap, const CellCleaner& cleaner, vtkPolyData* output)
+{
+  vtkCellArray* cellArrays[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+    input->GetStrips() };
+  CellBatches batches;
+  BuildCellBatches(cellArrays, batches);
+  RebuildCellsWorker worker(input, pmap, cleaner, batches);
+  worker.Execute(input, output);
+}
+
+} // anonymous namespace
+
+#endif // vtkCleanPolyDataInternal_h
+// VTK-HeaderTest-Exclude: vtkCleanPolyDataInternal.h
@@ -0,0 +1,399 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectedRegionsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectedRegionsInternal
+ * @brief   parallel labeling of the connected regions of a dataset
+ *
+ * vtkConnectedRegionsInternal labels the regions of cells connected through
+ * their points for vtkConnectivityFilter and vtkPolyDataConnectivityFilter,
+ * when their ParallelLabeling is on. Instead of growing each region with a
+ * wave front, the cells meeting the connectivity criterion are merged with
+ * their points in a lock-free union-find, concurrently with vtkSMPTools. The
+ * sets are linked below their smallest node and flattened by pointer jumping,
+ * so that the root of a set is its smallest cell.
+ *
+ * The regions, their ids and sizes are the same as the ones of the wave
+ * fronts of the filters: a region starts at the smallest cell not yet
+ * visited, and grows through the cells meeting the criterion. A cell which
+ * does not meet it is only visited when it starts a region, then the sets
+ * using its points join its region if it is the smallest cell reaching them.
+ * The points are numbered in the input order instead of the order in which
+ * the wave fronts reach them, and the region id of a point is the smallest
+ * region using it.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectedRegionsInternal_h
+#define vtkConnectedRegionsInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Lowers an atomic value to value if it is smaller.
+inline void vtkConnectedRegionsAtomicMin(std::atomic<vtkIdType>& atomic, vtkIdType value)
+{
+  vtkIdType current = atomic.load(std::memory_order_relaxed);
+  while (value < current && !atomic.compare_exchange_weak(current, value))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+// Lock-free disjoint sets. A root is always linked below a smaller root, so
+// that parents are never larger than their children and the root of a set is
+// its smallest node.
+class vtkConnectedRegionsUnionFind
+{
+public:
+  explicit vtkConnectedRegionsUnionFind(vtkIdType numNodes)
+    : Parents(numNodes)
+  {
+    vtkSMPTools::For(0, numNodes, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType node = begin; node < end; ++node)
+      {
+        this->Parents[node].store(node, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  vtkIdType Find(vtkIdType node)
+  {
+    while (true)
+    {
+      const vtkIdType parent = this->Parents[node].load(std::memory_order_relaxed);
+      if (parent == node)
+      {
+        return node;
+      }
+      const vtkIdType grandParent = this->Parents[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        // path halving: any ancestor is a valid parent, so a failure is harmless
+        vtkIdType expected = parent;
+        this->Parents[node].compare_exchange_weak(expected, grandParent);
+      }
+      node = grandParent;
+    }
+  }
+
+  void Union(vtkIdType node1, vtkIdType node2)
+  {
+    while (true)
+    {
+      vtkIdType root1 = this->Find(node1);
+      vtkIdType root2 = this->Find(node2);
+      if (root1 == root2)
+      {
+        return;
+      }
+      if (root1 < root2)
+      {
+        std::swap(root1, root2);
+      }
+      // link the larger root below the smaller one, unless another thread
+      // linked it meanwhile
+      vtkIdType expected = root1;
+      if (this->Parents[root1].compare_exchange_strong(expected, root2))
+      {
+        return;
+      }
+    }
+  }
+
+  // Point every node directly to its root (pointer jumping), after which
+  // GetRoot() can be used.
+  void Flatten()
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Parents.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType node = begin; node < end; ++node)
+        {
+          this->Parents[node].store(this->Find(node), std::memory_order_relaxed);
+        }
+      });
+  }
+
+  vtkIdType GetRoot(vtkIdType node) const
+  {
+    return this->Parents[node].load(std::memory_order_relaxed);
+  }
+
+private:
+  std::vector<std::atomic<vtkIdType>> Parents;
+};
+
+//------------------------------------------------------------------------------
+// Labels the regions of the cells of input. isConnected(cellId, cellPointIds)
+// tells whether a cell meets the connectivity criterion, and is called
+// concurrently. Without seeds, all the regions are labeled. With seeds, the
+// regions reached from the seed cells make the region 0.
+//
+// On output, visited holds the region of each cell (-1 if not extracted),
+// pointMap the output id of each point (-1 if not used by an extracted
+// cell), pointRegionIds the region id of each output point, indexed by
+// output id, and regionSizes the number of cells of each region. Returns the
+// number of output points.
+template <typename ConnectedFunctor>
+vtkIdType vtkLabelConnectedRegions(vtkAlgorithm* filter, vtkDataSet* input,
+  ConnectedFunctor& isConnected, const std::vector<vtkIdType>* seeds, vtkIdType* visited,
+  vtkIdType* pointMap, vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* regionSizes)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Make the subsequent calls to GetCellPoints() thread safe.
+  if (numCells > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+  }
+  vtkSMPThreadLocalObject<vtkIdList> localPointIds;
+
+  // Merge the cells meeting the criterion with their points: node c is the
+  // cell c, and node numCells + p the point p.
+  vtkConnectedRegionsUnionFind sets(numCells + numPts);
+  std::vector<unsigned char> connected(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          filter->CheckAbort();
+        }
+        if (filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      input->GetCellPoints(cellId, pointIds);
+      connected[cellId] = isConnected(cellId, pointIds) ? 1 : 0;
+      if (connected[cellId])
+      {
+        for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); ++i)
+        {
+          sets.Union(cellId, numCells + pointIds->GetId(i));
+        }
+      }
+    }
+  });
+  sets.Flatten();
+  filter->UpdateProgress(0.5);
+
+  vtkIdType numRegions = 0;
+  if (!seeds)
+  {
+    // The cell starting the region of a set is the smallest of its root and
+    // of the cells not meeting the criterion that use its points.
+    std::vector<std::atomic<vtkIdType>> owners(numCells);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        owners[cellId].store(cellId, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* pointIds = localPointIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (connected[cellId])
+        {
+          continue;
+        }
+        input->GetCellPoints(cellId, pointIds);
+        for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); ++i)
+        {
+          const vtkIdType root = sets.GetRoot(numCells + pointIds->GetId(i));
+          if (root < numCells)
+          {
+            vtkConnectedRegionsAtomicMin(owners[root], cellId);
+          }
+        }
+      }
+    });
+
+    // Number the regions in the order of their starting cells.
+    std::vector<vtkIdType> regionIds(numCells);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        regionIds[cellId] = (!connected[cellId] ||
+                              (sets.GetRoot(cellId) == cellId &&
+                                owners[cellId].load(std::memory_order_relaxed) == cellId))
+          ? 1
+          : 0;
+      }
+    });
+    numRegions = vtkSMPTools::ExclusiveScan(
+      regionIds.begin(), regionIds.end(), regionIds.begin(), vtkIdType(0));
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        visited[cellId] = connected[cellId]
+          ? regionIds[owners[sets.GetRoot(cellId)].load(std::memory_order_relaxed)]
+          : regionIds[cellId];
+      }
+    });
+  }
+  else
+  {
+    // The seed cells are extracted, along with the sets using their points.
+    std::vector<unsigned char> isSeed(numCells, 0);
+    std::vector<vtkIdType> seedCells;
+    for (vtkIdType cellId : *seeds)
+    {
+      if (cellId >= 0 && cellId < numCells && !isSeed[cellId])
+      {
+        isSeed[cellId] = 1;
+        seedCells.push_back(cellId);
+      }
+    }
+    std::vector<std::atomic<unsigned char>> reached(numCells);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(seedCells.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        vtkIdList* pointIds = localPointIds.Local();
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          input->GetCellPoints(seedCells[i], pointIds);
+          for (vtkIdType j = 0; j < pointIds->GetNumberOfIds(); ++j)
+          {
+            const vtkIdType root = sets.GetRoot(numCells + pointIds->GetId(j));
+            if (root < numCells)
+            {
+              reached[root].store(1, std::memory_order_relaxed);
+            }
+          }
+        }
+      });
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        visited[cellId] = (isSeed[cellId] ||
+                            (connected[cellId] &&
+                              reached[sets.GetRoot(cellId)].load(std::memory_order_relaxed)))
+          ? 0
+          : -1;
+      }
+    });
+    numRegions = 1;
+  }
+  filter->UpdateProgress(0.7);
+
+  // Count the cells of the regions and find the smallest region using each
+  // point. Consecutive cells are often in the same region, so the counts
+  // are accumulated before they are added.
+  std::vector<std::atomic<vtkIdType>> sizes(numRegions);
+  std::vector<std::atomic<vtkIdType>> pointRegions(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      pointRegions[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    vtkIdType region = -1;
+    vtkIdType count = 0;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (visited[cellId] < 0)
+      {
+        continue;
+      }
+      if (visited[cellId] != region)
+      {
+        if (count > 0)
+        {
+          sizes[region] += count;
+        }
+        region = visited[cellId];
+        count = 0;
+      }
+      ++count;
+      input->GetCellPoints(cellId, pointIds);
+      for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); ++i)
+      {
+        vtkConnectedRegionsAtomicMin(pointRegions[pointIds->GetId(i)], region);
+      }
+    }
+    if (count > 0)
+    {
+      sizes[region] += count;
+    }
+  });
+  regionSizes->SetNumberOfValues(numRegions);
+  for (vtkIdType region = 0; region < numRegions; ++region)
+  {
+    regionSizes->SetValue(region, sizes[region].load(std::memory_order_relaxed));
+  }
+
+  // Number the points used by the extracted cells in the input order.
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      pointMap[ptId] = pointRegions[ptId].load(std::memory_order_relaxed) != VTK_ID_MAX ? 1 : 0;
+    }
+  });
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(pointMap, pointMap + numPts, pointMap, vtkIdType(0));
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType region = pointRegions[ptId].load(std::memory_order_relaxed);
+      if (region == VTK_ID_MAX)
+      {
+        pointMap[ptId] = -1;
+      }
+      else
+      {
+        pointRegionIds->SetValue(pointMap[ptId], region);
+      }
+    }
+  });
+  filter->UpdateProgress(0.9);
+
+  return numNewPts;
+}
+
+} // anonymous namespace
+
+#endif // vtkConnectedRegionsInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectedRegionsInternal.h
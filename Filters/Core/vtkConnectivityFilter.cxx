@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -28,9 +29,11 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -46,6 +49,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->ScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
   this->ScalarRange[1] = 1.0;
+  this->ParallelLabeling = 0;
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
@@ -242,32 +246,47 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->ParallelLabeling)
     {
-      if (cellId && !(cellId % 5000))
+      this->LabelRegionsInParallel(input, nullptr);
+      for (i = 0; i < this->RegionNumber; i++)
       {
-        if (this->CheckAbort())
+        if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
         {
-          break;
+          maxCellsInRegion = this->RegionSizes->GetValue(i);
+          largestRegionId = i;
         }
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
       }
-
-      if (this->Visited[cellId] < 0)
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          if (this->CheckAbort())
+          {
+            break;
+          }
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave->InsertNextId(cellId);
+          this->TraverseAndMark(input);
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave->Reset();
+          this->Wave2->Reset();
+        }
       }
     }
   }
@@ -345,8 +364,15 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark(input);
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    if (this->ParallelLabeling)
+    {
+      this->LabelRegionsInParallel(input, this->Wave);
+    }
+    else
+    {
+      this->TraverseAndMark(input);
+      this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    }
     this->UpdateProgress(0.9);
   }
 
@@ -632,6 +658,47 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+// Label the regions like TraverseAndMark() does, but with a union-find of
+// the cells and their points built concurrently.
+//
+void vtkConnectivityFilter::LabelRegionsInParallel(vtkDataSet* input, vtkIdList* seeds)
+{
+  vtkDataArray* inScalars = this->InScalars;
+  const double* scalarRange = this->ScalarRange;
+  auto isConnected = [inScalars, scalarRange](vtkIdType, vtkIdList* pointIds) {
+    if (!inScalars)
+    {
+      return true;
+    }
+    // the scalars are converted to float, as in TraverseAndMark()
+    double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); i++)
+    {
+      double s = static_cast<float>(inScalars->GetComponent(pointIds->GetId(i), 0));
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+    }
+    return range[1] >= scalarRange[0] && range[0] <= scalarRange[1];
+  };
+
+  std::vector<vtkIdType> seedCells;
+  if (seeds)
+  {
+    seedCells.assign(seeds->GetPointer(0), seeds->GetPointer(0) + seeds->GetNumberOfIds());
+  }
+  this->PointNumber = vtkLabelConnectedRegions(this, input, isConnected,
+    seeds ? &seedCells : nullptr, this->Visited, this->PointMap, this->NewScalars,
+    this->RegionSizes);
+  this->RegionNumber = seeds ? 0 : this->RegionSizes->GetNumberOfValues();
+
+  vtkSMPTools::For(0, input->GetNumberOfCells(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+    }
+  });
+}
+
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
 {
@@ -789,6 +856,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -50,6 +50,11 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * @warning
+ * When ParallelLabeling is on, the regions are labeled with vtkSMPTools.
+ * Using TBB or other non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -106,6 +111,20 @@ public:
   vtkGetVector2Macro(ScalarRange, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the labeling of the regions in parallel. When on, the cells
+   * meeting the connectivity criterion are merged with their points in a
+   * lock-free union-find, concurrently, instead of growing each region with
+   * a serial wave front. The regions, their ids and sizes and the extracted
+   * cells are the same, but the output points keep their input order instead
+   * of the order in which the regions reach them. Default is off.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Control the extraction of connected surfaces.
@@ -241,10 +260,13 @@ protected:
 
   vtkTypeBool ScalarConnectivity;
   double ScalarRange[2];
+  vtkTypeBool ParallelLabeling;
 
   int RegionIdAssignmentMode;
 
   void TraverseAndMark(vtkDataSet* input);
+  // Label the regions with vtkSMPTools, all of them if seeds is nullptr
+  void LabelRegionsInParallel(vtkDataSet* input, vtkIdList* seeds);
 
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
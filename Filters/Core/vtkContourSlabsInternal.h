@@ -0,0 +1,420 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkContourSlabsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkContourSlabsInternal
+ * @brief   contour structured data in slabs of k-planes concurrently
+ *
+ * vtkContourSlabsInternal gathers the helpers used by vtkMarchingCubes,
+ * vtkGridSynchronizedTemplates3D and vtkRectilinearSynchronizedTemplates to
+ * contour their input concurrently. The extent is split into slabs of
+ * k-planes, adjacent slabs sharing their boundary plane, and each slab is
+ * contoured into its own polydata by the serial algorithm. The slabs are then
+ * merged: each slab owns some of its points, which are numbered after the
+ * points owned by the previous slabs, and maps its other points (those of the
+ * seam planes) to the points owned by its neighbours. The filters number the
+ * points and order the cells exactly as when contouring the whole extent at
+ * once, so that the output does not depend on the number of slabs.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkMarchingCubes vtkGridSynchronizedTemplates3D vtkRectilinearSynchronizedTemplates
+ */
+
+#ifndef vtkContourSlabsInternal_h
+#define vtkContourSlabsInternal_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The number of slabs to split numLayers layers of cells into. A single slab
+// means that the extent is contoured serially.
+inline int vtkContourSlabsNumberOfSlabs(int numLayers)
+{
+  // thin slabs would recompute too many seam planes
+  const int minimumThickness = 8;
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (numThreads <= 1)
+  {
+    return 1;
+  }
+  return std::max(1, std::min(numLayers / minimumThickness, 2 * numThreads));
+}
+
+//------------------------------------------------------------------------------
+// The first and last k-planes of a slab among numSlabs splitting [kMin, kMax].
+inline void vtkContourSlabsGetSlab(int kMin, int kMax, int numSlabs, int slab, int& k0, int& k1)
+{
+  const vtkIdType numLayers = kMax - kMin;
+  k0 = kMin + static_cast<int>(numLayers * slab / numSlabs);
+  k1 = kMin + static_cast<int>(numLayers * (slab + 1) / numSlabs);
+}
+
+//------------------------------------------------------------------------------
+// The contour of a slab, and where its points and cells go in the output.
+struct vtkContourSlab
+{
+  vtkSmartPointer<vtkPolyData> Output;
+
+  // The output id of each point of Output. The points of Output whose output
+  // ids lie in [PointOffset, PointOffset + NumberOfPoints) are owned by the
+  // slab, and numbered in the same order as in Output.
+  std::vector<vtkIdType> PointMap;
+  vtkIdType PointOffset = 0;
+  vtkIdType NumberOfPoints = 0;
+
+  // Point ids of the cells of Output which are not points of Output (e.g.
+  // reused from the previous slab) are at least ForeignBase, and their output
+  // ids are given by ForeignPointMap.
+  vtkIdType ForeignBase = VTK_ID_MAX;
+  std::vector<vtkIdType> ForeignPointMap;
+
+  vtkIdType CellOffset = 0;
+  vtkIdType ConnectivityOffset = 0;
+};
+
+//------------------------------------------------------------------------------
+// Set the point offsets of the slabs from the number of points they own, and
+// their cell offsets.
+inline void vtkContourSlabsComputeOffsets(std::vector<vtkContourSlab>& slabs)
+{
+  vtkIdType pointOffset = 0, cellOffset = 0, connectivityOffset = 0;
+  for (vtkContourSlab& slab : slabs)
+  {
+    slab.PointOffset = pointOffset;
+    slab.CellOffset = cellOffset;
+    slab.ConnectivityOffset = connectivityOffset;
+    pointOffset += slab.NumberOfPoints;
+    cellOffset += slab.Output->GetPolys()->GetNumberOfCells();
+    connectivityOffset += slab.Output->GetPolys()->GetNumberOfConnectivityIds();
+  }
+}
+
+//------------------------------------------------------------------------------
+// The edge intersections of the seam planes of a slab contoured by
+// synchronized templates, for one contour value. The templates keep the ids of
+// the points on the x, y and z edges of each point of two consecutive planes,
+// three per point, which are -1 if the edge does not intersect the contour.
+struct vtkContourSlabSeam
+{
+  bool HasPrevious = false;
+  bool HasNext = false;
+
+  // Points on the plane shared with the previous slab (when HasPrevious) may
+  // reuse the points of the z-edges of the plane below, inserted by the
+  // previous slab. Such points are given ids ForeignBase + the index of the
+  // edge in the plane.
+  vtkIdType ForeignBase = VTK_ID_MAX;
+
+  // The point ids of the first plane (when HasPrevious), and of the last two
+  // planes (when HasNext). The points inserted for the last plane, which are
+  // numbered from LastPlaneFirstPoint, are owned by the next slab.
+  std::vector<int> FirstPlane;
+  std::vector<int> PreviousPlane;
+  std::vector<int> LastPlane;
+  vtkIdType LastPlaneFirstPoint = 0;
+};
+
+//------------------------------------------------------------------------------
+// Fill the edge intersections of the plane below the first plane of a slab
+// with a previous slab, so that the templates reuse the points of its
+// z-edges like when contouring the whole extent. scalars points to the first
+// scalar of the plane below, and incX/incY/incZ are the increments to the next
+// scalar, row and plane.
+template <typename T>
+void vtkContourSlabsFillSeam(const T* scalars, int xdim, int ydim, vtkIdType incX,
+  vtkIdType incY, vtkIdType incZ, double value, vtkIdType foreignBase, int* isect)
+{
+  std::fill_n(isect, 3 * xdim * ydim, -1);
+  for (int j = 0; j < ydim; ++j)
+  {
+    const T* s0 = scalars + j * incY;
+    for (int i = 0; i < xdim; ++i, s0 += incX, isect += 3)
+    {
+      if ((*s0 < value) != (*(s0 + incZ) < value))
+      {
+        isect[2] = static_cast<int>(foreignBase + j * xdim + i);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Set the point maps of slabs contoured by synchronized templates from their
+// seams: a slab owns the points it inserted before its last plane (all of them
+// for the last slab), its last plane is mapped to the first plane of the next
+// slab, and its foreign points to the z-edges of the previous slab.
+inline void vtkContourSlabsMapSeams(
+  std::vector<vtkContourSlab>& slabs, const std::vector<vtkContourSlabSeam>& seams)
+{
+  const vtkIdType numSlabs = static_cast<vtkIdType>(slabs.size());
+  for (vtkIdType i = 0; i < numSlabs; ++i)
+  {
+    slabs[i].NumberOfPoints =
+      seams[i].HasNext ? seams[i].LastPlaneFirstPoint : slabs[i].Output->GetNumberOfPoints();
+  }
+  vtkContourSlabsComputeOffsets(slabs);
+
+  vtkSMPTools::For(0, numSlabs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkContourSlab& slab = slabs[i];
+        slab.PointMap.resize(slab.Output->GetNumberOfPoints());
+        for (vtkIdType ptId = 0; ptId < slab.NumberOfPoints; ++ptId)
+        {
+          slab.PointMap[ptId] = slab.PointOffset + ptId;
+        }
+      }
+    });
+  vtkSMPTools::For(0, numSlabs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkContourSlab& slab = slabs[i];
+        const vtkContourSlabSeam& seam = seams[i];
+        if (seam.HasNext)
+        {
+          // only the x and y edges of the last plane have new points
+          const std::vector<int>& nextFirstPlane = seams[i + 1].FirstPlane;
+          for (size_t edge = 0; edge < seam.LastPlane.size(); ++edge)
+          {
+            if (edge % 3 != 2 && seam.LastPlane[edge] >= seam.LastPlaneFirstPoint)
+            {
+              slab.PointMap[seam.LastPlane[edge]] = slabs[i + 1].PointMap[nextFirstPlane[edge]];
+            }
+          }
+        }
+        if (seam.HasPrevious)
+        {
+          const std::vector<int>& previousPlane = seams[i - 1].PreviousPlane;
+          slab.ForeignBase = seam.ForeignBase;
+          slab.ForeignPointMap.assign(previousPlane.size() / 3, -1);
+          for (size_t f = 0; f < slab.ForeignPointMap.size(); ++f)
+          {
+            if (previousPlane[3 * f + 2] >= 0)
+            {
+              slab.ForeignPointMap[f] = slabs[i - 1].PointMap[previousPlane[3 * f + 2]];
+            }
+          }
+        }
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Copy the cells of a slab into the pre-sized output cell array, with the
+// point ids mapped to the output ones.
+struct vtkContourSlabsCopyCells
+{
+  // Call this signature:
+  template <typename DstCellStateT>
+  void operator()(DstCellStateT& dst, const vtkContourSlab& slab) const
+  { // dispatch on src:
+    slab.Output->GetPolys()->Visit(*this, dst, slab);
+  }
+
+  // Above signature calls this operator in Visit:
+  template <typename SrcCellStateT, typename DstCellStateT>
+  void operator()(SrcCellStateT& src, DstCellStateT& dst, const vtkContourSlab& slab) const
+  {
+    using DstValueType = typename DstCellStateT::ValueType;
+
+    // the first offset of the slab is the last one of the previous slab
+    const auto srcOffsets = vtk::DataArrayValueRange<1>(src.GetOffsets(), 1);
+    auto dstOffsets = vtk::DataArrayValueRange<1>(
+      dst.GetOffsets(), slab.CellOffset + 1, slab.CellOffset + 1 + srcOffsets.size());
+    const DstValueType connectivityOffset = static_cast<DstValueType>(slab.ConnectivityOffset);
+    std::transform(srcOffsets.cbegin(), srcOffsets.cend(), dstOffsets.begin(),
+      [&](vtkIdType offset) -> DstValueType
+      { return static_cast<DstValueType>(offset) + connectivityOffset; });
+
+    const auto srcConnectivity = vtk::DataArrayValueRange<1>(src.GetConnectivity());
+    auto dstConnectivity = vtk::DataArrayValueRange<1>(dst.GetConnectivity(),
+      slab.ConnectivityOffset, slab.ConnectivityOffset + srcConnectivity.size());
+    std::transform(srcConnectivity.cbegin(), srcConnectivity.cend(), dstConnectivity.begin(),
+      [&](vtkIdType ptId) -> DstValueType
+      {
+        return static_cast<DstValueType>(ptId < slab.ForeignBase
+            ? slab.PointMap[ptId]
+            : slab.ForeignPointMap[ptId - slab.ForeignBase]);
+      });
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy the given tuples of an array to consecutive tuples of another one,
+// starting at destStart.
+struct vtkContourSlabsCopyTuples
+{
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T* src, Array2T* dest, const std::vector<vtkIdType>& srcIds,
+    vtkIdType destStart) const
+  {
+    const auto srcTuples = vtk::DataArrayTupleRange(src);
+    auto dstTuples =
+      vtk::DataArrayTupleRange(dest, destStart, destStart + static_cast<vtkIdType>(srcIds.size()));
+    auto dstTuple = dstTuples.begin();
+    for (vtkIdType srcId : srcIds)
+    {
+      *dstTuple++ = srcTuples[srcId];
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+inline void vtkContourSlabsCopyArray(vtkAbstractArray* inArray, vtkAbstractArray* outArray,
+  const std::vector<vtkIdType>& srcIds, vtkIdType destStart)
+{
+  static std::mutex abstractArraysMutex;
+  vtkDataArray* inData = vtkDataArray::FastDownCast(inArray);
+  vtkDataArray* outData = vtkDataArray::FastDownCast(outArray);
+  if (inData && outData)
+  {
+    vtkContourSlabsCopyTuples worker;
+    if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(
+          inData, outData, worker, srcIds, destStart))
+    {
+      worker(inData, outData, srcIds, destStart);
+    }
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(abstractArraysMutex);
+    for (vtkIdType i = 0; i < static_cast<vtkIdType>(srcIds.size()); ++i)
+    {
+      outArray->SetTuple(destStart + i, srcIds[i], inArray);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Give the output attributes the arrays of the attributes of a slab, with
+// numTuples tuples.
+inline void vtkContourSlabsAllocateAttributes(
+  vtkDataSetAttributes* in, vtkDataSetAttributes* out, vtkIdType numTuples)
+{
+  out->CopyStructure(in);
+  int attributeIndices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  in->GetAttributeIndices(attributeIndices);
+  for (int attributeType = 0; attributeType < vtkDataSetAttributes::NUM_ATTRIBUTES;
+       ++attributeType)
+  {
+    if (attributeIndices[attributeType] >= 0)
+    {
+      out->SetActiveAttribute(attributeIndices[attributeType], attributeType);
+    }
+  }
+  out->SetNumberOfTuples(numTuples);
+}
+
+//------------------------------------------------------------------------------
+// Merge the contours of the slabs into the output, once their offsets and
+// point maps are set. All the slabs have the same point and cell arrays.
+inline void vtkContourSlabsMerge(const std::vector<vtkContourSlab>& slabs, vtkPolyData* output)
+{
+  const vtkContourSlab& last = slabs.back();
+  const vtkIdType numPts = last.PointOffset + last.NumberOfPoints;
+  const vtkIdType numCells = last.CellOffset + last.Output->GetPolys()->GetNumberOfCells();
+  const vtkIdType connectivitySize =
+    last.ConnectivityOffset + last.Output->GetPolys()->GetNumberOfConnectivityIds();
+
+  vtkPolyData* first = slabs.front().Output;
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(first->GetPoints()->GetDataType());
+  newPts->SetNumberOfPoints(numPts);
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->AllocateExact(numCells, connectivitySize);
+  newPolys->GetOffsetsArray()->SetNumberOfValues(numCells + 1);
+  newPolys->GetConnectivityArray()->SetNumberOfValues(connectivitySize);
+  newPolys->GetOffsetsArray()->SetComponent(0, 0, 0.0);
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
+  vtkContourSlabsAllocateAttributes(first->GetPointData(), outPD, numPts);
+  vtkContourSlabsAllocateAttributes(first->GetCellData(), outCD, numCells);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(slabs.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      std::vector<vtkIdType> srcIds;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkContourSlab& slab = slabs[i];
+        vtkPolyData* input = slab.Output;
+
+        // the points owned by the slab
+        srcIds.clear();
+        for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+        {
+          const vtkIdType outPtId = slab.PointMap[ptId];
+          if (outPtId >= slab.PointOffset && outPtId < slab.PointOffset + slab.NumberOfPoints)
+          {
+            srcIds.push_back(ptId);
+          }
+        }
+        vtkContourSlabsCopyArray(
+          input->GetPoints()->GetData(), newPts->GetData(), srcIds, slab.PointOffset);
+        vtkPointData* inPD = input->GetPointData();
+        for (int arrayIdx = 0; arrayIdx < inPD->GetNumberOfArrays(); ++arrayIdx)
+        {
+          vtkContourSlabsCopyArray(inPD->GetAbstractArray(arrayIdx),
+            outPD->GetAbstractArray(arrayIdx), srcIds, slab.PointOffset);
+        }
+
+        // all the cells
+        newPolys->Visit(vtkContourSlabsCopyCells{}, slab);
+        const vtkIdType inNumCells = input->GetPolys()->GetNumberOfCells();
+        srcIds.resize(inNumCells);
+        for (vtkIdType cellId = 0; cellId < inNumCells; ++cellId)
+        {
+          srcIds[cellId] = cellId;
+        }
+        vtkCellData* inCD = input->GetCellData();
+        for (int arrayIdx = 0; arrayIdx < inCD->GetNumberOfArrays(); ++arrayIdx)
+        {
+          vtkContourSlabsCopyArray(inCD->GetAbstractArray(arrayIdx),
+            outCD->GetAbstractArray(arrayIdx), srcIds, slab.CellOffset);
+        }
+      }
+    });
+
+  output->SetPoints(newPts);
+  output->SetPolys(newPolys);
+}
+} // anonymous namespace
+
+#endif // vtkContourSlabsInternal_h
+// VTK-HeaderTest-Exclude: vtkContourSlabsInternal.h
@@ -22,6 +22,7 @@
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPartitionedDecimationInternal.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -197,6 +198,36 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  if (this->ParallelDecimation && this->TargetReduction > 0.0)
+  {
+    // Each partition is decimated by a serial instance of this filter. The
+    // error is made absolute so that it remains relative to the whole input.
+    const double errorTolerance = this->Error;
+    auto newDecimator = [this, errorTolerance](double targetReduction, bool lockBoundary) {
+      vtkNew<vtkDecimatePro> decimator;
+      decimator->SetTargetReduction(targetReduction);
+      decimator->SetFeatureAngle(this->FeatureAngle);
+      decimator->SetErrorIsAbsolute(1);
+      decimator->SetAbsoluteError(errorTolerance);
+      decimator->SetAccumulateError(this->AccumulateError);
+      decimator->SetSplitAngle(this->SplitAngle);
+      decimator->SetSplitting(lockBoundary ? 0 : this->Splitting);
+      decimator->SetPreSplitMesh(lockBoundary ? 0 : this->PreSplitMesh);
+      decimator->SetBoundaryVertexDeletion(lockBoundary ? 0 : this->BoundaryVertexDeletion);
+      decimator->SetPreserveTopology(this->PreserveTopology);
+      decimator->SetDegree(this->Degree);
+      decimator->SetInflectionPointRatio(this->InflectionPointRatio);
+      decimator->SetOutputPointsPrecision(this->OutputPointsPrecision);
+      return vtkSmartPointer<vtkPolyDataAlgorithm>(decimator.GetPointer());
+    };
+    if (::PartitionedDecimate(
+          input, output, this->TargetReduction, this->NumberOfPartitions, newDecimator))
+    {
+      this->NumberOfRemainingTris = output->GetNumberOfPolys();
+      return 1;
+    }
+  }
+
   // Build cell data structure. Need to copy triangle connectivity data
   // so we can modify it.
   if (this->TargetReduction > 0.0)
@@ -1728,5 +1759,7 @@ void vtkDecimatePro::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Inflection Points: " << this->GetNumberOfInflectionPoints() << "\n";
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Decimation: " << (this->ParallelDecimation ? "On\n" : "Off\n");
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 VTK_ABI_NAMESPACE_END
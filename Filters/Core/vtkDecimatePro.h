@@ -286,6 +286,35 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel decimation of the mesh (off by default). When
+   * on, the triangles are spatially partitioned, the partitions are
+   * decimated concurrently with their boundary vertices preserved, and the
+   * seams between partitions are decimated in a second pass. A last serial
+   * pass over the whole mesh is performed if needed to reach
+   * TargetReduction. A relative MaximumError remains relative to the
+   * bounds of the whole input. The output differs from the serial
+   * algorithm, and inflection points are not recorded. Meshes which are
+   * too small are decimated serially.
+   */
+  vtkSetMacro(ParallelDecimation, vtkTypeBool);
+  vtkGetMacro(ParallelDecimation, vtkTypeBool);
+  vtkBooleanMacro(ParallelDecimation, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of partitions used by the parallel decimation. When
+   * set to 0 (the default), the number of partitions is chosen from the
+   * number of threads and the size of the mesh. Setting an explicit number
+   * of partitions makes the output independent of the number of threads and
+   * of the machine.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
 protected:
   vtkDecimatePro();
   ~vtkDecimatePro() override;
@@ -307,6 +336,8 @@ protected:
   double InflectionPointRatio;
   vtkDoubleArray* InflectionPoints;
   int OutputPointsPrecision;
+  vtkTypeBool ParallelDecimation = false;
+  int NumberOfPartitions = 0;
 
   // to replace a static object
   vtkIdList* Neighbors;
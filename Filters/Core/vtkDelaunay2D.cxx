@@ -16,6 +16,7 @@
 
 #include "vtkAbstractTransform.h"
 #include "vtkCellArray.h"
+#include "vtkDelaunayInsertionOrderInternal.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -29,6 +30,7 @@
 #include "vtkTransform.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -45,6 +47,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->BoundingTriangulation = 0;
   this->Offset = 1.0;
   this->RandomPointInsertion = 0;
+  this->SpatiallySortedPointInsertion = 0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
 
@@ -467,6 +470,8 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   const double* bounds = points->GetBounds();
+  double projectedBounds[6];
+  std::copy_n(bounds, 6, projectedBounds);
   center[0] = (bounds[0] + bounds[1]) / 2.0;
   center[1] = (bounds[2] + bounds[3]) / 2.0;
   center[2] = (bounds[4] + bounds[5]) / 2.0;
@@ -524,12 +529,28 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // neighboring triangles for Delaunay criterion. Triangles that do not
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay. The points may be
-  // traversed in given order, or pseudo-random order.
+  // traversed in given order, pseudo-random order, or sorted along a
+  // space-filling curve.
   //
   GCDTraversal gcdIter(numPoints);
-  for (auto idx = 0; idx < numPoints; idx++)
+  std::vector<vtkIdType> order;
+  if (this->SpatiallySortedPointInsertion)
   {
-    ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
+    // The points are sorted in the projection plane, using the same
+    // (transformed) coordinates as the triangulation.
+    order = vtkDelaunayInsertionOrder(
+      [this](vtkIdType id, double p[3]) { this->GetPoint(id, p); }, numPoints, projectedBounds, 2);
+  }
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
+  {
+    if (this->SpatiallySortedPointInsertion)
+    {
+      ptId = order[idx];
+    }
+    else
+    {
+      ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
+    }
     this->GetPoint(ptId, x);
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -624,10 +645,10 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
       tri[0] = 0; // no triangle found
     }
 
-    if (!(ptId % 1000))
+    if (!(idx % 1000))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << idx);
+      this->UpdateProgress(static_cast<double>(idx) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -1652,6 +1673,8 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Random Point Insertion: " << (this->RandomPointInsertion ? "On" : "Off") << "\n";
+  os << indent << "Spatially Sorted Point Insertion: "
+     << (this->SpatiallySortedPointInsertion ? "On" : "Off") << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
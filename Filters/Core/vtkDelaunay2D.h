@@ -68,7 +68,8 @@
  * problems are present, you will see a warning message to this effect at
  * the end of the triangulation process. Note also that the
  * RandomPointInsertion mode can be set which will insert the points in
- * pseudo-random order.
+ * pseudo-random order, and the SpatiallySortedPointInsertion mode which will
+ * insert them sorted along a space-filling curve.
  *
  * To create constrained meshes, you must define an additional
  * input. This input is an instance of vtkPolyData which contains
@@ -267,6 +268,22 @@ public:
   vtkBooleanMacro(RandomPointInsertion, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points sorted along a space-filling
+   * curve of their projection (see Transform and ProjectionPlaneMode). This
+   * only changes the order of the serial insertion: the sort keys are
+   * computed and sorted with vtkSMPTools, then the points are inserted one
+   * at a time into the single triangulation. Consecutive insertions are spatially coherent, so that the
+   * walk towards the enclosing triangle is short; this is much faster for
+   * large, unorganized point sets. When on, it takes precedence over
+   * RandomPointInsertion. Point ids are preserved. Off by default.
+   */
+  vtkSetMacro(SpatiallySortedPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatiallySortedPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatiallySortedPointInsertion, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay2D();
 
@@ -277,6 +294,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   vtkTypeBool RandomPointInsertion;
+  vtkTypeBool SpatiallySortedPointInsertion;
 
   // Transform input points (if necessary)
   vtkSmartPointer<vtkAbstractTransform> Transform;
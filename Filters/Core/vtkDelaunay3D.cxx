@@ -15,6 +15,7 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkDelaunayInsertionOrderInternal.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
 #include "vtkIncrementalPointLocator.h"
@@ -29,6 +30,8 @@
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -138,6 +141,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->Tolerance = 0.001;
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
+  this->SpatiallySortedPointInsertion = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
@@ -496,17 +500,26 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
-  // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  // tetrahedra. The points may be traversed in given order, or sorted along
+  // a space-filling curve.
+  std::vector<vtkIdType> order;
+  if (this->SpatiallySortedPointInsertion)
+  {
+    order = vtkDelaunayInsertionOrder(
+      [inPoints](vtkIdType id, double p[3]) { inPoints->GetPoint(id, p); }, numPoints,
+      inPoints->GetBounds(), 3);
+  }
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
   {
+    ptId = (this->SpatiallySortedPointInsertion ? order[idx] : idx);
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(idx % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << idx);
+      this->UpdateProgress(static_cast<double>(idx) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -1063,6 +1076,8 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatially Sorted Point Insertion: "
+     << (this->SpatiallySortedPointInsertion ? "On\n" : "Off\n");
 
   if (this->Locator)
   {
@@ -52,7 +52,15 @@
  * mesh. (You may even want to add extra points to create a better
  * point distribution.) If numerical problems are present, you will
  * see a warning message to this effect at the end of the
- * triangulation process.
+ * triangulation process. The SpatiallySortedPointInsertion mode can be set
+ * which will insert the points sorted along a space-filling curve; this is
+ * much faster for large, unorganized point sets.
+ *
+ * @warning
+ * The triangulation is serial: the points are inserted one at a time into a
+ * single mesh, whatever the insertion order. Only the sort of
+ * SpatiallySortedPointInsertion runs with vtkSMPTools; the point set is not
+ * partitioned and triangulated concurrently.
  *
  * @warning
  * Points arranged on a regular lattice (termed degenerate cases) can be
@@ -66,7 +74,8 @@
  * Points that are coincident (or nearly so) may be discarded by the
  * algorithm.  This is because the Delaunay triangulation requires
  * unique input points.  You can control the definition of coincidence
- * with the "Tolerance" instance variable.
+ * with the "Tolerance" instance variable. The point which is kept is the one
+ * inserted first, so it depends on SpatiallySortedPointInsertion.
  *
  * @warning
  * The output of the Delaunay triangulation is supposedly a convex hull. In
@@ -198,6 +207,25 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in the given order, or sorted
+   * along a space-filling curve (a Morton curve of their bounding box). This
+   * only changes the order of the serial insertion: the sort keys are
+   * computed and sorted with vtkSMPTools, then the points are inserted one at
+   * a time into the single triangulation. Consecutive insertions are
+   * spatially coherent, which greatly reduces the cost of locating the
+   * enclosing tetrahedra of large, unorganized point sets. Point ids are
+   * preserved, but the output may change: of the points closer to each
+   * other than the tolerance of the locator, the one inserted first is kept
+   * and triangulated, and degenerate configurations may be triangulated
+   * differently. Off by default.
+   */
+  vtkSetMacro(SpatiallySortedPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatiallySortedPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatiallySortedPointInsertion, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -278,6 +306,7 @@ protected:
   double Tolerance;
   vtkTypeBool BoundingTriangulation;
   double Offset;
+  vtkTypeBool SpatiallySortedPointInsertion;
   int OutputPointsPrecision;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDelaunayInsertionOrderInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDelaunayInsertionOrderInternal
+ * @brief   spatially coherent point insertion order for Delaunay filters
+ *
+ * vtkDelaunayInsertionOrderInternal computes the order in which
+ * vtkDelaunay2D and vtkDelaunay3D insert their points when
+ * SpatiallySortedPointInsertion is on. The points are sorted along a Morton
+ * (Z-order) space-filling curve of their bounding box: consecutive points
+ * are then close to each other, so that the search of the simplex enclosing
+ * the next point is short and the mesh is accessed with a good locality.
+ * The keys are computed and sorted concurrently with vtkSMPTools, and ties
+ * are broken by point id so that the order does not depend on the number of
+ * threads.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkDelaunay2D vtkDelaunay3D
+ */
+
+#ifndef vtkDelaunayInsertionOrderInternal_h
+#define vtkDelaunayInsertionOrderInternal_h
+
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Insert two zero bits between each of the lower 21 bits of v.
+inline vtkTypeUInt64 vtkDelaunaySpreadBits3(vtkTypeUInt64 v)
+{
+  v &= 0x1fffff;
+  v = (v | (v << 32)) & 0x1f00000000ffffULL;
+  v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+  v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v << 2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+// Insert one zero bit between each of the lower 32 bits of v.
+inline vtkTypeUInt64 vtkDelaunaySpreadBits2(vtkTypeUInt64 v)
+{
+  v &= 0xffffffffULL;
+  v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+  v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+  v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  v = (v | (v << 2)) & 0x3333333333333333ULL;
+  v = (v | (v << 1)) & 0x5555555555555555ULL;
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Return the ids of the first numPts points sorted along a Morton curve of
+// the given bounds. The coordinates are given by getPoint(ptId, x), which is
+// called concurrently. With dimension 2, only the x and y coordinates are
+// used.
+template <typename PointFunctor>
+std::vector<vtkIdType> vtkDelaunayInsertionOrder(
+  PointFunctor&& getPoint, vtkIdType numPts, const double bounds[6], int dimension)
+{
+  // number of bits of the grid along each axis
+  const int bits = (dimension == 2 ? 32 : 21);
+  const double cells = static_cast<double>((vtkTypeUInt64(1) << bits) - 1);
+  double origin[3], scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    origin[i] = bounds[2 * i];
+    double length = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = (length > 0.0 ? cells / length : 0.0);
+  }
+
+  std::vector<std::pair<vtkTypeUInt64, vtkIdType>> keys(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    vtkTypeUInt64 ijk[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      getPoint(ptId, x);
+      for (int i = 0; i < 3; ++i)
+      {
+        double t = std::min(std::max((x[i] - origin[i]) * scale[i], 0.0), cells);
+        ijk[i] = static_cast<vtkTypeUInt64>(t);
+      }
+      vtkTypeUInt64 key = (dimension == 2)
+        ? vtkDelaunaySpreadBits2(ijk[0]) | (vtkDelaunaySpreadBits2(ijk[1]) << 1)
+        : vtkDelaunaySpreadBits3(ijk[0]) | (vtkDelaunaySpreadBits3(ijk[1]) << 1) |
+          (vtkDelaunaySpreadBits3(ijk[2]) << 2);
+      keys[ptId] = std::make_pair(key, ptId);
+    }
+  });
+
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  std::vector<vtkIdType> order(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      order[i] = keys[i].second;
+    }
+  });
+  return order;
+}
+
+} // anonymous namespace
+
+#endif // vtkDelaunayInsertionOrderInternal_h
+// VTK-HeaderTest-Exclude: vtkDelaunayInsertionOrderInternal.h
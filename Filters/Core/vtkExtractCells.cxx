@@ -407,30 +407,30 @@ vtkSmartPointer<vtkIdList> GeneratePointMap(
   });
   // convert flags to map where index is old id, value is new id and -1 means
   // the point is to be discarded.
-  vtkIdType nextid = 0;
-  for (auto& pt : *pointMap)
-  {
-    pt = pt ? nextid++ : -1;
-  }
-  outNumPoints = nextid;
+  std::vector<vtkIdType> newIds(pointMap->GetNumberOfIds());
+  outNumPoints =
+    vtkSMPTools::ExclusiveScan(pointMap->begin(), pointMap->end(), newIds.begin(), vtkIdType(0));
+  vtkSMPTools::Transform(pointMap->begin(), pointMap->end(), newIds.begin(), pointMap->begin(),
+    [](vtkIdType flag, vtkIdType newId) { return flag ? newId : -1; });
   return pointMap;
 }
 
 //------------------------------------------------------------------------------
-vtkSmartPointer<vtkIdList> ConvertToPointIdsToExtract(vtkIdList* pointMap)
+vtkSmartPointer<vtkIdList> ConvertToPointIdsToExtract(vtkIdList* pointMap, vtkIdType numPoints)
 {
-  const auto numberOfInputPoints = pointMap->GetNumberOfIds();
   vtkNew<vtkIdList> srcIds;
-  srcIds->Allocate(numberOfInputPoints);
+  srcIds->SetNumberOfIds(numPoints);
+  auto srcIdsPtr = srcIds->GetPointer(0);
   auto pointMapPtr = pointMap->GetPointer(0);
-  for (vtkIdType cc = 0; cc < numberOfInputPoints; ++cc)
-  {
-    if (pointMapPtr[cc] != -1)
+  vtkSMPTools::For(0, pointMap->GetNumberOfIds(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
     {
-      srcIds->InsertNextId(cc);
+      if (pointMapPtr[cc] != -1)
+      {
+        srcIdsPtr[pointMapPtr[cc]] = cc;
+      }
     }
-  }
-  srcIds->Squeeze();
+  });
   return srcIds;
 }
 
@@ -636,7 +636,7 @@ int vtkExtractCells::RequestData(vtkInformation* vtkNotUsed(request),
   // Build point map for selected cells.
   vtkIdType outputNumPoints;
   const auto pointMap = ::GeneratePointMap(input, this->CellList, outputNumPoints);
-  auto chosenPtIds = ::ConvertToPointIdsToExtract(pointMap);
+  auto chosenPtIds = ::ConvertToPointIdsToExtract(pointMap, outputNumPoints);
   this->UpdateProgress(0.25);
   if (this->CheckAbort())
   {
@@ -17,6 +17,8 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -27,11 +29,18 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkFeatureEdges);
@@ -40,6 +49,26 @@ namespace
 {
 constexpr unsigned char CELL_NOT_VISIBLE =
   vtkDataSetAttributes::HIDDENCELL | vtkDataSetAttributes::DUPLICATECELL;
+
+// The types of the output lines, indexing their "Edge Types" scalars.
+enum EdgeType : unsigned char
+{
+  BOUNDARY_EDGE,
+  NON_MANIFOLD_EDGE,
+  FEATURE_EDGE,
+  MANIFOLD_EDGE,
+  INPUT_LINE,
+  NOT_EXTRACTED
+};
+constexpr double EdgeTypeScalars[] = { 0.0, 0.222222, 0.444444, 0.666667, 0.888889 };
+
+// The polygon of an edge to sort, and the position of the edge in the
+// connectivity of the polygons.
+struct PolyEdge
+{
+  vtkIdType CellId;
+  vtkIdType Edge;
+};
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -55,6 +84,7 @@ vtkFeatureEdges::vtkFeatureEdges()
   this->PassLines = false;
   this->RemoveGhostInterfaces = true;
   this->Coloring = true;
+  this->MergePoints = true;
   this->Locator = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 }
@@ -86,23 +116,10 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkPoints* inPts;
-  vtkPoints* newPts;
-  vtkFloatArray* newScalars = nullptr;
-  vtkCellArray* newLines;
-  vtkPolyData* Mesh;
-  int i;
-  vtkIdType j, numNei;
-  vtkIdType numBEdges, numNonManifoldEdges, numFedges, numManifoldEdges;
-  double scalar, n[3], x1[3], x2[3];
-  double cosAngle = 0;
-  vtkIdType lineIds[2];
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
-  vtkCellArray *inPolys, *inStrips, *newPolys;
-  vtkFloatArray* polyNormals = nullptr;
-  vtkIdType numPts, numCells, numPolys, numStrips, numLines, nei;
-  vtkIdList* neighbors;
-  vtkIdType p1, p2, newId;
+  vtkCellArray* inPolys;
+  vtkIdType numPts, numCells, numPolys, numStrips, numLines;
   vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
   vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
 
@@ -147,8 +164,6 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Build cell structure.  Might have to triangulate the strips.
-  Mesh = vtkPolyData::New();
-  Mesh->SetPoints(inPts);
   inPolys = input->GetPolys();
   vtkIdType numberOfNewPolys = numPolys;
 
@@ -193,9 +208,10 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  vtkSmartPointer<vtkCellArray> newPolys = inPolys;
   if (numStrips > 0)
   {
-    newPolys = vtkCellArray::New();
+    newPolys = vtkSmartPointer<vtkCellArray>::New();
     if (numPolys > 0)
     {
       newPolys->DeepCopy(inPolys);
@@ -204,7 +220,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     {
       newPolys->AllocateEstimate(numStrips, 5);
     }
-    inStrips = input->GetStrips();
+    vtkCellArray* inStrips = input->GetStrips();
     vtkIdType stripId = -1;
     for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts);)
     {
@@ -212,313 +228,426 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       decomposedStripIdToStripIdMap.insert({ numberOfNewPolys, ++stripId });
       vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
     }
-
-    Mesh->SetPolys(newPolys);
-    newPolys->Delete();
-  }
-  else
-  {
-    newPolys = inPolys;
-    Mesh->SetPolys(newPolys);
-  }
-  Mesh->BuildLinks();
-
-  // Allocate storage for lines/points (arbitrary allocation sizes)
-  //
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(inPts->GetDataType());
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
   }
+  const vtkIdType numNewPolys = newPolys->GetNumberOfCells();
 
-  newPts->Allocate(numPts / 10, numPts);
-  newLines = vtkCellArray::New();
-  newLines->AllocateEstimate(numPts / 20, 2);
-  if (this->Coloring)
-  {
-    newScalars = vtkFloatArray::New();
-    newScalars->SetName("Edge Types");
-    newScalars->Allocate(numCells / 10, numCells);
-  }
-
-  outPD->CopyAllocate(pd, numPts);
-  outCD->CopyAllocate(cd, numCells);
-
-  // Get our locator for merging points
-  //
-  if (this->Locator == nullptr)
-  {
-    this->CreateDefaultLocator();
-  }
-  this->Locator->InitPointInsertion(newPts, input->GetBounds());
-
-  // Loop over all polygons generating boundary, non-manifold,
-  // and feature edges
-  //
-  if (this->FeatureEdges)
-  {
-    polyNormals = vtkFloatArray::New();
-    polyNormals->SetNumberOfComponents(3);
-    polyNormals->Allocate(3 * newPolys->GetNumberOfCells());
-
-    vtkIdType cellId;
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
+  // Input cell of each polygon, and whether it is visible.
+  std::vector<vtkIdType> polyCellIds(numNewPolys);
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newCellId = begin; newCellId < end; ++newCellId)
     {
-      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-      polyNormals->InsertTuple(cellId, n);
-    }
-
-    cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
-  }
-
-  neighbors = vtkIdList::New();
-  neighbors->Allocate(VTK_CELL_SIZE);
-
-  bool abort = false;
-  vtkIdType progressInterval = newPolys->GetNumberOfCells() / 20 + 1;
-
-  numBEdges = numNonManifoldEdges = numFedges = numManifoldEdges = 0;
-  vtkIdType newCellId, cellId;
-
-  // When filling output cells, to respect the same order as in vtkPolyData,
-  // we need to fill lines, then polys, then strips.
-  vtkIdType numOutLines = 0;
-  if (numLines)
-  {
-    vtkCellArray* lines = input->GetLines();
-    vtkIdType lineId = 0;
-    for (lines->InitTraversal(); lines->GetNextCell(npts, pts); ++lineId)
-    {
-      cellId = lineIdToCellIdMap->GetId(lineId);
-      if (ghosts && ghosts[cellId] & CELL_NOT_VISIBLE)
+      if (numPolys == numCells) // Input only has Polys
       {
-        continue;
+        polyCellIds[newCellId] = newCellId;
       }
-
-      for (vtkIdType pointId = 0; pointId < npts - 1; ++pointId)
+      else if (newCellId < numPolys) // Input has mixed types, and we currently are on a Poly
       {
-        p1 = pts[pointId];
-        p2 = pts[pointId + 1];
-
-        Mesh->GetPoint(p1, x1);
-        Mesh->GetPoint(p2, x2);
-
-        if (this->Locator->InsertUniquePoint(x1, lineIds[0]))
-        {
-          outPD->CopyData(pd, p1, lineIds[0]);
-        }
-
-        if (this->Locator->InsertUniquePoint(x2, lineIds[1]))
-        {
-          outPD->CopyData(pd, p2, lineIds[1]);
-        }
-
-        newId = newLines->InsertNextCell(2, lineIds);
-        outCD->CopyData(cd, cellId, newId);
-        if (this->Coloring)
-        {
-          newScalars->InsertTuple1(newId, 0.888889);
-        }
-        ++numOutLines;
+        polyCellIds[newCellId] = polyIdToCellIdMap->GetId(newCellId);
+      }
+      else // Input has mixed types and we are dealing with triangle strips
+      {
+        auto it = decomposedStripIdToStripIdMap.lower_bound(newCellId + 1);
+        polyCellIds[newCellId] = stripIdToCellIdMap->GetId(it->second);
       }
     }
-  }
-
-  for (newCellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts) && !abort;
-       newCellId++)
-  {
-    if (!(newCellId % progressInterval)) // manage progress / early abort
+  });
+  auto isVisible = [&](vtkIdType newCellId) {
+    return !ghosts || !(ghosts[polyCellIds[newCellId]] & CELL_NOT_VISIBLE);
+  };
+
+  // Each edge of a polygon is identified by its position in the
+  // connectivity of the polygons. The edges are gathered by their smallest
+  // point with a counting sort, then each bucket is sorted: this orders them
+  // as vtkStaticEdgeLocatorTemplate::MergeEdges() does, but in linear time,
+  // so that the polygons using an edge are contiguous.
+  std::vector<vtkIdType> polyOffsets(numNewPolys + 1);
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newCellId = begin; newCellId < end; ++newCellId)
     {
-      this->UpdateProgress(static_cast<double>(newCellId) / numCells);
-      abort = this->CheckAbort();
+      polyOffsets[newCellId] = newPolys->GetCellSize(newCellId);
     }
-
-    if (numPolys == numCells) // Input only has Polys
+  });
+  const vtkIdType numPolyEdges = vtkSMPTools::ExclusiveScan(
+    polyOffsets.begin(), polyOffsets.end() - 1, polyOffsets.begin(), vtkIdType(0));
+  polyOffsets[numNewPolys] = numPolyEdges;
+
+  // the polygon normals are kept in float, as they used to be
+  std::vector<float> polyNormals(this->FeatureEdges ? 3 * numNewPolys : 0);
+  std::vector<std::atomic<vtkIdType>> bucketEnds(numPts);
+  vtkSMPThreadLocalObject<vtkIdList> localPointIds;
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    vtkIdType cellSize;
+    const vtkIdType* cellPts;
+    for (vtkIdType newCellId = begin; newCellId < end; ++newCellId)
     {
-      cellId = newCellId;
+      newPolys->GetCellAtId(newCellId, cellSize, cellPts, pointIds);
+      for (vtkIdType i = 0; i < cellSize; ++i)
+      {
+        bucketEnds[std::min(cellPts[i], cellPts[(i + 1) % cellSize])]++;
+      }
+      if (this->FeatureEdges)
+      {
+        double n[3];
+        vtkPolygon::ComputeNormal(inPts, static_cast<int>(cellSize), cellPts, n);
+        std::copy(n, n + 3, &polyNormals[3 * newCellId]);
+      }
     }
-    else if (newCellId < numPolys) // Input has mixed types, and we currently are on a Poly
+  });
+  std::vector<vtkIdType> bucketOffsets(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
     {
-      cellId = polyIdToCellIdMap->GetId(newCellId);
+      bucketOffsets[ptId] = bucketEnds[ptId].load(std::memory_order_relaxed);
     }
-    else // Input has mixed types and we are dealing with triangle strips
+  });
+  bucketOffsets[numPts] = vtkSMPTools::ExclusiveScan(
+    bucketOffsets.begin(), bucketOffsets.end() - 1, bucketOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
     {
-      auto it = decomposedStripIdToStripIdMap.lower_bound(newCellId + 1);
-      cellId = stripIdToCellIdMap->GetId(it->second);
+      bucketEnds[ptId].store(bucketOffsets[ptId], std::memory_order_relaxed);
     }
-
-    if (ghosts && ghosts[cellId] & CELL_NOT_VISIBLE)
+  });
+
+  using EdgeTupleType = EdgeTuple<vtkIdType, PolyEdge>;
+  std::vector<EdgeTupleType> edges(numPolyEdges);
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    vtkIdType cellSize;
+    const vtkIdType* cellPts;
+    for (vtkIdType newCellId = begin; newCellId < end; ++newCellId)
     {
-      continue;
+      newPolys->GetCellAtId(newCellId, cellSize, cellPts, pointIds);
+      const vtkIdType offset = polyOffsets[newCellId];
+      for (vtkIdType i = 0; i < cellSize; ++i)
+      {
+        const EdgeTupleType edge(
+          cellPts[i], cellPts[(i + 1) % cellSize], PolyEdge{ newCellId, offset + i });
+        edges[bucketEnds[edge.V0]++] = edge;
+      }
     }
-
-    // Used with non manifold edges when there are ghost cells in the input
-    vtkNew<vtkIdList> edgesRemapping;
-
-    for (i = 0; i < npts; i++)
+  });
+  this->UpdateProgress(0.3);
+
+  // Classify each edge of each polygon from the polygons sharing it. The
+  // polygon owning the edge, i.e. the one generating the output line, is
+  // the same as when traversing the polygons with their edge neighbors.
+  const double cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+  std::vector<unsigned char> edgeTypes(numPolyEdges);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
     {
-      p1 = pts[i];
-      p2 = pts[(i + 1) % npts];
-
-      Mesh->GetCellEdgeNeighbors(newCellId, p1, p2, neighbors);
-      numNei = neighbors->GetNumberOfIds();
-
-      vtkIdType numNeiWithoutGhosts = numNei;
-      vtkIdType firstNeighbor = 0;
-      if (ghosts)
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      EdgeTupleType* bucket = edges.data() + bucketOffsets[ptId];
+      EdgeTupleType* bucketEnd = edges.data() + bucketOffsets[ptId + 1];
+      std::sort(bucket, bucketEnd, [](const EdgeTupleType& e1, const EdgeTupleType& e2) {
+        return e1.V1 < e2.V1 || (e1.V1 == e2.V1 && e1.Data.Edge < e2.Data.Edge);
+      });
+      vtkIdType groupSize;
+      for (const EdgeTupleType* group = bucket; group != bucketEnd; group += groupSize)
       {
-        for (j = 0; j < numNei; ++j)
+        groupSize = 1;
+        while (group + groupSize != bucketEnd && group[groupSize].V1 == group->V1)
         {
-          vtkIdType neiId = neighbors->GetId(j);
-          vtkIdType neighborCellIdInInput;
-          if (numPolys == numCells)
+          ++groupSize;
+        }
+        for (vtkIdType i = 0; i < groupSize; ++i)
+        {
+          const vtkIdType cellId = group[i].Data.CellId;
+          unsigned char& type = edgeTypes[group[i].Data.Edge];
+          type = NOT_EXTRACTED;
+          if (group[i].V0 == group[i].V1 || !isVisible(cellId))
           {
-            neighborCellIdInInput = neiId;
+            continue;
           }
-          else if (neiId < numPolys)
+
+          // the neighbors, the ones not visible, and the first visible one
+          vtkIdType numNei = 0, numGhostNei = 0, nei = VTK_ID_MAX;
+          for (vtkIdType j = 0; j < groupSize; ++j)
           {
-            neighborCellIdInInput = polyIdToCellIdMap->GetId(neiId);
+            const vtkIdType neiId = group[j].Data.CellId;
+            if (neiId != cellId)
+            {
+              ++numNei;
+              if (!isVisible(neiId))
+              {
+                ++numGhostNei;
+              }
+              else
+              {
+                nei = std::min(nei, neiId);
+              }
+            }
           }
-          else
+          const vtkIdType numNeiWithoutGhosts = numNei - numGhostNei;
+
+          // Ignoring edges that are not visible
+          if (numGhostNei > 0 && this->RemoveGhostInterfaces)
           {
-            auto it = decomposedStripIdToStripIdMap.lower_bound(neiId + 1);
-            neighborCellIdInInput = stripIdToCellIdMap->GetId(it->second);
+            continue;
           }
-          if (ghosts[neighborCellIdInInput] & CELL_NOT_VISIBLE)
+          if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
           {
-            if (this->NonManifoldEdges)
+            type = BOUNDARY_EDGE;
+          }
+          else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
+          {
+            // only the first polygon using the edge creates it
+            if (cellId < nei)
             {
-              edgesRemapping->InsertNextId(j);
+              type = NON_MANIFOLD_EDGE;
             }
-            if (j == firstNeighbor)
+          }
+          else if (this->FeatureEdges && numNeiWithoutGhosts == 1 && nei > cellId)
+          {
+            const float* n1 = &polyNormals[3 * nei];
+            const float* n2 = &polyNormals[3 * cellId];
+            const double cosNei = static_cast<double>(n1[0]) * n2[0] +
+              static_cast<double>(n1[1]) * n2[1] + static_cast<double>(n1[2]) * n2[2];
+            if (cosNei <= cosAngle)
             {
-              ++firstNeighbor;
+              type = FEATURE_EDGE;
             }
-            --numNeiWithoutGhosts;
+          }
+          else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 && nei > cellId)
+          {
+            type = MANIFOLD_EDGE;
           }
         }
       }
-      // Ignoring edges that are not visible
-      if (numNeiWithoutGhosts != numNei && this->RemoveGhostInterfaces)
+    }
+  });
+  this->UpdateProgress(0.6);
+
+  // Number the output lines: the input lines come first, split into
+  // segments, then the edges in the order of their polygons, to respect the
+  // order of the cells in vtkPolyData.
+  vtkCellArray* lines = input->GetLines();
+  std::vector<vtkIdType> lineOffsets(numLines + 1);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      const vtkIdType cellId = lineIdToCellIdMap->GetId(lineId);
+      lineOffsets[lineId] = (ghosts && ghosts[cellId] & CELL_NOT_VISIBLE)
+        ? 0
+        : std::max(lines->GetCellSize(lineId) - 1, vtkIdType(0));
+    }
+  });
+  const vtkIdType numOutLines = vtkSMPTools::ExclusiveScan(
+    lineOffsets.begin(), lineOffsets.end() - 1, lineOffsets.begin(), vtkIdType(0));
+  lineOffsets[numLines] = numOutLines;
+
+  std::vector<vtkIdType> polyEdgeOffsets(numNewPolys + 1);
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newCellId = begin; newCellId < end; ++newCellId)
+    {
+      polyEdgeOffsets[newCellId] =
+        std::count_if(edgeTypes.begin() + polyOffsets[newCellId],
+          edgeTypes.begin() + polyOffsets[newCellId + 1],
+          [](unsigned char type) { return type != NOT_EXTRACTED; });
+    }
+  });
+  const vtkIdType numNewLines = vtkSMPTools::ExclusiveScan(polyEdgeOffsets.begin(),
+    polyEdgeOffsets.end() - 1, polyEdgeOffsets.begin(), numOutLines);
+  polyEdgeOffsets[numNewPolys] = numNewLines;
+
+  // Fill the output lines with the input point ids, their cells, and types.
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(2 * numNewLines);
+  vtkIdType* linePts = connectivity->GetPointer(0);
+  std::vector<vtkIdType> lineCellIds(numNewLines);
+  std::vector<unsigned char> lineTypes(numNewLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    vtkIdType cellSize;
+    const vtkIdType* cellPts;
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      vtkIdType newId = lineOffsets[lineId];
+      if (newId == lineOffsets[lineId + 1])
       {
         continue;
       }
-
-      if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
+      lines->GetCellAtId(lineId, cellSize, cellPts, pointIds);
+      for (vtkIdType pointId = 0; pointId < cellSize - 1; ++pointId, ++newId)
       {
-        numBEdges++;
-        scalar = 0.0;
+        linePts[2 * newId] = cellPts[pointId];
+        linePts[2 * newId + 1] = cellPts[pointId + 1];
+        lineCellIds[newId] = lineIdToCellIdMap->GetId(lineId);
+        lineTypes[newId] = INPUT_LINE;
       }
-
-      else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
+    }
+  });
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    vtkIdType cellSize;
+    const vtkIdType* cellPts;
+    for (vtkIdType newCellId = begin; newCellId < end; ++newCellId)
+    {
+      vtkIdType newId = polyEdgeOffsets[newCellId];
+      if (newId == polyEdgeOffsets[newCellId + 1])
       {
-        // check to make sure that this edge hasn't been created before
-        for (j = 0; j < (ghosts ? edgesRemapping->GetNumberOfIds() : numNei); j++)
-        {
-          if (neighbors->GetId(ghosts ? edgesRemapping->GetId(j) : j) < newCellId)
-          {
-            break;
-          }
-        }
-        edgesRemapping->Reset();
-        if (j >= numNeiWithoutGhosts)
-        {
-          numNonManifoldEdges++;
-          scalar = 0.222222;
-        }
-        else
-        {
-          continue;
-        }
+        continue;
       }
-      else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
-        (nei = neighbors->GetId(firstNeighbor)) > newCellId)
+      newPolys->GetCellAtId(newCellId, cellSize, cellPts, pointIds);
+      for (vtkIdType i = 0; i < cellSize; ++i)
       {
-        double neiTuple[3];
-        double cellTuple[3];
-        polyNormals->GetTuple(nei, neiTuple);
-        polyNormals->GetTuple(newCellId, cellTuple);
-        if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
-        {
-          numFedges++;
-          scalar = 0.444444;
-        }
-        else
+        const unsigned char type = edgeTypes[polyOffsets[newCellId] + i];
+        if (type != NOT_EXTRACTED)
         {
-          continue;
+          linePts[2 * newId] = cellPts[i];
+          linePts[2 * newId + 1] = cellPts[(i + 1) % cellSize];
+          lineCellIds[newId] = polyCellIds[newCellId];
+          lineTypes[newId] = type;
+          ++newId;
         }
       }
-      else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
-        neighbors->GetId(firstNeighbor) > newCellId)
+    }
+  });
+  this->UpdateProgress(0.8);
+
+  // Allocate storage for points
+  //
+  vtkNew<vtkPoints> newPts;
+
+  // Set the desired precision for the points in the output.
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  if (this->MergePoints)
+  {
+    // Get our locator for merging points, and insert the points in the
+    // order of the lines.
+    //
+    newPts->Allocate(numPts / 10, numPts);
+    outPD->CopyAllocate(pd, numPts);
+    if (this->Locator == nullptr)
+    {
+      this->CreateDefaultLocator();
+    }
+    this->Locator->InitPointInsertion(newPts, input->GetBounds());
+
+    double x[3];
+    vtkIdType newPtId;
+    for (vtkIdType i = 0; i < 2 * numNewLines; ++i)
+    {
+      inPts->GetPoint(linePts[i], x);
+      if (this->Locator->InsertUniquePoint(x, newPtId))
+      {
+        outPD->CopyData(pd, linePts[i], newPtId);
+      }
+      linePts[i] = newPtId;
+    }
+    this->Locator->Initialize(); // release any extra memory
+  }
+  else
+  {
+    // Keep the points used by the lines, in the order of the input.
+    std::vector<std::atomic<unsigned char>> usedPts(numPts);
+    vtkSMPTools::For(0, 2 * numNewLines, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        numManifoldEdges++;
-        scalar = 0.666667;
+        usedPts[linePts[i]].store(1, std::memory_order_relaxed);
       }
-      else
+    });
+    std::vector<vtkIdType> pointMap(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-        continue;
+        pointMap[ptId] = usedPts[ptId].load(std::memory_order_relaxed);
       }
-
-      // Add edge to output
-      Mesh->GetPoint(p1, x1);
-      Mesh->GetPoint(p2, x2);
-
-      if (this->Locator->InsertUniquePoint(x1, lineIds[0]))
+    });
+    const vtkIdType numNewPts =
+      vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end(), pointMap.begin(), vtkIdType(0));
+
+    newPts->SetNumberOfPoints(numNewPts);
+    outPD->CopyAllocate(pd, numNewPts);
+    outPD->SetNumberOfTuples(numNewPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      double x[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-        outPD->CopyData(pd, p1, lineIds[0]);
+        if (usedPts[ptId].load(std::memory_order_relaxed))
+        {
+          inPts->GetPoint(ptId, x);
+          newPts->SetPoint(pointMap[ptId], x);
+          outPD->CopyData(pd, ptId, pointMap[ptId]);
+        }
       }
-
-      if (this->Locator->InsertUniquePoint(x2, lineIds[1]))
+    });
+    vtkSMPTools::For(0, 2 * numNewLines, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        outPD->CopyData(pd, p2, lineIds[1]);
+        linePts[i] = pointMap[linePts[i]];
       }
+    });
+  }
 
-      newId = newLines->InsertNextCell(2, lineIds);
-      outCD->CopyData(cd, cellId, newId);
+  // Create the lines and copy their cell data.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewLines + 1);
+  vtkSMPTools::For(0, numNewLines + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newId = begin; newId < end; ++newId)
+    {
+      offsets->SetValue(newId, 2 * newId);
+    }
+  });
+  vtkNew<vtkCellArray> newLines;
+  newLines->SetData(offsets, connectivity);
+
+  outCD->CopyAllocate(cd, numNewLines);
+  outCD->SetNumberOfTuples(numNewLines);
+  vtkNew<vtkFloatArray> newScalars;
+  if (this->Coloring)
+  {
+    newScalars->SetName("Edge Types");
+    newScalars->SetNumberOfValues(numNewLines);
+  }
+  vtkSMPTools::For(0, numNewLines, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newId = begin; newId < end; ++newId)
+    {
+      outCD->CopyData(cd, lineCellIds[newId], newId);
       if (this->Coloring)
       {
-        newScalars->InsertTuple(newId, &scalar);
+        newScalars->SetValue(newId, static_cast<float>(EdgeTypeScalars[lineTypes[newId]]));
       }
     }
-  }
+  });
 
-  vtkDebugMacro(<< "Created " << numBEdges << " boundary edges, " << numNonManifoldEdges
-                << " non-manifold edges, " << numFedges << " feature edges, " << numManifoldEdges
-                << " manifold edges," << numOutLines << " lines.");
-  (void)numBEdges;
-  (void)numOutLines;
+  vtkDebugMacro(<< "Created " << numNewLines - numOutLines << " edges, " << numOutLines
+                << " lines.");
 
   //  Update ourselves.
   //
-  if (this->FeatureEdges)
-  {
-    polyNormals->Delete();
-  }
-
-  Mesh->Delete();
-
   output->SetPoints(newPts);
-  newPts->Delete();
-  neighbors->Delete();
-
   output->SetLines(newLines);
-  newLines->Delete();
-  this->Locator->Initialize(); // release any extra memory
   if (this->Coloring)
   {
     int idx = outCD->AddArray(newScalars);
     outCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
   }
 
   return 1;
@@ -622,6 +751,7 @@ void vtkFeatureEdges::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Manifold Edges: " << (this->ManifoldEdges ? "On\n" : "Off\n");
   os << indent << "Pass Lines: " << (this->PassLines ? "On\n" : "Off\n");
   os << indent << "Coloring: " << (this->Coloring ? "On\n" : "Off\n");
+  os << indent << "Merge Points: " << (this->MergePoints ? "On\n" : "Off\n");
 
   if (this->Locator)
   {
@@ -32,6 +32,14 @@
  * instance variable of the mapper to SetScalarModeToUseCellData(). (This
  * is only a problem if there are point data scalars.)
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The edges of the polygons
+ * are sorted with vtkStaticEdgeLocatorTemplate to find their neighbors, and
+ * classified concurrently. Only the merging of the points with the Locator is
+ * serial, see MergePoints. Using TBB or other non-sequential type (set in the
+ * CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve performance
+ * significantly.
+ *
  * @sa
  * vtkExtractEdges
  */
@@ -155,8 +163,20 @@ public:
 
   ///@{
   /**
-   * Set / get a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Turn on/off the merging of coincident output points with the Locator.
+   * This is on by default. When off, the points of the output lines are the
+   * input points they use, in the input order, and they are copied
+   * concurrently; coincident input points are not merged.
+   */
+  vtkSetMacro(MergePoints, bool);
+  vtkGetMacro(MergePoints, bool);
+  vtkBooleanMacro(MergePoints, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set / get a spatial locator for merging points, used when MergePoints
+   * is on. By default an instance of vtkMergePoints is used.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
@@ -199,6 +219,7 @@ protected:
   bool Coloring;
   bool PassGlobalIds;
   bool RemoveGhostInterfaces;
+  bool MergePoints;
   int OutputPointsPrecision;
   vtkIncrementalPointLocator* Locator;
 
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkFloatArray.h"
+#include "vtkFlyingEdgesInternal.h"
 #include "vtkImageData.h"
 #include "vtkImageTransform.h"
 #include "vtkInformation.h"
@@ -533,6 +534,17 @@ void vtkFlyingEdges2DAlgorithm<T>::ProcessXEdge(double value, T* inPtr, vtkIdTyp
 
   // run along the entire x-edge computing edge cases
   std::fill_n(eMD, 5, 0);
+
+  // contiguous rows are classified by a vectorizable kernel, the NaN scalars
+  // are above as in the loop below
+  if (this->Inc0 == 1 && vtkFlyingEdgesVectorizable<T>::value)
+  {
+    eMD[0] = vtkFlyingEdgesClassifyXEdges<true>(inPtr, nxcells, value, ePtr, minInt, maxInt);
+    eMD[3] = minInt;
+    eMD[4] = maxInt;
+    return;
+  }
+
   for (vtkIdType i = 0; i < nxcells; ++i, ++ePtr)
   {
     s0 = s1;
@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkFloatArray.h"
+#include "vtkFlyingEdgesInternal.h"
 #include "vtkImageData.h"
 #include "vtkImageTransform.h"
 #include "vtkInformation.h"
@@ -1000,6 +1001,16 @@ void vtkFlyingEdges3DAlgorithm<T>::ProcessXEdge(
   // pull this out help reduce false sharing
   vtkIdType inc0 = this->Inc0;
 
+  // contiguous rows are classified by a vectorizable kernel
+  if (inc0 == 1 && vtkFlyingEdgesVectorizable<T>::value)
+  {
+    edgeMetaData[0] += vtkFlyingEdgesClassifyXEdges<false>(
+      inPtr, nxcells, value, ePtr, minInt, maxInt);
+    edgeMetaData[4] = minInt;
+    edgeMetaData[5] = maxInt;
+    return;
+  }
+
   for (vtkIdType i = 0; i < nxcells; ++i, ++ePtr)
   {
     s0 = s1;
@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFlyingEdgesInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkFlyingEdgesInternal
+ * @brief   classify the x-edges of a row of scalars against an isovalue
+ *
+ * vtkFlyingEdgesInternal gathers the first pass of vtkFlyingEdges2D and
+ * vtkFlyingEdges3D, which classifies the x-edges of each row of the volume.
+ * The isovalue is first converted to a threshold of the scalar type, so that
+ * the scalars are compared in their own type rather than converted to double
+ * one at a time. The edge cases are then computed without branches, which
+ * lets the compiler vectorize the loop with the widest instruction set it
+ * targets (e.g. 16 unsigned char or 4 float comparisons per SSE2
+ * instruction). The computational trimming bounds are found afterwards by
+ * scanning the ends of the row.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkFlyingEdges2D vtkFlyingEdges3D
+ */
+
+#ifndef vtkFlyingEdgesInternal_h
+#define vtkFlyingEdgesInternal_h
+
+#include "vtkType.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Convert an isovalue to a threshold of the scalar type T, such that
+// (s >= threshold) is equivalent to (static_cast<double>(s) >= value) for any
+// scalar s. Returns 0 if no scalar is above the isovalue, 1 if all the
+// scalars are, and 2 if they have to be compared with the threshold.
+template <typename T, bool IsInteger = std::numeric_limits<T>::is_integer>
+struct vtkFlyingEdgesThreshold
+{
+  static int Compute(double value, T& threshold)
+  {
+    const double ceilValue = std::ceil(value);
+    if (!(ceilValue <= static_cast<double>(std::numeric_limits<T>::max())))
+    {
+      return 0; // also catches a NaN isovalue
+    }
+    if (ceilValue <= static_cast<double>(std::numeric_limits<T>::lowest()))
+    {
+      return 1;
+    }
+    threshold = static_cast<T>(ceilValue);
+    return 2;
+  }
+};
+
+template <typename T>
+struct vtkFlyingEdgesThreshold<T, false>
+{
+  static int Compute(double value, T& threshold)
+  {
+    if (std::isnan(value))
+    {
+      return 0;
+    }
+    if (value > static_cast<double>(std::numeric_limits<T>::max()))
+    {
+      // only infinite scalars can be above
+      threshold = std::numeric_limits<T>::infinity();
+    }
+    else if (value < static_cast<double>(std::numeric_limits<T>::lowest()))
+    {
+      // only -inf can be below an infinite isovalue
+      threshold =
+        std::isinf(value) ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    }
+    else
+    {
+      // the isovalue rounded to nearest, moved up if it was rounded down
+      threshold = static_cast<T>(value);
+      if (static_cast<double>(threshold) < value)
+      {
+        threshold = std::nextafter(threshold, std::numeric_limits<T>::infinity());
+      }
+    }
+    return 2;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Whether vtkFlyingEdgesClassifyXEdges() is worth calling on contiguous rows
+// of T. The 64 bit scalars hold too few values per vector register to beat
+// the scalar loop.
+template <typename T>
+struct vtkFlyingEdgesVectorizable
+{
+  static constexpr bool value = sizeof(T) < 8;
+};
+
+//------------------------------------------------------------------------------
+// Classify the nEdges x-edges of a contiguous row of nEdges + 1 scalars:
+// bit 0 of each edge case is set if the left scalar is above the isovalue,
+// bit 1 if the right one is. Returns the number of edges intersecting the
+// contour, the first of which is minInt, while maxInt is one past the last
+// (nEdges and 0 if none). A scalar s is above if (s >= value), or if
+// !(s < value) when NaNAbove is set, which only differ for NaN scalars or
+// isovalues.
+template <bool NaNAbove, typename T>
+vtkIdType vtkFlyingEdgesClassifyXEdges(const T* scalars, vtkIdType nEdges, double value,
+  unsigned char* edgeCases, vtkIdType& minInt, vtkIdType& maxInt)
+{
+  minInt = nEdges;
+  maxInt = 0;
+  T threshold;
+  int compare = vtkFlyingEdgesThreshold<T>::Compute(value, threshold);
+  if (NaNAbove && std::isnan(value))
+  {
+    compare = 1;
+  }
+  if (compare != 2)
+  {
+    std::fill_n(edgeCases, nEdges, static_cast<unsigned char>(compare ? 3 : 0));
+    return 0;
+  }
+
+  // branch free, so that the loop is vectorized
+  vtkIdType sum = 0;
+  for (vtkIdType i = 0; i < nEdges; ++i)
+  {
+    const unsigned char leftAbove =
+      NaNAbove ? !(scalars[i] < threshold) : scalars[i] >= threshold;
+    const unsigned char rightAbove =
+      NaNAbove ? !(scalars[i + 1] < threshold) : scalars[i + 1] >= threshold;
+    edgeCases[i] = static_cast<unsigned char>(leftAbove | (rightAbove << 1));
+    sum += leftAbove ^ rightAbove;
+  }
+
+  // computational trimming
+  if (sum > 0)
+  {
+    minInt = 0;
+    while (edgeCases[minInt] == 0 || edgeCases[minInt] == 3)
+    {
+      ++minInt;
+    }
+    maxInt = nEdges;
+    while (edgeCases[maxInt - 1] == 0 || edgeCases[maxInt - 1] == 3)
+    {
+      --maxInt;
+    }
+  }
+  return sum;
+}
+} // anonymous namespace
+
+#endif // vtkFlyingEdgesInternal_h
+// VTK-HeaderTest-Exclude: vtkFlyingEdgesInternal.h
@@ -14,18 +14,23 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
-#include "vtkCell.h"
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
-#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,10 +38,168 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Number of instances, points, cells and connectivity entries of the four
+// cell arrays of vtkPolyData that a glyph generates. Once scanned over the
+// input points, where the glyph of each point goes in the output.
+struct GlyphSize
+{
+  vtkIdType Instances;
+  vtkIdType Points;
+  vtkIdType Cells[4];
+  vtkIdType Connectivity[4];
+
+  GlyphSize()
+    : Instances(0)
+    , Points(0)
+  {
+    std::fill(this->Cells, this->Cells + 4, 0);
+    std::fill(this->Connectivity, this->Connectivity + 4, 0);
+  }
+
+  GlyphSize operator+(const GlyphSize& other) const
+  {
+    GlyphSize sum;
+    sum.Instances = this->Instances + other.Instances;
+    sum.Points = this->Points + other.Points;
+    for (int type = 0; type < 4; ++type)
+    {
+      sum.Cells[type] = this->Cells[type] + other.Cells[type];
+      sum.Connectivity[type] = this->Connectivity[type] + other.Connectivity[type];
+    }
+    return sum;
+  }
+};
+
+//------------------------------------------------------------------------------
+// A source of the glyph table, prepared once so that the threads copy it
+// without calling the non thread safe vtkPolyData and vtkTransform methods.
+struct GlyphSource
+{
+  vtkPolyData* Source = nullptr;
+  vtkDataArray* Normals = nullptr;
+  // the source points, transformed by the source transform
+  std::vector<double> Points;
+  // the verts, lines, polys and strips of the source
+  std::vector<vtkIdType> Offsets[4];
+  std::vector<vtkIdType> Connectivity[4];
+  GlyphSize Size;
+
+  void Initialize(vtkPolyData* source, vtkTransform* sourceTransform)
+  {
+    this->Source = source;
+    this->Normals = source->GetPointData()->GetNormals();
+
+    vtkSmartPointer<vtkPoints> points = source->GetPoints();
+    const vtkIdType numPts = points ? points->GetNumberOfPoints() : 0;
+    if (numPts > 0 && sourceTransform)
+    {
+      vtkSmartPointer<vtkPoints> transformedPoints = vtkSmartPointer<vtkPoints>::New();
+      transformedPoints->SetDataTypeToDouble();
+      transformedPoints->Allocate(numPts);
+      sourceTransform->TransformPoints(points, transformedPoints);
+      points = transformedPoints;
+    }
+    this->Points.resize(3 * numPts);
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      points->GetPoint(i, &this->Points[3 * i]);
+    }
+
+    vtkCellArray* cells[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    for (int type = 0; type < 4; ++type)
+    {
+      const vtkIdType numCells = cells[type]->GetNumberOfCells();
+      this->Offsets[type].resize(numCells);
+      this->Connectivity[type].clear();
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cells[type]->GetCellAtId(cellId, npts, pts);
+        this->Offsets[type][cellId] = static_cast<vtkIdType>(this->Connectivity[type].size());
+        this->Connectivity[type].insert(this->Connectivity[type].end(), pts, pts + npts);
+      }
+      this->Size.Cells[type] = numCells;
+      this->Size.Connectivity[type] = static_cast<vtkIdType>(this->Connectivity[type].size());
+    }
+    this->Size.Instances = 1;
+    this->Size.Points = numPts;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Same computation as vtkLinearTransform::TransformPoints(), into a part of
+// an array allocated beforehand.
+template <typename T>
+void TransformGlyphPoints(vtkMatrix4x4* matrix, const std::vector<double>& points, T* out)
+{
+  const double(*m)[4] = matrix->Element;
+  for (size_t i = 0; i < points.size(); i += 3, out += 3)
+  {
+    const double* in = &points[i];
+    out[0] = static_cast<T>(m[0][0] * in[0] + m[0][1] * in[1] + m[0][2] * in[2] + m[0][3]);
+    out[1] = static_cast<T>(m[1][0] * in[0] + m[1][1] * in[1] + m[1][2] * in[2] + m[1][3]);
+    out[2] = static_cast<T>(m[2][0] * in[0] + m[2][1] * in[1] + m[2][2] * in[2] + m[2][3]);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Same computation as vtkLinearTransform::TransformNormals(), into a part of
+// an array allocated beforehand.
+void TransformGlyphNormals(vtkMatrix4x4* matrix, vtkDataArray* normals, vtkIdType numNormals,
+  float* out)
+{
+  // to transform the normals, multiply by the transposed inverse matrix
+  double m[4][4];
+  vtkMatrix4x4::DeepCopy(*m, matrix);
+  vtkMatrix4x4::Invert(*m, *m);
+  vtkMatrix4x4::Transpose(*m, *m);
+
+  numNormals = std::min(numNormals, normals->GetNumberOfTuples());
+  double in[3];
+  for (vtkIdType i = 0; i < numNormals; ++i, out += 3)
+  {
+    normals->GetTuple(i, in);
+    out[0] = static_cast<float>(m[0][0] * in[0] + m[0][1] * in[1] + m[0][2] * in[2]);
+    out[1] = static_cast<float>(m[1][0] * in[0] + m[1][1] * in[1] + m[1][2] * in[2]);
+    out[2] = static_cast<float>(m[2][0] * in[0] + m[2][1] * in[1] + m[2][2] * in[2]);
+    vtkMath::Normalize(out);
+  }
+}
+
+//------------------------------------------------------------------------------
+// The array lists only process numeric arrays. Return the pairs of input and
+// output arrays that must be copied otherwise (e.g., string arrays).
+std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> GetNonNumericArrays(
+  vtkDataSetAttributes* inAttr, vtkDataSetAttributes* outAttr)
+{
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> arrays;
+  for (int i = 0; i < outAttr->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* outArray = outAttr->GetAbstractArray(i);
+    vtkAbstractArray* inArray =
+      (outArray->GetName() ? inAttr->GetAbstractArray(outArray->GetName()) : nullptr);
+    if (inArray && !vtkArrayDownCast<vtkDataArray>(outArray))
+    {
+      arrays.emplace_back(inArray, outArray);
+    }
+  }
+  return arrays;
+}
+}
+
 //------------------------------------------------------------------------------
 // Construct object with scaling on, scaling mode is by scalar value,
 // scale factor = 1.0, the range is (0,1), orient geometry is on, and
@@ -64,6 +227,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->OutputInstances = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
@@ -137,40 +301,25 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  vtkPoints* newPts;
+  vtkIdType numPts;
+  vtkPoints* newPts = nullptr;
   vtkDataArray* newScalars = nullptr;
   vtkDataArray* newVectors = nullptr;
   vtkDataArray* newNormals = nullptr;
   vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
+  vtkDoubleArray* newMatrices = nullptr;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
   vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -197,8 +346,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -220,6 +367,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     haveVectors = 0;
   }
 
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
+  }
+
   if ((this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
     (this->IndexMode == VTK_INDEXING_BY_VECTOR &&
       ((!inVectors && this->VectorMode == VTK_USE_VECTOR) ||
@@ -228,8 +386,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -239,6 +395,13 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     }
   }
 
+  bool instances = this->OutputInstances != 0;
+  if (instances && this->IndexMode != VTK_INDEXING_OFF)
+  {
+    vtkWarningMacro(<< "Instances are not supported with indexing, generating the glyphs.");
+    instances = false;
+  }
+
   // Allocate storage for output PolyData
   //
   outputPD->CopyVectorsOff();
@@ -261,24 +424,21 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Prepare the sources of the glyph table, so that they can be copied
+  // concurrently. Without indexing, only the first source is used.
+  std::vector<GlyphSource> glyphSources;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    glyphSources.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
-      source = this->GetSource(i, sourceVector);
-      if (source != nullptr)
+      vtkPolyData* indexedSource = this->GetSource(i, sourceVector);
+      if (indexedSource != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
+        glyphSources[i].Initialize(indexedSource, this->SourceTransform);
+        if (!glyphSources[i].Normals)
         {
           haveNormals = 0;
         }
@@ -287,19 +447,9 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
-
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
-    {
-      haveNormals = 1;
-    }
-    else
-    {
-      haveNormals = 0;
-    }
+    glyphSources.resize(1);
+    glyphSources[0].Initialize(source, this->SourceTransform);
+    haveNormals = glyphSources[0].Normals ? 1 : 0;
 
     sourceTCoords = source->GetPointData()->GetTCoords();
     if (sourceTCoords)
@@ -311,57 +461,214 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
       haveTCoords = 0;
     }
 
-    // Prepare to copy output.
     pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
+  }
+
+  // Compute the scalar, the vector, the scale and the glyph index of a point.
+  auto computePoint = [&](vtkIdType ptId, double& s, double v[3], double& vMag,
+                        double scale[3]) -> int {
+    s = 0.0;
+    vMag = 0.0;
+    scale[0] = scale[1] = scale[2] = 1.0;
+
+    // Get the scalar and vector data
+    if (inSScalars)
     {
-      outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      s = inSScalars->GetComponent(ptId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
+    }
+
+    if (haveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        vMag = 1.0; // v will be set later
+      }
+      else
+      {
+        v[0] = 0;
+        v[1] = 0;
+        v[2] = 0;
+        array3D->GetTuple(ptId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = vMag;
+        }
+      }
     }
-  }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+    // Clamp data scale if enabled
+    if (this->Clamping)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = (scale[i] < this->Range[0]
+            ? this->Range[0]
+            : (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / den;
+      }
+    }
 
-  newPts = vtkPoints::New();
+    // Compute index into table of glyphs
+    if (this->IndexMode == VTK_INDEXING_OFF)
+    {
+      return 0;
+    }
+    double value = (this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : vMag);
+    int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+    return (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+  };
+
+  // Select the glyph of each point, -1 when the point is not glyphed.
+  // vtkDataSet::GetPoint() is thread safe once it has been called.
+  double x[3];
+  input->GetPoint(0, x);
+  std::vector<int> glyphIds(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double s, v[3], vMag, scale[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      int glyph = computePoint(ptId, s, v, vMag, scale);
+      // Make sure we're not indexing into empty glyph.
+      // Check ghost points: if we are processing a piece, we do not want to
+      // duplicate glyphs on the borders.
+      if (!glyphSources[glyph].Source ||
+        (inGhostLevels &&
+          inGhostLevels[ptId] &
+            (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT)))
+      {
+        glyph = -1;
+      }
+      glyphIds[ptId] = glyph;
+    }
+  });
 
-  // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  // The blanking of uniform grids and IsPointVisible(), which subclasses may
+  // implement without thread safety in mind, are checked serially.
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
   {
-    newPts->SetDataType(VTK_FLOAT);
+    if (glyphIds[ptId] >= 0 &&
+      ((inputUG && !inputUG->IsPointVisible(ptId)) || !this->IsPointVisible(input, ptId)))
+    {
+      glyphIds[ptId] = -1;
+    }
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  this->UpdateProgress(0.1);
+
+  // Compute where the glyph of each point goes in the output.
+  std::vector<GlyphSize> offsets(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const int glyph = glyphIds[ptId];
+      offsets[ptId] = (glyph >= 0 ? glyphSources[glyph].Size : GlyphSize());
+    }
+  });
+  const GlyphSize total =
+    vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), GlyphSize());
+
+  // With instances, the generated arrays hold one tuple per instance instead
+  // of one per glyph point.
+  const vtkIdType numOutTuples = instances ? total.Instances : total.Points;
+
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  vtkIdType cellBase[4] = { 0, 0, 0, 0 };
+  vtkSmartPointer<vtkIdTypeArray> cellOffsets[4];
+  vtkSmartPointer<vtkIdTypeArray> cellConnectivity[4];
+  if (instances)
   {
-    newPts->SetDataType(VTK_FLOAT);
+    newMatrices = vtkDoubleArray::New();
+    newMatrices->SetNumberOfComponents(16);
+    newMatrices->SetNumberOfTuples(numOutTuples);
+    newMatrices->SetName("GlyphMatrix");
   }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  else
   {
-    newPts->SetDataType(VTK_DOUBLE);
+    // Prepare to copy output.
+    if (pd)
+    {
+      outputPD->CopyAllocate(pd, total.Points);
+      pointArrays.AddArrays(total.Points, pd, outputPD, 0.0, false);
+      if (this->FillCellData)
+      {
+        outputCD->CopyGlobalIdsOn();
+        outputCD->CopyAllocate(pd, total.Cells[0] + total.Cells[1] + total.Cells[2] +
+            total.Cells[3]);
+        cellArrays.AddArrays(total.Cells[0] + total.Cells[1] + total.Cells[2] + total.Cells[3],
+          pd, outputCD, 0.0, false);
+      }
+    }
+
+    newPts = vtkPoints::New();
+
+    // Set the desired precision for the points in the output.
+    if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+      newPts->SetDataType(VTK_FLOAT);
+    }
+    else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+      newPts->SetDataType(VTK_FLOAT);
+    }
+    else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+      newPts->SetDataType(VTK_DOUBLE);
+    }
+    newPts->SetNumberOfPoints(total.Points);
+
+    // The cells of the glyphs are sorted by type in the output, as
+    // vtkPolyData numbers them.
+    for (int type = 0; type < 4; ++type)
+    {
+      if (type > 0)
+      {
+        cellBase[type] = cellBase[type - 1] + total.Cells[type - 1];
+      }
+      cellOffsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      cellOffsets[type]->SetNumberOfValues(total.Cells[type] + 1);
+      cellOffsets[type]->SetValue(total.Cells[type], total.Connectivity[type]);
+      cellConnectivity[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      cellConnectivity[type]->SetNumberOfValues(total.Connectivity[type]);
+    }
   }
 
-  newPts->Allocate(numPts * numSourcePts);
   if (this->GeneratePointIds)
   {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
-    outputPD->AddArray(pointIds);
+    pointIds->SetNumberOfValues(numOutTuples);
+    if (instances)
+    {
+      output->GetFieldData()->AddArray(pointIds);
+    }
+    else
+    {
+      outputPD->AddArray(pointIds);
+    }
     pointIds->Delete();
   }
   if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
   {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutTuples);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutTuples);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -371,224 +678,114 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutTuples);
     newScalars->SetName("VectorMagnitude");
   }
   if (haveVectors)
   {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numOutTuples);
     newVectors->SetName("GlyphVector");
   }
-  if (haveNormals)
+  if (haveNormals && !instances)
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(total.Points);
     newNormals->SetName("Normals");
   }
-  if (haveTCoords)
+  if (haveTCoords && !instances)
   {
     newTCoords = vtkFloatArray::New();
     int numComps = sourceTCoords->GetNumberOfComponents();
     newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords->SetNumberOfTuples(total.Points);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  // The instance matrices include the source transform, which is applied to
+  // the source points otherwise.
+  double sourceMatrix[16];
+  if (this->SourceTransform)
+  {
+    vtkMatrix4x4::DeepCopy(sourceMatrix, this->SourceTransform->GetMatrix());
+  }
 
   // Traverse all Input points, transforming Source points and copying
   // point attributes.
   //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
-    {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
-      {
-        break;
-      }
-    }
-
-    // Get the scalar and vector data
-    if (inSScalars)
-    {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = s;
-      }
-    }
-
-    if (haveVectors)
+  vtkSMPThreadLocalObject<vtkTransform> localTransform;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkTransform* trans = localTransform.Local();
+    double point[3], v[3], vNew[3], s, vMag, scale[3], tc[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType inPtId = begin; inPtId < end; inPtId++)
     {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      if (inPtId % checkAbortInterval == 0)
       {
-        vMag = 1.0; // v will be set later
-      }
-      else
-      {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        if (isFirst)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
-          {
-            newPts->Delete();
-          }
-          if (newVectors)
-          {
-            newVectors->Delete();
-          }
-          return false;
+          this->CheckAbort();
         }
-
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
-        {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
-        }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        if (this->GetAbortOutput())
         {
-          scalex = scaley = scalez = vMag;
+          break;
         }
       }
-    }
 
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
+      const int glyph = glyphIds[inPtId];
+      if (glyph < 0)
       {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
+        continue;
       }
+      const GlyphSource& glyphSource = glyphSources[glyph];
+      const GlyphSize& offset = offsets[inPtId];
+      computePoint(inPtId, s, v, vMag, scale);
 
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+      // the generated tuples of this point: its instance or its glyph points
+      const vtkIdType first = instances ? offset.Instances : offset.Points;
+      const vtkIdType count = instances ? 1 : glyphSource.Size.Points;
 
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
+      // Now begin copying/transforming glyph
+      trans->Identity();
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+      // translate Source to Input point
+      input->GetPoint(inPtId, point);
+      trans->Translate(point[0], point[1], point[2]);
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
+      if (haveVectors)
       {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+        const bool followCamera = (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION);
+        if (followCamera)
         {
           // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
+          v[0] = this->FollowedCameraPosition[0] - point[0];
+          v[1] = this->FollowedCameraPosition[1] - point[1];
+          v[2] = this->FollowedCameraPosition[2] - point[2];
           vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
+          if (this->Orient)
+          {
+            double glyphRight_World[3]; // glyph right direction in World coordinate system
+            double glyphUp_World[3];    // glyph up direction in World coordinate system
+            vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+            // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
+            // orthogonal to the normal direction)
+            vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+            double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
+              glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2],
+              glyphUp_World[2], v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+            trans->Concatenate(glyphToWorld);
+          }
         }
-        else if (vMag > 0.0)
+
+        // Copy Input vector
+        for (vtkIdType i = 0; i < count; i++)
+        {
+          newVectors->SetTuple(first + i, v);
+        }
+        if (this->Orient && !followCamera && vMag > 0.0)
         {
           // if there is no y or z component
           if (v[1] == 0.0 && v[2] == 0.0)
@@ -607,125 +804,214 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
           }
         }
       }
-    }
 
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
+      if (newTCoords)
       {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
+        for (vtkIdType i = 0; i < count; i++)
+        {
+          sourceTCoords->GetTuple(i, tc);
+          newTCoords->SetTuple(first + i, tc);
+        }
       }
-    }
 
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
+      // determine scale factor from scalars if appropriate
+      // Copy scalar value
+      if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
       {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
+        for (vtkIdType i = 0; i < count; i++)
+        {
+          newScalars->SetTuple(first + i, scale); // = scaley = scalez
+        }
       }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
+      else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
       {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
+        for (vtkIdType i = 0; i < count; i++)
+        {
+          newScalars->SetTuple(first + i, inPtId, inCScalars);
+        }
       }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
+      if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
       {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
+        for (vtkIdType i = 0; i < count; i++)
+        {
+          newScalars->SetTuple(first + i, &vMag);
+        }
       }
-    }
 
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+      // scale data if appropriate
+      if (this->Scaling)
       {
-        scalex = scaley = scalez = this->ScaleFactor;
+        if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+        {
+          scale[0] = scale[1] = scale[2] = this->ScaleFactor;
+        }
+        else
+        {
+          scale[0] *= this->ScaleFactor;
+          scale[1] *= this->ScaleFactor;
+          scale[2] *= this->ScaleFactor;
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+          if (scale[i] == 0.0)
+          {
+            scale[i] = 1.0e-10;
+          }
+        }
+        trans->Scale(scale[0], scale[1], scale[2]);
       }
-      else
+
+      // If point ids are to be generated, do it here
+      if (pointIds)
+      {
+        for (vtkIdType i = 0; i < count; i++)
+        {
+          pointIds->SetValue(first + i, inPtId);
+        }
+      }
+
+      if (instances)
       {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
+        if (this->SourceTransform)
+        {
+          trans->Concatenate(sourceMatrix);
+        }
+        vtkMatrix4x4::DeepCopy(newMatrices->GetPointer(16 * first), trans->GetMatrix());
+        continue;
       }
 
-      if (scalex == 0.0)
+      // multiply points and normals by resulting matrix
+      vtkMatrix4x4* matrix = trans->GetMatrix();
+      if (newPts->GetDataType() == VTK_DOUBLE)
       {
-        scalex = 1.0e-10;
+        TransformGlyphPoints(matrix, glyphSource.Points,
+          static_cast<vtkDoubleArray*>(newPts->GetData())->GetPointer(3 * first));
       }
-      if (scaley == 0.0)
+      else
       {
-        scaley = 1.0e-10;
+        TransformGlyphPoints(matrix, glyphSource.Points,
+          static_cast<vtkFloatArray*>(newPts->GetData())->GetPointer(3 * first));
       }
-      if (scalez == 0.0)
+      if (newNormals)
       {
-        scalez = 1.0e-10;
+        TransformGlyphNormals(matrix, glyphSource.Normals, count,
+          static_cast<vtkFloatArray*>(newNormals)->GetPointer(3 * first));
       }
-      trans->Scale(scalex, scaley, scalez);
-    }
 
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
+      // Copy all topology (transformation independent)
+      for (int type = 0; type < 4; ++type)
+      {
+        const std::vector<vtkIdType>& sourceOffsets = glyphSource.Offsets[type];
+        const std::vector<vtkIdType>& sourceConnectivity = glyphSource.Connectivity[type];
+        vtkIdType* outOffsets = cellOffsets[type]->GetPointer(offset.Cells[type]);
+        vtkIdType* outConnectivity = cellConnectivity[type]->GetPointer(offset.Connectivity[type]);
+        for (vtkIdType i = 0; i < glyphSource.Size.Cells[type]; ++i)
+        {
+          outOffsets[i] = sourceOffsets[i] + offset.Connectivity[type];
+        }
+        for (size_t i = 0; i < sourceConnectivity.size(); ++i)
+        {
+          outConnectivity[i] = sourceConnectivity[i] + offset.Points;
+        }
+      }
 
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
+      // Copy point data from source (if possible)
+      if (pd)
+      {
+        for (vtkIdType i = 0; i < count; ++i)
+        {
+          pointArrays.Copy(inPtId, first + i);
+        }
+        if (this->FillCellData)
+        {
+          for (int type = 0; type < 4; ++type)
+          {
+            const vtkIdType cellId = cellBase[type] + offset.Cells[type];
+            for (vtkIdType i = 0; i < glyphSource.Size.Cells[type]; ++i)
+            {
+              cellArrays.Copy(inPtId, cellId + i);
+            }
+          }
+        }
+      }
     }
+  });
 
-    // Copy point data from source (if possible)
-    if (pd)
+  // The arrays that the array lists do not handle are copied serially.
+  if (pd && !instances)
+  {
+    for (const auto& arrays : GetNonNumericArrays(pd, outputPD))
     {
-      for (i = 0; i < numSourcePts; ++i)
+      arrays.second->SetNumberOfTuples(total.Points);
+      for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
+        const int glyph = glyphIds[inPtId];
+        for (vtkIdType i = 0; glyph >= 0 && i < glyphSources[glyph].Size.Points; ++i)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          arrays.second->SetTuple(offsets[inPtId].Points + i, inPtId, arrays.first);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
       }
     }
-
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
+    if (this->FillCellData)
     {
-      for (i = 0; i < numSourcePts; i++)
+      for (const auto& arrays : GetNonNumericArrays(pd, outputCD))
       {
-        pointIds->InsertNextValue(inPtId);
+        arrays.second->SetNumberOfTuples(
+          total.Cells[0] + total.Cells[1] + total.Cells[2] + total.Cells[3]);
+        for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+        {
+          const int glyph = glyphIds[inPtId];
+          for (int type = 0; glyph >= 0 && type < 4; ++type)
+          {
+            const vtkIdType cellId = cellBase[type] + offsets[inPtId].Cells[type];
+            for (vtkIdType i = 0; i < glyphSources[glyph].Size.Cells[type]; ++i)
+            {
+              arrays.second->SetTuple(cellId + i, inPtId, arrays.first);
+            }
+          }
+        }
       }
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
   }
 
   // Update ourselves and release memory
   //
+  if (instances)
+  {
+    // the output holds the glyph once, the instances are in its field data
+    output->CopyStructure(source);
+    outputPD->CopyAllOn();
+    outputPD->PassData(source->GetPointData());
+    outputCD->PassData(source->GetCellData());
+    vtkFieldData* instanceData = output->GetFieldData();
+    instanceData->AddArray(newMatrices);
+    newMatrices->Delete();
+    if (newScalars)
+    {
+      instanceData->AddArray(newScalars);
+      newScalars->Delete();
+    }
+    if (newVectors)
+    {
+      instanceData->AddArray(newVectors);
+      newVectors->Delete();
+    }
+    return true;
+  }
+
   output->SetPoints(newPts);
   newPts->Delete();
 
+  vtkNew<vtkCellArray> cells[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    cells[type]->SetData(cellOffsets[type], cellConnectivity[type]);
+  }
+  output->SetVerts(cells[0]);
+  output->SetLines(cells[1]);
+  output->SetPolys(cells[2]);
+  output->SetStrips(cells[3]);
+
   if (newScalars)
   {
     int idx = outputPD->AddArray(newScalars);
@@ -752,8 +1038,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
 
   output->Squeeze();
-  trans->Delete();
-  pts->Delete();
 
   return true;
 }
@@ -905,6 +1189,7 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Output Instances: " << (this->OutputInstances ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
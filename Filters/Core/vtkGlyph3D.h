@@ -73,6 +73,12 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ * IsPointVisible() is still invoked serially.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -302,6 +308,23 @@ public:
   vtkBooleanMacro(FillCellData, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Enable/disable the output of instances instead of glyph geometry. When
+   * on, the output holds a single copy of the source, and each glyphed input
+   * point is an instance described in the output field data: its 4x4
+   * transformation matrix, row by row, is in the "GlyphMatrix" array, along
+   * with its scalars, vector and point id when they are generated. This is
+   * much more compact for consumers that do not need the glyphs copied at each
+   * point, e.g., instanced rendering. The source transform is included in the
+   * matrices, and FillCellData is ignored. Instances are not supported with
+   * indexing, for which the glyph geometry is generated. Default is off.
+   */
+  vtkSetMacro(OutputInstances, vtkTypeBool);
+  vtkGetMacro(OutputInstances, vtkTypeBool);
+  vtkBooleanMacro(OutputInstances, vtkTypeBool);
+  ///@}
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
@@ -369,6 +392,7 @@ protected:
   int IndexMode;                  // what to use to index into glyph table
   vtkTypeBool GeneratePointIds;   // produce input points ids for each output point
   vtkTypeBool FillCellData;       // whether to fill output cell data
+  vtkTypeBool OutputInstances;    // whether to output instances instead of glyphs
   char* PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkContourSlabsInternal.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkGridSynchronizedTemplates3D.h"
@@ -30,6 +31,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygonBuilder.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -40,6 +42,7 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGridSynchronizedTemplates3D);
@@ -413,23 +416,27 @@ private:
 }
 
 //------------------------------------------------------------------------------
-// Contouring filter specialized for structured grids
+// Contouring filter specialized for structured grids. Contours the execute
+// extent exExt with the contour values [vidxBegin, vidxEnd). When contouring
+// a slab of the extent, seam records the intersections of the planes shared
+// with the neighbouring slabs.
 template <class T, class PointsType>
 void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
   vtkStructuredGrid* input, vtkPolyData* output, PointsType*, vtkDataArray* inScalars,
-  bool outputTriangles)
+  bool outputTriangles, const CellVisibility& isCellVisible, vtkIdType vidxBegin,
+  vtkIdType vidxEnd, vtkContourSlabSeam* seam, bool isFirst)
 {
   int* inExt = input->GetExtent();
   int xdim = exExt[1] - exExt[0] + 1;
   int ydim = exExt[3] - exExt[2] + 1;
   double n0[3], n1[3]; // used in gradient macro
   double* values = self->GetValues();
-  vtkIdType numContours = self->GetNumberOfContours();
   PointsType *inPtPtrX, *inPtPtrY, *inPtPtrZ;
   PointsType *p0, *p1, *p2, *p3;
   T *inPtrX, *inPtrY, *inPtrZ;
   T *s0, *s1, *s2, *s3;
   int XMin, XMax, YMin, YMax, ZMin, ZMax;
+  int ZReuseMin;
   int incY, incZ;
   PointsType* points = static_cast<PointsType*>(input->GetPoints()->GetData()->GetVoidPointer(0));
   double t;
@@ -451,7 +458,6 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
   vtkIdType edgePtId, inCellId, outCellId;
   vtkPointData* inPD = input->GetPointData();
   vtkCellData* inCD = input->GetCellData();
-  CellVisibility isCellVisible(input);
   vtkPointData* outPD = output->GetPointData();
   vtkCellData* outCD = output->GetCellData();
   // Temporary point data.
@@ -492,6 +498,8 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
   YMax = exExt[3];
   ZMin = exExt[4];
   ZMax = exExt[5];
+  // the points of the plane below a seam may be reused
+  ZReuseMin = (seam && seam->HasPrevious ? ZMin - 1 : ZMin);
   // to skip over an x row of the input.
   incY = inExt[1] - inExt[0] + 1;
   // to skip over an xy slice of the input.
@@ -533,7 +541,7 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
 
   int checkAbortInterval = std::min((XMax - XMin) / 10 + 1, 1000);
   // for each contour
-  for (vidx = 0; vidx < numContours && !abort; vidx++)
+  for (vidx = vidxBegin; vidx < vidxEnd && !abort; vidx++)
   {
     value = values[vidx];
     //  skip any slices which are overlap for computing gradients.
@@ -541,6 +549,12 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
       points + 3 * ((ZMin - inExt[4]) * incZ + (YMin - inExt[2]) * incY + (XMin - inExt[0]));
     inPtrZ = scalars + ((ZMin - inExt[4]) * incZ + (YMin - inExt[2]) * incY + (XMin - inExt[0]));
     s2 = inPtrZ;
+    if (seam && seam->HasPrevious)
+    {
+      seam->ForeignBase = VTK_INT_MAX - zstep;
+      vtkContourSlabsFillSeam(inPtrZ - incZ, xdim, ydim, 1, incY, incZ, value, seam->ForeignBase,
+        isect1.data() + (ZMin % 2 ? 0 : zstep * 3));
+    }
 
     //==================================================================
     for (k = ZMin; k <= ZMax && !abort; k++)
@@ -564,6 +578,10 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
         isect1Ptr = isect1.data() + xdim * ydim * 3;
         isect2Ptr = isect1.data();
       }
+      if (seam && seam->HasNext && k == ZMax)
+      {
+        seam->LastPlaneFirstPoint = newPts->GetNumberOfPoints();
+      }
 
       inPtPtrY = inPtPtrZ;
       inPtrY = inPtrZ;
@@ -585,7 +603,8 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
         // inCellId is ised to keep track of ids for copying cell attributes.
         for (i = XMin; i <= XMax; i++, inCellId++)
         {
-          if (i % checkAbortInterval == 0 && self->CheckAbort())
+          if (i % checkAbortInterval == 0 &&
+            (isFirst ? self->CheckAbort() : self->GetAbortOutput()))
           {
             abort = true;
             break;
@@ -612,11 +631,11 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
                 {
                   *isect2Ptr = *(isect2Ptr - 3);
                 }
-                else if (j > XMin && *(isect2Ptr - yisectstep + 1) > -1)
+                else if (j > YMin && *(isect2Ptr - yisectstep + 1) > -1)
                 {
                   *isect2Ptr = *(isect2Ptr - yisectstep + 1);
                 }
-                else if (k > ZMin && *(isect1Ptr + 2) > -1)
+                else if (k > ZReuseMin && *(isect1Ptr + 2) > -1)
                 {
                   *isect2Ptr = *(isect1Ptr + 2);
                 }
@@ -627,7 +646,7 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
                 {
                   *isect2Ptr = *(isect2Ptr - yisectstep + 4);
                 }
-                else if (k > ZMin && i<XMax&&*(isect1Ptr + 5)> - 1)
+                else if (k > ZReuseMin && i<XMax&&*(isect1Ptr + 5)> - 1)
                 {
                   *isect2Ptr = *(isect1Ptr + 5);
                 }
@@ -668,12 +687,12 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
                 {
                   *(isect2Ptr + 1) = *(isect2Ptr - yisectstep + 1);
                 }
-                else if (k > ZMin && *(isect1Ptr + 2) > -1)
+                else if (k > ZReuseMin && *(isect1Ptr + 2) > -1)
                 {
                   *(isect2Ptr + 1) = *(isect1Ptr + 2);
                 }
               }
-              else if (*s2 == value && k > ZMin && *(isect1Ptr + yisectstep + 2) > -1)
+              else if (*s2 == value && k > ZReuseMin && *(isect1Ptr + yisectstep + 2) > -1)
               {
                 *(isect2Ptr + 1) = *(isect1Ptr + yisectstep + 2);
               }
@@ -717,7 +736,7 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
                 {
                   *(isect2Ptr + 2) = *(isect2Ptr - yisectstep + 1);
                 }
-                else if (k > ZMin && *(isect1Ptr + 2) > -1)
+                else if (k > ZReuseMin && *(isect1Ptr + 2) > -1)
                 {
                   *(isect2Ptr + 2) = *(isect1Ptr + 2);
                 }
@@ -814,10 +833,22 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
         inPtPtrY += 3 * incY;
         inPtrY += incY;
       }
+      if (seam && seam->HasPrevious && k == ZMin)
+      {
+        seam->FirstPlane.assign(isect2Ptr - zstep * 3, isect2Ptr);
+      }
       inPtPtrZ += 3 * incZ;
       inPtrZ += incZ;
     }
   }
+  if (seam && seam->HasNext)
+  {
+    // the buffers of the last plane and of the plane below
+    const int* lastPlane = isect1.data() + (ZMax % 2 ? zstep * 3 : 0);
+    const int* previousPlane = isect1.data() + (ZMax % 2 ? 0 : zstep * 3);
+    seam->LastPlane.assign(lastPlane, lastPlane + zstep * 3);
+    seam->PreviousPlane.assign(previousPlane, previousPlane + zstep * 3);
+  }
 
   if (newScalars)
   {
@@ -841,14 +872,64 @@ void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
   }
 }
 
+//------------------------------------------------------------------------------
+// Contour each contour value of slabs of k-planes concurrently, and merge
+// them into the output in the order of the serial algorithm.
+template <class T, class PointsType>
+void ContourGridSlabs(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
+  vtkStructuredGrid* input, vtkPolyData* output, PointsType* pointsType, vtkDataArray* inScalars,
+  bool outputTriangles)
+{
+  CellVisibility isCellVisible(input);
+  const vtkIdType numContours = self->GetNumberOfContours();
+  const int numSlabs = vtkContourSlabsNumberOfSlabs(exExt[5] - exExt[4]);
+  if (numSlabs == 1 || numContours == 0)
+  {
+    ContourGrid(self, exExt, scalars, input, output, pointsType, inScalars, outputTriangles,
+      isCellVisible, 0, numContours, nullptr, true);
+    return;
+  }
+
+  std::vector<vtkContourSlab> slabs(numContours * numSlabs);
+  std::vector<vtkContourSlabSeam> seams(slabs.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(slabs.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType task = begin; task < end; ++task)
+      {
+        const vtkIdType vidx = task / numSlabs;
+        const int slab = static_cast<int>(task % numSlabs);
+        int slabExt[6] = { exExt[0], exExt[1], exExt[2], exExt[3], 0, 0 };
+        vtkContourSlabsGetSlab(exExt[4], exExt[5], numSlabs, slab, slabExt[4], slabExt[5]);
+        seams[task].HasPrevious = slab > 0;
+        seams[task].HasNext = slab < numSlabs - 1;
+        slabs[task].Output = vtkSmartPointer<vtkPolyData>::New();
+        ContourGrid(self, slabExt, scalars, input, slabs[task].Output.Get(), pointsType,
+          inScalars, outputTriangles, isCellVisible, vidx, vidx + 1, &seams[task], isFirst);
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
+      }
+    });
+  if (self->GetAbortOutput())
+  {
+    return;
+  }
+
+  vtkContourSlabsMapSeams(slabs, seams);
+  vtkContourSlabsMerge(slabs, output);
+}
+
 template <class T>
 void ContourGrid(vtkGridSynchronizedTemplates3D* self, int* exExt, T* scalars,
   vtkStructuredGrid* input, vtkPolyData* output, vtkDataArray* inScalars, bool outputTriangles)
 {
   switch (input->GetPoints()->GetData()->GetDataType())
   {
-    vtkTemplateMacro(ContourGrid(self, exExt, scalars, input, output, static_cast<VTK_TT*>(nullptr),
-      inScalars, outputTriangles));
+    vtkTemplateMacro(ContourGridSlabs(self, exExt, scalars, input, output,
+      static_cast<VTK_TT*>(nullptr), inScalars, outputTriangles));
   }
 }
 
@@ -928,7 +1009,10 @@ void vtkGridSynchronizedTemplates3D::ThreadedExecute(
   if (this->ComputeScalars)
   {
     vtkDataArray* outScalars = output->GetPointData()->GetScalars();
-    outScalars->SetName(inScalars->GetName());
+    if (outScalars) // not when aborted while contouring slabs
+    {
+      outScalars->SetName(inScalars->GetName());
+    }
   }
 }
 
@@ -17,6 +17,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
 #include "vtkCharArray.h"
+#include "vtkContourSlabsInternal.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
@@ -32,6 +33,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredPoints.h"
@@ -40,6 +42,10 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkMarchingCubes);
 
@@ -162,8 +168,9 @@ struct ComputeGradientWorker
 {
   template <class ScalarArrayT>
   void operator()(ScalarArrayT* scalarsArray, vtkMarchingCubes* self, int dims[3],
-    vtkIncrementalPointLocator* locator, vtkDataArray* newScalars, vtkDataArray* newGradients,
-    vtkDataArray* newNormals, vtkCellArray* newPolys, double* values, vtkIdType numValues) const
+    const int extent[6], int kBegin, int kEnd, bool isFirst, vtkIncrementalPointLocator* locator,
+    vtkDataArray* newScalars, vtkDataArray* newGradients, vtkDataArray* newNormals,
+    vtkCellArray* newPolys, double* values, vtkIdType numValues) const
   {
     const auto scalars = vtk::DataArrayValueRange<1>(scalarsArray);
 
@@ -180,15 +187,11 @@ struct ComputeGradientWorker
     vtkTypeBool ComputeGradients = newGradients != nullptr;
     vtkTypeBool ComputeScalars = newScalars != nullptr;
     int NeedGradients;
-    int extent[6];
     double t, *x1, *x2, x[3], *n1, *n2, n[3], min, max;
     double pts[8][3], gradients[8][3], xp, yp, zp;
     static int edges[12][2] = { { 0, 1 }, { 1, 2 }, { 3, 2 }, { 0, 3 }, { 4, 5 }, { 5, 6 },
       { 7, 6 }, { 4, 7 }, { 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 } };
 
-    vtkInformation* inInfo = self->GetExecutive()->GetInputInformation(0, 0);
-    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
-
     triCases = vtkMarchingCubesTriangleCases::GetCases();
 
     //
@@ -211,17 +214,27 @@ struct ComputeGradientWorker
       }
     }
     //
-    // Traverse all voxel cells, generating triangles and point gradients
-    // using marching cubes algorithm.
+    // Traverse the voxel cells of layers [kBegin, kEnd), generating triangles
+    // and point gradients using marching cubes algorithm.
     //
     sliceSize = dims[0] * dims[1];
     int checkAbortInterval = std::min((dims[2] - 1) / 10 + 1, 1000);
-    for (k = 0; k < (dims[2] - 1); k++)
+    for (k = kBegin; k < kEnd; k++)
     {
-      self->UpdateProgress(k / static_cast<double>(dims[2] - 1));
-      if (k % checkAbortInterval == 0 && self->CheckAbort())
+      if (isFirst)
       {
-        break;
+        self->UpdateProgress(k / static_cast<double>(dims[2] - 1));
+      }
+      if (k % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          self->CheckAbort();
+        }
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
       }
       kOffset = k * sliceSize;
       pts[0][2] = k + extent[4];
@@ -374,84 +387,20 @@ struct ComputeGradientWorker
   }
 };
 
-} // end anon namespace
-
-//
-// Contouring filter specialized for volumes and "short int" data values.
-//
-int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+//------------------------------------------------------------------------------
+// Contour the layers [kBegin, kEnd) of voxel cells into output, merging the
+// points with the given locator.
+void vtkMarchingCubesContour(vtkMarchingCubes* self, vtkDataArray* inScalars, int dims[3],
+  const int extent[6], int kBegin, int kEnd, bool isFirst, vtkIncrementalPointLocator* locator,
+  vtkIdType estimatedSize, vtkPolyData* output)
 {
-  // get the info objects
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
-
-  // get the input and output
-  vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
-  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
-
   vtkPoints* newPts;
   vtkCellArray* newPolys;
   vtkFloatArray* newScalars;
   vtkFloatArray* newNormals;
   vtkFloatArray* newGradients;
-  vtkPointData* pd;
-  vtkDataArray* inScalars;
-  int dims[3], extent[6];
-  vtkIdType estimatedSize;
   double bounds[6];
-  vtkIdType numContours = this->ContourValues->GetNumberOfContours();
-  double* values = this->ContourValues->GetValues();
 
-  vtkDebugMacro(<< "Executing marching cubes");
-
-  //
-  // Initialize and check input
-  //
-  pd = input->GetPointData();
-  if (pd == nullptr)
-  {
-    vtkErrorMacro(<< "PointData is nullptr");
-    return 1;
-  }
-  vtkInformationVector* inArrayVec = this->Information->Get(INPUT_ARRAYS_TO_PROCESS());
-  if (inArrayVec)
-  { // we have been passed an input array
-    inScalars = this->GetInputArrayToProcess(0, inputVector);
-  }
-  else
-  {
-    inScalars = pd->GetScalars();
-  }
-  if (inScalars == nullptr)
-  {
-    vtkErrorMacro(<< "Scalars must be defined for contouring");
-    return 1;
-  }
-
-  if (inScalars->GetNumberOfComponents() != 1)
-  {
-    vtkErrorMacro("Scalar array must only have a single component.");
-    return 1;
-  }
-
-  if (input->GetDataDimension() != 3)
-  {
-    vtkErrorMacro(<< "Cannot contour data of dimension != 3");
-    return 1;
-  }
-  input->GetDimensions(dims);
-
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
-
-  // estimate the number of points from the volume dimensions
-  estimatedSize = static_cast<vtkIdType>(pow(1.0 * dims[0] * dims[1] * dims[2], 0.75));
-  estimatedSize = estimatedSize / 1024 * 1024; // multiple of 1024
-  if (estimatedSize < 1024)
-  {
-    estimatedSize = 1024;
-  }
-  vtkDebugMacro(<< "Estimated allocation size is " << estimatedSize);
   newPts = vtkPoints::New();
   newPts->Allocate(estimatedSize, estimatedSize / 2);
   // compute bounds for merging points
@@ -460,13 +409,11 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     bounds[2 * i] = extent[2 * i];
     bounds[2 * i + 1] = extent[2 * i + 1];
   }
-  if (this->Locator == nullptr)
-  {
-    this->CreateDefaultLocator();
-  }
-  this->Locator->InitPointInsertion(newPts, bounds, estimatedSize);
+  bounds[4] = extent[4] + kBegin;
+  bounds[5] = extent[4] + kEnd;
+  locator->InitPointInsertion(newPts, bounds, estimatedSize);
 
-  if (this->ComputeNormals)
+  if (self->GetComputeNormals())
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
@@ -477,7 +424,7 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     newNormals = nullptr;
   }
 
-  if (this->ComputeGradients)
+  if (self->GetComputeGradients())
   {
     newGradients = vtkFloatArray::New();
     newGradients->SetNumberOfComponents(3);
@@ -491,7 +438,7 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
   newPolys = vtkCellArray::New();
   newPolys->AllocateEstimate(estimatedSize, 3);
 
-  if (this->ComputeScalars)
+  if (self->GetComputeScalars())
   {
     newScalars = vtkFloatArray::New();
     newScalars->Allocate(estimatedSize, estimatedSize / 2);
@@ -501,17 +448,17 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     newScalars = nullptr;
   }
 
+  double* values = self->GetValues();
+  vtkIdType numContours = self->GetNumberOfContours();
   using Dispatcher = vtkArrayDispatch::Dispatch;
   ComputeGradientWorker worker;
-  if (!Dispatcher::Execute(inScalars, worker, this, dims, this->Locator, newScalars, newGradients,
-        newNormals, newPolys, values, numContours))
+  if (!Dispatcher::Execute(inScalars, worker, self, dims, extent, kBegin, kEnd, isFirst, locator,
+        newScalars, newGradients, newNormals, newPolys, values, numContours))
   { // Fallback to slow path for unknown arrays:
-    worker(inScalars, this, dims, this->Locator, newScalars, newGradients, newNormals, newPolys,
-      values, numContours);
+    worker(inScalars, self, dims, extent, kBegin, kEnd, isFirst, locator, newScalars, newGradients,
+      newNormals, newPolys, values, numContours);
   }
 
-  vtkDebugMacro(<< "Created: " << newPts->GetNumberOfPoints() << " points, "
-                << newPolys->GetNumberOfCells() << " triangles");
   //
   // Update ourselves.  Because we don't know up front how many triangles
   // we've created, take care to reclaim memory.
@@ -538,11 +485,204 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->SetNormals(newNormals);
     newNormals->Delete();
   }
-  output->Squeeze();
-  if (this->Locator)
+  locator->Initialize(); // free storage
+}
+
+//------------------------------------------------------------------------------
+// Contour slabs of layers of voxel cells concurrently, each with its own
+// vtkMergePoints. A point of the plane shared by two slabs is merged by its
+// coordinates, as the locator does when contouring the whole volume, so the
+// merged output is the same.
+void vtkMarchingCubesContourSlabs(vtkMarchingCubes* self, vtkDataArray* inScalars, int dims[3],
+  const int extent[6], int numSlabs, vtkIdType estimatedSize, vtkPolyData* output)
+{
+  std::vector<vtkContourSlab> slabs(numSlabs);
+  vtkSMPTools::For(0, numSlabs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType slab = begin; slab < end; ++slab)
+      {
+        int kBegin, kEnd;
+        vtkContourSlabsGetSlab(0, dims[2] - 1, numSlabs, slab, kBegin, kEnd);
+        vtkNew<vtkMergePoints> locator;
+        slabs[slab].Output = vtkSmartPointer<vtkPolyData>::New();
+        vtkMarchingCubesContour(self, inScalars, dims, extent, kBegin, kEnd, isFirst, locator,
+          estimatedSize / numSlabs + 1024, slabs[slab].Output);
+      }
+    });
+
+  // Find the points of each slab which lie on the plane shared with the
+  // previous slab, and were already inserted by it.
+  std::vector<std::vector<std::pair<vtkIdType, vtkIdType>>> seamPoints(numSlabs);
+  vtkSMPTools::For(1, numSlabs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType slab = begin; slab < end; ++slab)
+      {
+        int kBegin, kEnd;
+        vtkContourSlabsGetSlab(0, dims[2] - 1, numSlabs, slab, kBegin, kEnd);
+        const double z = extent[4] + kBegin;
+        double x[3];
+        std::map<std::pair<double, double>, vtkIdType> previousPoints;
+        vtkPoints* points = slabs[slab - 1].Output->GetPoints();
+        for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+        {
+          points->GetPoint(ptId, x);
+          if (x[2] == z)
+          {
+            previousPoints.emplace(std::make_pair(x[0], x[1]), ptId);
+          }
+        }
+        points = slabs[slab].Output->GetPoints();
+        for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+        {
+          points->GetPoint(ptId, x);
+          if (x[2] == z)
+          {
+            auto previous = previousPoints.find(std::make_pair(x[0], x[1]));
+            if (previous != previousPoints.end())
+            {
+              seamPoints[slab].emplace_back(ptId, previous->second);
+            }
+          }
+        }
+      }
+    });
+
+  for (int slab = 0; slab < numSlabs; ++slab)
   {
-    this->Locator->Initialize(); // free storage
+    slabs[slab].NumberOfPoints = slabs[slab].Output->GetNumberOfPoints() -
+      static_cast<vtkIdType>(seamPoints[slab].size());
   }
+  vtkContourSlabsComputeOffsets(slabs);
+
+  // Number the points owned by each slab, then map the seam points to the
+  // points of the previous slab.
+  vtkSMPTools::For(0, numSlabs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType slab = begin; slab < end; ++slab)
+      {
+        std::vector<vtkIdType>& pointMap = slabs[slab].PointMap;
+        pointMap.assign(slabs[slab].Output->GetNumberOfPoints(), 0);
+        for (const auto& seamPoint : seamPoints[slab])
+        {
+          pointMap[seamPoint.first] = -1;
+        }
+        vtkIdType outPtId = slabs[slab].PointOffset;
+        for (vtkIdType& id : pointMap)
+        {
+          id = (id < 0 ? -1 : outPtId++);
+        }
+      }
+    });
+  vtkSMPTools::For(1, numSlabs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType slab = begin; slab < end; ++slab)
+      {
+        for (const auto& seamPoint : seamPoints[slab])
+        {
+          slabs[slab].PointMap[seamPoint.first] = slabs[slab - 1].PointMap[seamPoint.second];
+        }
+      }
+    });
+
+  vtkContourSlabsMerge(slabs, output);
+}
+
+} // end anon namespace
+
+//
+// Contouring filter specialized for volumes and "short int" data values.
+//
+int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkPointData* pd;
+  vtkDataArray* inScalars;
+  int dims[3], extent[6];
+  vtkIdType estimatedSize;
+
+  vtkDebugMacro(<< "Executing marching cubes");
+
+  //
+  // Initialize and check input
+  //
+  pd = input->GetPointData();
+  if (pd == nullptr)
+  {
+    vtkErrorMacro(<< "PointData is nullptr");
+    return 1;
+  }
+  vtkInformationVector* inArrayVec = this->Information->Get(INPUT_ARRAYS_TO_PROCESS());
+  if (inArrayVec)
+  { // we have been passed an input array
+    inScalars = this->GetInputArrayToProcess(0, inputVector);
+  }
+  else
+  {
+    inScalars = pd->GetScalars();
+  }
+  if (inScalars == nullptr)
+  {
+    vtkErrorMacro(<< "Scalars must be defined for contouring");
+    return 1;
+  }
+
+  if (inScalars->GetNumberOfComponents() != 1)
+  {
+    vtkErrorMacro("Scalar array must only have a single component.");
+    return 1;
+  }
+
+  if (input->GetDataDimension() != 3)
+  {
+    vtkErrorMacro(<< "Cannot contour data of dimension != 3");
+    return 1;
+  }
+  input->GetDimensions(dims);
+
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+
+  // estimate the number of points from the volume dimensions
+  estimatedSize = static_cast<vtkIdType>(pow(1.0 * dims[0] * dims[1] * dims[2], 0.75));
+  estimatedSize = estimatedSize / 1024 * 1024; // multiple of 1024
+  if (estimatedSize < 1024)
+  {
+    estimatedSize = 1024;
+  }
+  vtkDebugMacro(<< "Estimated allocation size is " << estimatedSize);
+  if (this->Locator == nullptr)
+  {
+    this->CreateDefaultLocator();
+  }
+
+  // The slabs can only be merged like the default locator merges points.
+  const int numSlabs =
+    vtkMergePoints::SafeDownCast(this->Locator) ? vtkContourSlabsNumberOfSlabs(dims[2] - 1) : 1;
+  if (numSlabs > 1 && this->GetNumberOfContours() > 0)
+  {
+    vtkMarchingCubesContourSlabs(this, inScalars, dims, extent, numSlabs, estimatedSize, output);
+  }
+  else
+  {
+    vtkMarchingCubesContour(this, inScalars, dims, extent, 0, dims[2] - 1, true, this->Locator,
+      estimatedSize, output);
+  }
+
+  vtkDebugMacro(<< "Created: " << output->GetNumberOfPoints() << " points, "
+                << output->GetNumberOfPolys() << " triangles");
+  output->Squeeze();
 
   vtkImageTransform::TransformPointSet(input, output);
 
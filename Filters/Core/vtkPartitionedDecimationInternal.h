@@ -0,0 +1,450 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPartitionedDecimationInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPartitionedDecimationInternal
+ * @brief   threaded decimation of triangle meshes by spatial partitioning
+ *
+ * vtkPartitionedDecimationInternal implements a parallel decimation
+ * strategy shared by vtkDecimatePro and vtkQuadricDecimation. The triangles
+ * are spatially partitioned with a recursive coordinate bisection of their
+ * centroids. Each partition is then decimated independently (and
+ * concurrently with vtkSMPTools) while its boundary points are locked, so
+ * that the partitions still match along their common boundaries. The
+ * partitions are merged, and a second pass decimates the band of triangles
+ * adjacent to the seams between partitions (seam points are free, the
+ * boundary of the band is locked). Finally, if the requested reduction has
+ * still not been reached, the whole mesh is decimated serially to honor the
+ * target reduction.
+ *
+ * The decimation of each partition is delegated to an instance of the
+ * calling filter, produced by a factory functor with the signature
+ * vtkSmartPointer<vtkPolyDataAlgorithm>(double reduction, bool lockBoundary).
+ * For a given number of partitions, the output does not depend on the number
+ * of threads nor on their scheduling.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkDecimatePro vtkQuadricDecimation
+ */
+
+#ifndef vtkPartitionedDecimationInternal_h
+#define vtkPartitionedDecimationInternal_h
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Automatic partitioning does not create partitions smaller than this.
+const vtkIdType DECIMATION_MIN_AUTO_PARTITION_SIZE = 10000;
+
+// Name of the temporary cell data array tracking the partition of each cell.
+const char* const DECIMATION_PARTITION_ARRAY = "vtkDecimationPartitionId";
+
+// Name of the temporary point data array tracking the id of each point in the
+// input of the partitioned decimation. It is used to merge the pieces back.
+const char* const DECIMATION_POINT_ID_ARRAY = "vtkDecimationPointId";
+
+//------------------------------------------------------------------------------
+// Recursive coordinate bisection of the cells by their centroids. Cells are
+// ordered by (coordinate, cell id) so that the result is deterministic.
+inline void BisectCells(std::vector<vtkIdType>& cellIds, const std::vector<double>& centroids,
+  vtkIdType begin, vtkIdType end, int numParts, int firstPart, std::vector<int>& partIds)
+{
+  if (numParts <= 1 || end - begin < 2)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      partIds[cellIds[i]] = firstPart;
+    }
+    return;
+  }
+
+  double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+    VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (vtkIdType i = begin; i < end; ++i)
+  {
+    const double* c = centroids.data() + 3 * cellIds[i];
+    for (int j = 0; j < 3; ++j)
+    {
+      bounds[2 * j] = std::min(bounds[2 * j], c[j]);
+      bounds[2 * j + 1] = std::max(bounds[2 * j + 1], c[j]);
+    }
+  }
+  int axis = 0;
+  for (int j = 1; j < 3; ++j)
+  {
+    if (bounds[2 * j + 1] - bounds[2 * j] > bounds[2 * axis + 1] - bounds[2 * axis])
+    {
+      axis = j;
+    }
+  }
+
+  const int numLeftParts = numParts / 2;
+  const vtkIdType mid = begin + (end - begin) * numLeftParts / numParts;
+  std::nth_element(cellIds.begin() + begin, cellIds.begin() + mid, cellIds.begin() + end,
+    [&](vtkIdType a, vtkIdType b) {
+      const double ca = centroids[3 * a + axis];
+      const double cb = centroids[3 * b + axis];
+      return ca < cb || (ca == cb && a < b);
+    });
+  BisectCells(cellIds, centroids, begin, mid, numLeftParts, firstPart, partIds);
+  BisectCells(cellIds, centroids, mid, end, numParts - numLeftParts, firstPart + numLeftParts,
+    partIds);
+}
+
+//------------------------------------------------------------------------------
+// Extract the given polygons of the input into a new polydata, renumbering
+// the points (and copying the point data) of the extracted polygons. If the
+// input does not track the original point ids yet, they are added to the
+// point data of the output.
+inline vtkSmartPointer<vtkPolyData> ExtractPolys(
+  vtkPolyData* input, const std::vector<vtkIdType>& cellIds)
+{
+  vtkCellArray* inPolys = input->GetPolys();
+  auto iter = vtk::TakeSmartPointer(inPolys->NewIterator());
+  vtkIdType npts;
+  const vtkIdType* pts;
+
+  // Gather the points used by the polygons.
+  std::vector<vtkIdType> ptIds;
+  vtkIdType connSize = 0;
+  for (vtkIdType cellId : cellIds)
+  {
+    iter->GetCellAtId(cellId, npts, pts);
+    ptIds.insert(ptIds.end(), pts, pts + npts);
+    connSize += npts;
+  }
+  std::sort(ptIds.begin(), ptIds.end());
+  ptIds.erase(std::unique(ptIds.begin(), ptIds.end()), ptIds.end());
+  const vtkIdType numPts = static_cast<vtkIdType>(ptIds.size());
+
+  vtkNew<vtkCellArray> polys;
+  polys->AllocateExact(static_cast<vtkIdType>(cellIds.size()), connSize);
+  std::vector<vtkIdType> newPts;
+  for (vtkIdType cellId : cellIds)
+  {
+    iter->GetCellAtId(cellId, npts, pts);
+    newPts.resize(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      newPts[i] = std::lower_bound(ptIds.begin(), ptIds.end(), pts[i]) - ptIds.begin();
+    }
+    polys->InsertNextCell(npts, newPts.data());
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(numPts);
+  vtkPointData* inPD = input->GetPointData();
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numPts);
+  double x[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    input->GetPoint(ptIds[i], x);
+    points->SetPoint(i, x);
+    outPD->CopyData(inPD, ptIds[i], i);
+  }
+  if (!inPD->GetArray(DECIMATION_POINT_ID_ARRAY))
+  {
+    vtkNew<vtkIdTypeArray> origIds;
+    origIds->SetName(DECIMATION_POINT_ID_ARRAY);
+    origIds->SetNumberOfTuples(numPts);
+    std::copy(ptIds.begin(), ptIds.end(), origIds->GetPointer(0));
+    outPD->AddArray(origIds);
+  }
+  output->SetPoints(points);
+  output->SetPolys(polys);
+  return output;
+}
+
+//------------------------------------------------------------------------------
+// Append the pieces and merge the points sharing the same original point id
+// (coincident points with distinct ids are left alone). The merged points are
+// ordered by original id. Cell data added to the pieces is carried over.
+inline vtkSmartPointer<vtkPolyData> MergePieces(
+  const std::vector<vtkSmartPointer<vtkPolyData>>& pieces)
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (const auto& piece : pieces)
+  {
+    append->AddInputData(piece);
+  }
+  append->Update();
+  vtkPolyData* appended = append->GetOutput();
+  vtkPointData* inPD = appended->GetPointData();
+  vtkIdTypeArray* origIds =
+    vtkIdTypeArray::SafeDownCast(inPD->GetArray(DECIMATION_POINT_ID_ARRAY));
+  const vtkIdType numAppendedPts = appended->GetNumberOfPoints();
+
+  // Map the appended points to the merged points, keeping the first appended
+  // point of each original id.
+  std::vector<vtkIdType> order(numAppendedPts);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+    [&](vtkIdType a, vtkIdType b) { return origIds->GetValue(a) < origIds->GetValue(b); });
+  std::vector<vtkIdType> pointMap(numAppendedPts);
+  std::vector<vtkIdType> srcIds;
+  for (vtkIdType i = 0; i < numAppendedPts; ++i)
+  {
+    const vtkIdType ptId = order[i];
+    if (i == 0 || origIds->GetValue(ptId) != origIds->GetValue(order[i - 1]))
+    {
+      srcIds.push_back(ptId);
+    }
+    pointMap[ptId] = static_cast<vtkIdType>(srcIds.size()) - 1;
+  }
+  const vtkIdType numPts = static_cast<vtkIdType>(srcIds.size());
+
+  auto merged = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(appended->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(numPts);
+  vtkPointData* outPD = merged->GetPointData();
+  outPD->CopyAllocate(inPD, numPts);
+  double x[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    appended->GetPoint(srcIds[i], x);
+    points->SetPoint(i, x);
+    outPD->CopyData(inPD, srcIds[i], i);
+  }
+
+  vtkCellArray* inPolys = appended->GetPolys();
+  vtkNew<vtkCellArray> polys;
+  polys->AllocateExact(inPolys->GetNumberOfCells(), inPolys->GetNumberOfConnectivityIds());
+  auto iter = vtk::TakeSmartPointer(inPolys->NewIterator());
+  std::vector<vtkIdType> newPts;
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    newPts.resize(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      newPts[i] = pointMap[pts[i]];
+    }
+    polys->InsertNextCell(npts, newPts.data());
+  }
+
+  merged->SetPoints(points);
+  merged->SetPolys(polys);
+  merged->GetCellData()->ShallowCopy(appended->GetCellData());
+  return merged;
+}
+
+// Tag the cells of a piece with the id of the partition they belong to.
+inline void TagPartition(vtkPolyData* piece, int partId)
+{
+  vtkNew<vtkIntArray> tags;
+  tags->SetName(DECIMATION_PARTITION_ARRAY);
+  tags->SetNumberOfTuples(piece->GetNumberOfCells());
+  tags->FillValue(partId);
+  piece->GetCellData()->AddArray(tags);
+}
+
+//------------------------------------------------------------------------------
+// Perform the partitioned decimation. Returns false (and leaves the output
+// untouched) if the input is not suited to partitioning, in which case the
+// caller should execute the serial algorithm.
+template <typename FactoryT>
+bool PartitionedDecimate(vtkPolyData* input, vtkPolyData* output, double targetReduction,
+  int numberOfPartitions, FactoryT&& newDecimator)
+{
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  if (input->GetNumberOfCells() != numTris || input->GetPolys()->GetMaxCellSize() != 3)
+  {
+    return false; // triangles only
+  }
+  int numParts = numberOfPartitions;
+  if (numParts <= 0)
+  {
+    numParts = static_cast<int>(std::min(static_cast<vtkIdType>(
+      vtkSMPTools::GetEstimatedNumberOfThreads()), numTris / DECIMATION_MIN_AUTO_PARTITION_SIZE));
+  }
+  numParts = static_cast<int>(std::min(static_cast<vtkIdType>(numParts), numTris / 4));
+  if (numParts < 2)
+  {
+    return false;
+  }
+  const double numTargetTris = (1.0 - targetReduction) * numTris;
+
+  // Partition the triangles.
+  vtkCellArray* polys = input->GetPolys();
+  std::vector<double> centroids(3 * numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType cellId, vtkIdType endCellId) {
+    auto iter = vtk::TakeSmartPointer(polys->NewIterator());
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      double* c = centroids.data() + 3 * cellId;
+      c[0] = c[1] = c[2] = 0.0;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        input->GetPoint(pts[i], x);
+        c[0] += x[0] / npts;
+        c[1] += x[1] / npts;
+        c[2] += x[2] / npts;
+      }
+    }
+  });
+  std::vector<vtkIdType> cellIds(numTris);
+  for (vtkIdType i = 0; i < numTris; ++i)
+  {
+    cellIds[i] = i;
+  }
+  std::vector<int> partIds(numTris);
+  BisectCells(cellIds, centroids, 0, numTris, numParts, 0, partIds);
+  centroids.clear();
+  centroids.shrink_to_fit();
+
+  std::vector<std::vector<vtkIdType>> partCells(numParts);
+  for (vtkIdType cellId = 0; cellId < numTris; ++cellId)
+  {
+    partCells[partIds[cellId]].push_back(cellId);
+  }
+
+  // Decimate the partitions concurrently, with their boundary locked.
+  std::vector<vtkSmartPointer<vtkPolyData>> pieces(numParts);
+  vtkSMPTools::For(0, numParts, 1, [&](vtkIdType partId, vtkIdType endPartId) {
+    for (; partId < endPartId; ++partId)
+    {
+      vtkSmartPointer<vtkPolyData> part = ExtractPolys(input, partCells[partId]);
+      vtkSmartPointer<vtkPolyDataAlgorithm> decimator = newDecimator(targetReduction, true);
+      decimator->SetInputData(part);
+      decimator->Update();
+      pieces[partId] = vtkSmartPointer<vtkPolyData>::New();
+      pieces[partId]->ShallowCopy(decimator->GetOutput());
+      TagPartition(pieces[partId], static_cast<int>(partId));
+    }
+  });
+  partCells.clear();
+  vtkSmartPointer<vtkPolyData> mesh = MergePieces(pieces);
+  pieces.clear();
+
+  // Decimate the band of triangles along the seams between partitions.
+  vtkIdType numMeshTris = mesh->GetNumberOfPolys();
+  if (numMeshTris > numTargetTris)
+  {
+    vtkIntArray* tags =
+      vtkIntArray::SafeDownCast(mesh->GetCellData()->GetArray(DECIMATION_PARTITION_ARRAY));
+    const vtkIdType numPts = mesh->GetNumberOfPoints();
+    std::vector<std::atomic<int>> owner(numPts);
+    std::vector<unsigned char> seam(numPts, 0);
+    for (auto& o : owner)
+    {
+      o.store(-1, std::memory_order_relaxed);
+    }
+    vtkCellArray* meshPolys = mesh->GetPolys();
+    vtkSMPTools::For(0, numMeshTris, [&](vtkIdType cellId, vtkIdType endCellId) {
+      auto iter = vtk::TakeSmartPointer(meshPolys->NewIterator());
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (; cellId < endCellId; ++cellId)
+      {
+        const int partId = tags->GetValue(cellId);
+        iter->GetCellAtId(cellId, npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          int expected = -1;
+          if (!owner[pts[i]].compare_exchange_strong(expected, partId) && expected != partId)
+          {
+            seam[pts[i]] = 1;
+          }
+        }
+      }
+    });
+
+    std::vector<vtkIdType> bandCells;
+    std::vector<vtkIdType> otherCells;
+    auto iter = vtk::TakeSmartPointer(meshPolys->NewIterator());
+    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      iter->GetCurrentCell(npts, pts);
+      bool inBand = false;
+      for (vtkIdType i = 0; i < npts && !inBand; ++i)
+      {
+        inBand = (seam[pts[i]] != 0);
+      }
+      (inBand ? bandCells : otherCells).push_back(iter->GetCurrentCellId());
+    }
+
+    if (!bandCells.empty())
+    {
+      const double bandReduction =
+        std::min(1.0, (numMeshTris - numTargetTris) / static_cast<double>(bandCells.size()));
+      vtkSmartPointer<vtkPolyDataAlgorithm> decimator = newDecimator(bandReduction, true);
+      decimator->SetInputData(ExtractPolys(mesh, bandCells));
+      decimator->Update();
+      std::vector<vtkSmartPointer<vtkPolyData>> parts(2);
+      parts[0] = ExtractPolys(mesh, otherCells);
+      parts[1] = vtkSmartPointer<vtkPolyData>::New();
+      parts[1]->ShallowCopy(decimator->GetOutput());
+      mesh = MergePieces(parts);
+      numMeshTris = mesh->GetNumberOfPolys();
+    }
+  }
+  mesh->GetCellData()->RemoveArray(DECIMATION_PARTITION_ARRAY);
+  mesh->GetPointData()->RemoveArray(DECIMATION_POINT_ID_ARRAY);
+
+  // If needed, finish with a serial decimation of the whole mesh so that the
+  // target reduction is honored.
+  if (numMeshTris > numTargetTris)
+  {
+    vtkSmartPointer<vtkPolyDataAlgorithm> decimator =
+      newDecimator(1.0 - numTargetTris / numMeshTris, false);
+    decimator->SetInputData(mesh);
+    decimator->Update();
+    mesh = decimator->GetOutput();
+  }
+
+  output->ShallowCopy(mesh);
+  return true;
+}
+
+} // anonymous namespace
+
+#endif // vtkPartitionedDecimationInternal_h
+// VTK-HeaderTest-Exclude: vtkPartitionedDecimationInternal.h
@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -43,6 +44,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->FullScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
   this->ScalarRange[1] = 1.0;
+  this->ParallelLabeling = 0;
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
@@ -134,7 +136,15 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (!this->ParallelLabeling || this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    this->Mesh->BuildLinks();
+  }
+  else
+  { // the parallel labeling only needs the cells
+    this->Mesh->BuildCells();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -190,32 +200,47 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->ParallelLabeling)
     {
-      if (cellId && !(cellId % 5000))
+      this->LabelRegionsInParallel(nullptr);
+      for (i = 0; i < this->RegionNumber; i++)
       {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-        if (this->CheckAbort())
+        if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
         {
-          break;
+          maxCellsInRegion = this->RegionSizes->GetValue(i);
+          largestRegionId = i;
         }
       }
-
-      if (this->Visited[cellId] < 0)
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
+          if (this->CheckAbort())
+          {
+            break;
+          }
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave.push_back(cellId);
+          this->TraverseAndMark();
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave.clear();
+          this->Wave2.clear();
+        }
       }
     }
   }
@@ -287,8 +312,16 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark();
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    if (this->ParallelLabeling)
+    {
+      this->LabelRegionsInParallel(&this->Wave);
+      this->Wave.clear();
+    }
+    else
+    {
+      this->TraverseAndMark();
+      this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    }
     this->UpdateProgress(0.9);
   } // else extracted seeded cells
 
@@ -544,6 +577,41 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+// Label the regions like TraverseAndMark() does, but with a union-find of
+// the cells and their points built concurrently.
+void vtkPolyDataConnectivityFilter::LabelRegionsInParallel(const std::vector<vtkIdType>* seeds)
+{
+  vtkDataArray* inScalars = this->InScalars;
+  const double* scalarRange = this->ScalarRange;
+  const bool fullScalarConnectivity = this->FullScalarConnectivity != 0;
+  auto isConnected = [inScalars, scalarRange, fullScalarConnectivity](
+                       vtkIdType, vtkIdList* pointIds) {
+    if (!inScalars)
+    {
+      return true;
+    }
+    // same test as IsScalarConnected(), which converts the scalars to float
+    double range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); i++)
+    {
+      double s = static_cast<float>(inScalars->GetComponent(pointIds->GetId(i), 0));
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+    }
+    if (fullScalarConnectivity)
+    {
+      return range[0] >= scalarRange[0] && range[1] <= scalarRange[1];
+    }
+    return range[1] >= scalarRange[0] && range[0] <= scalarRange[1];
+  };
+
+  this->PointNumber = vtkLabelConnectedRegions(this, this->Mesh, isConnected, seeds,
+    this->Visited, this->PointMap, vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars),
+    this->RegionSizes);
+  this->RegionNumber = seeds ? 0 : this->RegionSizes->GetNumberOfValues();
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -671,6 +739,7 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 
   os << indent << "RegionSizes: ";
   if (this->GetNumberOfExtractedRegions() > 10)
@@ -43,6 +43,11 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * @warning
+ * When ParallelLabeling is on, the regions are labeled with vtkSMPTools.
+ * Using TBB or other non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -118,6 +123,20 @@ public:
   vtkGetVector2Macro(ScalarRange, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the labeling of the regions in parallel. When on, the cells
+   * meeting the connectivity criterion are merged with their points in a
+   * lock-free union-find, concurrently, instead of growing each region with
+   * a serial wave front. The regions, their ids and sizes and the extracted
+   * cells are the same, but the output points keep their input order instead
+   * of the order in which the regions reach them. Default is off.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Control the extraction of connected surfaces.
@@ -250,8 +269,11 @@ protected:
   int IsScalarConnected(vtkIdType cellId);
 
   double ScalarRange[2];
+  vtkTypeBool ParallelLabeling;
 
   void TraverseAndMark();
+  // Label the regions with vtkSMPTools, all of them if seeds is nullptr
+  void LabelRegionsInParallel(const std::vector<vtkIdType>* seeds);
 
   // used to support algorithm execution
   vtkDataArray* CellScalars;
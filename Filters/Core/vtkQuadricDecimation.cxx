@@ -50,11 +50,14 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPartitionedDecimationInternal.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
@@ -159,7 +162,7 @@ void vtkQuadricDecimation::SetPointAttributeArray(vtkIdType ptId[2], const doubl
     for (int iArr = 0; iArr < this->Mesh->GetPointData()->GetNumberOfArrays(); ++iArr)
     {
       auto dArray = this->Mesh->GetPointData()->GetArray(iArr);
-      if (!dArray)
+      if (!dArray || dArray == this->OriginalPointIds)
       {
         continue;
       }
@@ -266,6 +269,42 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->ParallelDecimation)
+  {
+    // Each partition is decimated by a serial instance of this filter.
+    auto newDecimator = [this](double reduction, bool lockBoundary) {
+      vtkNew<vtkQuadricDecimation> decimator;
+      decimator->SetTargetReduction(reduction);
+      decimator->SetAttributeErrorMetric(this->AttributeErrorMetric);
+      decimator->SetVolumePreservation(this->VolumePreservation);
+      decimator->SetRegularize(this->Regularize);
+      decimator->SetRegularization(this->Regularization);
+      decimator->SetWeighBoundaryConstraintsByLength(this->WeighBoundaryConstraintsByLength);
+      decimator->SetBoundaryWeightFactor(this->BoundaryWeightFactor);
+      decimator->SetMapPointData(this->MapPointData);
+      decimator->SetScalarsAttribute(this->ScalarsAttribute);
+      decimator->SetVectorsAttribute(this->VectorsAttribute);
+      decimator->SetNormalsAttribute(this->NormalsAttribute);
+      decimator->SetTCoordsAttribute(this->TCoordsAttribute);
+      decimator->SetTensorsAttribute(this->TensorsAttribute);
+      decimator->SetScalarsWeight(this->ScalarsWeight);
+      decimator->SetVectorsWeight(this->VectorsWeight);
+      decimator->SetNormalsWeight(this->NormalsWeight);
+      decimator->SetTCoordsWeight(this->TCoordsWeight);
+      decimator->SetTensorsWeight(this->TensorsWeight);
+      decimator->LockBoundaryPoints = lockBoundary;
+      return vtkSmartPointer<vtkPolyDataAlgorithm>(decimator.GetPointer());
+    };
+    if (::PartitionedDecimate(
+          input, output, this->TargetReduction, this->NumberOfPartitions, newDecimator))
+    {
+      this->ActualReduction = numTris > 0
+        ? 1.0 - static_cast<double>(output->GetNumberOfPolys()) / numTris
+        : 0.0;
+      return 1;
+    }
+  }
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   outputCellList = vtkIdList::New();
@@ -282,6 +321,21 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   {
     this->Mesh->GetPointData()->DeepCopy(input->GetPointData());
   }
+  if (this->LockBoundaryPoints)
+  {
+    // The original point ids of a partition are passed to the output (and
+    // never interpolated) so that the partitions can be merged back.
+    vtkPointData* meshPD = this->Mesh->GetPointData();
+    this->OriginalPointIds = meshPD->GetArray(DECIMATION_POINT_ID_ARRAY);
+    if (!this->OriginalPointIds)
+    {
+      this->OriginalPointIds = input->GetPointData()->GetArray(DECIMATION_POINT_ID_ARRAY);
+      if (this->OriginalPointIds)
+      {
+        meshPD->AddArray(this->OriginalPointIds);
+      }
+    }
+  }
   this->Mesh->GetFieldData()->PassData(input->GetFieldData());
   this->Mesh->BuildCells();
   this->Mesh->BuildLinks();
@@ -345,6 +399,23 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDebugMacro(<< "Computing Quadrics");
   this->InitializeQuadrics(numPts);
   this->AddBoundaryConstraints();
+  if (this->LockBoundaryPoints)
+  {
+    // Points of boundary edges (used by a single triangle) are locked.
+    this->LockedPoints.assign(numPts, 0);
+    vtkNew<vtkIdList> edgeCells;
+    for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
+    {
+      endPtIds[0] = this->EndPoint1List->GetId(i);
+      endPtIds[1] = this->EndPoint2List->GetId(i);
+      this->Mesh->GetCellEdgeNeighbors(-1, endPtIds[0], endPtIds[1], edgeCells);
+      if (edgeCells->GetNumberOfIds() < 2)
+      {
+        this->LockedPoints[endPtIds[0]] = 1;
+        this->LockedPoints[endPtIds[1]] = 1;
+      }
+    }
+  }
   this->UpdateProgress(0.15);
 
   vtkDebugMacro(<< "Computing Costs");
@@ -432,6 +503,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   delete[] this->TempB;
   delete[] this->TempA;
   delete[] this->TempData;
+  this->LockedPoints.clear();
 
   // copy the simplified mesh from the working mesh to the output mesh
   for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
@@ -449,6 +521,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->Mesh->DeleteLinks();
   this->Mesh->Delete();
+  this->OriginalPointIds = nullptr;
   outputCellList->Delete();
 
   // renormalize, clamp attributes
@@ -957,6 +1030,15 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
+  if (!this->LockedPoints.empty() &&
+    (this->LockedPoints[pointIds[0]] || this->LockedPoints[pointIds[1]]))
+  {
+    // edges touching a locked point are never collapsed
+    std::fill_n(x, 3 + this->NumberOfComponents + this->VolumePreservation, 0.0);
+    this->Mesh->GetPoint(pointIds[0], x);
+    return VTK_DOUBLE_MAX;
+  }
+
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
     this->TempQuad[i] =
@@ -1052,6 +1134,15 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
+  if (!this->LockedPoints.empty() &&
+    (this->LockedPoints[pointIds[0]] || this->LockedPoints[pointIds[1]]))
+  {
+    // edges touching a locked point are never collapsed
+    std::fill_n(x, 3 + this->NumberOfComponents + this->VolumePreservation, 0.0);
+    this->Mesh->GetPoint(pointIds[0], x);
+    return VTK_DOUBLE_MAX;
+  }
+
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
     this->TempQuad[i] =
@@ -1559,5 +1650,8 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+
+  os << indent << "Parallel Decimation: " << (this->ParallelDecimation ? "On\n" : "Off\n");
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -60,7 +60,10 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+#include <vector> // For std::vector
+
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
 class vtkEdgeTable;
 class vtkIdList;
 class vtkPointData;
@@ -206,6 +209,34 @@ public:
   vtkGetMacro(ActualReduction, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel decimation of the mesh (off by default). When
+   * on, the triangles are spatially partitioned, the partitions are
+   * decimated concurrently with their boundaries locked, and the seams
+   * between partitions are decimated in a second pass. A last serial pass
+   * over the whole mesh is performed if needed to reach TargetReduction.
+   * The output differs from the serial algorithm, as collapses are ordered
+   * per partition rather than globally. Meshes which are too small, or
+   * which are not made of triangles only, are decimated serially.
+   */
+  vtkSetMacro(ParallelDecimation, vtkTypeBool);
+  vtkGetMacro(ParallelDecimation, vtkTypeBool);
+  vtkBooleanMacro(ParallelDecimation, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of partitions used by the parallel decimation. When
+   * set to 0 (the default), the number of partitions is chosen from the
+   * number of threads and the size of the mesh. Setting an explicit number
+   * of partitions makes the output independent of the number of threads and
+   * of the machine.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() override;
@@ -292,6 +323,15 @@ protected:
 
   bool MapPointData = false;
 
+  vtkTypeBool ParallelDecimation = false;
+  int NumberOfPartitions = 0;
+
+  // Used by the parallel decimation: when on, the points on the boundary of
+  // the mesh are neither moved nor deleted.
+  bool LockBoundaryPoints = false;
+  std::vector<unsigned char> LockedPoints;
+  vtkDataArray* OriginalPointIds = nullptr;
+
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
   vtkTypeBool NormalsAttribute;
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkContourSlabsInternal.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdListCollection.h"
@@ -30,6 +31,7 @@
 #include "vtkPolyData.h"
 #include "vtkPolygonBuilder.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -41,6 +43,7 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRectilinearSynchronizedTemplates);
@@ -250,12 +253,17 @@ void vtkRSTComputePointGradient(
 
 //------------------------------------------------------------------------------
 //
-// Contouring filter specialized for images
+// Contouring filter specialized for images. Contours the k-planes [kMin, kMax]
+// of the execute extent exExt with the contour values [vidxBegin, vidxEnd),
+// ptr pointing to the scalars of plane kMin. When contouring a slab of the
+// extent, seam records the intersections of the planes shared with the
+// neighbouring slabs.
 //
 template <class T>
-void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exExt,
-  vtkRectilinearGrid* data, vtkPolyData* output, T* ptr, vtkDataArray* inScalars,
-  bool outputTriangles)
+void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exExt, int kMin,
+  int kMax, vtkRectilinearGrid* data, vtkPolyData* output, T* ptr, vtkDataArray* inScalars,
+  bool outputTriangles, vtkIdType vidxBegin, vtkIdType vidxEnd, vtkContourSlabSeam* seam,
+  bool isFirst)
 {
   int* inExt = data->GetExtent();
   int xdim = exExt[1] - exExt[0] + 1;
@@ -265,6 +273,7 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
   T *inPtrX, *inPtrY, *inPtrZ;
   T *s0, *s1, *s2, *s3;
   int xMin, xMax, yMin, yMax, zMin, zMax;
+  int zReuseMin;
   int xInc, yInc, zInc;
   int *isect1Ptr, *isect2Ptr;
   double y, z, t;
@@ -327,8 +336,10 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
   xMax = exExt[1];
   yMin = exExt[2];
   yMax = exExt[3];
-  zMin = exExt[4];
-  zMax = exExt[5];
+  zMin = kMin;
+  zMax = kMax;
+  // the points of the plane below a seam may be reused
+  zReuseMin = (seam && seam->HasPrevious ? zMin - 1 : zMin);
 
   // increments to move through scalars Compute these ourself because
   // we may be contouring an array other than scalars.
@@ -371,18 +382,27 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
   int checkAbortInterval = std::min((zMax - zMin) / 10 + 1, 1000);
 
   // for each contour
-  for (vidx = 0; vidx < numContours && !abort; vidx++)
+  for (vidx = vidxBegin; vidx < vidxEnd && !abort; vidx++)
   {
     value = values[vidx];
     inPtrZ = ptr;
     s2 = inPtrZ;
+    if (seam && seam->HasPrevious)
+    {
+      seam->ForeignBase = VTK_INT_MAX - zstep;
+      vtkContourSlabsFillSeam(inPtrZ - zInc, xdim, ydim, xInc, yInc, zInc, value,
+        seam->ForeignBase, isect1 + (zMin % 2 ? 0 : zstep * 3));
+    }
 
     //==================================================================
     for (k = zMin; k <= zMax; k++)
     {
-      self->UpdateProgress(
-        (double)vidx / numContours + (k - zMin) / ((zMax - zMin + 1.0) * numContours));
-      if (k % checkAbortInterval == 0 && self->CheckAbort())
+      if (isFirst)
+      {
+        self->UpdateProgress(
+          (double)vidx / numContours + (k - zMin) / ((zMax - zMin + 1.0) * numContours));
+      }
+      if (k % checkAbortInterval == 0 && (isFirst ? self->CheckAbort() : self->GetAbortOutput()))
       {
         abort = true;
         break;
@@ -410,6 +430,10 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
         isect1Ptr = isect1 + xdim * ydim * 3;
         isect2Ptr = isect1;
       }
+      if (seam && seam->HasNext && k == zMax)
+      {
+        seam->LastPlaneFirstPoint = newPts->GetNumberOfPoints();
+      }
 
       inPtrY = inPtrZ;
       for (j = yMin; j <= yMax; j++)
@@ -455,7 +479,7 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
                 {
                   *isect2Ptr = *(isect2Ptr - yisectstep + 1);
                 }
-                else if (k > zMin && *(isect1Ptr + 2) > -1)
+                else if (k > zReuseMin && *(isect1Ptr + 2) > -1)
                 {
                   *isect2Ptr = *(isect1Ptr + 2);
                 }
@@ -466,7 +490,7 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
                 {
                   *isect2Ptr = *(isect2Ptr - yisectstep + 4);
                 }
-                else if (k > zMin && i<xMax&&*(isect1Ptr + 5)> - 1)
+                else if (k > zReuseMin && i<xMax&&*(isect1Ptr + 5)> - 1)
                 {
                   *isect2Ptr = *(isect1Ptr + 5);
                 }
@@ -507,12 +531,12 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
                 {
                   *(isect2Ptr + 1) = *(isect2Ptr - yisectstep + 1);
                 }
-                else if (k > zMin && *(isect1Ptr + 2) > -1)
+                else if (k > zReuseMin && *(isect1Ptr + 2) > -1)
                 {
                   *(isect2Ptr + 1) = *(isect1Ptr + 2);
                 }
               }
-              else if (*s2 == value && k > zMin && *(isect1Ptr + yisectstep + 2) > -1)
+              else if (*s2 == value && k > zReuseMin && *(isect1Ptr + yisectstep + 2) > -1)
               {
                 *(isect2Ptr + 1) = *(isect1Ptr + yisectstep + 2);
               }
@@ -556,7 +580,7 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
                 {
                   *(isect2Ptr + 2) = *(isect2Ptr - yisectstep + 1);
                 }
-                else if (k > zMin && *(isect1Ptr + 2) > -1)
+                else if (k > zReuseMin && *(isect1Ptr + 2) > -1)
                 {
                   *(isect2Ptr + 2) = *(isect1Ptr + 2);
                 }
@@ -650,9 +674,21 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
         }
         inPtrY += yInc;
       }
+      if (seam && seam->HasPrevious && k == zMin)
+      {
+        seam->FirstPlane.assign(isect2Ptr - zstep * 3, isect2Ptr);
+      }
       inPtrZ += zInc;
     }
   }
+  if (seam && seam->HasNext)
+  {
+    // the buffers of the last plane and of the plane below
+    const int* lastPlane = isect1 + (zMax % 2 ? zstep * 3 : 0);
+    const int* previousPlane = isect1 + (zMax % 2 ? 0 : zstep * 3);
+    seam->LastPlane.assign(lastPlane, lastPlane + zstep * 3);
+    seam->PreviousPlane.assign(previousPlane, previousPlane + zstep * 3);
+  }
   delete[] isect1;
 
   if (newScalars)
@@ -681,6 +717,59 @@ void ContourRectilinearGrid(vtkRectilinearSynchronizedTemplates* self, int* exEx
   }
 }
 
+//------------------------------------------------------------------------------
+// Contour each contour value of slabs of k-planes concurrently, and merge
+// them into the output in the order of the serial algorithm.
+template <class T>
+void ContourRectilinearGridSlabs(vtkRectilinearSynchronizedTemplates* self, int* exExt,
+  vtkRectilinearGrid* data, vtkPolyData* output, T* ptr, vtkDataArray* inScalars,
+  bool outputTriangles)
+{
+  const vtkIdType numContours = self->GetNumberOfContours();
+  const int numSlabs = vtkContourSlabsNumberOfSlabs(exExt[5] - exExt[4]);
+  if (numSlabs == 1 || numContours == 0)
+  {
+    ContourRectilinearGrid(self, exExt, exExt[4], exExt[5], data, output, ptr, inScalars,
+      outputTriangles, 0, numContours, nullptr, true);
+    return;
+  }
+
+  int* inExt = data->GetExtent();
+  const vtkIdType zInc = static_cast<vtkIdType>(inScalars->GetNumberOfComponents()) *
+    (inExt[1] - inExt[0] + 1) * (inExt[3] - inExt[2] + 1);
+  std::vector<vtkContourSlab> slabs(numContours * numSlabs);
+  std::vector<vtkContourSlabSeam> seams(slabs.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(slabs.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType task = begin; task < end; ++task)
+      {
+        const vtkIdType vidx = task / numSlabs;
+        const int slab = static_cast<int>(task % numSlabs);
+        int kMin, kMax;
+        vtkContourSlabsGetSlab(exExt[4], exExt[5], numSlabs, slab, kMin, kMax);
+        seams[task].HasPrevious = slab > 0;
+        seams[task].HasNext = slab < numSlabs - 1;
+        slabs[task].Output = vtkSmartPointer<vtkPolyData>::New();
+        ContourRectilinearGrid(self, exExt, kMin, kMax, data, slabs[task].Output.Get(),
+          ptr + (kMin - exExt[4]) * zInc, inScalars, outputTriangles, vidx, vidx + 1,
+          &seams[task], isFirst);
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
+      }
+    });
+  if (self->GetAbortOutput())
+  {
+    return;
+  }
+
+  vtkContourSlabsMapSeams(slabs, seams);
+  vtkContourSlabsMerge(slabs, output);
+}
+
 //------------------------------------------------------------------------------
 //
 // Contouring filter specialized for images (or slices from images)
@@ -741,7 +830,7 @@ int vtkRectilinearSynchronizedTemplates::RequestData(vtkInformation* vtkNotUsed(
 
   switch (inScalars->GetDataType())
   {
-    vtkTemplateMacro(ContourRectilinearGrid(
+    vtkTemplateMacro(ContourRectilinearGridSlabs(
       this, exExt, data, output, (VTK_TT*)ptr, inScalars, this->GenerateTriangles != 0));
   }
 
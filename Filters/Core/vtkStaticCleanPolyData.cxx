@@ -18,6 +18,7 @@
 #include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
 #include "vtkDataArrayRange.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -119,21 +120,10 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // we'll be needing these
-  vtkIdType newId;
-  vtkIdType i;
-  vtkIdType ptId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-
   vtkCellArray* inVerts = input->GetVerts();
-  vtkSmartPointer<vtkCellArray> newVerts;
   vtkCellArray* inLines = input->GetLines();
-  vtkSmartPointer<vtkCellArray> newLines;
   vtkCellArray* inPolys = input->GetPolys();
-  vtkSmartPointer<vtkCellArray> newPolys;
   vtkCellArray* inStrips = input->GetStrips();
-  vtkSmartPointer<vtkCellArray> newStrips;
 
   vtkPointData* inPD = input->GetPointData();
   vtkCellData* inCD = input->GetCellData();
@@ -229,294 +219,27 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   }
   this->UpdateProgress(0.6);
 
-  // Finally, remap the topology to use new point ids. Celldata needs to be
-  // copied correctly. If a poly is converted to a line, or a line to a
-  // point, then using a CellCounter will not do, as the cells should be
-  // ordered verts, lines, polys, strips. We need to maintain separate cell
-  // data lists so we can copy them all correctly. Tedious but easy to
-  // implement. We can use outCD for vertex cell data, then add the rest
-  // at the end.
-  vtkSmartPointer<vtkCellData> outLineData;
-  vtkSmartPointer<vtkCellData> outPolyData;
-  vtkSmartPointer<vtkCellData> outStrpData;
+  // Finally, remap the topology to use new point ids. Degenerate cells are
+  // removed or converted, and cell data is copied. This is threaded: if a
+  // poly is converted to a line, or a line to a point, the cells must still
+  // be ordered verts, lines, polys, strips; so the output of each batch of
+  // cells is counted first, and then written at the proper location.
   outCD->CopyAllocate(inCD);
-
-  // Begin to adjust topology. We need to cull out duplicate points and see
-  // what's left.  Just use a vector to keep track of unique ids - it's a
-  // small set so find() will execute relatively fast.
-  std::vector<vtkIdType> cellIds;
-  vtkIdType inCellID = 0;
-  vtkIdType progressCounter = 0;
-  vtkIdType checkAbortInterval = 0;
-
-  //
-  // Vertices are renumbered and we remove duplicates
-  if (!this->CheckAbort() && inVerts->GetNumberOfCells() > 0)
-  {
-    newVerts.TakeReference(vtkCellArray::New());
-    newVerts->AllocateEstimate(inVerts->GetNumberOfCells(), 1);
-    checkAbortInterval = std::min(inVerts->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-
-    vtkDebugMacro(<< "Starting Verts " << inCellID);
-    for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all points of vertex cell
-
-      if (!cellIds.empty())
-      {
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-  }
-  this->UpdateProgress(0.7);
-
-  // lines reduced to one point are eliminated or made into verts
-  if (!this->CheckAbort() && inLines->GetNumberOfCells() > 0)
+  CellCleaner cleaner;
+  cleaner.ConvertLinesToPoints = this->ConvertLinesToPoints;
+  cleaner.ConvertPolysToLines = this->ConvertPolysToLines;
+  cleaner.ConvertStripsToPolys = this->ConvertStripsToPolys;
+  cleaner.RemoveAllDuplicates = true;
+  if (!this->CheckAbort())
   {
-    newLines.TakeReference(vtkCellArray::New());
-    newLines->AllocateEstimate(inLines->GetNumberOfCells(), 2);
-    outLineData.TakeReference(vtkCellData::New());
-    outLineData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inLines->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-    //
-    vtkDebugMacro(<< "Starting Lines " << inCellID);
-    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all cell points
-
-      if (cellIds.size() > 1)
-      {
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inLines->GetNumberOfCells() - newLines->GetNumberOfCells()
-                  << " lines");
-  }
-  this->UpdateProgress(0.8);
-
-  // polygons reduced to two points or less are either eliminated
-  // or converted to lines or points if enabled
-  if (!this->CheckAbort() && inPolys->GetNumberOfCells() > 0)
-  {
-    newPolys.TakeReference(vtkCellArray::New());
-    newPolys->AllocateCopy(inPolys);
-    outPolyData.TakeReference(vtkCellData::New());
-    outPolyData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inPolys->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-
-    vtkDebugMacro(<< "Starting Polys " << inCellID);
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for points in cell
-
-      if (cellIds.size() > 2)
-      {
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inPolys->GetNumberOfCells() - newPolys->GetNumberOfCells()
-                  << " polys");
+    RebuildCells(input, pmap, cleaner, output);
   }
   this->UpdateProgress(0.9);
 
-  // triangle strips can reduced to polys/lines/points etc
-  if (!this->CheckAbort() && inStrips->GetNumberOfCells() > 0)
-  {
-    newStrips.TakeReference(vtkCellArray::New());
-    newStrips->AllocateCopy(inStrips);
-    outStrpData.TakeReference(vtkCellData::New());
-    outStrpData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inStrips->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      }
-      if (cellIds.size() > 3)
-      {
-        newId = newStrips->InsertNextCell(cellIds.size(), cellIds.data());
-        outStrpData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 3 && this->ConvertStripsToPolys)
-      {
-        if (!newPolys)
-        {
-          newPolys.TakeReference(vtkCellArray::New());
-          newPolys->AllocateEstimate(5, 3);
-          outPolyData.TakeReference(vtkCellData::New());
-          outPolyData->CopyAllocate(inCD);
-        }
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inStrips->GetNumberOfCells() - newStrips->GetNumberOfCells()
-                  << " strips");
-  }
-
-  vtkDebugMacro(<< "Removed " << numNewPts - newPts->GetNumberOfPoints() << " points");
-
   // Update ourselves and release memory
   //
   this->Locator->Initialize(); // release memory.
 
-  // Now transfer all CellData from Lines/Polys/Strips into final
-  // cell attribute data. The vertex cell data has already been inserted.
-  vtkIdType cellCounter = (newVerts == nullptr ? 0 : newVerts->GetNumberOfCells());
-  vtkIdType lineCounter = (newLines == nullptr ? 0 : newLines->GetNumberOfCells());
-  vtkIdType polyCounter = (newPolys == nullptr ? 0 : newPolys->GetNumberOfCells());
-  vtkIdType strpCounter = (newStrips == nullptr ? 0 : newStrips->GetNumberOfCells());
-
-  if (newLines)
-  {
-    for (i = 0; i < lineCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outLineData, i, cellCounter);
-    }
-  }
-  if (newPolys)
-  {
-    for (i = 0; i < polyCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outPolyData, i, cellCounter);
-    }
-  }
-  if (newStrips)
-  {
-    for (i = 0; i < strpCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outStrpData, i, cellCounter);
-    }
-  }
-
-  // Update the output connectivity
-  if (newVerts)
-  {
-    output->SetVerts(newVerts);
-  }
-  if (newLines)
-  {
-    output->SetLines(newLines);
-  }
-  if (newPolys)
-  {
-    output->SetPolys(newPolys);
-  }
-  if (newStrips)
-  {
-    output->SetStrips(newStrips);
-  }
-
   return 1;
 }
 
@@ -21,15 +21,257 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStripper);
 
+namespace
+{
+// The triangle strips, poly-lines and passed through polygons built from a
+// range of cells in the legacy cell array layout, with the ids of the cells
+// providing their field data.
+struct StripperChunk
+{
+  std::vector<vtkIdType> Strips;
+  std::vector<vtkIdType> Lines;
+  std::vector<vtkIdType> Polys;
+  std::vector<vtkIdType> StripCellIds;
+  std::vector<vtkIdType> LineCellIds;
+  std::vector<vtkIdType> PolyCellIds;
+  vtkIdType NumStrips = 0;
+  vtkIdType NumLines = 0;
+  vtkIdType LongestStrip = 0;
+  vtkIdType LongestLine = 0;
+};
+
+//------------------------------------------------------------------------------
+void InsertCell(std::vector<vtkIdType>& cells, vtkIdType npts, const vtkIdType* pts)
+{
+  cells.push_back(npts);
+  cells.insert(cells.end(), pts, pts + npts);
+}
+
+//------------------------------------------------------------------------------
+// Strip the mesh cells in [begin, end). Strips and poly-lines only grow
+// through cells of the range, the ranges can be stripped concurrently.
+void StripCells(vtkStripper* self, vtkPolyData* mesh, vtkUnsignedCharArray* ghostCells,
+  char* visited, vtkIdType begin, vtkIdType end, bool reportProgress, StripperChunk& chunk)
+{
+  const int maximumLength = self->GetMaximumLength();
+  std::vector<vtkIdType> pts(maximumLength + 2); // working array
+  vtkNew<vtkIdList> cellIds;
+  cellIds->Allocate(maximumLength + 2);
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkIdList> neighborPts;
+  const vtkIdType* triPts;
+  const vtkIdType* linePts;
+  vtkIdType numTriPts, numLinePts, neighbor = 0, i, j;
+  auto inRange = [begin, end](vtkIdType id) { return id >= begin && id < end; };
+
+  // array keeps track of data that's been visited
+  for (vtkIdType cellId = begin; cellId < end; cellId++)
+  {
+    visited[cellId] = ghostCells && ghostCells->GetValue(cellId) ? 1 : 0;
+  }
+
+  vtkIdType progressInterval = (end - begin) / 20 + 1;
+  for (vtkIdType cellId = begin; cellId < end; cellId++)
+  {
+    if (ghostCells && ghostCells->GetValue(cellId))
+    {
+      continue;
+    }
+    if (reportProgress && !((cellId - begin) % progressInterval))
+    {
+      self->UpdateProgress(static_cast<double>(cellId - begin) / (end - begin));
+      if (self->CheckAbort())
+      {
+        break;
+      }
+    }
+    if (visited[cellId])
+    {
+      continue;
+    }
+    visited[cellId] = 1;
+    const int cellType = mesh->GetCellType(cellId);
+    if (cellType == VTK_TRIANGLE)
+    {
+      //  Got a starting point for the strip.  Initialize.  Find a neighbor
+      //  to extend strip.
+      //
+      chunk.NumStrips++;
+      vtkIdType numPts = 3;
+
+      mesh->GetCellPoints(cellId, numTriPts, triPts, cellPts);
+
+      for (i = 0; i < 3; i++)
+      {
+        pts[1] = triPts[i];
+        pts[2] = triPts[(i + 1) % 3];
+
+        mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
+        if (cellIds->GetNumberOfIds() > 0 && inRange(neighbor = cellIds->GetId(0)) &&
+          !visited[neighbor] && mesh->GetCellType(neighbor) == VTK_TRIANGLE)
+        {
+          pts[0] = triPts[(i + 2) % 3];
+          break;
+        }
+      }
+      chunk.StripCellIds.push_back(cellId);
+      //  If no unvisited neighbor, just create the strip of one triangle.
+      //
+      if (i >= 3)
+      {
+        ::InsertCell(chunk.Strips, 3, triPts);
+        continue;
+      }
+
+      //  Have a neighbor.  March along grabbing new points
+      //
+      while (neighbor >= 0)
+      {
+        visited[neighbor] = 1;
+        mesh->GetCellPoints(neighbor, numTriPts, triPts, neighborPts);
+        chunk.StripCellIds.push_back(neighbor);
+        for (i = 0; i < 3; i++)
+        {
+          if (triPts[i] != pts[numPts - 2] && triPts[i] != pts[numPts - 1])
+          {
+            break;
+          }
+        }
+
+        // only add the triangle to the strip if it isn't degenerate.
+        if (i < 3)
+        {
+          pts[numPts] = triPts[i];
+          mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+          numPts++;
+        }
+
+        if (numPts > chunk.LongestStrip)
+        {
+          chunk.LongestStrip = numPts;
+        }
+
+        // note: if updates value of neighbor
+        // Note2: for a degenerate triangle this test will
+        // correctly fail because the visited[neighbor] will
+        // now be visited
+        if (cellIds->GetNumberOfIds() <= 0 || !inRange(neighbor = cellIds->GetId(0)) ||
+          visited[neighbor] || mesh->GetCellType(neighbor) != VTK_TRIANGLE ||
+          numPts >= (maximumLength + 2))
+        {
+          ::InsertCell(chunk.Strips, numPts, pts.data());
+          neighbor = (-1);
+        }
+      } // while
+    }   // if triangle
+
+    else if (cellType == VTK_LINE)
+    {
+      //
+      //  Got a starting point for the line.  Initialize.  Find a neighbor
+      //  to extend poly-line.
+      //
+      chunk.NumLines++;
+      vtkIdType numPts = 2;
+
+      mesh->GetCellPoints(cellId, numLinePts, linePts, cellPts);
+
+      bool foundOne = false;
+      for (i = 0; !foundOne && i < 2; i++)
+      {
+        pts[0] = linePts[i];
+        pts[1] = linePts[(i + 1) % 2];
+        mesh->GetPointCells(pts[1], cellIds);
+        for (j = 0; j < cellIds->GetNumberOfIds(); j++)
+        {
+          neighbor = cellIds->GetId(j);
+          if (neighbor != cellId && inRange(neighbor) && !visited[neighbor] &&
+            mesh->GetCellType(neighbor) == VTK_LINE)
+          {
+            foundOne = true;
+            break;
+          }
+        }
+      }
+
+      // for each polyline that we construct, we set the cell data to be that
+      // for the first cell that formed the polyline. We may build the field data
+      // for the mini-cells in the polyline, similar to triangle strips,
+      // but that is not required currently.
+      chunk.LineCellIds.push_back(cellId);
+      //  If no unvisited neighbor, just create the poly-line from one line.
+      //
+      if (!foundOne)
+      {
+        ::InsertCell(chunk.Lines, 2, linePts);
+        continue;
+      }
+
+      //  Have a neighbor.  March along grabbing new points
+      //
+      while (neighbor >= 0)
+      {
+        visited[neighbor] = 1;
+        mesh->GetCellPoints(neighbor, numLinePts, linePts, neighborPts);
+        for (i = 0; i < 2; i++)
+        {
+          if (linePts[i] != pts[numPts - 1])
+          {
+            break;
+          }
+        }
+        pts[numPts] = linePts[i];
+        mesh->GetPointCells(pts[numPts], cellIds);
+        if (++numPts > chunk.LongestLine)
+        {
+          chunk.LongestLine = numPts;
+        }
+
+        // get new neighbor
+        for (j = 0; j < cellIds->GetNumberOfIds(); j++)
+        {
+          const vtkIdType nei = cellIds->GetId(j);
+          if (nei != neighbor && inRange(nei) && !visited[nei] &&
+            mesh->GetCellType(nei) == VTK_LINE)
+          {
+            neighbor = nei;
+            break;
+          }
+        }
+
+        if (j >= cellIds->GetNumberOfIds() || numPts >= (maximumLength + 1))
+        {
+          ::InsertCell(chunk.Lines, numPts, pts.data());
+          neighbor = (-1);
+        }
+      } // while
+    }   // if line
+
+    // not line, triangle, or strip must be quad or tpolygon which we pass through
+    else if (cellType == VTK_POLYGON || cellType == VTK_QUAD)
+    {
+      mesh->GetCellPoints(cellId, numTriPts, triPts, cellPts);
+      ::InsertCell(chunk.Polys, numTriPts, triPts);
+      chunk.PolyCellIds.push_back(cellId);
+    }
+  } // for all elements
+}
+} // anonymous namespace
+
 // Construct object with MaximumLength set to 1000.
 vtkStripper::vtkStripper()
 {
@@ -38,6 +280,8 @@ vtkStripper::vtkStripper()
   this->PassThroughCellIds = 0;
   this->PassThroughPointIds = 0;
   this->JoinContiguousSegments = 0;
+  this->PartitionedStripping = 0;
+  this->PartitionSize = 10000;
 }
 
 int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
@@ -52,21 +296,15 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType cellId, numCells, i;
-  int longestStrip, longestLine, j, numPts;
-  vtkIdType numLines, numStrips, nei;
+  vtkIdType longestStrip, longestLine;
+  vtkIdType numLines, numStrips;
   vtkCellArray *newStrips = nullptr, *inStrips, *newLines = nullptr, *inLines, *inPolys;
   vtkCellArray* newPolys = nullptr;
   vtkIdType numLinePts = 0;
-  vtkIdList* cellIds;
-  int foundOne;
-  vtkIdType *pts, neighbor = 0;
   vtkPolyData* mesh;
-  char* visited;
   vtkIdType numStripPts = 0;
   const vtkIdType* stripPts = nullptr;
   const vtkIdType* linePts = nullptr;
-  const vtkIdType* triPts;
-  vtkIdType numTriPts;
   vtkPointData* pd = input->GetPointData();
   vtkCellData* cd = input->GetCellData();
 
@@ -108,10 +346,6 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  pts = new vtkIdType[this->MaximumLength + 2]; // working array
-  cellIds = vtkIdList::New();
-  cellIds->Allocate(this->MaximumLength + 2);
-
   // The new field data object that maintains the transformed cell data.
   if (this->PassCellDataAsFieldData)
   {
@@ -222,248 +456,103 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  // array keeps track of data that's been visited
-  visited = new char[numCells];
-  for (i = 0; i < numCells; i++)
-  {
-    visited[i] = ghostCells && ghostCells->GetValue(i) ? 1 : 0;
-  }
-
   // Loop over all cells and find one that hasn't been visited.
   // Start a triangle strip (or poly-line) and mark as visited, and
   // then find a neighbor that isn't visited.  Add this to the strip
-  // (or poly-line) and mark as visited (and so on).
+  // (or poly-line) and mark as visited (and so on). With partitioned
+  // stripping, the ranges of PartitionSize cells are stripped in parallel
+  // and a strip never crosses a range, so that the output does not depend
+  // on the number of threads.
   //
+  std::vector<char> visited(numCells);
+  std::vector<StripperChunk> chunks;
+  if (!this->PartitionedStripping)
+  {
+    chunks.resize(1);
+    ::StripCells(this, mesh, ghostCells, visited.data(), 0, numCells, true, chunks[0]);
+  }
+  else
+  {
+    const vtkIdType partitionSize = this->PartitionSize;
+    chunks.resize((numCells + partitionSize - 1) / partitionSize);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1,
+      [&](vtkIdType beginChunk, vtkIdType endChunk)
+      {
+        bool isFirst = vtkSMPTools::GetSingleThread();
+        for (vtkIdType chunkId = beginChunk; chunkId < endChunk; ++chunkId)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+          const vtkIdType begin = chunkId * partitionSize;
+          ::StripCells(this, mesh, ghostCells, visited.data(), begin,
+            std::min(begin + partitionSize, numCells), false, chunks[chunkId]);
+        }
+      });
+  }
+
   longestStrip = 0;
   numStrips = 0;
   longestLine = 0;
   numLines = 0;
-
-  int cellType;
-  bool abort = false;
-  vtkIdType progressInterval = numCells / 20 + 1;
-  for (cellId = 0; cellId < numCells && !abort; cellId++)
+  for (const StripperChunk& chunk : chunks)
   {
-    if (ghostCells && ghostCells->GetValue(cellId))
+    if (!chunk.Strips.empty())
     {
-      continue;
+      newStrips->AppendLegacyFormat(
+        chunk.Strips.data(), static_cast<vtkIdType>(chunk.Strips.size()));
+    }
+    if (!chunk.Lines.empty())
+    {
+      newLines->AppendLegacyFormat(chunk.Lines.data(), static_cast<vtkIdType>(chunk.Lines.size()));
     }
-    if (!(cellId % progressInterval))
+    if (!chunk.Polys.empty())
     {
-      this->UpdateProgress((float)cellId / numCells);
-      abort = this->CheckAbort();
+      newPolys->AppendLegacyFormat(chunk.Polys.data(), static_cast<vtkIdType>(chunk.Polys.size()));
     }
-    if (!visited[cellId])
+    if (this->PassCellDataAsFieldData)
     {
-      visited[cellId] = 1;
-      if ((cellType = mesh->GetCellType(cellId)) == VTK_TRIANGLE)
+      for (vtkIdType id : chunk.StripCellIds)
       {
-        //  Got a starting point for the strip.  Initialize.  Find a neighbor
-        //  to extend strip.
-        //
-        numStrips++;
-        numPts = 3;
-
-        mesh->GetCellPoints(cellId, numTriPts, triPts);
-
-        for (i = 0; i < 3; i++)
-        {
-          pts[1] = triPts[i];
-          pts[2] = triPts[(i + 1) % 3];
-
-          mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
-          if (cellIds->GetNumberOfIds() > 0 && !visited[neighbor = cellIds->GetId(0)] &&
-            mesh->GetCellType(neighbor) == VTK_TRIANGLE)
-          {
-            pts[0] = triPts[(i + 2) % 3];
-            break;
-          }
-        }
-        //  If no unvisited neighbor, just create the strip of one triangle.
-        //
-        if (i >= 3)
-        {
-          pts[0] = triPts[0];
-          pts[1] = triPts[1];
-          pts[2] = triPts[2];
-          newStrips->InsertNextCell(3, pts);
-          if (this->PassCellDataAsFieldData)
-          {
-            newfdStrips->InsertNextTuple(cellId, cd);
-          }
-          if (this->PassThroughCellIds)
-          {
-            origStripIds->InsertNextValue(cellId);
-          }
-        }
-        else // continue strip
-        {
-          //  Have a neighbor.  March along grabbing new points
-          //
-          if (this->PassCellDataAsFieldData)
-          {
-            newfdStrips->InsertNextTuple(cellId, cd);
-          }
-          if (this->PassThroughCellIds)
-          {
-            origStripIds->InsertNextValue(cellId);
-          }
-          while (neighbor >= 0)
-          {
-            visited[neighbor] = 1;
-            mesh->GetCellPoints(neighbor, numTriPts, triPts);
-            if (this->PassCellDataAsFieldData)
-            {
-              newfdStrips->InsertNextTuple(neighbor, cd);
-            }
-            if (this->PassThroughCellIds)
-            {
-              origStripIds->InsertNextValue(neighbor);
-            }
-            for (i = 0; i < 3; i++)
-            {
-              if (triPts[i] != pts[numPts - 2] && triPts[i] != pts[numPts - 1])
-              {
-                break;
-              }
-            }
-
-            // only add the triangle to the strip if it isn't degenerate.
-            if (i < 3)
-            {
-              pts[numPts] = triPts[i];
-              mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
-              numPts++;
-            }
-
-            if (numPts > longestStrip)
-            {
-              longestStrip = numPts;
-            }
-
-            // note: if updates value of neighbor
-            // Note2: for a degenerate triangle this test will
-            // correctly fail because the visited[neighbor] will
-            // now be visited
-            if (cellIds->GetNumberOfIds() <= 0 || visited[neighbor = cellIds->GetId(0)] ||
-              mesh->GetCellType(neighbor) != VTK_TRIANGLE || numPts >= (this->MaximumLength + 2))
-            {
-              newStrips->InsertNextCell(numPts, pts);
-              neighbor = (-1);
-            }
-          } // while
-        }   // else continue strip
-      }     // if triangle
-
-      else if (cellType == VTK_LINE)
+        newfdStrips->InsertNextTuple(id, cd);
+      }
+      for (vtkIdType id : chunk.LineCellIds)
       {
-        //
-        //  Got a starting point for the line.  Initialize.  Find a neighbor
-        //  to extend poly-line.
-        //
-        numLines++;
-        numPts = 2;
-
-        mesh->GetCellPoints(cellId, numLinePts, linePts);
-
-        for (foundOne = i = 0; !foundOne && i < 2; i++)
-        {
-          pts[0] = linePts[i];
-          pts[1] = linePts[(i + 1) % 2];
-          mesh->GetPointCells(pts[1], cellIds);
-          for (j = 0; j < cellIds->GetNumberOfIds(); j++)
-          {
-            neighbor = cellIds->GetId(j);
-            if (neighbor != cellId && !visited[neighbor] && mesh->GetCellType(neighbor) == VTK_LINE)
-            {
-              foundOne = 1;
-              break;
-            }
-          }
-        }
-
-        // for each polyline that we construct, we set the cell data to be that
-        // for the first cell that formed the polyline. We may build the field data
-        // for the mini-cells in the polyline, similar to triangle strips,
-        // but that is not required currently.
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdLines->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origLineIds->InsertNextValue(cellId);
-        }
-        //  If no unvisited neighbor, just create the poly-line from one line.
-        //
-        if (!foundOne)
-        {
-          newLines->InsertNextCell(2, linePts);
-        }
-        else // continue poly-line
-        {
-          //  Have a neighbor.  March along grabbing new points
-          //
-          while (neighbor >= 0)
-          {
-            visited[neighbor] = 1;
-            mesh->GetCellPoints(neighbor, numLinePts, linePts);
-            for (i = 0; i < 2; i++)
-            {
-              if (linePts[i] != pts[numPts - 1])
-              {
-                break;
-              }
-            }
-            pts[numPts] = linePts[i];
-            mesh->GetPointCells(pts[numPts], cellIds);
-            if (++numPts > longestLine)
-            {
-              longestLine = numPts;
-            }
-
-            // get new neighbor
-            for (j = 0; j < cellIds->GetNumberOfIds(); j++)
-            {
-              nei = cellIds->GetId(j);
-              if (nei != neighbor && !visited[nei] && mesh->GetCellType(nei) == VTK_LINE)
-              {
-                neighbor = nei;
-                break;
-              }
-            }
-
-            if (j >= cellIds->GetNumberOfIds() || numPts >= (this->MaximumLength + 1))
-            {
-              newLines->InsertNextCell(numPts, pts);
-              neighbor = (-1);
-            }
-          } // while
-        }   // else continue line
-      }     // if line
-
-      // not line, triangle, or strip must be quad or tpolygon which we pass through
-      else if (cellType == VTK_POLYGON || cellType == VTK_QUAD)
+        newfdLines->InsertNextTuple(id, cd);
+      }
+      for (vtkIdType id : chunk.PolyCellIds)
       {
-        mesh->GetCellPoints(cellId, numTriPts, triPts);
-        newPolys->InsertNextCell(numTriPts, triPts);
-        if (this->PassCellDataAsFieldData)
-        {
-          newfdPolys->InsertNextTuple(cellId, cd);
-        }
-        if (this->PassThroughCellIds)
-        {
-          origPolyIds->InsertNextValue(cellId);
-        }
+        newfdPolys->InsertNextTuple(id, cd);
       }
-
-    } // if not visited
-  }   // for all elements
+    }
+    if (this->PassThroughCellIds)
+    {
+      for (vtkIdType id : chunk.StripCellIds)
+      {
+        origStripIds->InsertNextValue(id);
+      }
+      for (vtkIdType id : chunk.LineCellIds)
+      {
+        origLineIds->InsertNextValue(id);
+      }
+      for (vtkIdType id : chunk.PolyCellIds)
+      {
+        origPolyIds->InsertNextValue(id);
+      }
+    }
+    numStrips += chunk.NumStrips;
+    numLines += chunk.NumLines;
+    longestStrip = std::max(longestStrip, chunk.LongestStrip);
+    longestLine = std::max(longestLine, chunk.LongestLine);
+  }
 
   // Update output and release memory
   //
-  delete[] pts;
-  delete[] visited;
   mesh->Delete();
 
   output->SetPoints(input->GetPoints());
@@ -652,7 +741,6 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
 
   // pass through verts
   output->SetVerts(input->GetVerts());
-  cellIds->Delete();
 
   if (this->PassCellDataAsFieldData)
   {
@@ -746,5 +834,7 @@ void vtkStripper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PassThroughCellIds: " << this->PassThroughCellIds << endl;
   os << indent << "PassThroughPointIds: " << this->PassThroughPointIds << endl;
   os << indent << "JoinContiguousSegments: " << this->JoinContiguousSegments << endl;
+  os << indent << "PartitionedStripping: " << this->PartitionedStripping << endl;
+  os << indent << "PartitionSize: " << this->PartitionSize << endl;
 }
 VTK_ABI_NAMESPACE_END
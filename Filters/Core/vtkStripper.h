@@ -47,6 +47,12 @@
  * If there is a ghost cell array in the input, the ghost array is discarded.
  * Any cell tagged as ghost is skipped when stripping. Ghost points are kept.
  *
+ * With PartitionedStripping on, the cells are split in ranges of
+ * PartitionSize consecutive cells stripped in parallel with vtkSMPTools. A
+ * strip or poly-line never crosses a range, which gives a few more (and
+ * shorter) strips than the serial stripping, but an output independent of
+ * the number of threads.
+ *
  * @warning
  * If triangle strips or poly-lines exist in the input data they will
  * be passed through to the output data. This filter will only construct
@@ -129,6 +135,26 @@ public:
   vtkBooleanMacro(JoinContiguousSegments, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * If on, strip ranges of PartitionSize cells in parallel, the strips and
+   * poly-lines do not extend across ranges. The default is off.
+   */
+  vtkSetMacro(PartitionedStripping, vtkTypeBool);
+  vtkGetMacro(PartitionedStripping, vtkTypeBool);
+  vtkBooleanMacro(PartitionedStripping, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Specify the number of consecutive input lines and polygons stripped
+   * together with PartitionedStripping on. Larger ranges give longer strips
+   * and less parallelism. The default is 10000.
+   */
+  vtkSetClampMacro(PartitionSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(PartitionSize, vtkIdType);
+  ///@}
+
 protected:
   vtkStripper();
   ~vtkStripper() override = default;
@@ -141,6 +167,8 @@ protected:
   vtkTypeBool PassThroughCellIds;
   vtkTypeBool PassThroughPointIds;
   vtkTypeBool JoinContiguousSegments;
+  vtkTypeBool PartitionedStripping;
+  vtkIdType PartitionSize;
 
 private:
   vtkStripper(const vtkStripper&) = delete;
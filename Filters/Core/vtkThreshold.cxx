@@ -231,14 +231,12 @@ struct vtkThreshold::EvaluateCellsFunctor
 
   void Reduce()
   {
-    this->KeptCellsList->Allocate(this->NumberOfCells);
-    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
-    {
-      if (this->InsidenessArray->GetValue(cellId))
-      {
-        this->KeptCellsList->InsertNextId(cellId);
-      }
-    }
+    const unsigned char* insideness = this->InsidenessArray->GetPointer(0);
+    this->KeptCellsList->SetNumberOfIds(this->NumberOfCells);
+    vtkIdType numberOfKeptCells = vtkSMPTools::CompactIndices(0, this->NumberOfCells,
+      this->KeptCellsList->GetPointer(0),
+      [insideness](vtkIdType cellId) { return insideness[cellId] != 0; });
+    this->KeptCellsList->Resize(numberOfKeptCells);
   }
 };
 
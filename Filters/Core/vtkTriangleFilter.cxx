@@ -16,17 +16,152 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
-#include "vtkTriangleStrip.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTriangleFilter);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// The simplices generated from the cells of an input cell array, and the
+// range of simplices of each input cell.
+struct Simplices
+{
+  vtkSmartPointer<vtkCellArray> Cells;
+  std::vector<vtkIdType> Offsets;
+};
+
+//------------------------------------------------------------------------------
+// Split the cells of a cell array into simplices of simplexSize points in
+// parallel, in the order of the cells. bound(npts, pts) is the largest number
+// of simplices of a cell, and split(npts, pts, simplices) writes them and
+// returns their number. Returns false if the filter was aborted.
+template <typename TBound, typename TSplit>
+bool SplitCells(vtkTriangleFilter* self, vtkCellArray* cells, int simplexSize, TBound&& bound,
+  TSplit&& split, Simplices& simplices)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  std::vector<vtkIdType>& offsets = simplices.Offsets;
+  offsets.resize(numCells + 1);
+  vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellPts = localCellPts.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          self->CheckAbort();
+        }
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      cells->GetCellAtId(cellId, npts, pts, cellPts);
+      offsets[cellId] = bound(npts, pts);
+    }
+  });
+  if (self->GetAbortOutput())
+  {
+    return false;
+  }
+  const vtkIdType maxNumSimplices =
+    vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end() - 1, offsets.begin(), vtkIdType(0));
+  offsets[numCells] = maxNumSimplices;
+
+  // Each cell writes its simplices where its bound puts them. A polygon may
+  // produce fewer triangles than its bound, the simplices are then packed.
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(maxNumSimplices * simplexSize);
+  std::vector<vtkIdType> numSimplices(numCells + 1);
+  std::atomic<bool> packed(true);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellPts = localCellPts.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cells->GetCellAtId(cellId, npts, pts, cellPts);
+      numSimplices[cellId] =
+        split(npts, pts, connectivity->GetPointer(offsets[cellId] * simplexSize));
+      if (numSimplices[cellId] != offsets[cellId + 1] - offsets[cellId])
+      {
+        packed.store(false, std::memory_order_relaxed);
+      }
+    }
+  });
+  if (!packed)
+  {
+    const vtkIdType numPacked = vtkSMPTools::ExclusiveScan(
+      numSimplices.begin(), numSimplices.end() - 1, numSimplices.begin(), vtkIdType(0));
+    numSimplices[numCells] = numPacked;
+    vtkNew<vtkIdTypeArray> packedConnectivity;
+    packedConnectivity->SetNumberOfValues(numPacked * simplexSize);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        std::copy_n(connectivity->GetPointer(offsets[cellId] * simplexSize),
+          (numSimplices[cellId + 1] - numSimplices[cellId]) * simplexSize,
+          packedConnectivity->GetPointer(numSimplices[cellId] * simplexSize));
+      }
+    });
+    connectivity->ShallowCopy(packedConnectivity);
+    offsets.swap(numSimplices);
+  }
+
+  const vtkIdType numOutCells = offsets[numCells];
+  vtkNew<vtkIdTypeArray> cellOffsets;
+  cellOffsets->SetNumberOfValues(numOutCells + 1);
+  vtkSMPTools::For(0, numOutCells + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cellOffsets->SetValue(cellId, cellId * simplexSize);
+    }
+  });
+  simplices.Cells = vtkSmartPointer<vtkCellArray>::New();
+  simplices.Cells->SetData(cellOffsets, connectivity);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Copy the data of each input cell to the simplices it generated.
+void CopySimplexData(vtkCellData* inCD, vtkCellData* outCD, const Simplices& simplices,
+  vtkIdType inFirstId, vtkIdType outFirstId)
+{
+  const vtkIdType numCells = static_cast<vtkIdType>(simplices.Offsets.size()) - 1;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      for (vtkIdType i = simplices.Offsets[cellId]; i < simplices.Offsets[cellId + 1]; ++i)
+      {
+        outCD->CopyData(inCD, inFirstId + cellId, outFirstId + i);
+      }
+    }
+  });
+}
+} // anonymous namespace
+
 //-------------------------------------------------------------------------
 int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -39,187 +174,165 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numCells = input->GetNumberOfCells();
-  vtkIdType cellNum = 0;
-  vtkIdType numPts, newId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  int i, j;
   vtkCellData* inCD = input->GetCellData();
   vtkCellData* outCD = output->GetCellData();
-  vtkIdType updateInterval;
-  vtkCellArray* cells;
   vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inVerts = input->GetVerts();
+  vtkCellArray* inLines = input->GetLines();
+  vtkCellArray* inPolys = input->GetPolys();
+  vtkCellArray* inStrips = input->GetStrips();
 
+  // Each cell array is split into simplices separately, in parallel: the
+  // simplices of each cell are counted, then written at their offset. The
+  // triangles of polygons and strips are placed in the output polys.
+  Simplices verts, lines, polys, strips;
   bool abort = false;
-  updateInterval = numCells / 100 + 1;
-  outCD->CopyAllocate(inCD, numCells);
 
-  // Do each of the verts, lines, polys, and strips separately
   // verts
-  if (input->GetVerts()->GetNumberOfCells() > 0)
+  if (this->PassVerts && inVerts->GetNumberOfCells() > 0)
   {
-    cells = input->GetVerts();
-    if (this->PassVerts)
-    {
-      newId = output->GetNumberOfCells();
-      vtkNew<vtkCellArray> newCells;
-      newCells->AllocateCopy(cells);
-      for (cells->InitTraversal(); cells->GetNextCell(npts, pts) && !abort; cellNum++)
-      {
-        if (!(cellNum % updateInterval)) // manage progress reports / early abort
-        {
-          this->UpdateProgress((float)cellNum / numCells);
-          abort = this->CheckAbort();
-        }
-        if (npts > 1)
+    abort = !::SplitCells(
+      this, inVerts, 1, [](vtkIdType npts, const vtkIdType*) { return npts > 1 ? npts : 1; },
+      [](vtkIdType npts, const vtkIdType* pts, vtkIdType* simplices) {
+        npts = npts > 1 ? npts : 1;
+        std::copy_n(pts, npts, simplices);
+        return npts;
+      },
+      verts);
+    output->SetVerts(verts.Cells);
+  }
+  this->UpdateProgress(0.1);
+
+  // lines
+  if (!abort && this->PassLines && inLines->GetNumberOfCells() > 0)
+  {
+    abort = !::SplitCells(
+      this, inLines, 2,
+      [](vtkIdType npts, const vtkIdType*) { return npts > 2 ? npts - 1 : 1; },
+      [](vtkIdType npts, const vtkIdType* pts, vtkIdType* simplices) {
+        if (npts <= 2)
         {
-          for (i = 0; i < npts; i++)
-          {
-            newCells->InsertNextCell(1, pts + i);
-            outCD->CopyData(inCD, cellNum, newId++);
-          }
+          std::copy_n(pts, 2, simplices);
+          return vtkIdType(1);
         }
-        else
+        for (vtkIdType i = 0; i < npts - 1; ++i)
         {
-          newCells->InsertNextCell(1, pts);
-          outCD->CopyData(inCD, cellNum, newId++);
+          simplices[2 * i] = pts[i];
+          simplices[2 * i + 1] = pts[i + 1];
         }
-      }
-      output->SetVerts(newCells);
-    }
-    else
-    {
-      cellNum += cells->GetNumberOfCells(); // skip over verts
-    }
+        return npts - 1;
+      },
+      lines);
+    output->SetLines(lines.Cells);
   }
+  this->UpdateProgress(0.2);
 
-  // lines
-  if (!abort && input->GetLines()->GetNumberOfCells() > 0)
+  // polygons, triangulated with a polygon per thread. It may be necessary to
+  // specify a custom tessellation tolerance.
+  if (!abort && inPolys->GetNumberOfCells() > 0)
   {
-    cells = input->GetLines();
-    if (this->PassLines)
-    {
-      newId = output->GetNumberOfCells();
-      vtkNew<vtkCellArray> newCells;
-      newCells->AllocateCopy(cells);
-      for (cells->InitTraversal(); cells->GetNextCell(npts, pts) && !abort; cellNum++)
-      {
-        if (!(cellNum % updateInterval)) // manage progress reports / early abort
+    vtkSMPThreadLocalObject<vtkPolygon> localPoly;
+    vtkSMPThreadLocalObject<vtkIdList> localTris;
+    abort = !::SplitCells(
+      this, inPolys, 3,
+      [](vtkIdType npts, const vtkIdType*) { return npts > 3 ? npts - 2 : (npts == 3 ? 1 : 0); },
+      [&](vtkIdType npts, const vtkIdType* pts, vtkIdType* simplices) {
+        if (npts == 3)
         {
-          this->UpdateProgress((float)cellNum / numCells);
-          abort = this->CheckAbort();
+          std::copy_n(pts, 3, simplices);
+          return vtkIdType(1);
         }
-        if (npts > 2)
+        else if (npts < 3)
         {
-          for (i = 0; i < (npts - 1); i++)
-          {
-            newCells->InsertNextCell(2, pts + i);
-            outCD->CopyData(inCD, cellNum, newId++);
-          }
+          return vtkIdType(0);
         }
-        else
+        vtkPolygon* poly = localPoly.Local();
+        vtkIdList* tris = localTris.Local();
+        if (this->Tolerance > 0.0)
         {
-          newCells->InsertNextCell(2, pts);
-          outCD->CopyData(inCD, cellNum, newId++);
+          poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
         }
-      } // for all lines
-      output->SetLines(newCells);
-    }
-    else
-    {
-      cellNum += cells->GetNumberOfCells(); // skip over lines
-    }
-  }
-
-  // Output from polygons and triangle strips cell arrays are placed
-  // in newPolys.
-  vtkSmartPointer<vtkCellArray> newPolys;
-  if (!abort && input->GetPolys()->GetNumberOfCells() > 0)
-  {
-    cells = input->GetPolys();
-    newId = output->GetNumberOfCells();
-    newPolys = vtkSmartPointer<vtkCellArray>::New();
-    newPolys->AllocateCopy(cells);
-    output->SetPolys(newPolys);
-    vtkNew<vtkIdList> ptIds;
-    ptIds->Allocate(VTK_CELL_SIZE);
-    int numSimplices;
-    vtkIdType triPts[3];
-    // It may be necessary to specify a custom tessellation
-    // tolerance.
-    vtkNew<vtkPolygon> poly;
-    if (this->Tolerance > 0.0)
-    {
-      poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
-    }
-
-    for (cells->InitTraversal(); cells->GetNextCell(npts, pts) && !abort; cellNum++)
-    {
-      if (!(cellNum % updateInterval)) // manage progress reports / early abort
-      {
-        this->UpdateProgress((float)cellNum / numCells);
-        abort = this->CheckAbort();
-      }
-      if (npts == 0)
-      {
-        continue;
-      }
-      if (npts == 3)
-      {
-        newPolys->InsertNextCell(3, pts);
-        outCD->CopyData(inCD, cellNum, newId++);
-      }
-      else // triangulate polygon
-      {
-        // initialize polygon
         poly->PointIds->SetNumberOfIds(npts);
         poly->Points->SetNumberOfPoints(npts);
-        for (i = 0; i < npts; i++)
+        double x[3];
+        for (vtkIdType i = 0; i < npts; i++)
         {
           poly->PointIds->SetId(i, pts[i]);
-          poly->Points->SetPoint(i, inPts->GetPoint(pts[i]));
+          inPts->GetPoint(pts[i], x);
+          poly->Points->SetPoint(i, x);
         }
-        poly->Triangulate(ptIds);
-        numPts = ptIds->GetNumberOfIds();
-        numSimplices = numPts / 3;
-        for (i = 0; i < numSimplices; i++)
+        poly->Triangulate(tris);
+        const vtkIdType numIds = tris->GetNumberOfIds() / 3 * 3;
+        for (vtkIdType i = 0; i < numIds; i++)
         {
-          for (j = 0; j < 3; j++)
-          {
-            triPts[j] = poly->PointIds->GetId(ptIds->GetId(3 * i + j));
-          }
-          newPolys->InsertNextCell(3, triPts);
-          outCD->CopyData(inCD, cellNum, newId++);
-        } // for each simplex
-      }   // triangulate polygon
-    }
+          simplices[i] = pts[tris->GetId(i)];
+        }
+        return numIds / 3;
+      },
+      polys);
   }
+  this->UpdateProgress(0.6);
 
   // strips
-  if (!abort && input->GetStrips()->GetNumberOfCells() > 0)
+  if (!abort && inStrips->GetNumberOfCells() > 0)
+  {
+    abort = !::SplitCells(
+      this, inStrips, 3,
+      [](vtkIdType npts, const vtkIdType*) { return npts > 2 ? npts - 2 : 0; },
+      [](vtkIdType npts, const vtkIdType* pts, vtkIdType* simplices) {
+        for (vtkIdType i = 0; i < npts - 2; ++i, simplices += 3)
+        {
+          // flip ordering to preserve consistency
+          simplices[0] = pts[i % 2 ? i + 1 : i];
+          simplices[1] = pts[i % 2 ? i : i + 1];
+          simplices[2] = pts[i + 2];
+        }
+        return npts > 2 ? npts - 2 : 0;
+      },
+      strips);
+  }
+  this->UpdateProgress(0.8);
+
+  if (polys.Cells && strips.Cells)
+  {
+    polys.Cells->Append(strips.Cells);
+    output->SetPolys(polys.Cells);
+  }
+  else if (polys.Cells || strips.Cells)
+  {
+    output->SetPolys(polys.Cells ? polys.Cells : strips.Cells);
+  }
+
+  // Copy the cell data of the input cells to their simplices, in the order
+  // of the output cell arrays.
+  const vtkIdType numOutVerts = verts.Cells ? verts.Cells->GetNumberOfCells() : 0;
+  const vtkIdType numOutLines = lines.Cells ? lines.Cells->GetNumberOfCells() : 0;
+  const vtkIdType numPolyTris = polys.Cells ? polys.Offsets.back() : 0;
+  const vtkIdType numStripTris = strips.Cells ? strips.Offsets.back() : 0;
+  outCD->CopyAllocate(inCD, numOutVerts + numOutLines + numPolyTris + numStripTris);
+  if (!abort)
   {
-    cells = input->GetStrips();
-    newId = output->GetNumberOfCells();
-    if (newPolys == nullptr)
+    outCD->SetNumberOfTuples(numOutVerts + numOutLines + numPolyTris + numStripTris);
+    const vtkIdType numInVerts = inVerts->GetNumberOfCells();
+    const vtkIdType numInLines = inLines->GetNumberOfCells();
+    const vtkIdType numInPolys = inPolys->GetNumberOfCells();
+    if (verts.Cells)
     {
-      newPolys = vtkSmartPointer<vtkCellArray>::New();
-      newPolys->AllocateCopy(cells);
-      output->SetPolys(newPolys);
+      ::CopySimplexData(inCD, outCD, verts, 0, 0);
     }
-    for (cells->InitTraversal(); cells->GetNextCell(npts, pts) && !abort; cellNum++)
+    if (lines.Cells)
     {
-      if (!(cellNum % updateInterval)) // manage progress reports / early abort
-      {
-        this->UpdateProgress((float)cellNum / numCells);
-        abort = this->CheckAbort();
-      }
-      vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
-      for (i = 0; i < (npts - 2); i++)
-      {
-        outCD->CopyData(inCD, cellNum, newId++);
-      }
-    } // for all strips
+      ::CopySimplexData(inCD, outCD, lines, numInVerts, numOutVerts);
+    }
+    if (polys.Cells)
+    {
+      ::CopySimplexData(inCD, outCD, polys, numInVerts + numInLines, numOutVerts + numOutLines);
+    }
+    if (strips.Cells)
+    {
+      ::CopySimplexData(inCD, outCD, strips, numInVerts + numInLines + numInPolys,
+        numOutVerts + numOutLines + numPolyTris);
+    }
   }
 
   // Update output
@@ -20,6 +20,11 @@
  * strips.  It also generates line segments from polylines unless PassLines
  * is off, and generates individual vertex cells from vtkVertex point lists
  * unless PassVerts is off.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Each cell is first bounded
+ * by its number of simplices, then split in parallel at the offset of its
+ * simplices, so the output is the same whatever the number of threads.
  */
 
 #ifndef vtkTriangleFilter_h
@@ -17,15 +17,24 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -53,6 +62,9 @@ vtkTubeFilter::vtkTubeFilter()
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
+  this->Theta = 0.0;
+  this->ReportWarnings = true;
+
   // by default process active point scalars
   this->SetInputArrayToProcess(
     0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
@@ -83,6 +95,159 @@ struct IdPointsEqual
   vtkPoints* Points;
 };
 
+//------------------------------------------------------------------------------
+// Number of points, strips and strip connectivity entries of the tube
+// generated around a polyline. Once scanned over the lines, where the tube of
+// each line goes in the output.
+struct TubeSize
+{
+  vtkIdType Points = 0;
+  vtkIdType Strips = 0;
+  vtkIdType Connectivity = 0;
+
+  TubeSize operator+(const TubeSize& other) const
+  {
+    TubeSize sum;
+    sum.Points = this->Points + other.Points;
+    sum.Strips = this->Strips + other.Strips;
+    sum.Connectivity = this->Connectivity + other.Connectivity;
+    return sum;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy the point ids of a polyline without the consecutive coincident points.
+// Returns the number of remaining points, or 0 if they cannot make a line.
+vtkIdType UniqueLinePoints(
+  vtkPoints* inPts, vtkIdType npts, const vtkIdType* pts, std::vector<vtkIdType>& linePts)
+{
+  if (npts < 2)
+  {
+    return 0;
+  }
+  linePts.assign(pts, pts + npts);
+  npts = static_cast<vtkIdType>(
+    std::unique(linePts.begin(), linePts.end(), IdPointsEqual(inPts)) - linePts.begin());
+  return npts < 2 ? 0 : npts;
+}
+
+//------------------------------------------------------------------------------
+// Writes the strips of a tube in a vtkCellArray, one after the other.
+struct CellArrayStrips
+{
+  vtkCellArray* Strips;
+  vtkCellData* InCD;
+  vtkCellData* OutCD;
+  vtkIdType InCellId;
+
+  void InsertNextCell(vtkIdType npts)
+  {
+    vtkIdType outCellId = this->Strips->InsertNextCell(npts);
+    this->OutCD->CopyData(this->InCD, this->InCellId, outCellId);
+  }
+  void InsertCellPoint(vtkIdType id) { this->Strips->InsertCellPoint(id); }
+};
+
+//------------------------------------------------------------------------------
+// Writes the strips of a tube at their place in the offsets and connectivity
+// arrays of the output, so that tubes are written concurrently.
+struct PreallocatedStrips
+{
+  vtkIdType* Offsets;
+  vtkIdType* Connectivity;
+  vtkCellData* InCD;
+  vtkCellData* OutCD;
+  vtkIdType InCellId;
+  vtkIdType CellId;
+  vtkIdType ConnectivityId;
+
+  void InsertNextCell(vtkIdType vtkNotUsed(npts))
+  {
+    this->Offsets[this->CellId] = this->ConnectivityId;
+    this->OutCD->CopyData(this->InCD, this->InCellId, this->CellId);
+    this->CellId++;
+  }
+  void InsertCellPoint(vtkIdType id) { this->Connectivity[this->ConnectivityId++] = id; }
+};
+
+//------------------------------------------------------------------------------
+// The triangle strips of a tube, and its caps. The caps are n-sided polygons
+// that can be easily triangle stripped.
+template <typename StripsT>
+void GenerateTubeStrips(vtkTubeFilter* self, vtkIdType offset, vtkIdType npts, StripsT& strips)
+{
+  const int numSides = self->GetNumberOfSides();
+  const int sideOffset = self->GetOffset();
+  const int onRatio = self->GetOnRatio();
+  const bool sidesShareVertices = self->GetSidesShareVertices() != 0;
+  vtkIdType i, i3;
+  int k;
+  int i1, i2;
+
+  for (k = sideOffset; k < (numSides + sideOffset); k += onRatio)
+  {
+    if (sidesShareVertices)
+    {
+      i1 = k % numSides;
+      i2 = (k + 1) % numSides;
+    }
+    else
+    {
+      i1 = 2 * (k % numSides) + 1;
+      i2 = 2 * ((k + 1) % numSides);
+    }
+    strips.InsertNextCell(npts * 2);
+    for (i = 0; i < npts; i++)
+    {
+      i3 = (sidesShareVertices ? 1 : 2) * i * numSides;
+      strips.InsertCellPoint(offset + i2 + i3);
+      strips.InsertCellPoint(offset + i1 + i3);
+    }
+  } // for each side of the tube
+
+  if (self->GetCapping())
+  {
+    vtkIdType startIdx = offset + (sidesShareVertices ? 1 : 2) * npts * numSides;
+
+    // The start cap
+    strips.InsertNextCell(numSides);
+    strips.InsertCellPoint(startIdx);
+    strips.InsertCellPoint(startIdx + 1);
+    for (i1 = numSides - 1, i2 = 2, k = 0; k < (numSides - 2); k++)
+    {
+      if ((k % 2))
+      {
+        strips.InsertCellPoint(startIdx + i2);
+        i2++;
+      }
+      else
+      {
+        strips.InsertCellPoint(startIdx + i1);
+        i1--;
+      }
+    }
+
+    // The end cap - reversed order to be consistent with normal
+    startIdx += numSides;
+    strips.InsertNextCell(numSides);
+    strips.InsertCellPoint(startIdx);
+    strips.InsertCellPoint(startIdx + numSides - 1);
+    for (i1 = numSides - 2, i2 = 1, k = 0; k < (numSides - 2); k++)
+    {
+      if ((k % 2))
+      {
+        strips.InsertCellPoint(startIdx + i1);
+        i1--;
+      }
+      else
+      {
+        strips.InsertCellPoint(startIdx + i2);
+        i2++;
+      }
+    }
+  }
+}
+
 }
 
 int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -239,68 +404,75 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
   // the line cellIds start after the last vert cellId
   inCellId = input->GetNumberOfVerts();
-  int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
-  int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
+  // Generate the tubes concurrently when possible, otherwise polyline after
+  // polyline.
+  if (!this->GenerateTubesInParallel(inCellId, inLines, inPts, pd, cd, outPD, outCD, newPts,
+        newNormals, newTCoords, newStrips, inScalars, range, inVectors, maxSpeed, inNormals,
+        generateNormals != 0))
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+    int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
+    int progressCounter = 0;
+    for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
     {
-      abort = this->CheckAbort();
-      break;
-    }
-    progressCounter++;
+      this->UpdateProgress((double)inCellId / numLines);
+      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+      {
+        abort = this->CheckAbort();
+        break;
+      }
+      progressCounter++;
 
-    // Make a copy of point indices to avoid modifying input polydata cells
-    // while removing degenerate lines.
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
+      // Make a copy of point indices to avoid modifying input polydata cells
+      // while removing degenerate lines.
+      if (npts < 2)
+      {
+        continue; // skip tubing this polyline
+      }
+      std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
+      vtkIdType* pts = ptsCopy.data();
 
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
+      // remove degenerate lines to avoid warnings
+      npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
+      if (npts < 2)
+      {
+        continue; // skip tubing this polyline
+      }
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
-    }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+      {
+        singlePolyline->Reset(); // avoid instantiation
+        singlePolyline->InsertNextCell(npts, pts);
+        vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      }
 
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
-    }
+      // Generate the points around the polyline. The tube is not stripped
+      // if the polyline is bad.
+      //
+      if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
+            range, inVectors, maxSpeed, inNormals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; // skip tubing this polyline
+      }
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      // Generate the strips for this polyline (including caps)
+      //
+      this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset, npts);
 
-  } // for all polylines
+    } // for all polylines
+  }
 
   singlePolyline->Delete();
 
@@ -351,7 +523,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
   double sPrev[3];
   double startCapNorm[3], endCapNorm[3];
   double n[3];
-  double s[3];
+  double s[3], v[3];
   // double bevelAngle;
   double w[3];
   double nP[3];
@@ -404,7 +576,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
-      vtkWarningMacro(<< "Coincident points!");
+      if (this->ReportWarnings)
+      {
+        vtkWarningMacro(<< "Coincident points!");
+      }
       return 0;
     }
 
@@ -442,8 +617,11 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     vtkMath::Cross(s, n, w);
     if (vtkMath::Normalize(w) == 0.0)
     {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
+      if (this->ReportWarnings)
+      {
+        vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2]
+                        << " n = " << n[0] << " " << n[1] << " " << n[2]);
+      }
       return 0;
     }
 
@@ -459,7 +637,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
     {
-      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(inVectors->GetTuple(pts[j])));
+      inVectors->GetTuple(pts[j], v);
+      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(v));
       if (sFactor > this->RadiusFactor)
       {
         sFactor = this->RadiusFactor;
@@ -467,15 +646,18 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
     {
-      sFactor =
-        1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(inVectors->GetTuple(pts[j])) / maxSpeed;
+      inVectors->GetTuple(pts[j], v);
+      sFactor = 1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(v) / maxSpeed;
     }
     else if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
     {
       sFactor = inScalars->GetComponent(pts[j], 0);
       if (sFactor < 0.0)
       {
-        vtkWarningMacro(<< "Scalar value less than zero, skipping line");
+        if (this->ReportWarnings)
+        {
+          vtkWarningMacro(<< "Scalar value less than zero, skipping line");
+        }
         return 0;
       }
     }
@@ -571,98 +753,8 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
   const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
   vtkCellArray* newStrips)
 {
-  vtkIdType i, outCellId;
-  int k;
-  int i1, i2, i3;
-
-  if (this->SidesShareVertices)
-  {
-    for (k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
-    {
-      i1 = k % this->NumberOfSides;
-      i2 = (k + 1) % this->NumberOfSides;
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
-      for (i = 0; i < npts; i++)
-      {
-        i3 = i * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
-      }
-    } // for each side of the tube
-  }
-  else
-  {
-    for (k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
-    {
-      i1 = 2 * (k % this->NumberOfSides) + 1;
-      i2 = 2 * ((k + 1) % this->NumberOfSides);
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
-      for (i = 0; i < npts; i++)
-      {
-        i3 = i * 2 * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
-      }
-    } // for each side of the tube
-  }
-
-  // Take care of capping. The caps are n-sided polygons that can be
-  // easily triangle stripped.
-  if (this->Capping)
-  {
-    vtkIdType startIdx = offset + npts * this->NumberOfSides;
-    vtkIdType idx;
-
-    if (!this->SidesShareVertices)
-    {
-      startIdx = offset + 2 * npts * this->NumberOfSides;
-    }
-
-    // The start cap
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + 1);
-    for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
-    {
-      if ((k % 2))
-      {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
-        i2++;
-      }
-      else
-      {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
-        i1--;
-      }
-    }
-
-    // The end cap - reversed order to be consistent with normal
-    startIdx += this->NumberOfSides;
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
-    for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
-    {
-      if ((k % 2))
-      {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
-        i1--;
-      }
-      else
-      {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
-        i2++;
-      }
-    }
-  }
+  CellArrayStrips strips = { newStrips, cd, outCD, inCellId };
+  ::GenerateTubeStrips(this, offset, npts, strips);
 }
 
 void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
@@ -681,10 +773,10 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
   double s0, s;
   if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS)
   {
-    s0 = inScalars->GetTuple1(pts[0]);
+    s0 = inScalars->GetComponent(pts[0], 0);
     for (i = 0; i < npts; i++)
     {
-      s = inScalars->GetTuple1(pts[i]);
+      s = inScalars->GetComponent(pts[i], 0);
       tc = (s - s0) / this->TextureLength;
       for (k = 0; k < numSides; k++)
       {
@@ -783,6 +875,166 @@ vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+// Generate all the tubes concurrently: the points and strips of each tube
+// are counted first, so that each polyline writes its tube at its place in
+// the output. The output is the same as the one of the serial traversal in
+// RequestData(). Returns false, without output, if the polylines have to be
+// processed serially: when the sliding normals of polylines sharing points
+// are generated, or when a polyline cannot be tubed, so that the serial
+// traversal reports it.
+bool vtkTubeFilter::GenerateTubesInParallel(vtkIdType firstCellId, vtkCellArray* inLines,
+  vtkPoints* inPts, vtkPointData* pd, vtkCellData* cd, vtkPointData* outPD, vtkCellData* outCD,
+  vtkPoints* newPts, vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+  vtkDataArray* inNormals, bool generateNormals)
+{
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  const vtkIdType numStripsPerLine = (this->NumberOfSides + this->OnRatio - 1) / this->OnRatio;
+  vtkSMPThreadLocalObject<vtkIdList> localCellIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localLinePts;
+
+  // Count the points and strips of each tube. When normals are generated,
+  // each polyline writes them at its points: check that no point is used by
+  // two polylines, the line using a point is stored plus one.
+  std::vector<TubeSize> offsets(numLines + 1);
+  std::vector<std::atomic<vtkIdType>> pointLines(generateNormals ? inPts->GetNumberOfPoints() : 0);
+  std::atomic<bool> sharedPoints(false);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellIds = localCellIds.Local();
+    std::vector<vtkIdType>& linePts = localLinePts.Local();
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      inLines->GetCellAtId(lineId, npts, pts, cellIds);
+      npts = ::UniqueLinePoints(inPts, npts, pts, linePts);
+      if (npts == 0)
+      {
+        continue;
+      }
+      TubeSize& size = offsets[lineId];
+      size.Points = this->ComputeOffset(0, npts);
+      size.Strips = numStripsPerLine + (this->Capping ? 2 : 0);
+      size.Connectivity =
+        2 * npts * numStripsPerLine + (this->Capping ? 2 * this->NumberOfSides : 0);
+
+      for (vtkIdType i = 0; generateNormals && i < npts; ++i)
+      {
+        vtkIdType line = 0;
+        if (!pointLines[linePts[i]].compare_exchange_strong(line, lineId + 1) &&
+          line != lineId + 1)
+        {
+          sharedPoints = true;
+        }
+      }
+    }
+  });
+  if (sharedPoints)
+  {
+    return false;
+  }
+  const TubeSize total =
+    vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), TubeSize());
+
+  newPts->SetNumberOfPoints(total.Points);
+  newNormals->SetNumberOfTuples(total.Points);
+  outPD->SetNumberOfTuples(total.Points);
+  outCD->SetNumberOfTuples(total.Strips);
+  if (newTCoords)
+  {
+    // No texture coordinates are generated for the cap points, the array ends
+    // with the sheath of the last tube.
+    const vtkIdType numCapPoints = this->Capping ? 2 * this->NumberOfSides : 0;
+    newTCoords->SetNumberOfTuples(total.Points > 0 ? total.Points - numCapPoints : 0);
+    if (this->Capping)
+    {
+      newTCoords->Fill(0.0);
+    }
+  }
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(total.Strips + 1);
+  stripOffsets->SetValue(total.Strips, total.Connectivity);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(total.Connectivity);
+
+  // Generate the tubes, the warnings are reported by the serial traversal
+  // if a polyline fails.
+  std::atomic<bool> failed(false);
+  this->ReportWarnings = false;
+  vtkSMPThreadLocalObject<vtkCellArray> localPolyline;
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellIds = localCellIds.Local();
+    std::vector<vtkIdType>& linePts = localLinePts.Local();
+    vtkCellArray* singlePolyline = localPolyline.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType lineId = begin; lineId < end && !failed; ++lineId)
+    {
+      if (lineId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      const TubeSize& offset = offsets[lineId];
+      if (offsets[lineId + 1].Points == offset.Points)
+      {
+        continue; // skip tubing this polyline
+      }
+      vtkIdType npts;
+      const vtkIdType* pts;
+      inLines->GetCellAtId(lineId, npts, pts, cellIds);
+      npts = ::UniqueLinePoints(inPts, npts, pts, linePts);
+      pts = linePts.data();
+
+      if (generateNormals)
+      {
+        singlePolyline->Reset();
+        singlePolyline->InsertNextCell(npts, pts);
+        vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      }
+
+      if (!this->GeneratePoints(offset.Points, npts, pts, inPts, newPts, pd, outPD, newNormals,
+            inScalars, range, inVectors, maxSpeed, inNormals))
+      {
+        failed = true;
+        break;
+      }
+
+      PreallocatedStrips strips = { stripOffsets->GetPointer(0), stripConnectivity->GetPointer(0),
+        cd, outCD, firstCellId + lineId, offset.Strips, offset.Connectivity };
+      ::GenerateTubeStrips(this, offset.Points, npts, strips);
+
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset.Points, npts, pts, inPts, inScalars, newTCoords);
+      }
+    }
+  });
+  this->ReportWarnings = true;
+
+  if (failed)
+  {
+    newPts->Reset();
+    newNormals->Reset();
+    outPD->Reset();
+    outCD->Reset();
+    if (newTCoords)
+    {
+      newTCoords->Reset();
+    }
+    return false;
+  }
+  newStrips->SetData(stripOffsets, stripConnectivity);
+  return true;
+}
+
 // Description:
 // Return the method of varying tube radius descriptive character string.
 const char* vtkTubeFilter::GetVaryRadiusAsString()
@@ -33,11 +33,15 @@
 #include "vtkSelectionNode.h"
 #include "vtkSignedCharArray.h"
 #include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkThreshold.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkExtractSelectedThresholds);
@@ -544,13 +548,37 @@ int vtkExtractSelectedThresholds::ExtractPoints(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+typedef std::vector<std::pair<std::string, std::string>> StringLimits;
+
+// Return whether a value of a string array lies within one of the [low, high]
+// pairs of limits, in lexicographic order.
+int EvaluateString(vtkStringArray* array, vtkIdType valueId, const StringLimits& limits)
+{
+  const std::string value(
+    array->GetValueData(valueId), static_cast<size_t>(array->GetValueSize(valueId)));
+  for (const auto& range : limits)
+  {
+    if (value >= range.first && value <= range.second)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
 //------------------------------------------------------------------------------
 int vtkExtractSelectedThresholds::ExtractRows(
   vtkSelectionNode* sel, vtkTable* input, vtkTable* output)
 {
-  // find the values to threshold within
+  // find the values to threshold within, string columns being thresholded
+  // by pairs of strings
   vtkDataArray* lims = vtkArrayDownCast<vtkDataArray>(sel->GetSelectionList());
-  if (lims == nullptr)
+  vtkStringArray* stringLims = vtkArrayDownCast<vtkStringArray>(sel->GetSelectionList());
+  if (lims == nullptr && stringLims == nullptr)
   {
     vtkErrorMacro(<< "No values to threshold with");
     return 1;
@@ -558,10 +586,16 @@ int vtkExtractSelectedThresholds::ExtractRows(
 
   // Determine the array to threshold.
   vtkDataArray* inScalars = nullptr;
+  vtkStringArray* inStrings = nullptr;
   bool use_ids = false;
   if (sel->GetSelectionList()->GetName())
   {
-    if (strcmp(sel->GetSelectionList()->GetName(), "vtkGlobalIds") == 0)
+    if (stringLims)
+    {
+      inStrings = vtkArrayDownCast<vtkStringArray>(
+        input->GetRowData()->GetAbstractArray(sel->GetSelectionList()->GetName()));
+    }
+    else if (strcmp(sel->GetSelectionList()->GetName(), "vtkGlobalIds") == 0)
     {
       inScalars = input->GetRowData()->GetGlobalIds();
     }
@@ -575,7 +609,7 @@ int vtkExtractSelectedThresholds::ExtractRows(
     }
   }
 
-  if (inScalars == nullptr && !use_ids)
+  if (inScalars == nullptr && inStrings == nullptr && !use_ids)
   {
     vtkErrorMacro("Could not figure out what array to threshold in.");
     return 1;
@@ -632,6 +666,28 @@ int vtkExtractSelectedThresholds::ExtractRows(
 
   flag = -flag;
 
+  StringLimits stringLimits;
+  std::vector<int> keepCodes;
+  const int* codes = nullptr;
+  if (inStrings)
+  {
+    for (vtkIdType i = 0; i + 1 < stringLims->GetNumberOfValues(); i += 2)
+    {
+      stringLimits.emplace_back(stringLims->GetValue(i), stringLims->GetValue(i + 1));
+    }
+    // compare each distinct value of a dictionary encoded column once
+    if (inStrings->GetDictionaryEncoding() && inStrings->GetNumberOfComponents() == 1)
+    {
+      vtkStringArray* dictionary = inStrings->GetDictionary();
+      keepCodes.resize(dictionary->GetNumberOfValues());
+      for (vtkIdType code = 0; code < dictionary->GetNumberOfValues(); ++code)
+      {
+        keepCodes[code] = ::EvaluateString(dictionary, code, stringLimits);
+      }
+      codes = inStrings->GetCodesArray()->GetPointer(0);
+    }
+  }
+
   vtkIdType outRCnt = 0;
   vtkIdType checkAbortInterval = std::min(numRows / 10 + 1, (vtkIdType)1000);
   for (vtkIdType rowId = 0; rowId < numRows; rowId++)
@@ -640,7 +696,20 @@ int vtkExtractSelectedThresholds::ExtractRows(
     {
       break;
     }
-    int keepRow = vtkExtractSelectedThresholds::EvaluateValue(inScalars, comp_no, rowId, lims);
+    int keepRow;
+    if (codes)
+    {
+      keepRow = keepCodes[codes[rowId]];
+    }
+    else if (inStrings)
+    {
+      keepRow = ::EvaluateString(
+        inStrings, rowId * inStrings->GetNumberOfComponents() + comp_no, stringLimits);
+    }
+    else
+    {
+      keepRow = vtkExtractSelectedThresholds::EvaluateValue(inScalars, comp_no, rowId, lims);
+    }
     if (keepRow ^ inverse)
     {
       if (passThrough)
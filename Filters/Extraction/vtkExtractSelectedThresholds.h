@@ -23,6 +23,9 @@
  * can specify to threshold a particular array within either the point or cell
  * attribute data of the input. This is similar to vtkThreshold
  * but allows multiple thresholds ranges.
+ * The rows of a vtkTable can also be extracted from a string column, when the
+ * selection list is a vtkStringArray of [low, high] pairs of strings compared
+ * in lexicographic order.
  * This filter adds a scalar array called vtkOriginalCellIds that says what
  * input cell produced each output cell. This is an example of a Pedigree ID
  * which helps to trace back results.
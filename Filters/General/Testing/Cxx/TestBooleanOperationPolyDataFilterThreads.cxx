@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBooleanOperationPolyDataFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkBooleanOperationPolyDataFilter produces the same surface and
+// intersection lines whatever the number of threads, that the surface bounds
+// the result of the operation on two spheres, and that sorting the cells with
+// winding numbers selects the same cells as with distances.
+
+#include "vtkBooleanOperationPolyDataFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool SameSurfaces(vtkPolyData* output, vtkPolyData* expected)
+{
+  return vtkSMPTestUtilities::SameArrays(
+           output->GetPoints()->GetData(), expected->GetPoints()->GetData(), "Points") &&
+    vtkSMPTestUtilities::SameCells(output->GetLines(), expected->GetLines(), "Lines") &&
+    vtkSMPTestUtilities::SameCells(output->GetPolys(), expected->GetPolys(), "Polys");
+}
+
+//------------------------------------------------------------------------------
+// Each point of the result lies on one of the spheres, of radius 0.5, and
+// outside of the other sphere for the union, inside for the intersection. The
+// difference keeps the part of the first sphere outside of the second one and
+// the part of the second one inside of the first one.
+bool OnBoundary(
+  vtkPolyData* output, const double center0[3], const double center1[3], int operation)
+{
+  const double tol = 0.01;
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    const double d0 = std::sqrt(vtkMath::Distance2BetweenPoints(x, center0));
+    const double d1 = std::sqrt(vtkMath::Distance2BetweenPoints(x, center1));
+    const bool on0 = std::abs(d0 - 0.5) < tol;
+    const bool on1 = std::abs(d1 - 0.5) < tol;
+    bool valid = false;
+    switch (operation)
+    {
+      case vtkBooleanOperationPolyDataFilter::VTK_UNION:
+        valid = (on0 && d1 > 0.5 - tol) || (on1 && d0 > 0.5 - tol);
+        break;
+      case vtkBooleanOperationPolyDataFilter::VTK_INTERSECTION:
+        valid = (on0 && d1 < 0.5 + tol) || (on1 && d0 < 0.5 + tol);
+        break;
+      default:
+        valid = (on0 && d1 > 0.5 - tol) || (on1 && d0 < 0.5 + tol);
+    }
+    if (!valid)
+    {
+      std::cerr << "Point " << ptId << " is not on the boundary of operation " << operation
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestBooleanOperationPolyDataFilterThreads(int, char*[])
+{
+  bool success = true;
+  vtkNew<vtkSphereSource> sphere0;
+  sphere0->SetThetaResolution(40);
+  sphere0->SetPhiResolution(30);
+  sphere0->SetCenter(0.25, 0.1, 0.05);
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetThetaResolution(43);
+  sphere1->SetPhiResolution(31);
+  sphere1->SetCenter(-0.2, 0.0, 0.0);
+
+  vtkNew<vtkBooleanOperationPolyDataFilter> boolean;
+  boolean->SetInputConnection(0, sphere0->GetOutputPort());
+  boolean->SetInputConnection(1, sphere1->GetOutputPort());
+  vtkNew<vtkPolyData> expected;
+  for (int operation = vtkBooleanOperationPolyDataFilter::VTK_UNION;
+       operation <= vtkBooleanOperationPolyDataFilter::VTK_DIFFERENCE; ++operation)
+  {
+    boolean->SetOperation(operation);
+    boolean->UseWindingNumbersOff();
+    success &= vtkSMPTestUtilities::CompareThreads(boolean, "vtkBooleanOperationPolyDataFilter");
+    expected->DeepCopy(boolean->GetOutput(0));
+    if (expected->GetNumberOfPolys() == 0 || boolean->GetOutput(1)->GetNumberOfLines() == 0)
+    {
+      std::cerr << "Operation " << operation << " produced no cells." << std::endl;
+      success = false;
+    }
+    success &= ::OnBoundary(expected, sphere0->GetCenter(), sphere1->GetCenter(), operation);
+
+    boolean->UseWindingNumbersOn();
+    boolean->Update();
+    vtkPolyData* output = boolean->GetOutput(0);
+    if (!::SameSurfaces(output, expected) || !output->GetCellData()->GetArray("WindingNumber"))
+    {
+      std::cerr << "Operation " << operation << " selects other cells with winding numbers."
+                << std::endl;
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,18 +15,233 @@
 #include "vtkBooleanOperationPolyDataFilter.h"
 
 #include "vtkCellData.h"
+#include "vtkCellType.h"
 #include "vtkDistancePolyDataFilter.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIdList.h"
 #include "vtkIntersectionPolyDataFilter.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Fast generalized winding numbers of points with respect to the triangles of
+// a surface (Barill et al., "Fast Winding Numbers for Soups and Clouds", 2018).
+// A bounding volume hierarchy groups the triangles. The contribution of a
+// group far enough from the point is approximated by the one of a dipole at
+// its area weighted center, with the sum of the area weighted normals of its
+// triangles. The solid angles of the near triangles are computed exactly.
+class vtkWindingNumberTree
+{
+public:
+  void Build(vtkPolyData* surface)
+  {
+    this->Triangles.clear();
+    this->Nodes.clear();
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); cellId++)
+    {
+      const int cellType = surface->GetCellType(cellId);
+      if (cellType != VTK_TRIANGLE && cellType != VTK_QUAD && cellType != VTK_POLYGON)
+      {
+        continue;
+      }
+      vtkIdType npts;
+      const vtkIdType* pts;
+      surface->GetCellPoints(cellId, npts, pts, ptIds);
+      // fan triangulation of the polygons
+      for (vtkIdType i = 1; i + 1 < npts; i++)
+      {
+        Triangle triangle;
+        surface->GetPoint(pts[0], triangle.Points[0]);
+        surface->GetPoint(pts[i], triangle.Points[1]);
+        surface->GetPoint(pts[i + 1], triangle.Points[2]);
+        double v1[3], v2[3];
+        vtkMath::Subtract(triangle.Points[1], triangle.Points[0], v1);
+        vtkMath::Subtract(triangle.Points[2], triangle.Points[0], v2);
+        vtkMath::Cross(v1, v2, triangle.Normal);
+        vtkMath::MultiplyScalar(triangle.Normal, 0.5);
+        for (int j = 0; j < 3; j++)
+        {
+          triangle.Center[j] =
+            (triangle.Points[0][j] + triangle.Points[1][j] + triangle.Points[2][j]) / 3.0;
+        }
+        this->Triangles.push_back(triangle);
+      }
+    }
+    if (!this->Triangles.empty())
+    {
+      this->BuildNode(0, static_cast<vtkIdType>(this->Triangles.size()));
+    }
+  }
+
+  double Evaluate(const double x[3]) const
+  {
+    if (this->Nodes.empty())
+    {
+      return 0.0;
+    }
+    double solidAngle = 0.0;
+    std::vector<vtkIdType> stack(1, 0);
+    while (!stack.empty())
+    {
+      const Node& node = this->Nodes[stack.back()];
+      stack.pop_back();
+      double d[3];
+      vtkMath::Subtract(node.Center, x, d);
+      const double dist = vtkMath::Norm(d);
+      if (dist > vtkWindingNumberTree::Accuracy * node.Radius)
+      {
+        // far field: dipole approximation
+        solidAngle += vtkMath::Dot(d, node.Normal) / (dist * dist * dist);
+      }
+      else if (node.Children[0] < 0)
+      {
+        for (vtkIdType i = node.Begin; i < node.End; i++)
+        {
+          solidAngle += vtkWindingNumberTree::SolidAngle(this->Triangles[i], x);
+        }
+      }
+      else
+      {
+        stack.push_back(node.Children[0]);
+        stack.push_back(node.Children[1]);
+      }
+    }
+    return solidAngle / (4.0 * vtkMath::Pi());
+  }
+
+private:
+  struct Triangle
+  {
+    double Points[3][3];
+    double Center[3];
+    double Normal[3]; // area weighted
+  };
+
+  struct Node
+  {
+    double Center[3];
+    double Normal[3];
+    double Radius;
+    vtkIdType Begin;
+    vtkIdType End;
+    vtkIdType Children[2];
+  };
+
+  // Ratio of the distance of a group to its radius above which the group is
+  // approximated by a dipole
+  static constexpr double Accuracy = 2.0;
+  static constexpr vtkIdType LeafSize = 8;
+
+  // Van Oosterom and Strackee formula
+  static double SolidAngle(const Triangle& triangle, const double x[3])
+  {
+    double a[3], b[3], c[3], bc[3];
+    vtkMath::Subtract(triangle.Points[0], x, a);
+    vtkMath::Subtract(triangle.Points[1], x, b);
+    vtkMath::Subtract(triangle.Points[2], x, c);
+    const double la = vtkMath::Norm(a);
+    const double lb = vtkMath::Norm(b);
+    const double lc = vtkMath::Norm(c);
+    vtkMath::Cross(b, c, bc);
+    const double numerator = vtkMath::Dot(a, bc);
+    const double denominator =
+      la * lb * lc + vtkMath::Dot(a, b) * lc + vtkMath::Dot(a, c) * lb + vtkMath::Dot(b, c) * la;
+    return 2.0 * std::atan2(numerator, denominator);
+  }
+
+  vtkIdType BuildNode(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType nodeId = static_cast<vtkIdType>(this->Nodes.size());
+    this->Nodes.emplace_back();
+    Node node;
+    node.Begin = begin;
+    node.End = end;
+    node.Children[0] = node.Children[1] = -1;
+
+    // area weighted center, sum of the normals, and bounds of the centers
+    double area = 0.0;
+    double center[3] = { 0.0, 0.0, 0.0 };
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    double normal[3] = { 0.0, 0.0, 0.0 };
+    double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+      VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const Triangle& triangle = this->Triangles[i];
+      const double triangleArea = vtkMath::Norm(triangle.Normal);
+      area += triangleArea;
+      for (int j = 0; j < 3; j++)
+      {
+        center[j] += triangleArea * triangle.Center[j];
+        mean[j] += triangle.Center[j];
+        normal[j] += triangle.Normal[j];
+        bounds[2 * j] = std::min(bounds[2 * j], triangle.Center[j]);
+        bounds[2 * j + 1] = std::max(bounds[2 * j + 1], triangle.Center[j]);
+      }
+    }
+    for (int j = 0; j < 3; j++)
+    {
+      node.Center[j] = area > 0.0 ? center[j] / area : mean[j] / (end - begin);
+      node.Normal[j] = normal[j];
+    }
+    node.Radius = 0.0;
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      for (int k = 0; k < 3; k++)
+      {
+        node.Radius = std::max(node.Radius,
+          vtkMath::Distance2BetweenPoints(node.Center, this->Triangles[i].Points[k]));
+      }
+    }
+    node.Radius = std::sqrt(node.Radius);
+
+    if (end - begin > vtkWindingNumberTree::LeafSize)
+    {
+      // median split along the largest extent of the centers
+      int axis = 0;
+      for (int j = 1; j < 3; j++)
+      {
+        if (bounds[2 * j + 1] - bounds[2 * j] > bounds[2 * axis + 1] - bounds[2 * axis])
+        {
+          axis = j;
+        }
+      }
+      const vtkIdType middle = begin + (end - begin) / 2;
+      std::nth_element(this->Triangles.begin() + begin, this->Triangles.begin() + middle,
+        this->Triangles.begin() + end, [axis](const Triangle& t1, const Triangle& t2)
+        { return t1.Center[axis] < t2.Center[axis]; });
+      node.Children[0] = this->BuildNode(begin, middle);
+      node.Children[1] = this->BuildNode(middle, end);
+    }
+    this->Nodes[nodeId] = node;
+    return nodeId;
+  }
+
+  std::vector<Triangle> Triangles;
+  std::vector<Node> Nodes;
+};
+
+constexpr double vtkWindingNumberTree::Accuracy;
+constexpr vtkIdType vtkWindingNumberTree::LeafSize;
+}
+
 vtkStandardNewMacro(vtkBooleanOperationPolyDataFilter);
 
 //------------------------------------------------------------------------------
@@ -35,6 +250,7 @@ vtkBooleanOperationPolyDataFilter::vtkBooleanOperationPolyDataFilter()
   this->Tolerance = 1e-6;
   this->Operation = VTK_UNION;
   this->ReorientDifferenceCells = 1;
+  this->UseWindingNumbers = 0;
 
   this->SetNumberOfInputPorts(2);
   this->SetNumberOfOutputPorts(2);
@@ -49,6 +265,24 @@ void vtkBooleanOperationPolyDataFilter::SortPolyData(
 {
   int numCells = input->GetNumberOfCells();
 
+  if (this->UseWindingNumbers)
+  {
+    vtkDoubleArray* windingArray =
+      vtkArrayDownCast<vtkDoubleArray>(input->GetCellData()->GetArray("WindingNumber"));
+    for (int cid = 0; cid < numCells; cid++)
+    {
+      if (windingArray->GetValue(cid) > 0.5)
+      {
+        intersectionList->InsertNextId(cid);
+      }
+      else
+      {
+        unionList->InsertNextId(cid);
+      }
+    }
+    return;
+  }
+
   vtkDoubleArray* distArray =
     vtkArrayDownCast<vtkDoubleArray>(input->GetCellData()->GetArray("Distance"));
 
@@ -66,6 +300,64 @@ void vtkBooleanOperationPolyDataFilter::SortPolyData(
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkBooleanOperationPolyDataFilter::ComputeWindingNumbers(
+  vtkPolyData* mesh, vtkPolyData* surface)
+{
+  for (vtkPolyData* polyData : { mesh, surface })
+  {
+    if (polyData->NeedToBuildCells())
+    {
+      polyData->BuildCells();
+    }
+  }
+  vtkWindingNumberTree tree;
+  tree.Build(surface);
+
+  const vtkIdType numCells = mesh->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> windingArray;
+  windingArray->SetName("WindingNumber");
+  windingArray->SetNumberOfTuples(numCells);
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIds = tlPtIds.Local();
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+        if (cellId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        vtkIdType npts;
+        const vtkIdType* pts;
+        mesh->GetCellPoints(cellId, npts, pts, ptIds);
+        double center[3] = { 0.0, 0.0, 0.0 };
+        for (vtkIdType i = 0; i < npts; i++)
+        {
+          double x[3];
+          mesh->GetPoint(pts[i], x);
+          vtkMath::Add(center, x, center);
+        }
+        if (npts > 0)
+        {
+          vtkMath::MultiplyScalar(center, 1.0 / npts);
+        }
+        windingArray->SetValue(cellId, tree.Evaluate(center));
+      }
+    });
+  mesh->GetCellData()->AddArray(windingArray);
+}
+
 //------------------------------------------------------------------------------
 int vtkBooleanOperationPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -112,18 +404,37 @@ int vtkBooleanOperationPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(re
   outputIntersection->GetPointData()->PassData(PolyDataIntersection->GetOutput()->GetPointData());
   outputIntersection->GetCellData()->PassData(PolyDataIntersection->GetOutput()->GetCellData());
 
-  // Compute distances
-  vtkSmartPointer<vtkDistancePolyDataFilter> PolyDataDistance =
-    vtkSmartPointer<vtkDistancePolyDataFilter>::New();
-
-  PolyDataDistance->SetInputConnection(0, PolyDataIntersection->GetOutputPort(1));
-  PolyDataDistance->SetInputConnection(1, PolyDataIntersection->GetOutputPort(2));
-  PolyDataDistance->ComputeSecondDistanceOn();
-  PolyDataDistance->SetContainerAlgorithm(this);
-  PolyDataDistance->Update();
-
-  vtkPolyData* pd0 = PolyDataDistance->GetOutput();
-  vtkPolyData* pd1 = PolyDataDistance->GetSecondDistanceOutput();
+  vtkSmartPointer<vtkPolyData> pd0;
+  vtkSmartPointer<vtkPolyData> pd1;
+  if (this->UseWindingNumbers)
+  {
+    // Compute winding numbers
+    pd0 = vtkSmartPointer<vtkPolyData>::New();
+    pd0->ShallowCopy(PolyDataIntersection->GetOutput(1));
+    pd1 = vtkSmartPointer<vtkPolyData>::New();
+    pd1->ShallowCopy(PolyDataIntersection->GetOutput(2));
+    this->ComputeWindingNumbers(pd0, pd1);
+    this->ComputeWindingNumbers(pd1, pd0);
+    if (this->CheckAbort())
+    {
+      return 1;
+    }
+  }
+  else
+  {
+    // Compute distances
+    vtkSmartPointer<vtkDistancePolyDataFilter> PolyDataDistance =
+      vtkSmartPointer<vtkDistancePolyDataFilter>::New();
+
+    PolyDataDistance->SetInputConnection(0, PolyDataIntersection->GetOutputPort(1));
+    PolyDataDistance->SetInputConnection(1, PolyDataIntersection->GetOutputPort(2));
+    PolyDataDistance->ComputeSecondDistanceOn();
+    PolyDataDistance->SetContainerAlgorithm(this);
+    PolyDataDistance->Update();
+
+    pd0 = PolyDataDistance->GetOutput();
+    pd1 = PolyDataDistance->GetSecondDistanceOutput();
+  }
 
   pd0->BuildCells();
   pd0->BuildLinks();
@@ -241,6 +552,7 @@ void vtkBooleanOperationPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << "\n";
   os << indent << "ReorientDifferenceCells: " << this->ReorientDifferenceCells << "\n";
+  os << indent << "UseWindingNumbers: " << this->UseWindingNumbers << "\n";
 }
 
 //------------------------------------------------------------------------------
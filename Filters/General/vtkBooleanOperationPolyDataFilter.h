@@ -24,6 +24,13 @@
  * contains a set of polylines that represent the intersection between
  * the two input surfaces.
  *
+ * The cells of each intersected surface are sorted as inside or outside of
+ * the other surface with the signed distance of their centers, or, with
+ * UseWindingNumbers on, with the generalized winding number of their centers
+ * which is robust to holes and self intersections of the other surface.
+ * The intersection of the surfaces, the remeshing of the intersected cells
+ * and the sorting of the cells are performed in parallel with vtkSMPTools.
+ *
  * @warning This filter is not designed to perform 2D boolean operations,
  * and in fact relies on the inputs having no co-planar, overlapping cells.
  *
@@ -94,6 +101,21 @@ public:
   vtkGetMacro(Tolerance, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the sorting of the cells with the generalized winding numbers
+   * of their centers with respect to the other surface, in place of their
+   * signed distance to it. A cell is inside the other surface when the
+   * winding number of its center is greater than 0.5. The winding numbers are
+   * evaluated with a bounding volume hierarchy approximating far triangles by
+   * dipoles, and the output cell data has a WindingNumber array in place of
+   * the Distance arrays. Defaults to off.
+   */
+  vtkSetMacro(UseWindingNumbers, vtkTypeBool);
+  vtkGetMacro(UseWindingNumbers, vtkTypeBool);
+  vtkBooleanMacro(UseWindingNumbers, vtkTypeBool);
+  ///@}
+
 protected:
   vtkBooleanOperationPolyDataFilter();
   ~vtkBooleanOperationPolyDataFilter() override;
@@ -103,6 +125,12 @@ protected:
    */
   void SortPolyData(vtkPolyData* input, vtkIdList* intersectionList, vtkIdList* unionList);
 
+  /**
+   * Adds a WindingNumber cell array to mesh with the winding numbers of the
+   * cell centers with respect to surface.
+   */
+  void ComputeWindingNumbers(vtkPolyData* mesh, vtkPolyData* surface);
+
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
 
@@ -138,6 +166,8 @@ private:
    */
   vtkTypeBool ReorientDifferenceCells;
   ///@}
+
+  vtkTypeBool UseWindingNumbers;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -32,6 +32,9 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkTransform.h"
@@ -40,8 +43,12 @@
 #include "vtkTriangleFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <set>
+#include <utility>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -86,16 +93,59 @@ public:
   virtual ~Impl();
 
   // Finds all triangle triangle intersections between two input OOBTrees
-  static int FindTriangleIntersections(
-    vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
+  void FindTriangleIntersections(vtkOBBTree* obbTree0);
 
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
 protected:
+  // Intersection between a triangle of each input, computed concurrently
+  // and added to the intersection lines in the order of the OBB traversal.
+  struct TriangleIntersection
+  {
+    vtkIdType LeafPairId;
+    vtkIdType CellId0;
+    vtkIdType CellId1;
+    double Points[2][3];
+    double SurfaceIds[2];
+  };
+
+  // Updates of the shared arrays made while splitting a cell, deferred
+  // so that the cells can be split concurrently and the updates applied
+  // in the order of the cells.
+  struct SplitCellUpdates
+  {
+    struct NewCell
+    {
+      vtkIdType CellIndex;
+      int InterPtCount;
+      int InterPts[3];
+    };
+    std::vector<std::pair<vtkIdType, int>> BoundaryPoints;
+    std::vector<NewCell> NewCells;
+
+    void AddNewCell(vtkIdType cellIndex, int interPtCount, const int interPts[3])
+    {
+      NewCell newCell = { cellIndex, interPtCount, { 0, 0, 0 } };
+      std::copy(interPts, interPts + interPtCount, newCell.InterPts);
+      this->NewCells.push_back(newCell);
+    }
+  };
+
+  // Records the leaf pairs of intersecting OBBs in traversal order
+  static int CollectLeafPairs(
+    vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
+
+  // Intersects the triangles of a pair of intersecting leaf nodes
+  void IntersectLeafPair(vtkIdType leafPairId, vtkOBBNode* node0, vtkOBBNode* node1,
+    vtkIdList* ptIds, std::vector<TriangleIntersection>& intersections);
+
+  // Adds a triangle triangle intersection to the lines and maps
+  void AddTriangleIntersection(const TriangleIntersection& intersection);
+
   // Split cells into polygons created by intersection lines
   vtkCellArray* SplitCell(vtkPolyData* input, vtkIdType cellId, const vtkIdType* cellPts,
-    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, int numCurrCells);
+    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, SplitCellUpdates* updates);
 
   // Function to add point to check edge list for remeshing step
   int AddToPointEdgeMap(int index, vtkIdType ptId, double x[3], vtkPolyData* mesh, vtkIdType cellId,
@@ -170,10 +220,16 @@ public:
   // cell, and the ID of the line.
   PointEdgeMapType* PointEdgeMap[2];
 
-  // vtkPolyData to hold current splitting cell. Used to double check area
-  // of small area cells
-  vtkPolyData* SplittingPD;
-  int TransformSign;
+  // Pairs of intersecting leaf nodes of the OBB trees
+  std::vector<std::pair<vtkOBBNode*, vtkOBBNode*>> LeafPairs;
+
+  // End points of the intersection lines, to check for duplicate lines
+  std::set<std::pair<vtkIdType, vtkIdType>> LineEndPoints;
+
+  // vtkPolyData to hold current splitting cell of each thread. Used to
+  // double check area of small area cells
+  vtkSMPThreadLocalObject<vtkPolyData> SplittingPD;
+  vtkSMPThreadLocal<int> TransformSign;
   double Tolerance;
   double RelativeSubtriangleArea;
 
@@ -201,8 +257,6 @@ vtkIntersectionPolyDataFilter::Impl::Impl()
     this->PointEdgeMap[i] = new PointEdgeMapType();
   }
   this->PointMapper = new IntersectionMapType();
-  this->SplittingPD = vtkPolyData::New();
-  this->TransformSign = 0;
   this->Tolerance = 1e-6;
   this->RelativeSubtriangleArea = 1e-4;
 }
@@ -217,26 +271,101 @@ vtkIntersectionPolyDataFilter::Impl::~Impl()
     delete this->PointEdgeMap[i];
   }
   delete this->PointMapper;
-  this->SplittingPD->Delete();
 }
 
 //------------------------------------------------------------------------------
-int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
-  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg)
+int vtkIntersectionPolyDataFilter::Impl ::CollectLeafPairs(
+  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* vtkNotUsed(transform), void* arg)
 {
   vtkIntersectionPolyDataFilter::Impl* info =
     reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
+  info->LeafPairs.emplace_back(node0, node1);
+  return 1;
+}
 
-  // Set up local structures to hold Impl array information
-  vtkPolyData* mesh0 = info->Mesh[0];
-  vtkPolyData* mesh1 = info->Mesh[1];
-  vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
-  double tolerance = info->Tolerance;
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(vtkOBBTree* obbTree0)
+{
+  // The OBB traversal only gathers the pairs of intersecting leaf nodes. The
+  // triangles of the pairs are then intersected concurrently, and the
+  // intersections are added to the lines in the order of the pairs so that
+  // the output does not depend on the number of threads.
+  this->LeafPairs.clear();
+  obbTree0->IntersectWithOBBTree(
+    this->OBBTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::CollectLeafPairs, this);
+  const vtkIdType numLeafPairs = static_cast<vtkIdType>(this->LeafPairs.size());
+  for (vtkPolyData* mesh : this->Mesh)
+  {
+    if (mesh->NeedToBuildCells())
+    {
+      mesh->BuildCells();
+    }
+  }
+
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  vtkSMPThreadLocal<std::vector<TriangleIntersection>> tlIntersections;
+  vtkSMPTools::For(0, numLeafPairs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIds = tlPtIds.Local();
+      std::vector<TriangleIntersection>& intersections = tlIntersections.Local();
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType leafPairId = begin; leafPairId < end; leafPairId++)
+      {
+        if (leafPairId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->ParentFilter->CheckAbort();
+          }
+          if (this->ParentFilter->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        this->IntersectLeafPair(leafPairId, this->LeafPairs[leafPairId].first,
+          this->LeafPairs[leafPairId].second, ptIds, intersections);
+      }
+    });
+  if (this->ParentFilter->GetAbortOutput())
+  {
+    this->LeafPairs.clear();
+    return;
+  }
+
+  // Each pair is intersected by a single thread, sorting the intersections
+  // by pair restores the order of a serial traversal.
+  std::vector<TriangleIntersection> intersections;
+  for (auto& threadIntersections : tlIntersections)
+  {
+    intersections.insert(
+      intersections.end(), threadIntersections.begin(), threadIntersections.end());
+  }
+  std::stable_sort(intersections.begin(), intersections.end(),
+    [](const TriangleIntersection& a, const TriangleIntersection& b)
+    { return a.LeafPairId < b.LeafPairId; });
+  this->LeafPairs.clear();
+
+  this->LineEndPoints.clear();
+  for (const TriangleIntersection& intersection : intersections)
+  {
+    this->AddTriangleIntersection(intersection);
+  }
+  this->LineEndPoints.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl ::IntersectLeafPair(vtkIdType leafPairId,
+  vtkOBBNode* node0, vtkOBBNode* node1, vtkIdList* ptIds,
+  std::vector<TriangleIntersection>& intersections)
+{
+  // Set up local structures to hold Impl array information. The cells of the
+  // meshes are built, the thread safe versions of the cell queries are used.
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkOBBTree* obbTree1 = this->OBBTree1;
+  double tolerance = this->Tolerance;
 
   // The number of cells in OBBTree
   int numCells0 = node0->Cells->GetNumberOfIds();
@@ -251,14 +380,14 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
     {
       vtkIdType npts0;
       const vtkIdType* triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
+      mesh0->GetCellPoints(cellId0, npts0, triPtIds0, ptIds);
       double triPts0[3][3];
       for (vtkIdType id = 0; id < npts0; id++)
       {
         mesh0->GetPoint(triPtIds0[id], triPts0[id]);
       }
 
-      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], transform))
+      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], nullptr))
       {
         int numCells1 = node1->Cells->GetNumberOfIds();
         for (vtkIdType id1 = 0; id1 < numCells1; id1++)
@@ -267,12 +396,11 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
           int type1 = mesh1->GetCellType(cellId1);
           if (type1 == VTK_TRIANGLE)
           {
-            // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
+            // See if the two cells actually intersect. If they do, keep
+            // the intersection to add it to the maps and the lines.
             vtkIdType npts1;
             const vtkIdType* triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
+            mesh1->GetCellPoints(cellId1, npts1, triPtIds1, ptIds);
 
             double triPts1[3][3];
             for (vtkIdType id = 0; id < npts1; id++)
@@ -281,186 +409,202 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
             }
 
             int coplanar = 0;
-            double outpt0[3], outpt1[3];
-            double surfaceid[2];
+            TriangleIntersection intersection;
             int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
-              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, outpt0, outpt1,
-              surfaceid, tolerance);
+              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar,
+              intersection.Points[0], intersection.Points[1], intersection.SurfaceIds, tolerance);
 
-            if (coplanar)
+            // Coplanar triangle intersection is not handled.
+            // This intersection will not be included in the output. TODO
+            if (intersects && !coplanar)
             {
-              // Coplanar triangle intersection is not handled.
-              // This intersection will not be included in the output. TODO
-              // vtkDebugMacro(<<"Coplanar");
-              intersects = 0;
-              continue;
+              intersection.LeafPairId = leafPairId;
+              intersection.CellId0 = cellId0;
+              intersection.CellId1 = cellId1;
+              intersections.push_back(intersection);
             }
+          }
+        }
+      }
+    }
+  }
+}
 
-            // If actual intersection, add point and cell to edge, line,
-            // and surface maps!
-            if (intersects)
-            {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl ::AddTriangleIntersection(
+  const TriangleIntersection& intersection)
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+  const vtkIdType cellId0 = intersection.CellId0;
+  const vtkIdType cellId1 = intersection.CellId1;
+  double outpt0[3], outpt1[3];
+  std::copy(intersection.Points[0], intersection.Points[0] + 3, outpt0);
+  std::copy(intersection.Points[1], intersection.Points[1] + 3, outpt1);
+  const double* surfaceid = intersection.SurfaceIds;
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+  vtkIdType npts0, npts1;
+  const vtkIdType *triPtIds0, *triPtIds1;
+  mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
+  mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  // Add point and cell to edge, line, and surface maps!
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
-        }
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
+
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
       }
     }
   }
 
-  return 1;
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    if (this->LineEndPoints.count(std::minmax(ptId0, ptId1)))
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+    this->LineEndPoints.insert(std::minmax(ptId0, ptId1));
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge =
+        this->AddToPointEdgeMap(0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge =
+        this->AddToPointEdgeMap(0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge =
+        this->AddToPointEdgeMap(1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge =
+        this->AddToPointEdgeMap(1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -532,17 +676,108 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
   if (input->GetPolys()->GetNumberOfCells() > 0)
   {
     vtkCellArray* cells = input->GetPolys();
+    const vtkIdType numPolys = cells->GetNumberOfCells();
     vtkIdType newId = output->GetNumberOfCells();
 
     vtkSmartPointer<vtkCellArray> newPolys = vtkSmartPointer<vtkCellArray>::New();
 
-    newPolys->AllocateEstimate(cells->GetNumberOfCells(), 3);
+    newPolys->AllocateEstimate(numPolys, 3);
     output->SetPolys(newPolys);
 
-    vtkSmartPointer<vtkIdList> edgeNeighbors = vtkSmartPointer<vtkIdList>::New();
+    // The cells are split concurrently, the shared structures are built
+    // beforehand.
+    splitLines->BuildLinks();
+    input->GetBounds();
+
+    // Collect the cells relevant for splitting each cell.  If the
+    // cell is in the intersection map, split. If not, one of its
+    // edges may be split by an intersection line that splits a
+    // neighbor cell. Mark the cell as needing a split if this is
+    // the case.
+    std::vector<char> needsSplit(numPolys, 0);
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPtIds;
+    vtkSMPThreadLocalObject<vtkIdList> tlEdgeNeighbors;
+    vtkSMPTools::For(0, numPolys,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtkIdList* cellPtIds = tlCellPtIds.Local();
+        vtkIdList* edgeNeighbors = tlEdgeNeighbors.Local();
+        vtkIdType nptsX;
+        const vtkIdType* pts;
+        for (vtkIdType polyId = begin; polyId < end; polyId++)
+        {
+          cells->GetCellAtId(polyId, nptsX, pts, cellPtIds);
+          if (nptsX != 3)
+          {
+            continue;
+          }
+          bool split = intersectionMap->find(polyId) != intersectionMap->end();
+          for (vtkIdType ptId = 0; ptId < nptsX && !split; ptId++)
+          {
+            vtkIdType pt0Id = pts[ptId];
+            vtkIdType pt1Id = pts[(ptId + 1) % nptsX];
+            edgeNeighbors->Reset();
+            input->GetCellEdgeNeighbors(polyId, pt0Id, pt1Id, edgeNeighbors);
+            for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
+            {
+              if (intersectionMap->find(edgeNeighbors->GetId(nbr)) != intersectionMap->end())
+              {
+                split = true;
+              }
+            }
+          }
+          needsSplit[polyId] = split;
+        }
+      });
+
+    std::vector<vtkIdType> splitCellIds;
+    for (vtkIdType polyId = 0; polyId < numPolys; polyId++)
+    {
+      if (needsSplit[polyId])
+      {
+        splitCellIds.push_back(polyId);
+      }
+    }
+
+    // Splitting occurs here
+    const vtkIdType numSplitCells = static_cast<vtkIdType>(splitCellIds.size());
+    std::vector<vtkSmartPointer<vtkCellArray>> splitCellsList(numSplitCells);
+    std::vector<SplitCellUpdates> splitCellsUpdates(numSplitCells);
+    vtkSMPTools::For(0, numSplitCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtkIdList* cellPtIds = tlCellPtIds.Local();
+        vtkIdType nptsX;
+        const vtkIdType* pts;
+        bool isFirst = vtkSMPTools::GetSingleThread();
+        vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+        for (vtkIdType splitId = begin; splitId < end; splitId++)
+        {
+          if (splitId % checkAbortInterval == 0)
+          {
+            if (isFirst)
+            {
+              this->ParentFilter->CheckAbort();
+            }
+            if (this->ParentFilter->GetAbortOutput())
+            {
+              break;
+            }
+          }
+          const vtkIdType splitCellId = splitCellIds[splitId];
+          cells->GetCellAtId(splitCellId, nptsX, pts, cellPtIds);
+          splitCellsList[splitId].TakeReference(this->SplitCell(input, splitCellId, pts,
+            intersectionMap, splitLines, inputIndex, &splitCellsUpdates[splitId]));
+        }
+      });
+    if (this->ParentFilter->GetAbortOutput())
+    {
+      return 1;
+    }
+
     vtkIdType nptsX = 0;
     const vtkIdType* pts = nullptr;
-    vtkSmartPointer<vtkIdList> cellsToCheck = vtkSmartPointer<vtkIdList>::New();
+    vtkIdType splitId = 0;
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
     {
       if (nptsX != 3)
@@ -552,36 +787,7 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
         continue;
       }
 
-      cellsToCheck->Reset();
-      cellsToCheck->Allocate(nptsX + 1);
-      cellsToCheck->InsertNextId(cellIdX);
-
-      // Collect the cells relevant for splitting this cell.  If the
-      // cell is in the intersection map, split. If not, one of its
-      // edges may be split by an intersection line that splits a
-      // neighbor cell. Mark the cell as needing a split if this is
-      // the case.
-      bool needsSplit = intersectionMap->find(cellIdX) != intersectionMap->end();
-      for (vtkIdType ptId = 0; ptId < nptsX; ptId++)
-      {
-        vtkIdType pt0Id = pts[ptId];
-        vtkIdType pt1Id = pts[(ptId + 1) % nptsX];
-        edgeNeighbors->Reset();
-        input->GetCellEdgeNeighbors(cellIdX, pt0Id, pt1Id, edgeNeighbors);
-        for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
-        {
-          vtkIdType nbrId = edgeNeighbors->GetId(nbr);
-          cellsToCheck->InsertNextId(nbrId);
-
-          if (intersectionMap->find(nbrId) != intersectionMap->end())
-          {
-            needsSplit = true;
-          }
-        } // for (vtkIdType nbr = 0; ...
-      }   // for (vtkIdType pt = 0; ...
-
-      // Splitting occurs here
-      if (!needsSplit)
+      if (!needsSplit[cellIdX])
       {
         // Just insert the cell and copy the cell data
         newId = newPolys->InsertNextCell(3, pts);
@@ -592,8 +798,20 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
         // Total number of cells so that we know the id numbers of the new
         // cells added and we can add it to the new cell id mapping
         int numCurrCells = newPolys->GetNumberOfCells();
-        vtkCellArray* splitCells = this->SplitCell(
-          input, cellIdX, pts, intersectionMap, splitLines, inputIndex, numCurrCells);
+        vtkCellArray* splitCells = splitCellsList[splitId];
+        const SplitCellUpdates& updates = splitCellsUpdates[splitId++];
+        for (const auto& boundaryPoint : updates.BoundaryPoints)
+        {
+          this->BoundaryPoints[inputIndex]->InsertValue(
+            boundaryPoint.first, boundaryPoint.second);
+        }
+        for (const auto& newCell : updates.NewCells)
+        {
+          int interPts[3];
+          std::copy(newCell.InterPts, newCell.InterPts + 3, interPts);
+          this->AddToNewCellMap(inputIndex, newCell.InterPtCount, interPts, splitLines,
+            numCurrCells + newCell.CellIndex);
+        }
         if (splitCells == nullptr)
         {
           vtkDebugWithObjectMacro(this->ParentFilter, << "Error in splitting cell!");
@@ -636,7 +854,6 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
           outCD->CopyData(inCD, cellIdX, newId); // Duplicate cell data
         }
-        splitCells->Delete();
       }
     } // for (cells->InitTraversal(); ...
   }   // if inputGetPolys()->GetNumberOfCells() > 1 ...
@@ -646,8 +863,12 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
 vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input, vtkIdType cellId,
   const vtkIdType* cellPts, IntersectionMapType* map, vtkPolyData* interLines, int inputIndex,
-  int numCurrCells)
+  SplitCellUpdates* updates)
 {
+  // Index of the next cell of the split cells, offset by the number of
+  // output cells when the updates are applied
+  int numCurrCells = 0;
+
   // Copy down the SurfaceID array that tells which surface the point belongs
   // to
   vtkIdTypeArray* surfaceMapper;
@@ -691,6 +912,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   // vtkDelaunay2D back to the original IDs in interLines. NOTE: The
   // point IDs from the cell are not stored here.
   std::map<vtkIdType, vtkIdType> ptIdMap;
+  vtkSmartPointer<vtkIdList> linePtIdList = vtkSmartPointer<vtkIdList>::New();
 
   IntersectionMapIteratorType iterLower = map->lower_bound(cellId);
   IntersectionMapIteratorType iterUpper = map->upper_bound(cellId);
@@ -700,7 +922,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     vtkIdType lineId = iterLower->second;
     vtkIdType nLinePts;
     const vtkIdType* linePtIds;
-    interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds);
+    interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds, linePtIdList);
 
     interceptlines->InsertNextCell(2);
     lines->InsertNextCell(2);
@@ -796,7 +1018,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         vtkIdType lineId = iterLower->second;
         vtkIdType nLinePts;
         const vtkIdType* linePtIds;
-        interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds);
+        interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds, linePtIdList);
         for (vtkIdType k = 0; k < nLinePts; k++)
         {
           if (linePtIds[k] >= interLines->GetNumberOfPoints())
@@ -929,15 +1151,15 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     // Setting the boundary points
     if (ptId > 2)
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(reverseIdMap[ptId], 1);
+      updates->BoundaryPoints.emplace_back(reverseIdMap[ptId], 1);
     }
     else if (CellPointOnInterLine[ptId])
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 1);
+      updates->BoundaryPoints.emplace_back(cellPts[ptId], 1);
     }
     else
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 0);
+      updates->BoundaryPoints.emplace_back(cellPts[ptId], 0);
     }
   }
   // Sort the edgePtIdList according to the angle list. The starting
@@ -974,7 +1196,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   // Set up a transform that will rotate the points to the
   // XY-plane (normal aligned with z-axis).
   vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
-  this->TransformSign = this->GetTransform(transform, points);
+  this->TransformSign.Local() = this->GetTransform(transform, points);
 
   vtkCellArray* splitCells = vtkCellArray::New();
   vtkSmartPointer<vtkPolyData> interpd = vtkSmartPointer<vtkPolyData>::New();
@@ -985,7 +1207,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   vtkSmartPointer<vtkPolyData> fullpd = vtkSmartPointer<vtkPolyData>::New();
   fullpd->SetPoints(points);
   fullpd->SetLines(lines);
-  SplittingPD->DeepCopy(fullpd);
+  this->SplittingPD.Local()->DeepCopy(fullpd);
 
   vtkSmartPointer<vtkTransformPolyDataFilter> transformer =
     vtkSmartPointer<vtkTransformPolyDataFilter>::New();
@@ -1050,9 +1272,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       int success = boundaryPoly->BoundedTriangulate(idList, this->RelativeSubtriangleArea);
 
       vtkSmartPointer<vtkDelaunay2D> del2D = vtkSmartPointer<vtkDelaunay2D>::New();
-      del2D->SetContainerAlgorithm(this->ParentFilter);
       vtkSmartPointer<vtkTriangleFilter> triangulator = vtkSmartPointer<vtkTriangleFilter>::New();
-      triangulator->SetContainerAlgorithm(this->ParentFilter);
 
       vtkSmartPointer<vtkCellArray> triangulatedPolyCells = vtkSmartPointer<vtkCellArray>::New();
       if (success)
@@ -1122,7 +1342,6 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       // Renumber the point IDs.
       vtkIdType npts;
       const vtkIdType* ptIds;
-      interLines->BuildLinks();
       for (polys->InitTraversal(); polys->GetNextCell(npts, ptIds);)
       {
         if (pointMapper[ptIds[0]] >= points->GetNumberOfPoints() ||
@@ -1157,7 +1376,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         if (interPtCount >= 2) // If there are more than two, inter line
         {
           // Add the information to new cell mapping on intersection lines
-          this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+          updates->AddNewCell(numCurrCells, interPtCount, interPts);
         }
         numCurrCells++;
       }
@@ -1215,7 +1434,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       }
       if (interPtCount >= 2)
       {
-        this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+        updates->AddNewCell(numCurrCells, interPtCount, interPts);
       }
       numCurrCells++;
     }
@@ -1708,12 +1927,13 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
     vtkDebugWithObjectMacro(this->ParentFilter, << "Very Small Area Triangle");
     vtkDebugWithObjectMacro(
       this->ParentFilter, << "Double check area with more accurate transform");
+    vtkPolyData* splittingPD = this->SplittingPD.Local();
     vtkSmartPointer<vtkPoints> testPoints = vtkSmartPointer<vtkPoints>::New();
     vtkSmartPointer<vtkPolyData> testPD = vtkSmartPointer<vtkPolyData>::New();
     vtkSmartPointer<vtkCellArray> testCells = vtkSmartPointer<vtkCellArray>::New();
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId1));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId2));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId3));
+    testPoints->InsertNextPoint(splittingPD->GetPoint(ptId1));
+    testPoints->InsertNextPoint(splittingPD->GetPoint(ptId2));
+    testPoints->InsertNextPoint(splittingPD->GetPoint(ptId3));
     for (int i = 0; i < 3; i++)
     {
       testCells->InsertNextCell(2);
@@ -1726,13 +1946,13 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
 
     vtkSmartPointer<vtkTransform> newTransform = vtkSmartPointer<vtkTransform>::New();
     int sign = this->GetTransform(newTransform, testPoints);
-    if (sign != this->TransformSign)
+    if (sign != this->TransformSign.Local())
     {
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId2));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(0, splittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(1, splittingPD->GetPoint(ptId1));
       this->GetTransform(newTransform, testPoints);
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId1));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(0, splittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(1, splittingPD->GetPoint(ptId2));
     }
 
     vtkSmartPointer<vtkTransformPolyDataFilter> newTransformer =
@@ -2382,8 +2602,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   }
 
   // This performs the triangle intersection search
-  obbTree0->IntersectWithOBBTree(
-    obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  impl->FindTriangleIntersections(obbTree0);
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
@@ -54,6 +54,11 @@
  * indicating if the cell has any free edges. A watertight surface will have
  * 0 everywhere for this array!
  *
+ * The triangles of the overlapping leaves of the OBB trees of the inputs are
+ * intersected in parallel, and the cells crossed by the intersection lines
+ * are split in parallel, with vtkSMPTools. The output does not depend on the
+ * number of threads.
+ *
  * @author Adam Updegrove updega2@gmail.com
  *
  * @warning This filter is not designed to perform 2D boolean operations,
@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkDataSetSurfaceFilter extracts the same surface of linear
+// grids whatever the number of threads, with as many faces as vtkGeometryFilter,
+// and the same triangles from the faces of nonlinear grids as through
+// vtkUnstructuredGridGeometryFilter.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkGeometryFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The triangles of a surface as sorted coordinates, in sorted order.
+std::vector<std::array<double, 9>> GetTriangles(vtkPolyData* surface)
+{
+  std::vector<std::array<double, 9>> triangles;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = surface->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    std::array<std::array<double, 3>, 3> corners;
+    for (vtkIdType i = 0; i < 3 && i < npts; ++i)
+    {
+      surface->GetPoint(pts[i], corners[i].data());
+    }
+    std::sort(corners.begin(), corners.end());
+    std::array<double, 9> triangle;
+    for (int i = 0; i < 9; ++i)
+    {
+      triangle[i] = corners[i / 3][i % 3];
+    }
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+}
+
+int TestDataSetSurfaceFilterThreads(int, char*[])
+{
+  bool success = true;
+  vtkNew<vtkCellTypeSource> source;
+  source->SetBlocksDimensions(5, 4, 3);
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputConnection(source->GetOutputPort());
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  vtkNew<vtkGeometryFilter> geometry;
+  geometry->SetInputConnection(source->GetOutputPort());
+
+  const int linearTypes[6] = { VTK_TETRA, VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID,
+    VTK_PENTAGONAL_PRISM, VTK_HEXAGONAL_PRISM };
+  for (int cellType : linearTypes)
+  {
+    source->SetCellType(cellType);
+    success &= vtkSMPTestUtilities::CompareThreads(surface, "vtkDataSetSurfaceFilter");
+
+    // The boundary faces are the ones extracted by vtkGeometryFilter. The 94
+    // quads of the 5x4x3 blocks of hexahedra use the 96 points of its sides.
+    geometry->Update();
+    vtkPolyData* output = surface->GetOutput();
+    if (output->GetNumberOfPolys() != geometry->GetOutput()->GetNumberOfPolys() ||
+      output->GetNumberOfPoints() != geometry->GetOutput()->GetNumberOfPoints() ||
+      (cellType == VTK_HEXAHEDRON &&
+        (output->GetNumberOfPolys() != 94 || output->GetNumberOfPoints() != 96)))
+    {
+      std::cerr << "Wrong surface of cell type " << cellType << ": " << output->GetNumberOfPolys()
+                << " faces and " << output->GetNumberOfPoints() << " points" << std::endl;
+      success = false;
+    }
+  }
+
+  // A ghost array makes the nonlinear cells go through
+  // vtkUnstructuredGridGeometryFilter, the faces must be subdivided the same.
+  surface->SetNonlinearSubdivisionLevel(1);
+  const int nonlinearTypes[5] = { VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON,
+    VTK_QUADRATIC_WEDGE, VTK_LAGRANGE_TETRAHEDRON, VTK_LAGRANGE_HEXAHEDRON };
+  for (int cellType : nonlinearTypes)
+  {
+    source->SetCellType(cellType);
+    source->SetCellOrder(3);
+    source->Update();
+    vtkNew<vtkUnstructuredGrid> input;
+    input->ShallowCopy(source->GetOutput());
+    surface->SetInputData(input);
+    surface->Update();
+    const auto triangles = ::GetTriangles(surface->GetOutput());
+    vtkDataArray* cellIds =
+      surface->GetOutput()->GetCellData()->GetArray(surface->GetOriginalCellIdsName());
+    double range[2];
+    cellIds->GetRange(range);
+
+    vtkNew<vtkUnsignedCharArray> ghosts;
+    ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    ghosts->SetNumberOfValues(input->GetNumberOfCells());
+    ghosts->FillValue(0);
+    input->GetCellData()->AddArray(ghosts);
+    surface->Update();
+    if (triangles.empty() || triangles != ::GetTriangles(surface->GetOutput()) ||
+      range[0] < 0 || range[1] >= input->GetNumberOfCells())
+    {
+      std::cerr << "Wrong subdivided faces for cell type " << cellType << std::endl;
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
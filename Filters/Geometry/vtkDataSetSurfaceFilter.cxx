@@ -40,6 +40,9 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -57,9 +60,13 @@
 #include "vtkWedge.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <memory>
 #include <numeric>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -290,6 +297,346 @@ bool StructuredExecuteWithBlanking(
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Helpers to extract the boundary faces of the 3D cells of a
+// vtkUnstructuredGrid in parallel. The faces are defined, rotated and matched
+// as InsertTriInHash(), InsertQuadInHash() and InsertPolygonInHash() do, and
+// the faces sharing a hash are kept in the order the cells insert them, so
+// the boundary faces and their order are the ones of the quad hash.
+enum FaceKind : unsigned char
+{
+  TRIANGLE_FACE,
+  QUAD_FACE,
+  POLYGON_FACE
+};
+
+// The faces of the common cells, in the order they are inserted in the hash.
+constexpr int HexahedronFaces[6][4] = { { 0, 1, 5, 4 }, { 0, 3, 2, 1 }, { 0, 4, 7, 3 },
+  { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 4, 5, 6, 7 } };
+constexpr int VoxelFaces[6][4] = { { 0, 1, 5, 4 }, { 0, 2, 3, 1 }, { 0, 4, 6, 2 },
+  { 1, 3, 7, 5 }, { 2, 6, 7, 3 }, { 4, 5, 7, 6 } };
+constexpr int TetraFaces[4][3] = { { 0, 1, 3 }, { 0, 2, 1 }, { 0, 3, 2 }, { 1, 2, 3 } };
+constexpr int PyramidTriangles[4][3] = { { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 } };
+constexpr int WedgeQuads[3][4] = { { 0, 2, 5, 3 }, { 1, 0, 3, 4 }, { 2, 1, 4, 5 } };
+
+//------------------------------------------------------------------------------
+// The nonlinear 3D cells whose boundary faces are extracted with the linear
+// ones: their faces are quadratic or Lagrange triangles and quads, hashed by
+// their corner points, and subdivided once at most.
+bool IsHashableNonlinearCell(unsigned char cellType)
+{
+  switch (cellType)
+  {
+    case VTK_QUADRATIC_TETRA:
+    case VTK_QUADRATIC_HEXAHEDRON:
+    case VTK_QUADRATIC_WEDGE:
+    case VTK_QUADRATIC_PYRAMID:
+    case VTK_TRIQUADRATIC_HEXAHEDRON:
+    case VTK_TRIQUADRATIC_PYRAMID:
+    case VTK_QUADRATIC_LINEAR_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
+    case VTK_LAGRANGE_TETRAHEDRON:
+    case VTK_LAGRANGE_HEXAHEDRON:
+    case VTK_LAGRANGE_WEDGE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// The corners of the faces of a nonlinear 3D cell type, as indices in the
+// points of its cells, so that the faces are not built for every cell.
+struct NonlinearCellFaces
+{
+  std::vector<FaceKind> Kinds;
+  std::vector<std::array<vtkIdType, 4>> Corners;
+};
+using NonlinearFaceTables = std::vector<NonlinearCellFaces>;
+
+//------------------------------------------------------------------------------
+// The face tables of the nonlinear 3D cell types of a grid, indexed by type,
+// taken from the first cell of each type with its points numbered locally.
+NonlinearFaceTables BuildNonlinearFaceTables(vtkUnstructuredGrid* input)
+{
+  NonlinearFaceTables tables(VTK_NUMBER_OF_CELL_TYPES);
+  vtkUnsignedCharArray* types = input->GetDistinctCellTypesArray();
+  const unsigned char* cellTypes = input->GetCellTypesArray()->GetPointer(0);
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < types->GetNumberOfValues(); ++i)
+  {
+    const unsigned char cellType = types->GetValue(i);
+    if (vtkCellTypes::GetDimension(cellType) != 3 || vtkCellTypes::IsLinear(cellType))
+    {
+      continue;
+    }
+    input->GetCell(std::find(cellTypes, cellTypes + numCells, cellType) - cellTypes, cell);
+    std::iota(cell->PointIds->begin(), cell->PointIds->end(), 0);
+    NonlinearCellFaces& faces = tables[cellType];
+    for (int j = 0; j < cell->GetNumberOfFaces(); ++j)
+    {
+      vtkCell* face = cell->GetFace(j);
+      faces.Kinds.push_back(face->GetNumberOfEdges() == 3 ? TRIANGLE_FACE : QUAD_FACE);
+      std::array<vtkIdType, 4> corners{ { 0, 0, 0, 0 } };
+      std::copy_n(face->PointIds->begin(), faces.Kinds.back() == TRIANGLE_FACE ? 3 : 4,
+        corners.begin());
+      faces.Corners.push_back(corners);
+    }
+  }
+  return tables;
+}
+
+//------------------------------------------------------------------------------
+// Call functor(kind, numPts, pts) for each face of a 3D cell, in the order
+// the faces are inserted in the quad hash.
+template <typename TFunctor>
+void VisitCellFaces(vtkUnstructuredGrid* input, vtkIdType cellId, vtkGenericCell* cell,
+  vtkIdList* cellPtIds, const NonlinearFaceTables& nonlinearFaces, TFunctor& functor)
+{
+  const unsigned char cellType = static_cast<unsigned char>(input->GetCellType(cellId));
+  if (vtkCellTypes::GetDimension(cellType) != 3)
+  {
+    return;
+  }
+  vtkIdType numCellPts;
+  const vtkIdType* ids;
+  vtkIdType face[4];
+  auto visitFaces = [&](const int(*faces)[4], int numFaces, int numFacePts, FaceKind kind) {
+    for (int j = 0; j < numFaces; ++j)
+    {
+      for (int k = 0; k < numFacePts; ++k)
+      {
+        face[k] = ids[faces[j][k]];
+      }
+      functor(kind, numFacePts, face);
+    }
+  };
+  auto visitTriangles = [&](const int(*faces)[3], int numFaces) {
+    for (int j = 0; j < numFaces; ++j)
+    {
+      face[0] = ids[faces[j][0]];
+      face[1] = ids[faces[j][1]];
+      face[2] = ids[faces[j][2]];
+      functor(TRIANGLE_FACE, 3, face);
+    }
+  };
+  auto visitPrism = [&](int numSides) {
+    for (int j = 0; j < numSides; ++j)
+    {
+      face[0] = ids[j];
+      face[1] = ids[(j + 1) % numSides];
+      face[2] = ids[(j + 1) % numSides + numSides];
+      face[3] = ids[j + numSides];
+      functor(QUAD_FACE, 4, face);
+    }
+    functor(POLYGON_FACE, numSides, ids);
+    functor(POLYGON_FACE, numSides, ids + numSides);
+  };
+
+  switch (cellType)
+  {
+    case VTK_HEXAHEDRON:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      visitFaces(HexahedronFaces, 6, 4, QUAD_FACE);
+      break;
+    case VTK_VOXEL:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      visitFaces(VoxelFaces, 6, 4, QUAD_FACE);
+      break;
+    case VTK_TETRA:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      visitTriangles(TetraFaces, 4);
+      break;
+    case VTK_PENTAGONAL_PRISM:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      visitPrism(5);
+      break;
+    case VTK_HEXAGONAL_PRISM:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      visitPrism(6);
+      break;
+    case VTK_PYRAMID:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      face[0] = ids[3];
+      face[1] = ids[2];
+      face[2] = ids[1];
+      face[3] = ids[0];
+      functor(QUAD_FACE, 4, face);
+      visitTriangles(PyramidTriangles, 4);
+      break;
+    case VTK_WEDGE:
+      input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+      visitFaces(WedgeQuads, 3, 4, QUAD_FACE);
+      face[0] = ids[0];
+      face[1] = ids[1];
+      face[2] = ids[2];
+      functor(TRIANGLE_FACE, 3, face);
+      face[0] = ids[3];
+      face[1] = ids[5];
+      face[2] = ids[4];
+      functor(TRIANGLE_FACE, 3, face);
+      break;
+    default:
+      if (!vtkCellTypes::IsLinear(cellType))
+      {
+        // hashed with its corners, the face is subdivided when extracted
+        input->GetCellPoints(cellId, numCellPts, ids, cellPtIds);
+        const NonlinearCellFaces& faces = nonlinearFaces[cellType];
+        for (size_t j = 0; j < faces.Kinds.size(); ++j)
+        {
+          const int numFacePts = faces.Kinds[j] == TRIANGLE_FACE ? 3 : 4;
+          for (int k = 0; k < numFacePts; ++k)
+          {
+            face[k] = ids[faces.Corners[j][k]];
+          }
+          functor(faces.Kinds[j], numFacePts, face);
+        }
+        break;
+      }
+      input->GetCell(cellId, cell);
+      for (int j = 0, numFaces = cell->GetNumberOfFaces(); j < numFaces; ++j)
+      {
+        vtkIdList* facePtIds = cell->GetFace(j)->PointIds;
+        const vtkIdType* facePts = facePtIds->GetPointer(0);
+        const int numFacePts = static_cast<int>(facePtIds->GetNumberOfIds());
+        if (numFacePts == 4)
+        {
+          functor(QUAD_FACE, 4, facePts);
+        }
+        else if (numFacePts == 3)
+        {
+          functor(TRIANGLE_FACE, 3, facePts);
+        }
+        else if (numFacePts > 0)
+        {
+          functor(POLYGON_FACE, numFacePts, facePts);
+        }
+      }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Copy the points of a face starting with the point the quad hash would
+// start it with.
+void RotateFace(FaceKind kind, int numPts, const vtkIdType* pts, vtkIdType* face)
+{
+  int first = 0;
+  switch (kind)
+  {
+    case TRIANGLE_FACE:
+      if (pts[1] < pts[0] && pts[1] < pts[2])
+      {
+        first = 1;
+      }
+      else if (pts[2] < pts[0] && pts[2] < pts[1])
+      {
+        first = 2;
+      }
+      break;
+    case QUAD_FACE:
+      if (pts[1] < pts[0] && pts[1] < pts[2] && pts[1] < pts[3])
+      {
+        first = 1;
+      }
+      else if (pts[2] < pts[0] && pts[2] < pts[1] && pts[2] < pts[3])
+      {
+        first = 2;
+      }
+      else if (pts[3] < pts[0] && pts[3] < pts[1] && pts[3] < pts[2])
+      {
+        first = 3;
+      }
+      break;
+    case POLYGON_FACE:
+      for (int i = 1; i < numPts; ++i)
+      {
+        if (pts[i] < pts[first])
+        {
+          first = i;
+        }
+      }
+      break;
+  }
+  for (int i = 0; i < numPts; ++i)
+  {
+    face[i] = pts[(first + i) % numPts];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Whether a face inserted in the hash after a face with the same first point
+// matches it, with the tests of the quad hash.
+bool MatchFace(FaceKind kind, vtkIdType numPts, const vtkIdType* face, vtkIdType numOtherPts,
+  const vtkIdType* other)
+{
+  switch (kind)
+  {
+    case TRIANGLE_FACE:
+      return numOtherPts == 3 &&
+        ((face[1] == other[1] && face[2] == other[2]) ||
+          (face[1] == other[2] && face[2] == other[1]));
+    case QUAD_FACE:
+      return numOtherPts == 4 && face[2] == other[2] &&
+        ((face[1] == other[1] && face[3] == other[3]) ||
+          (face[1] == other[3] && face[3] == other[1]));
+    default:
+      if (numPts != numOtherPts || face[0] != other[0])
+      {
+        return false;
+      }
+      if (numPts > 1 && face[1] == other[1])
+      {
+        return std::equal(face + 2, face + numPts, other + 2);
+      }
+      for (vtkIdType i = 1; i < numPts; ++i)
+      {
+        if (face[numPts - i] != other[i])
+        {
+          return false;
+        }
+      }
+      return true;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Grow the arrays of attributes to a number of tuples, keeping the tuples
+// already inserted (SetNumberOfTuples reallocates without copying).
+void ResizeAttributes(vtkFieldData* attributes, vtkIdType numTuples)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = attributes->GetAbstractArray(i);
+    array->SetNumberOfValues(numTuples * array->GetNumberOfComponents());
+  }
+}
+
+//------------------------------------------------------------------------------
+// Whether the boundary faces of the nonlinear 3D cells of a grid, if any, can
+// be extracted with the ones of the linear cells rather than through a
+// vtkUnstructuredGridGeometryFilter.
+bool CanHashNonlinearCells(vtkUnstructuredGrid* input, int subdivisionLevel)
+{
+  bool hasNonlinearCells = false;
+  vtkUnsignedCharArray* types = input->GetDistinctCellTypesArray();
+  for (vtkIdType i = 0; i < types->GetNumberOfValues(); ++i)
+  {
+    const unsigned char cellType = types->GetValue(i);
+    if (vtkCellTypes::GetDimension(cellType) == 3 && !vtkCellTypes::IsLinear(cellType))
+    {
+      if (subdivisionLevel > 1 || !::IsHashableNonlinearCell(cellType))
+      {
+        return false;
+      }
+      hasNonlinearCells = true;
+    }
+  }
+  // vtkUnstructuredGridGeometryFilter matches the faces of the hidden cells
+  // too, and drops the faces with a hidden point: keep it for ghosts.
+  return !hasNonlinearCells || (!input->GetCellGhostArray() && !input->GetPointGhostArray());
+}
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1395,8 +1742,17 @@ int vtkDataSetSurfaceFilter::UnstructuredGridBaseExecute(
 int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   vtkUnstructuredGridBase* input, vtkPolyData* output, bool handleSubdivision)
 {
+  // The boundary faces of the 3D cells of a vtkUnstructuredGrid are extracted
+  // in parallel. This also saves the vtkUnstructuredGridGeometryFilter pass
+  // of most nonlinear cells, while the faces of linear cells are faster to
+  // match in the serial hash when there is a single thread.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  const bool parallelFaces = grid &&
+    (handleSubdivision ? ::CanHashNonlinearCells(grid, this->NonlinearSubdivisionLevel)
+                       : vtkSMPTools::GetEstimatedNumberOfThreads() > 1);
+
   vtkSmartPointer<vtkUnstructuredGrid> tempInput;
-  if (handleSubdivision)
+  if (handleSubdivision && !parallelFaces)
   {
     // Since this filter only properly subdivides 2D cells past
     // level 1, we convert 3D cells to 2D by using
@@ -1564,6 +1920,11 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
     progressCount++;
 
     cellType = input->GetCellType(cellId);
+    if (parallelFaces && vtkCellTypes::GetDimension(cellType) == 3)
+    {
+      // extracted after the 2D cells
+      continue;
+    }
 
     switch (cellType)
     {
@@ -2129,6 +2490,10 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   } // for all cells.
 
   // Now transfer geometry from hash to output (only triangles and quads).
+  if (parallelFaces && !abort)
+  {
+    this->ExtractBoundaryFacesInParallel(grid, newPts, newPolys, outputPD, outputCD);
+  }
   this->InitQuadHashTraversal();
   while ((q = this->GetNextVisibleQuadFromHash()))
   {
@@ -2214,6 +2579,394 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Parallel counterpart of the quad hash for the 3D cells of a
+// vtkUnstructuredGrid: the faces are grouped by their first point with a
+// counting sort, each group is matched in the insertion order of the hash,
+// then the boundary faces are appended to the output in the order of the hash
+// traversal. The faces of the nonlinear cells are triangulated when
+// NonlinearSubdivisionLevel is 1.
+void vtkDataSetSurfaceFilter::ExtractBoundaryFacesInParallel(vtkUnstructuredGrid* input,
+  vtkPoints* newPts, vtkCellArray* newPolys, vtkPointData* outputPD, vtkCellData* outputCD)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnsignedCharArray* ghostCells = input->GetCellGhostArray();
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+
+  // Count the faces of each cell and their points.
+  const ::NonlinearFaceTables nonlinearFaces = ::BuildNonlinearFaceTables(input);
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocalObject<vtkIdList> localCellPtIds;
+  std::vector<vtkIdType> cellFaceOffsets(numCells + 1);
+  std::vector<vtkIdType> cellFacePtOffsets(numCells + 1);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = localCell.Local();
+    vtkIdList* cellPtIds = localCellPtIds.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      vtkIdType numFaces = 0, numFacePts = 0;
+      // We skip cells marked as hidden
+      if (!ghostCells ||
+        !(ghostCells->GetValue(cellId) & vtkDataSetAttributes::CellGhostTypes::HIDDENCELL))
+      {
+        auto count = [&](FaceKind, int faceNumPts, const vtkIdType*) {
+          ++numFaces;
+          numFacePts += faceNumPts;
+        };
+        ::VisitCellFaces(input, cellId, cell, cellPtIds, nonlinearFaces, count);
+      }
+      cellFaceOffsets[cellId] = numFaces;
+      cellFacePtOffsets[cellId] = numFacePts;
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return;
+  }
+  const vtkIdType numFaces = vtkSMPTools::ExclusiveScan(
+    cellFaceOffsets.begin(), cellFaceOffsets.end() - 1, cellFaceOffsets.begin(), vtkIdType(0));
+  cellFaceOffsets[numCells] = numFaces;
+  const vtkIdType numFacePts = vtkSMPTools::ExclusiveScan(cellFacePtOffsets.begin(),
+    cellFacePtOffsets.end() - 1, cellFacePtOffsets.begin(), vtkIdType(0));
+  cellFacePtOffsets[numCells] = numFacePts;
+
+  // Store the faces as the hash does, and count the faces of each hash.
+  // The large arrays are not initialized, they are fully written in parallel.
+  std::unique_ptr<unsigned char[]> faceKinds(new unsigned char[numFaces]);
+  std::unique_ptr<vtkIdType[]> facePtOffsets(new vtkIdType[numFaces + 1]);
+  std::unique_ptr<vtkIdType[]> facePts(new vtkIdType[numFacePts]);
+  std::vector<std::atomic<vtkIdType>> hashEnds(numPts);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = localCell.Local();
+    vtkIdList* cellPtIds = localCellPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (cellFaceOffsets[cellId] == cellFaceOffsets[cellId + 1])
+      {
+        continue;
+      }
+      vtkIdType faceId = cellFaceOffsets[cellId];
+      vtkIdType offset = cellFacePtOffsets[cellId];
+      auto store = [&](FaceKind kind, int numFacePoints, const vtkIdType* pts) {
+        vtkIdType* face = facePts.get() + offset;
+        ::RotateFace(kind, numFacePoints, pts, face);
+        hashEnds[face[0]].fetch_add(1, std::memory_order_relaxed);
+        faceKinds[faceId] = kind;
+        facePtOffsets[faceId++] = offset;
+        offset += numFacePoints;
+      };
+      ::VisitCellFaces(input, cellId, cell, cellPtIds, nonlinearFaces, store);
+    }
+  });
+  facePtOffsets[numFaces] = numFacePts;
+
+  std::vector<vtkIdType> hashOffsets(numPts + 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      hashOffsets[ptId] = hashEnds[ptId].load(std::memory_order_relaxed);
+    }
+  });
+  hashOffsets[numPts] = vtkSMPTools::ExclusiveScan(
+    hashOffsets.begin(), hashOffsets.end() - 1, hashOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      hashEnds[ptId].store(hashOffsets[ptId], std::memory_order_relaxed);
+    }
+  });
+  std::unique_ptr<vtkIdType[]> hashFaces(new vtkIdType[numFaces]);
+  vtkSMPTools::For(0, numFaces, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType faceId = begin; faceId < end; ++faceId)
+    {
+      hashFaces[hashEnds[facePts[facePtOffsets[faceId]]].fetch_add(
+        1, std::memory_order_relaxed)] = faceId;
+    }
+  });
+
+  // Match the faces of each hash in insertion order, i.e. by face id, and
+  // keep the ones inserted once at the beginning of the hash.
+  std::vector<vtkIdType> numHashBoundaryFaces(numPts + 1);
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localInserted;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<vtkIdType>& inserted = localInserted.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      vtkIdType* hash = hashFaces.get() + hashOffsets[ptId];
+      vtkIdType* hashEnd = hashFaces.get() + hashOffsets[ptId + 1];
+      // already sorted unless several threads scattered the faces
+      if (!std::is_sorted(hash, hashEnd))
+      {
+        std::sort(hash, hashEnd);
+      }
+      // a face matching an inserted one hides it, marked with a negative id
+      inserted.clear();
+      for (const vtkIdType* faceIt = hash; faceIt != hashEnd; ++faceIt)
+      {
+        const vtkIdType faceId = *faceIt;
+        const vtkIdType* face = facePts.get() + facePtOffsets[faceId];
+        const vtkIdType faceSize = facePtOffsets[faceId + 1] - facePtOffsets[faceId];
+        auto match = std::find_if(inserted.begin(), inserted.end(), [&](vtkIdType other) {
+          other = other < 0 ? -other - 1 : other;
+          return ::MatchFace(static_cast<FaceKind>(faceKinds[faceId]), faceSize, face,
+            facePtOffsets[other + 1] - facePtOffsets[other], facePts.get() + facePtOffsets[other]);
+        });
+        if (match == inserted.end())
+        {
+          inserted.push_back(faceId);
+        }
+        else if (*match >= 0)
+        {
+          *match = -*match - 1;
+        }
+      }
+      vtkIdType* boundaryEnd =
+        std::copy_if(inserted.begin(), inserted.end(), hash, [](vtkIdType f) { return f >= 0; });
+      numHashBoundaryFaces[ptId] = boundaryEnd - hash;
+    }
+  });
+  if (this->GetAbortOutput())
+  {
+    return;
+  }
+  const vtkIdType numBoundaryFaces = vtkSMPTools::ExclusiveScan(numHashBoundaryFaces.begin(),
+    numHashBoundaryFaces.end() - 1, numHashBoundaryFaces.begin(), vtkIdType(0));
+  numHashBoundaryFaces[numPts] = numBoundaryFaces;
+  std::vector<vtkIdType> boundaryFaces(numBoundaryFaces);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      std::copy(hashFaces.get() + hashOffsets[ptId],
+        hashFaces.get() + hashOffsets[ptId] + numHashBoundaryFaces[ptId + 1] -
+          numHashBoundaryFaces[ptId],
+        boundaryFaces.begin() + numHashBoundaryFaces[ptId]);
+    }
+  });
+  hashFaces.reset();
+  std::vector<vtkIdType>().swap(hashOffsets);
+  std::vector<std::atomic<vtkIdType>>().swap(hashEnds);
+
+  // The points used by a boundary face, the ones of the hash or the
+  // triangulation of a nonlinear face, which has no ghosts. As in the hash
+  // traversal, the points of a face with a hidden point are used but the
+  // face is skipped.
+  const bool subdivide = this->NonlinearSubdivisionLevel >= 1;
+  vtkSMPThreadLocalObject<vtkIdList> localTriPts;
+  vtkSMPThreadLocalObject<vtkPoints> localTriCoords;
+  auto getFacePoints = [&](vtkIdType faceId, vtkIdType cellId, const vtkIdType*& pts,
+                         vtkIdType& numIds, int& cellSize, bool& hidden) {
+    const vtkIdType offset = facePtOffsets[faceId];
+    pts = nullptr;
+    hidden = false;
+    const unsigned char cellType = static_cast<unsigned char>(input->GetCellType(cellId));
+    if (!subdivide || vtkCellTypes::IsLinear(cellType))
+    {
+      pts = facePts.get() + offset;
+      numIds = facePtOffsets[faceId + 1] - offset;
+      cellSize = static_cast<int>(numIds);
+      for (vtkIdType i = 0; ghosts && i < numIds; ++i)
+      {
+        hidden |= (ghosts->GetValue(pts[i]) & vtkDataSetAttributes::HIDDENPOINT) != 0;
+      }
+      return;
+    }
+    vtkGenericCell* cell = localCell.Local();
+    input->GetCell(cellId, cell);
+    vtkCell* face = cell->GetFace(static_cast<int>(faceId - cellFaceOffsets[cellId]));
+    vtkIdList* triPts = localTriPts.Local();
+    face->Triangulate(0, triPts, localTriCoords.Local());
+    pts = triPts->GetPointer(0);
+    numIds = triPts->GetNumberOfIds();
+    cellSize = 3;
+  };
+  auto getCellId = [&](vtkIdType faceId) {
+    return static_cast<vtkIdType>(
+      std::upper_bound(cellFaceOffsets.begin(), cellFaceOffsets.end(), faceId) -
+      cellFaceOffsets.begin() - 1);
+  };
+
+  std::vector<vtkIdType> faceIdOffsets(numBoundaryFaces + 1);
+  std::vector<vtkIdType> faceCellOffsets(numBoundaryFaces + 1);
+  std::vector<vtkIdType> faceConnOffsets(numBoundaryFaces + 1);
+  vtkSMPTools::For(0, numBoundaryFaces, [&](vtkIdType begin, vtkIdType end) {
+    const vtkIdType* pts;
+    vtkIdType numIds;
+    int cellSize;
+    bool hidden;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      getFacePoints(boundaryFaces[i], getCellId(boundaryFaces[i]), pts, numIds, cellSize, hidden);
+      faceIdOffsets[i] = numIds;
+      faceCellOffsets[i] = hidden ? 0 : numIds / cellSize;
+      faceConnOffsets[i] = hidden ? 0 : numIds;
+    }
+  });
+  const vtkIdType numFaceIds = vtkSMPTools::ExclusiveScan(
+    faceIdOffsets.begin(), faceIdOffsets.end() - 1, faceIdOffsets.begin(), vtkIdType(0));
+  faceIdOffsets[numBoundaryFaces] = numFaceIds;
+
+  // The new points are numbered in the order they are first used.
+  std::vector<vtkIdType> faceIds(numFaceIds);
+  std::vector<std::atomic<vtkIdType>> firstUses(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstUses[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numBoundaryFaces, [&](vtkIdType begin, vtkIdType end) {
+    const vtkIdType* pts;
+    vtkIdType numIds;
+    int cellSize;
+    bool hidden;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      getFacePoints(boundaryFaces[i], getCellId(boundaryFaces[i]), pts, numIds, cellSize, hidden);
+      std::copy(pts, pts + numIds, faceIds.begin() + faceIdOffsets[i]);
+      for (vtkIdType j = 0; j < numIds; ++j)
+      {
+        if (this->PointMap[pts[j]] < 0)
+        {
+          const vtkIdType use = faceIdOffsets[i] + j;
+          vtkIdType firstUse = firstUses[pts[j]].load(std::memory_order_relaxed);
+          while (use < firstUse && !firstUses[pts[j]].compare_exchange_weak(firstUse, use))
+          {
+          }
+        }
+      }
+    }
+  });
+  std::vector<vtkIdType> newPtOffsets(numBoundaryFaces + 1);
+  vtkSMPTools::For(0, numBoundaryFaces, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType numNewPts = 0;
+      for (vtkIdType use = faceIdOffsets[i]; use < faceIdOffsets[i + 1]; ++use)
+      {
+        numNewPts += firstUses[faceIds[use]].load(std::memory_order_relaxed) == use;
+      }
+      newPtOffsets[i] = numNewPts;
+    }
+  });
+  const vtkIdType numOutPts = vtkSMPTools::ExclusiveScan(newPtOffsets.begin(),
+    newPtOffsets.end() - 1, newPtOffsets.begin(), newPts->GetNumberOfPoints());
+  newPts->GetData()->SetNumberOfValues(3 * numOutPts);
+  newPts->Modified();
+  ::ResizeAttributes(outputPD, numOutPts);
+  if (this->OriginalPointIds)
+  {
+    this->OriginalPointIds->SetNumberOfValues(numOutPts);
+  }
+  vtkPointData* inputPD = input->GetPointData();
+  vtkSMPTools::For(0, numBoundaryFaces, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType outPtId = newPtOffsets[i];
+      for (vtkIdType use = faceIdOffsets[i]; use < faceIdOffsets[i + 1]; ++use)
+      {
+        const vtkIdType inPtId = faceIds[use];
+        if (firstUses[inPtId].load(std::memory_order_relaxed) == use)
+        {
+          input->GetPoint(inPtId, x);
+          newPts->SetPoint(outPtId, x);
+          outputPD->CopyData(inputPD, inPtId, outPtId);
+          if (this->OriginalPointIds)
+          {
+            this->OriginalPointIds->SetValue(outPtId, inPtId);
+          }
+          this->PointMap[inPtId] = outPtId++;
+        }
+      }
+    }
+  });
+
+  // Append the faces, or their triangles, to the polygons.
+  const vtkIdType numFaceCells = vtkSMPTools::ExclusiveScan(
+    faceCellOffsets.begin(), faceCellOffsets.end() - 1, faceCellOffsets.begin(), vtkIdType(0));
+  faceCellOffsets[numBoundaryFaces] = numFaceCells;
+  const vtkIdType numFaceConn = vtkSMPTools::ExclusiveScan(
+    faceConnOffsets.begin(), faceConnOffsets.end() - 1, faceConnOffsets.begin(), vtkIdType(0));
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numFaceCells + 1);
+  offsets->SetValue(numFaceCells, numFaceConn);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numFaceConn);
+  const vtkIdType numOutCells = this->NumberOfNewCells;
+  ::ResizeAttributes(outputCD, numOutCells + numFaceCells);
+  if (this->OriginalCellIds)
+  {
+    this->OriginalCellIds->SetNumberOfValues(numOutCells + numFaceCells);
+  }
+  vtkCellData* inputCD = input->GetCellData();
+  vtkSMPTools::For(0, numBoundaryFaces, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType numFaceIdCells = faceCellOffsets[i + 1] - faceCellOffsets[i];
+      if (numFaceIdCells == 0)
+      {
+        continue;
+      }
+      const vtkIdType cellId = getCellId(boundaryFaces[i]);
+      const vtkIdType cellSize = (faceIdOffsets[i + 1] - faceIdOffsets[i]) / numFaceIdCells;
+      for (vtkIdType j = 0; j < numFaceIdCells; ++j)
+      {
+        const vtkIdType outCellId = faceCellOffsets[i] + j;
+        const vtkIdType offset = faceConnOffsets[i] + j * cellSize;
+        offsets->SetValue(outCellId, offset);
+        for (vtkIdType k = 0; k < cellSize; ++k)
+        {
+          connectivity->SetValue(
+            offset + k, this->PointMap[faceIds[faceIdOffsets[i] + j * cellSize + k]]);
+        }
+        outputCD->CopyData(inputCD, cellId, numOutCells + outCellId);
+        if (this->OriginalCellIds)
+        {
+          this->OriginalCellIds->SetValue(numOutCells + outCellId, cellId);
+        }
+      }
+    }
+  });
+  this->NumberOfNewCells += numFaceCells;
+  if (newPolys->GetNumberOfCells() == 0)
+  {
+    newPolys->SetData(offsets, connectivity);
+  }
+  else
+  {
+    vtkNew<vtkCellArray> faces;
+    faces->SetData(offsets, connectivity);
+    newPolys->Append(faces);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
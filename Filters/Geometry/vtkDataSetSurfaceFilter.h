@@ -72,9 +72,18 @@
  * boundary face and sent to the filter output. The filter determines this by
  * creating a hash table of faces: faces that are placed into the hash table
  * a single time are used only once, and therefore sent to the output. Thus
- * large amounts of extra memory is necessary to build the hash table. This
- * obsoleted approach requires a significant amount of memory, and is a
- * significant bottleneck to threading.
+ * large amounts of extra memory is necessary to build the hash table.
+ *
+ * @warning
+ * For vtkUnstructuredGrid inputs, the hash table is built and traversed
+ * with vtkSMPTools when several threads are available, giving the same
+ * output as the serial hash table. The faces of quadratic and Lagrange 3D
+ * cells are always hashed this way, by their corner points, and triangulated
+ * in parallel, unless NonlinearSubdivisionLevel is greater than 1 or the grid
+ * has ghosts. Other nonlinear 3D cells, such as Bezier cells, first go
+ * through a serial vtkUnstructuredGridGeometryFilter. Using TBB or other
+ * non-sequential type (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE)
+ * may improve performance significantly.
  *
  * @warning
  * This filter may create duplicate points. Unlike vtkGeometryFilter, it does
@@ -96,12 +105,15 @@ VTK_ABI_NAMESPACE_BEGIN
 template <typename ArrayType>
 class vtkSmartPointer;
 
+class vtkCellArray;
+class vtkCellData;
 class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
 class vtkImageData;
 class vtkRectilinearGrid;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 class vtkUnstructuredGridBase;
 
 // Helper structure for hashing faces.
@@ -361,6 +373,8 @@ private:
   int UnstructuredGridBaseExecute(vtkDataSet* input, vtkPolyData* output);
   int UnstructuredGridExecuteInternal(
     vtkUnstructuredGridBase* input, vtkPolyData* output, bool handleSubdivision);
+  void ExtractBoundaryFacesInParallel(vtkUnstructuredGrid* input, vtkPoints* newPts,
+    vtkCellArray* newPolys, vtkPointData* outputPD, vtkCellData* outputCD);
 
   int StructuredExecuteNoBlanking(
     vtkDataSet* input, vtkPolyData* output, vtkIdType* ext, vtkIdType* wholeExt);
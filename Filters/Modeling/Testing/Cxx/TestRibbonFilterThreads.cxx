@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRibbonFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Generate ribbons along random polylines with vtkRibbonFilter, check that
+// each ribbon is centered on its polyline, that the output does not depend on
+// the number of threads and that the ribbons generated concurrently are
+// exactly the ones of the serial traversal. The polylines sharing points are
+// processed serially when their normals are generated, concurrently when they
+// are given.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRibbonFilter.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Record whether the ribbons are generated concurrently, or force the serial
+// traversal.
+class vtkCheckedRibbonFilter : public vtkRibbonFilter
+{
+public:
+  static vtkCheckedRibbonFilter* New();
+  vtkTypeMacro(vtkCheckedRibbonFilter, vtkRibbonFilter);
+
+  bool Serial = false;
+  bool Concurrent = false;
+
+protected:
+  vtkCheckedRibbonFilter() = default;
+  ~vtkCheckedRibbonFilter() override = default;
+
+  bool GenerateRibbonsInParallel(vtkCellArray* inLines, vtkPoints* inPts, vtkPointData* pd,
+    vtkCellData* cd, vtkPointData* outPD, vtkCellData* outCD, vtkPoints* newPts,
+    vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals,
+    bool generateNormals) override
+  {
+    this->Concurrent = !this->Serial &&
+      this->Superclass::GenerateRibbonsInParallel(inLines, inPts, pd, cd, outPD, outCD, newPts,
+        newNormals, newTCoords, newStrips, inScalars, range, inNormals, generateNormals);
+    return this->Concurrent;
+  }
+
+private:
+  vtkCheckedRibbonFilter(const vtkCheckedRibbonFilter&) = delete;
+  void operator=(const vtkCheckedRibbonFilter&) = delete;
+};
+
+vtkStandardNewMacro(vtkCheckedRibbonFilter);
+
+//------------------------------------------------------------------------------
+// Random polylines, optionally starting at the same point and with normals,
+// none of which is parallel to a segment since the coordinates increase along
+// each polyline.
+vtkSmartPointer<vtkPolyData> RandomLines(int numLines, bool sharePoints, bool normals)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> lineIds;
+  lineIds->SetName("LineIds");
+  for (int line = 0; line < numLines; ++line)
+  {
+    const int numPts = 2 + line % 50;
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetNextRangeValue(-10.0, 10.0);
+    }
+    lines->InsertNextCell(numPts);
+    for (int i = 0; i < numPts; ++i)
+    {
+      if (sharePoints && line > 0 && i == 0)
+      {
+        lines->InsertCellPoint(0); // all the polylines start at the same point
+        continue;
+      }
+      for (int j = 0; j < 3; ++j)
+      {
+        x[j] += random->GetNextRangeValue(0.1, 1.0);
+      }
+      lines->InsertCellPoint(points->InsertNextPoint(x));
+      scalars->InsertNextValue(random->GetNextRangeValue(0.5, 2.0));
+    }
+    lineIds->InsertNextValue(line);
+  }
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->SetLines(lines);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetCellData()->AddArray(lineIds);
+  if (normals)
+  {
+    vtkNew<vtkFloatArray> pointNormals;
+    pointNormals->SetNumberOfComponents(3);
+    pointNormals->SetNumberOfTuples(points->GetNumberOfPoints());
+    for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+    {
+      pointNormals->SetTuple3(ptId, 0.6, -0.8, 0.0);
+    }
+    input->GetPointData()->SetNormals(pointNormals);
+  }
+  return input;
+}
+
+//------------------------------------------------------------------------------
+// Each polyline is covered by one strip whose pairs of points are centered on
+// the points of the polyline.
+bool CheckRibbons(vtkPolyData* output, vtkPolyData* input)
+{
+  if (output->GetNumberOfStrips() != input->GetNumberOfLines() ||
+    output->GetNumberOfPoints() != 2 * input->GetLines()->GetNumberOfConnectivityIds())
+  {
+    std::cerr << "Wrong output: " << output->GetNumberOfStrips() << " strips and "
+              << output->GetNumberOfPoints() << " points" << std::endl;
+    return false;
+  }
+  vtkCellArray* lines = input->GetLines();
+  vtkCellArray* strips = output->GetStrips();
+  for (vtkIdType lineId = 0; lineId < lines->GetNumberOfCells(); ++lineId)
+  {
+    vtkIdType npts, nStripPts;
+    const vtkIdType* pts;
+    const vtkIdType* stripPts;
+    lines->GetCellAtId(lineId, npts, pts);
+    strips->GetCellAtId(lineId, nStripPts, stripPts);
+    if (nStripPts != 2 * npts)
+    {
+      std::cerr << "Wrong strip " << lineId << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      double x[3], p0[3], p1[3];
+      input->GetPoint(pts[i], x);
+      output->GetPoint(stripPts[2 * i], p0);
+      output->GetPoint(stripPts[2 * i + 1], p1);
+      for (int j = 0; j < 3; ++j)
+      {
+        if (std::abs(0.5 * (p0[j] + p1[j]) - x[j]) > 1e-4)
+        {
+          std::cerr << "Strip " << lineId << " is not centered on its polyline" << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestRibbonFilterThreads(int, char*[])
+{
+  // the polylines sharing points are processed serially when their normals
+  // are generated
+  bool success = true;
+  for (int input = 0; input < 3; ++input)
+  {
+    const bool concurrent = input != 1;
+    vtkSmartPointer<vtkPolyData> lines = ::RandomLines(500, input > 0, input == 2);
+    vtkNew<vtkCheckedRibbonFilter> ribbon;
+    vtkNew<vtkCheckedRibbonFilter> serialRibbon;
+    serialRibbon->Serial = true;
+    for (vtkCheckedRibbonFilter* filter : { ribbon.Get(), serialRibbon.Get() })
+    {
+      filter->SetInputData(lines);
+      filter->VaryWidthOn();
+      filter->SetGenerateTCoordsToUseLength();
+    }
+
+    for (double angle : { 0.0, 30.0 })
+    {
+      ribbon->SetAngle(angle);
+      serialRibbon->SetAngle(angle);
+      success &= vtkSMPTestUtilities::CompareThreads(ribbon, "vtkRibbonFilter");
+      serialRibbon->Update();
+      if (ribbon->Concurrent != concurrent || serialRibbon->Concurrent)
+      {
+        std::cerr << "Wrong traversal of input " << input << std::endl;
+        success = false;
+      }
+      if (!vtkSMPTestUtilities::SameDataSets(ribbon->GetOutput(), serialRibbon->GetOutput()))
+      {
+        std::cerr << "The ribbons of input " << input << " with angle " << angle
+                  << " differ from the serial ones" << std::endl;
+        success = false;
+      }
+      success &= ::CheckRibbons(ribbon->GetOutput(), lines);
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
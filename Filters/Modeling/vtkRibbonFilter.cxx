@@ -17,14 +17,23 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -46,6 +55,9 @@ vtkRibbonFilter::vtkRibbonFilter()
   this->GenerateTCoords = 0;
   this->TextureLength = 1.0;
 
+  this->Theta = 0.0;
+  this->ReportWarnings = true;
+
   // by default process active point scalars
   this->SetInputArrayToProcess(
     0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
@@ -175,56 +187,62 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
+  // Generate the ribbons concurrently when possible, otherwise polyline after
+  // polyline.
+  if (!this->GenerateRibbonsInParallel(inLines, inPts, pd, cd, outPD, outCD, newPts, newNormals,
+        newTCoords, newStrips, inScalars, range, inNormals, generateNormals != 0))
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->CheckAbort();
-
-    if (npts < 2)
+    for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
+         inCellId++)
     {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
-    }
+      this->UpdateProgress((double)inCellId / numLines);
+      abort = this->CheckAbort();
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+      if (npts < 2)
       {
-        vtkWarningMacro(<< "No normals for line!");
+        vtkWarningMacro(<< "Less than two points in line!");
         continue; // skip tubing this polyline
       }
-    }
 
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
-    }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+      {
+        singlePolyline->Reset(); // avoid instantiation
+        singlePolyline->InsertNextCell(npts, pts);
+        if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+        {
+          vtkWarningMacro(<< "No normals for line!");
+          continue; // skip tubing this polyline
+        }
+      }
+
+      // Generate the points around the polyline. The strip is not created
+      // if the polyline is bad.
+      //
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; // skip ribboning this polyline
+      }
 
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      // Generate the strip for this polyline
+      //
+      this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset, npts);
 
-  } // for all polylines
+    } // for all polylines
+  }
 
   singlePolyline->Delete();
 
@@ -315,7 +333,10 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
-      vtkWarningMacro(<< "Coincident points!");
+      if (this->ReportWarnings)
+      {
+        vtkWarningMacro(<< "Coincident points!");
+      }
       return 0;
     }
 
@@ -326,6 +347,10 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
     // if s is zero then just use sPrev cross n
     if (vtkMath::Normalize(s) == 0.0)
     {
+      if (!this->ReportWarnings)
+      {
+        return 0;
+      }
       vtkWarningMacro(<< "Using alternate bevel vector");
       vtkMath::Cross(sPrev, n, s);
       if (vtkMath::Normalize(s) == 0.0)
@@ -353,8 +378,11 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
     vtkMath::Cross(s, n, w);
     if (vtkMath::Normalize(w) == 0.0)
     {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
+      if (this->ReportWarnings)
+      {
+        vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2]
+                        << " n = " << n[0] << " " << n[1] << " " << n[2]);
+      }
       return 0;
     }
 
@@ -419,10 +447,10 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
   }
   if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
   {
-    s0 = inScalars->GetTuple1(pts[0]);
+    s0 = inScalars->GetComponent(pts[0], 0);
     for (i = 1; i < npts; i++)
     {
-      s = inScalars->GetTuple1(pts[i]);
+      s = inScalars->GetComponent(pts[i], 0);
       tc = (s - s0) / this->TextureLength;
       for (k = 0; k < 2; k++)
       {
@@ -485,6 +513,148 @@ vtkIdType vtkRibbonFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+// Generate all the ribbons concurrently: each polyline writes its ribbon at
+// its place in the output, computed from the number of points of the
+// polylines. The output is the same as the one of the serial traversal in
+// RequestData(). Returns false, without output, if the polylines have to be
+// processed serially: when the sliding normals of polylines sharing points
+// are generated, or when a polyline raises a warning, so that the serial
+// traversal reports it.
+bool vtkRibbonFilter::GenerateRibbonsInParallel(vtkCellArray* inLines, vtkPoints* inPts,
+  vtkPointData* pd, vtkCellData* cd, vtkPointData* outPD, vtkCellData* outCD, vtkPoints* newPts,
+  vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals, bool generateNormals)
+{
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  vtkSMPThreadLocalObject<vtkIdList> localCellIds;
+
+  // Count the points of each ribbon, they are also the connectivity entries
+  // of its strip. When normals are generated, each polyline writes them at
+  // its points: check that no point is used by two polylines, the line using
+  // a point is stored plus one.
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numLines + 1);
+  vtkIdType* offsets = stripOffsets->GetPointer(0);
+  offsets[numLines] = 0;
+  std::vector<std::atomic<vtkIdType>> pointLines(generateNormals ? inPts->GetNumberOfPoints() : 0);
+  std::atomic<bool> serial(false);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellIds = localCellIds.Local();
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      inLines->GetCellAtId(lineId, npts, pts, cellIds);
+      if (npts < 2)
+      {
+        serial = true; // let the serial traversal warn about it
+        continue;
+      }
+      offsets[lineId] = this->ComputeOffset(0, npts);
+
+      for (vtkIdType i = 0; generateNormals && i < npts; ++i)
+      {
+        vtkIdType line = 0;
+        if (!pointLines[pts[i]].compare_exchange_strong(line, lineId + 1) && line != lineId + 1)
+        {
+          serial = true;
+        }
+      }
+    }
+  });
+  if (serial)
+  {
+    return false;
+  }
+  const vtkIdType numNewPts =
+    vtkSMPTools::ExclusiveScan(offsets, offsets + numLines + 1, offsets, vtkIdType(0));
+
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  outPD->SetNumberOfTuples(numNewPts);
+  outCD->SetNumberOfTuples(numLines);
+  if (newTCoords)
+  {
+    newTCoords->SetNumberOfTuples(numNewPts);
+  }
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(numNewPts);
+  vtkIdType* connectivity = stripConnectivity->GetPointer(0);
+
+  // Generate the ribbons, the warnings are reported by the serial traversal
+  // if a polyline fails.
+  std::atomic<bool> failed(false);
+  this->ReportWarnings = false;
+  vtkSMPThreadLocalObject<vtkCellArray> localPolyline;
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellIds = localCellIds.Local();
+    vtkCellArray* singlePolyline = localPolyline.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType lineId = begin; lineId < end && !failed; ++lineId)
+    {
+      if (lineId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      const vtkIdType offset = offsets[lineId];
+      vtkIdType npts;
+      const vtkIdType* pts;
+      inLines->GetCellAtId(lineId, npts, pts, cellIds);
+
+      if (generateNormals)
+      {
+        singlePolyline->Reset();
+        singlePolyline->InsertNextCell(npts, pts);
+        vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      }
+
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+      {
+        failed = true;
+        break;
+      }
+
+      // the strip of 2 * npts points has the id of the polyline
+      outCD->CopyData(cd, lineId, lineId);
+      for (vtkIdType i = 0; i < 2 * npts; ++i)
+      {
+        connectivity[offset + i] = offset + i;
+      }
+
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
+    }
+  });
+  this->ReportWarnings = true;
+
+  if (failed)
+  {
+    newPts->Reset();
+    newNormals->Reset();
+    outPD->Reset();
+    outCD->Reset();
+    if (newTCoords)
+    {
+      newTCoords->Reset();
+    }
+    return false;
+  }
+  newStrips->SetData(stripOffsets, stripConnectivity);
+  return true;
+}
+
 // Description:
 // Return the method of generating the texture coordinates.
 const char* vtkRibbonFilter::GetGenerateTCoordsAsString()
@@ -29,6 +29,14 @@
  * can be removed with vtkCleanPolyData.) If a line does not meet this
  * criteria, then that line is not tubed.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly. The
+ * ribbons are generated concurrently, and the output is the same as the one
+ * generated serially. The lines are processed serially when normals have to
+ * be generated for lines that share points, or when a line raises a warning.
+ *
  * @sa
  * vtkTubeFilter
  */
@@ -172,8 +180,16 @@ protected:
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
+  // Generate the ribbons of all the polylines concurrently. Returns false,
+  // without output, to process them serially instead.
+  virtual bool GenerateRibbonsInParallel(vtkCellArray* inLines, vtkPoints* inPts, vtkPointData* pd,
+    vtkCellData* cd, vtkPointData* outPD, vtkCellData* outCD, vtkPoints* newPts,
+    vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals, bool generateNormals);
+
   // Helper data members
   double Theta;
+  bool ReportWarnings; // when false, GeneratePoints() fails instead of warning
 
 private:
   vtkRibbonFilter(const vtkRibbonFilter&) = delete;
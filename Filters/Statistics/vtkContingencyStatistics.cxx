@@ -26,6 +26,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkLongArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
@@ -33,7 +34,9 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
 
+#include <array>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include <sstream>
@@ -41,6 +44,28 @@ PURPOSE.  See the above copyright notice for more information.
 typedef std::map<std::string, vtkIdType> StringCounts;
 typedef std::map<vtkIdType, double> Entropies;
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Return the codes of a dictionary encoded string array, or nullptr.
+const int* DictionaryCodes(vtkAbstractArray* array)
+{
+  vtkStringArray* stringArray = vtkArrayDownCast<vtkStringArray>(array);
+  return stringArray && stringArray->GetNumberOfComponents() == 1 &&
+      stringArray->GetDictionaryEncoding()
+    ? stringArray->GetCodesArray()->GetPointer(0)
+    : nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkStdString DictionaryValue(vtkAbstractArray* array, int code)
+{
+  vtkStringArray* dictionary = static_cast<vtkStringArray*>(array)->GetDictionary();
+  return vtkStdString(
+    dictionary->GetValueData(code), static_cast<size_t>(dictionary->GetValueSize(code)));
+}
+}
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 template <typename TypeSpec, typename vtkType>
@@ -118,19 +143,45 @@ public:
   {
     this->DataX = valsX;
     this->DataY = valsY;
+    this->CodesX = ::DictionaryCodes(valsX);
+    this->CodesY = ::DictionaryCodes(valsY);
   }
   ~BivariateContingenciesAndInformationFunctor() override = default;
   void operator()(vtkDoubleArray* result, vtkIdType id) override
   {
+    result->SetNumberOfValues(4);
+    if (this->CodesX && this->CodesY)
+    {
+      // Look the strings up once per pair of codes
+      auto inserted = this->CodeValues.emplace(
+        std::make_pair(this->CodesX[id], this->CodesY[id]), std::array<double, 4>());
+      if (inserted.second)
+      {
+        TypeSpec x = ::DictionaryValue(this->DataX, this->CodesX[id]);
+        TypeSpec y = ::DictionaryValue(this->DataY, this->CodesY[id]);
+        inserted.first->second = { { this->PdfX_Y[x][y], this->PdfYcX[x][y], this->PdfXcY[x][y],
+          this->PmiX_Y[x][y] } };
+      }
+      for (int i = 0; i < 4; ++i)
+      {
+        result->SetValue(i, inserted.first->second[i]);
+      }
+      return;
+    }
+
     TypeSpec x = this->DataX->GetVariantValue(id).ToString();
     TypeSpec y = this->DataY->GetVariantValue(id).ToString();
 
-    result->SetNumberOfValues(4);
     result->SetValue(0, this->PdfX_Y[x][y]);
     result->SetValue(1, this->PdfYcX[x][y]);
     result->SetValue(2, this->PdfXcY[x][y]);
     result->SetValue(3, this->PmiX_Y[x][y]);
   }
+
+private:
+  const int* CodesX;
+  const int* CodesY;
+  std::map<std::pair<int, int>, std::array<double, 4>> CodeValues;
 };
 
 // Count is separated from the class so that it can be properly specialized
@@ -165,6 +216,23 @@ void Count(std::map<vtkStdString, std::map<vtkStdString, vtkIdType>>& table,
   vtkAbstractArray* valsX, vtkAbstractArray* valsY)
 {
   vtkIdType nRow = valsX->GetNumberOfTuples();
+  const int* codesX = ::DictionaryCodes(valsX);
+  const int* codesY = ::DictionaryCodes(valsY);
+  if (codesX && codesY)
+  {
+    // Count the pairs of codes, then convert them to strings
+    std::map<std::pair<int, int>, vtkIdType> codeTable;
+    for (vtkIdType r = 0; r < nRow; ++r)
+    {
+      ++codeTable[std::make_pair(codesX[r], codesY[r])];
+    }
+    for (const auto& codeCount : codeTable)
+    {
+      table[::DictionaryValue(valsX, codeCount.first.first)]
+           [::DictionaryValue(valsY, codeCount.first.second)] += codeCount.second;
+    }
+    return;
+  }
   for (vtkIdType r = 0; r < nRow; ++r)
   {
     ++table[valsX->GetVariantValue(r).ToString()][valsY->GetVariantValue(r).ToString()];
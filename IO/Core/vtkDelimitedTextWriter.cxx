@@ -28,6 +28,7 @@
 #include "vtkInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtksys/FStream.hxx"
 
@@ -159,6 +160,37 @@ void vtkDelimitedTextWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>*
   }
 }
 
+//------------------------------------------------------------------------------
+// The values of a string array are written from its characters, which neither
+// converts an array with compact storage nor copies the values.
+void vtkDelimitedTextWriterGetDataString(vtkStringArray* array, vtkIdType tupleIndex,
+  ostream* stream, vtkDelimitedTextWriter* writer, bool* first)
+{
+  const char* delimiter = writer->GetUseStringDelimiter() ? writer->GetStringDelimiter() : nullptr;
+  int numComps = array->GetNumberOfComponents();
+  vtkIdType index = tupleIndex * numComps;
+  for (int cc = 0; cc < numComps; cc++)
+  {
+    if (!*first)
+    {
+      (*stream) << writer->GetFieldDelimiter();
+    }
+    *first = false;
+    if ((index + cc) < array->GetNumberOfValues())
+    {
+      if (delimiter)
+      {
+        (*stream) << delimiter;
+      }
+      stream->write(array->GetValueData(index + cc), array->GetValueSize(index + cc));
+      if (delimiter)
+      {
+        (*stream) << delimiter;
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkStdString vtkDelimitedTextWriter::GetString(vtkStdString string)
 {
@@ -195,7 +227,9 @@ void vtkDelimitedTextWriter::WriteTable(vtkTable* table)
     return;
   }
 
+  // string columns are written without iterator
   std::vector<vtkSmartPointer<vtkArrayIterator>> columnsIters;
+  std::vector<vtkStringArray*> stringColumns;
 
   int cc;
   int numArrays = dsa->GetNumberOfArrays();
@@ -220,6 +254,13 @@ void vtkDelimitedTextWriter::WriteTable(vtkTable* table)
       }
       (*this->Stream) << this->GetString(array_name.str());
     }
+    vtkStringArray* stringArray = vtkArrayDownCast<vtkStringArray>(array);
+    stringColumns.push_back(stringArray);
+    if (stringArray)
+    {
+      columnsIters.emplace_back(nullptr);
+      continue;
+    }
     vtkArrayIterator* iter = array->NewIterator();
     columnsIters.emplace_back(iter);
     iter->Delete();
@@ -232,6 +273,12 @@ void vtkDelimitedTextWriter::WriteTable(vtkTable* table)
     std::vector<vtkSmartPointer<vtkArrayIterator>>::iterator iter;
     for (iter = columnsIters.begin(); iter != columnsIters.end(); ++iter)
     {
+      vtkStringArray* stringArray = stringColumns[iter - columnsIters.begin()];
+      if (stringArray)
+      {
+        vtkDelimitedTextWriterGetDataString(stringArray, index, this->Stream, this, &first);
+        continue;
+      }
       switch ((*iter)->GetDataType())
       {
         vtkArrayIteratorTemplateMacro(vtkDelimitedTextWriterGetDataString(
@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFReaderCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the static geometry of a transient file is shared between time
+// steps when the cache of vtkHDFReader is used, while the point data changes.
+
+#include "vtkHDFReader.h"
+
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTesting.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+struct StepData
+{
+  vtkSmartPointer<vtkDataArray> Points;
+  vtkSmartPointer<vtkDataArray> Modulator;
+};
+
+StepData ReadStep(vtkHDFReader* reader, double time)
+{
+  // read one of the two pieces, so that the output is not appended
+  reader->UpdateTimeStep(time, 0, 2);
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputDataObject(0));
+  StepData data;
+  data.Points = output->GetPoints()->GetData();
+  data.Modulator = output->GetPointData()->GetArray("Modulator");
+  return data;
+}
+}
+
+int TestHDFReaderCache(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testUtils;
+  testUtils->AddArguments(argc, argv);
+  const std::string fileName = std::string(testUtils->GetDataRoot()) + "/Data/transient_sphere.hdf";
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  StepData step0 = ::ReadStep(reader, 0.0);
+  StepData step1 = ::ReadStep(reader, 0.1);
+  if (!step0.Points || !step0.Modulator || !step1.Modulator)
+  {
+    std::cerr << "Missing arrays in the output." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (step0.Points != step1.Points)
+  {
+    std::cerr << "The points are not shared between time steps." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (step0.Modulator == step1.Modulator ||
+    step0.Modulator->GetComponent(0, 0) == step1.Modulator->GetComponent(0, 0))
+  {
+    std::cerr << "The point data did not change between time steps." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  reader->UseCacheOff();
+  StepData step2 = ::ReadStep(reader, 0.2);
+  if (step2.Points == step1.Points ||
+    step2.Points->GetNumberOfTuples() != step1.Points->GetNumberOfTuples())
+  {
+    std::cerr << "The points must be read again without the cache." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < step1.Points->GetNumberOfValues(); ++i)
+  {
+    if (step1.Points->GetComponent(i / 3, i % 3) != step2.Points->GetComponent(i / 3, i % 3))
+    {
+      std::cerr << "Wrong cached points." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
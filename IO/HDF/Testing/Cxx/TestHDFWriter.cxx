@@ -0,0 +1,320 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write images, poly data, unstructured grids, partitioned datasets and
+// transient data with vtkHDFWriter and read them back with vtkHDFReader.
+
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTesting.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// Sphere whose radius is the time.
+class TimeSphereSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeSphereSource* New();
+  vtkTypeMacro(TimeSphereSource, vtkPolyDataAlgorithm);
+
+protected:
+  TimeSphereSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    const double times[3] = { 1.0, 2.0, 3.0 };
+    const double range[2] = { 1.0, 3.0 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, 3);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetRadius(time);
+    // the geometry changes with time
+    sphere->SetThetaResolution(8 + static_cast<int>(time));
+    sphere->Update();
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->ShallowCopy(sphere->GetOutput());
+    vtkNew<vtkDoubleArray> value;
+    value->SetName("Value");
+    value->SetNumberOfValues(output->GetNumberOfPoints());
+    value->Fill(time);
+    output->GetPointData()->AddArray(value);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeSphereSource);
+
+//------------------------------------------------------------------------------
+bool CompareArrays(vtkDataArray* array, vtkDataArray* expected, const char* name)
+{
+  if (!array || array->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    array->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    std::cerr << "Wrong array " << name << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+    {
+      if (array->GetComponent(i, c) != expected->GetComponent(i, c))
+      {
+        std::cerr << "Wrong value in " << name << " at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareDataSets(vtkDataSet* output, vtkDataSet* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of points or cells: " << output->GetNumberOfPoints() << " / "
+              << output->GetNumberOfCells() << " instead of " << expected->GetNumberOfPoints()
+              << " / " << expected->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    output->GetPoint(i, x);
+    expected->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Wrong point " << i << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfCells(); ++i)
+  {
+    if (output->GetCellType(i) != expected->GetCellType(i) ||
+      output->GetCell(i)->GetNumberOfPoints() != expected->GetCell(i)->GetNumberOfPoints() ||
+      output->GetCell(i)->GetPointId(0) != expected->GetCell(i)->GetPointId(0))
+    {
+      std::cerr << "Wrong cell " << i << std::endl;
+      return false;
+    }
+  }
+  for (int attributeType = vtkDataObject::POINT; attributeType <= vtkDataObject::CELL;
+       ++attributeType)
+  {
+    vtkDataSetAttributes* attributes = expected->GetAttributes(attributeType);
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+    {
+      const char* name = attributes->GetArrayName(i);
+      if (!CompareArrays(
+            output->GetAttributes(attributeType)->GetArray(name), attributes->GetArray(i), name))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataSet> WriteAndRead(vtkDataObject* input, const std::string& fileName,
+  int compressionLevel = 0, int chunkSize = 25000)
+{
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressionLevel(compressionLevel);
+  writer->SetChunkSize(chunkSize);
+  if (!writer->Write())
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return nullptr;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  return vtkDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+}
+
+//------------------------------------------------------------------------------
+bool TestPolyData(const std::string& tempDirectory)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(20);
+  sphere->SetPhiResolution(20);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkDoubleArray> field;
+  field->SetName("Field");
+  field->SetNumberOfComponents(2);
+  field->InsertNextTuple2(1.0, 2.0);
+  field->InsertNextTuple2(3.0, 4.0);
+  input->GetFieldData()->AddArray(field);
+
+  auto output = WriteAndRead(input, tempDirectory + "/TestHDFWriterPolyData.vtkhdf", 0, 100);
+  if (!output || !CompareDataSets(output, input) ||
+    !CompareArrays(output->GetFieldData()->GetArray("Field"), field, "Field"))
+  {
+    std::cerr << "TestPolyData failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestUnstructuredGrid(const std::string& tempDirectory)
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkAppendFilter> append;
+  append->SetInputConnection(sphere->GetOutputPort());
+  append->Update();
+  vtkUnstructuredGrid* input = append->GetOutput();
+
+  auto output = WriteAndRead(input, tempDirectory + "/TestHDFWriterUnstructuredGrid.vtkhdf");
+  if (!output || !CompareDataSets(output, input))
+  {
+    std::cerr << "TestUnstructuredGrid failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestImageData(const std::string& tempDirectory)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-5, 10, 0, 12, 3, 8);
+  source->Update();
+  vtkImageData* input = source->GetOutput();
+
+  auto output = WriteAndRead(input, tempDirectory + "/TestHDFWriterImageData.vtkhdf", 4, 50);
+  if (!output || !CompareDataSets(output, input))
+  {
+    std::cerr << "TestImageData failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestPartitionedDataSet(const std::string& tempDirectory)
+{
+  vtkNew<vtkPartitionedDataSet> input;
+  vtkNew<vtkAppendFilter> append;
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(i, 0, 0);
+    sphere->Update();
+    input->SetPartition(i, sphere->GetOutput());
+    append->AddInputData(sphere->GetOutput());
+  }
+  append->Update();
+
+  auto output = WriteAndRead(input, tempDirectory + "/TestHDFWriterPartitioned.vtkhdf");
+  vtkNew<vtkAppendFilter> appendOutput;
+  appendOutput->AddInputData(output);
+  appendOutput->Update();
+  if (!output || !CompareDataSets(appendOutput->GetOutput(), append->GetOutput()))
+  {
+    std::cerr << "TestPartitionedDataSet failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestTransient(const std::string& tempDirectory)
+{
+  const std::string fileName = tempDirectory + "/TestHDFWriterTransient.vtkhdf";
+  vtkNew<TimeSphereSource> source;
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  if (!writer->Write())
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  if (reader->GetNumberOfSteps() != 3)
+  {
+    std::cerr << "Wrong number of steps: " << reader->GetNumberOfSteps() << std::endl;
+    return false;
+  }
+  for (int step = 0; step < 3; ++step)
+  {
+    reader->SetStep(step);
+    reader->Update();
+    source->UpdateTimeStep(step + 1.0);
+    if (!CompareDataSets(
+          vtkDataSet::SafeDownCast(reader->GetOutputDataObject(0)), source->GetOutput()))
+    {
+      std::cerr << "TestTransient failed at step " << step << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestHDFWriter(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDirectory = testing->GetTempDirectory();
+
+  bool success = TestPolyData(tempDirectory);
+  success &= TestUnstructuredGrid(tempDirectory);
+  success &= TestImageData(tempDirectory);
+  success &= TestPartitionedDataSet(tempDirectory);
+  success &= TestTransient(tempDirectory);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -240,6 +240,7 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "UseCache: " << (this->UseCache ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -772,6 +773,12 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkUnstructuredGrid* data)
     {
       return 0;
     }
+    if (filePiece == piece && filePiece + memoryPieceCount >= filePieceCount)
+    {
+      // a single piece is shared as is, with its cached arrays
+      data->ShallowCopy(pieceData);
+      break;
+    }
     append->Update();
     data->ShallowCopy(append->GetOutput());
   }
@@ -924,6 +931,12 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data)
         }
       }
     }
+    if (filePiece == piece && filePiece + memoryPieceCount >= filePieceCount)
+    {
+      // a single piece is shared as is, with its cached arrays
+      data->ShallowCopy(pieceData);
+      break;
+    }
     append->Update();
     data->ShallowCopy(append->GetOutput());
   }
@@ -1000,6 +1013,8 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro("HDF dataset type unknown: " << dataSetType);
     return 0;
   }
-  return ok && this->AddFieldArrays(output);
+  ok = ok && this->AddFieldArrays(output);
+  this->Impl->UpdateCache();
+  return ok;
 }
 VTK_ABI_NAMESPACE_END
@@ -130,6 +130,18 @@ public:
   const std::array<double, 2>& GetTimeRange() const { return this->TimeRange; }
   ///@}
 
+  ///@{
+  /**
+   * When on (the default), the arrays read for an output are shared with the
+   * next output if it reads them from the same part of the file, such as the
+   * points and cells of transient data with a static geometry. Only the
+   * arrays that changed are then read for a new time step.
+   */
+  vtkSetMacro(UseCache, bool);
+  vtkGetMacro(UseCache, bool);
+  vtkBooleanMacro(UseCache, bool);
+  ///@}
+
   vtkSetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
   vtkGetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
 
@@ -240,6 +252,8 @@ protected:
 
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
+  bool UseCache = true;
+
   class Implementation;
   Implementation* Impl;
 };
@@ -375,6 +375,8 @@ int vtkHDFReader::Implementation::GetNumberOfPieces(vtkIdType step)
 //------------------------------------------------------------------------------
 void vtkHDFReader::Implementation::Close()
 {
+  this->PreviousCache.clear();
+  this->CurrentCache.clear();
   this->DataSetType = -1;
   this->NumberOfPieces = 0;
   std::fill(this->Version.begin(), this->Version.end(), 0);
@@ -752,7 +754,8 @@ hid_t vtkHDFReader::Implementation::OpenDataSet(
 vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, const std::vector<hsize_t>& fileExtent)
 {
-  return NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
+  return this->NewCachedArray(
+    attributeType, this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -760,7 +763,8 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
+  return this->NewCachedArray(
+    attributeType, this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -857,7 +861,45 @@ vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
   const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return NewArrayForGroup(this->VTKGroup, name, fileExtent);
+  return this->NewCachedArray(-1, this->VTKGroup, name, fileExtent);
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkHDFReader::Implementation::NewCachedArray(
+  int cacheGroup, hid_t group, const char* name, const std::vector<hsize_t>& fileExtent)
+{
+  if (!this->Reader->UseCache)
+  {
+    return this->NewArrayForGroup(group, name, fileExtent);
+  }
+  const CacheKey key(cacheGroup, name, fileExtent);
+  auto it = this->CurrentCache.find(key);
+  if (it == this->CurrentCache.end())
+  {
+    auto previous = this->PreviousCache.find(key);
+    vtkSmartPointer<vtkDataArray> array = previous != this->PreviousCache.end()
+      ? previous->second
+      : vtk::TakeSmartPointer(this->NewArrayForGroup(group, name, fileExtent));
+    if (!array)
+    {
+      return nullptr;
+    }
+    it = this->CurrentCache.emplace(key, array).first;
+  }
+  // the caller owns a reference, as for a new array
+  it->second->Register(nullptr);
+  return it->second;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::UpdateCache()
+{
+  this->PreviousCache.swap(this->CurrentCache);
+  this->CurrentCache.clear();
+  if (!this->Reader->UseCache)
+  {
+    this->PreviousCache.clear();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -22,10 +22,12 @@
 #define vtkHDFReaderImplementation_h
 
 #include "vtkHDFReader.h"
+#include "vtkSmartPointer.h" // for the cached arrays
 #include "vtk_hdf5.h"
 #include <array>
 #include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -90,7 +92,8 @@ public:
    * or CellData groups depending on the 'attributeType' parameter.
    * There are two versions: a first one that reads from a 3D array using a fileExtent,
    * and a second one that reads from a linear array using an offset and size.
-   * The array has to be deleted by the user.
+   * The array has to be deleted by the user. When the reader uses its cache,
+   * the array may be shared with the previous output.
    */
   vtkDataArray* NewArray(
     int attributeType, const char* name, const std::vector<hsize_t>& fileExtent);
@@ -103,7 +106,8 @@ public:
    * Reads a 1D metadata array in a DataArray or a vector of vtkIdType.
    * We read either the whole array for the vector version or a slice
    * specified with (offset, size). For an error we return nullptr or an
-   * empty vector.
+   * empty vector. When the reader uses its cache, the array may be shared
+   * with the previous output.
    */
   vtkDataArray* NewMetadataArray(const char* name, hsize_t offset, hsize_t size);
   std::vector<vtkIdType> GetMetadata(const char* name, hsize_t size, hsize_t offset = 0);
@@ -113,6 +117,12 @@ public:
    */
   std::vector<hsize_t> GetDimensions(const char* dataset);
 
+  /**
+   * Keeps the arrays read for the current output, to share them with the
+   * next one, and releases the others. Called once the output is complete.
+   */
+  void UpdateCache();
+
   /**
    * Fills the given AMR data with the content of the opened HDF file.
    * The number of level to read is limited by the maximumLevelsToReadByDefault argument.
@@ -237,6 +247,25 @@ private:
 
   bool ReadDataSetType();
 
+  /**
+   * Reads an array with NewArrayForGroup, or returns the array already read
+   * for the current or the previous output from the same extent of the same
+   * dataset. 'cacheGroup' identifies the group: an attribute type, or -1 for
+   * the metadata.
+   */
+  vtkDataArray* NewCachedArray(
+    int cacheGroup, hid_t group, const char* name, const std::vector<hsize_t>& fileExtent);
+
+  ///@{
+  /**
+   * Arrays read for the previous and for the current outputs, keyed by
+   * group, dataset name and extent read.
+   */
+  using CacheKey = std::tuple<int, std::string, std::vector<hsize_t>>;
+  std::map<CacheKey, vtkSmartPointer<vtkDataArray>> PreviousCache;
+  std::map<CacheKey, vtkSmartPointer<vtkDataArray>> CurrentCache;
+  ///@}
+
   ///@{
   /**
    * These methods are valid only with AMR data set type.
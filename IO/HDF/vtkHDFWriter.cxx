@@ -0,0 +1,337 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHDFWriter.h"
+
+#include "vtkCommand.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkErrorCode.h"
+#include "vtkFieldData.h"
+#include "vtkHDFWriterImplementation.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPI.h"
+#include "vtkMPICommunicator.h"
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Temporary field array keeping the extent of the images gathered on the
+// first process, which is lost by the marshaling.
+const char* const EXTENT_ARRAY_NAME = "vtkHDFWriterExtent";
+
+//------------------------------------------------------------------------------
+void CollectParts(vtkDataObject* input, std::vector<vtkSmartPointer<vtkDataSet>>& parts)
+{
+  if (vtkDataSet* dataSet = vtkDataSet::SafeDownCast(input))
+  {
+    parts.emplace_back(dataSet);
+  }
+  else if (vtkCompositeDataSet* composite = vtkCompositeDataSet::SafeDownCast(input))
+  {
+    auto iter = vtk::TakeSmartPointer(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (vtkDataSet* leaf = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        parts.emplace_back(leaf);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Gathers the pieces of all the processes on the first one.
+bool GatherParts(
+  vtkMultiProcessController* controller, std::vector<vtkSmartPointer<vtkDataSet>>& parts)
+{
+  vtkNew<vtkPartitionedDataSet> local;
+  for (const auto& part : parts)
+  {
+    vtkSmartPointer<vtkDataSet> copy = vtk::TakeSmartPointer(part->NewInstance());
+    copy->ShallowCopy(part);
+    if (vtkImageData* image = vtkImageData::SafeDownCast(copy))
+    {
+      vtkNew<vtkIntArray> extent;
+      extent->SetName(EXTENT_ARRAY_NAME);
+      extent->SetNumberOfValues(6);
+      std::copy_n(image->GetExtent(), 6, extent->GetPointer(0));
+      vtkNew<vtkFieldData> fieldData;
+      fieldData->ShallowCopy(image->GetFieldData());
+      fieldData->AddArray(extent);
+      image->SetFieldData(fieldData);
+    }
+    local->SetPartition(local->GetNumberOfPartitions(), copy);
+  }
+
+  std::vector<vtkSmartPointer<vtkDataObject>> received;
+  if (!controller->Gather(local, received, 0))
+  {
+    return false;
+  }
+  parts.clear();
+  for (const auto& object : received)
+  {
+    std::vector<vtkSmartPointer<vtkDataSet>> processParts;
+    ::CollectParts(object, processParts);
+    for (const auto& part : processParts)
+    {
+      if (vtkImageData* image = vtkImageData::SafeDownCast(part))
+      {
+        vtkIntArray* extent =
+          vtkIntArray::SafeDownCast(image->GetFieldData()->GetArray(EXTENT_ARRAY_NAME));
+        if (extent && extent->GetNumberOfValues() == 6)
+        {
+          image->SetExtent(extent->GetPointer(0));
+        }
+        image->GetFieldData()->RemoveArray(EXTENT_ARRAY_NAME);
+      }
+      parts.push_back(part);
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkHDFWriter);
+vtkCxxSetObjectMacro(vtkHDFWriter, Controller, vtkMultiProcessController);
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::vtkHDFWriter()
+  : Impl(new Implementation(this))
+{
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::~vtkHDFWriter()
+{
+  this->SetFileName(nullptr);
+  this->SetController(nullptr);
+  delete this->Impl;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "WriteAllTimeSteps: " << this->WriteAllTimeSteps << "\n";
+  os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  os << indent << "Controller: " << this->Controller << "\n";
+  os << indent << "UseCollectiveIO: " << this->UseCollectiveIO << "\n";
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Remove(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE());
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPartitionedDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPartitionedDataSetCollection");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkHDFWriter::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    return this->RequestInformation(request, inputVector, outputVector);
+  }
+  else if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    return this->RequestUpdateExtent(request, inputVector, outputVector);
+  }
+  else if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    return this->RequestData(request, inputVector, outputVector);
+  }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    this->NumberOfTimeSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  }
+  else
+  {
+    this->NumberOfTimeSteps = 0;
+  }
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (this->WriteAllTimeSteps && inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    double* timeSteps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    inInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), timeSteps[this->CurrentTimeIndex]);
+  }
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      this->Controller->GetLocalProcessId());
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      this->Controller->GetNumberOfProcesses());
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+  vtkInformationVector* vtkNotUsed(outputVector))
+{
+  if (!this->FileName)
+  {
+    vtkErrorMacro("A FileName must be specified.");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return 0;
+  }
+
+  const bool transient = this->WriteAllTimeSteps && this->NumberOfTimeSteps > 1;
+  if (this->CurrentTimeIndex == 0 && transient)
+  {
+    // Tell the pipeline to start looping.
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+  }
+
+  this->SetErrorCode(vtkErrorCode::NoError);
+  this->InvokeEvent(vtkCommand::StartEvent, nullptr);
+  this->WriteData();
+  this->InvokeEvent(vtkCommand::EndEvent, nullptr);
+  const bool success = this->GetErrorCode() == vtkErrorCode::NoError;
+
+  this->CurrentTimeIndex++;
+  if (!transient || !success || this->CurrentTimeIndex >= this->NumberOfTimeSteps)
+  {
+    this->Impl->Close();
+    this->CurrentTimeIndex = 0;
+    if (transient)
+    {
+      // Tell the pipeline to stop looping.
+      request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 0);
+    }
+  }
+  return success ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::WriteData()
+{
+  vtkInformation* inInfo = this->GetInputInformation();
+  vtkDataObject* input = this->GetInput();
+  const bool transient = this->WriteAllTimeSteps && this->NumberOfTimeSteps > 1;
+  const int numberOfProcesses = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  const int rank = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+
+  // With collective IO all the processes write in the file, otherwise the
+  // pieces are gathered on the first process.
+  bool collective = false;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI && defined(H5_HAVE_PARALLEL)
+  vtkMPICommunicator* communicator = this->Controller
+    ? vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator())
+    : nullptr;
+  collective = numberOfProcesses > 1 && this->UseCollectiveIO && communicator;
+#endif
+
+  std::vector<vtkSmartPointer<vtkDataSet>> parts;
+  ::CollectParts(input, parts);
+  if (numberOfProcesses > 1 && !collective)
+  {
+    if (!::GatherParts(this->Controller, parts))
+    {
+      vtkErrorMacro("Cannot gather the pieces on the first process.");
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+      return;
+    }
+    if (rank != 0)
+    {
+      return;
+    }
+  }
+
+  if (this->CurrentTimeIndex == 0 || !transient || !this->Impl->IsOpen())
+  {
+    bool created = false;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI && defined(H5_HAVE_PARALLEL)
+    if (collective)
+    {
+      created = this->Impl->CreateCollective(
+        this->FileName, *communicator->GetMPIComm()->GetHandle());
+    }
+    else
+#endif
+    {
+      created = this->Impl->Create(this->FileName);
+    }
+    if (!created)
+    {
+      this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+      return;
+    }
+  }
+
+  double time = 0.0;
+  if (input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+  {
+    time = input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
+  }
+  else if (transient && inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    time = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS())[this->CurrentTimeIndex];
+  }
+
+  std::vector<vtkDataSet*> dataSets(parts.size());
+  std::transform(parts.begin(), parts.end(), dataSets.begin(),
+    [](const vtkSmartPointer<vtkDataSet>& part) { return part.Get(); });
+  if (!this->Impl->WriteDataSets(
+        dataSets, input->GetFieldData(), transient ? this->CurrentTimeIndex : -1, time))
+  {
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+  }
+}
+VTK_ABI_NAMESPACE_END
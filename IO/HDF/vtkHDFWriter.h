@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFWriter
+ * @brief   Write VTK HDF files.
+ *
+ * Writes data in the VTK HDF format read by vtkHDFReader. vtkImageData,
+ * vtkPolyData and vtkUnstructuredGrid are supported, as well as
+ * vtkPartitionedDataSet and vtkPartitionedDataSetCollection inputs whose
+ * partitions are all poly data or all unstructured grids. The partitions are
+ * written as the pieces of a single dataset (the hierarchy of a collection is
+ * not stored).
+ *
+ * When the input provides time steps and WriteAllTimeSteps is on, all the
+ * time steps are written in the same file, described by the 'VTKHDF/Steps'
+ * group.
+ *
+ * Datasets are chunked (see ChunkSize) and can be compressed with the
+ * deflate filter of HDF5 (see CompressionLevel).
+ *
+ * In parallel, the pieces of all the processes are written in the same
+ * file. When VTK is built with an MPI-enabled HDF5 and UseCollectiveIO is on,
+ * each process writes its pieces in the shared datasets with collective
+ * MPI-IO. Otherwise the pieces are gathered and written by the first
+ * process.
+ *
+ * @sa
+ * vtkHDFReader
+ */
+
+#ifndef vtkHDFWriter_h
+#define vtkHDFWriter_h
+
+#include "vtkIOHDFModule.h" // For export macro
+#include "vtkWriter.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkMultiProcessController;
+
+class VTKIOHDF_EXPORT vtkHDFWriter : public vtkWriter
+{
+public:
+  static vtkHDFWriter* New();
+  vtkTypeMacro(vtkHDFWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the name of the output file.
+   */
+  vtkSetFilePathMacro(FileName);
+  vtkGetFilePathMacro(FileName);
+  ///@}
+
+  ///@{
+  /**
+   * When on (the default) and the input provides time steps, all the time
+   * steps are written in the file. Otherwise only the current time step is
+   * written.
+   */
+  vtkSetMacro(WriteAllTimeSteps, vtkTypeBool);
+  vtkGetMacro(WriteAllTimeSteps, vtkTypeBool);
+  vtkBooleanMacro(WriteAllTimeSteps, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the approximate number of values in each HDF5 chunk (25000 by
+   * default). Chunks span whole tuples, and whole rows and slices of images
+   * when they fit.
+   */
+  vtkSetClampMacro(ChunkSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(ChunkSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the deflate compression level, from 0 (no compression, the
+   * default) to 9 (highest compression).
+   */
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the controller used to write the pieces of all the processes in
+   * the same file. Defaults to the global controller.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  ///@{
+  /**
+   * When on (the default), and if HDF5 supports it, the processes write their
+   * pieces in the shared datasets with collective MPI-IO. Otherwise the
+   * pieces are gathered and written by the first process. With collective
+   * IO, the names and types of the arrays are taken from the first piece of
+   * the first process.
+   */
+  vtkSetMacro(UseCollectiveIO, vtkTypeBool);
+  vtkGetMacro(UseCollectiveIO, vtkTypeBool);
+  vtkBooleanMacro(UseCollectiveIO, vtkTypeBool);
+  ///@}
+
+protected:
+  vtkHDFWriter();
+  ~vtkHDFWriter() override;
+
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector);
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector);
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  void WriteData() override;
+
+  char* FileName = nullptr;
+  vtkTypeBool WriteAllTimeSteps = true;
+  int ChunkSize = 25000;
+  int CompressionLevel = 0;
+  vtkMultiProcessController* Controller = nullptr;
+  vtkTypeBool UseCollectiveIO = true;
+
+  ///@{
+  /**
+   * Time steps of the input, and index of the time step being written.
+   */
+  int NumberOfTimeSteps = 0;
+  int CurrentTimeIndex = 0;
+  ///@}
+
+private:
+  vtkHDFWriter(const vtkHDFWriter&) = delete;
+  void operator=(const vtkHDFWriter&) = delete;
+
+  class Implementation;
+  Implementation* Impl;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
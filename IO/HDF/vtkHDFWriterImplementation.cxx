@@ -0,0 +1,1270 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriterImplementation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkHDFWriterImplementation.h"
+
+#include "vtkCellArray.h"
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkHDF5ScopedHandle.h"
+#include "vtkImageData.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkType.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+namespace
+{
+constexpr int NUM_POLY_DATA_TOPOS = 4;
+const char* const POLY_DATA_TOPOS[NUM_POLY_DATA_TOPOS] = { "Vertices", "Lines", "Polygons",
+  "Strips" };
+// in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
+const char* const ARRAY_GROUPS[] = { "/VTKHDF/PointData", "/VTKHDF/CellData",
+  "/VTKHDF/FieldData" };
+const char* const ARRAY_OFFSET_GROUPS[] = { "/VTKHDF/Steps/PointDataOffsets",
+  "/VTKHDF/Steps/CellDataOffsets", "/VTKHDF/Steps/FieldDataOffsets" };
+
+//------------------------------------------------------------------------------
+hid_t GetNativeType(int vtkType)
+{
+  switch (vtkType)
+  {
+    case VTK_CHAR:
+      return H5T_NATIVE_CHAR;
+    case VTK_SIGNED_CHAR:
+      return H5T_NATIVE_SCHAR;
+    case VTK_UNSIGNED_CHAR:
+      return H5T_NATIVE_UCHAR;
+    case VTK_SHORT:
+      return H5T_NATIVE_SHORT;
+    case VTK_UNSIGNED_SHORT:
+      return H5T_NATIVE_USHORT;
+    case VTK_INT:
+      return H5T_NATIVE_INT;
+    case VTK_UNSIGNED_INT:
+      return H5T_NATIVE_UINT;
+    case VTK_LONG:
+      return H5T_NATIVE_LONG;
+    case VTK_UNSIGNED_LONG:
+      return H5T_NATIVE_ULONG;
+    case VTK_LONG_LONG:
+      return H5T_NATIVE_LLONG;
+    case VTK_UNSIGNED_LONG_LONG:
+      return H5T_NATIVE_ULLONG;
+    case VTK_ID_TYPE:
+      return sizeof(vtkIdType) == sizeof(long long) ? H5T_NATIVE_LLONG : H5T_NATIVE_INT;
+    case VTK_FLOAT:
+      return H5T_NATIVE_FLOAT;
+    case VTK_DOUBLE:
+      return H5T_NATIVE_DOUBLE;
+    default:
+      return -1;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Same dimensions as the ones vtkHDFReader uses for image arrays.
+int GetNDims(const int* extent)
+{
+  int ndims = 3;
+  if (extent[5] - extent[4] == 0)
+  {
+    --ndims;
+  }
+  if (extent[3] - extent[2] == 0)
+  {
+    --ndims;
+  }
+  return ndims;
+}
+
+//------------------------------------------------------------------------------
+// Returns the tuples of 'arrays' one after the other in a contiguous array of
+// the given type. The array itself is returned when there is only one with
+// the right layout. Missing (null) arrays are replaced by 'sizes' zero tuples.
+vtkSmartPointer<vtkDataArray> Concatenate(const std::vector<vtkDataArray*>& arrays,
+  const std::vector<vtkIdType>& sizes, int dataType, int numberOfComponents)
+{
+  if (arrays.size() == 1 && arrays[0] &&
+    ::GetNativeType(arrays[0]->GetDataType()) == ::GetNativeType(dataType) &&
+    arrays[0]->GetNumberOfComponents() == numberOfComponents &&
+    arrays[0]->HasStandardMemoryLayout())
+  {
+    return arrays[0];
+  }
+  auto result = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(dataType));
+  result->SetNumberOfComponents(numberOfComponents);
+  result->SetNumberOfTuples(std::accumulate(sizes.begin(), sizes.end(), vtkIdType(0)));
+  if (std::find(arrays.begin(), arrays.end(), nullptr) != arrays.end())
+  {
+    result->Fill(0);
+  }
+  vtkIdType start = 0;
+  for (std::size_t i = 0; i < arrays.size(); ++i)
+  {
+    if (arrays[i] && sizes[i] > 0)
+    {
+      result->InsertTuples(start, sizes[i], 0, arrays[i]);
+    }
+    start += sizes[i];
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+const void* GetData(vtkDataArray* array)
+{
+  return array->GetNumberOfTuples() > 0 ? array->GetVoidPointer(0) : nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkCellArray* GetTopology(vtkPolyData* polyData, int topology)
+{
+  switch (topology)
+  {
+    case 0:
+      return polyData->GetVerts();
+    case 1:
+      return polyData->GetLines();
+    case 2:
+      return polyData->GetPolys();
+    default:
+      return polyData->GetStrips();
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+vtkHDFWriter::Implementation::Implementation(vtkHDFWriter* writer)
+  : Writer(writer)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::Implementation::~Implementation()
+{
+  this->Close();
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::Create(const char* fileName)
+{
+  this->Close();
+  this->File = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (this->File < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create file " << fileName);
+    return false;
+  }
+  return true;
+}
+
+#ifdef H5_HAVE_PARALLEL
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::CreateCollective(const char* fileName, MPI_Comm comm)
+{
+  this->Close();
+  vtkHDF::ScopedH5PHandle accessProperties = H5Pcreate(H5P_FILE_ACCESS);
+  if (accessProperties < 0 || H5Pset_fapl_mpio(accessProperties, comm, MPI_INFO_NULL) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot set the MPI-IO file driver");
+    return false;
+  }
+  this->File = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, accessProperties);
+  if (this->File < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create file " << fileName);
+    return false;
+  }
+  this->TransferProperties = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(this->TransferProperties, H5FD_MPIO_COLLECTIVE);
+  this->Collective = true;
+  return true;
+}
+#endif
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::Implementation::Close()
+{
+  for (auto& group : this->Groups)
+  {
+    H5Gclose(group.second);
+  }
+  this->Groups.clear();
+  if (this->TransferProperties != H5P_DEFAULT)
+  {
+    H5Pclose(this->TransferProperties);
+    this->TransferProperties = H5P_DEFAULT;
+  }
+  if (this->File >= 0)
+  {
+    H5Fclose(this->File);
+    this->File = -1;
+  }
+  this->Collective = false;
+  this->DataSetType = -1;
+  this->PreviousCounts = Counts();
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteDataSets(
+  const std::vector<vtkDataSet*>& parts, vtkFieldData* fieldData, int step, double time)
+{
+  // all the pieces of all the processes must have the same type
+  int minType = VTK_INT_MAX;
+  int maxType = -1;
+  for (vtkDataSet* part : parts)
+  {
+    int type = part->GetDataObjectType();
+    if (vtkImageData::SafeDownCast(part))
+    {
+      type = VTK_IMAGE_DATA;
+    }
+    else if (vtkUnstructuredGrid::SafeDownCast(part))
+    {
+      type = VTK_UNSTRUCTURED_GRID;
+    }
+    minType = std::min(minType, type);
+    maxType = std::max(maxType, type);
+  }
+  minType = this->AllReduce(minType, vtkCommunicator::MIN_OP);
+  maxType = this->AllReduce(maxType, vtkCommunicator::MAX_OP);
+  if (maxType < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "No dataset to write.");
+    return false;
+  }
+  if (minType != maxType)
+  {
+    vtkErrorWithObjectMacro(
+      this->Writer, "The pieces must all be images, poly data or unstructured grids.");
+    return false;
+  }
+  if (maxType != VTK_IMAGE_DATA && maxType != VTK_POLY_DATA && maxType != VTK_UNSTRUCTURED_GRID)
+  {
+    vtkErrorWithObjectMacro(this->Writer,
+      "Cannot write " << vtkDataObjectTypes::GetClassNameFromTypeId(maxType) << " pieces.");
+    return false;
+  }
+  if (this->DataSetType >= 0 && this->DataSetType != maxType)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "The type of the data changed between time steps.");
+    return false;
+  }
+
+  hid_t root = this->GetGroup("/VTKHDF");
+  if (root < 0)
+  {
+    return false;
+  }
+  if (this->DataSetType < 0)
+  {
+    const int version[2] = { 2, 0 };
+    const char* type = maxType == VTK_IMAGE_DATA
+      ? "ImageData"
+      : (maxType == VTK_POLY_DATA ? "PolyData" : "UnstructuredGrid");
+    if (!this->WriteAttribute(root, "Version", H5T_NATIVE_INT, 2, version) ||
+      !this->WriteStringAttribute(root, "Type", type))
+    {
+      return false;
+    }
+    this->DataSetType = maxType;
+  }
+
+  this->StepCounts = Counts();
+  bool success = false;
+  switch (this->DataSetType)
+  {
+    case VTK_IMAGE_DATA:
+      success = this->WriteImageData(parts, step);
+      break;
+    case VTK_POLY_DATA:
+      success = this->WritePolyData(parts, step);
+      break;
+    default:
+      success = this->WriteUnstructuredGrid(parts, step);
+      break;
+  }
+  success = success && this->WriteFieldData(fieldData, step);
+  if (success && step >= 0)
+  {
+    success = this->WriteSteps(step, time);
+    this->PreviousCounts.Parts += this->StepCounts.Parts;
+    this->PreviousCounts.Points += this->StepCounts.Points;
+    for (int i = 0; i < ::NUM_POLY_DATA_TOPOS; ++i)
+    {
+      this->PreviousCounts.Cells[i] += this->StepCounts.Cells[i];
+      this->PreviousCounts.ConnectivityIds[i] += this->StepCounts.ConnectivityIds[i];
+    }
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteImageData(const std::vector<vtkDataSet*>& parts, int step)
+{
+  std::vector<vtkImageData*> images;
+  int wholeExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX,
+    VTK_INT_MIN };
+  for (vtkDataSet* part : parts)
+  {
+    vtkImageData* image = vtkImageData::SafeDownCast(part);
+    const int* extent = image->GetExtent();
+    if (extent[1] < extent[0] || extent[3] < extent[2] || extent[5] < extent[4])
+    {
+      continue;
+    }
+    images.push_back(image);
+    for (int i = 0; i < 3; ++i)
+    {
+      wholeExtent[2 * i] = std::min(wholeExtent[2 * i], extent[2 * i]);
+      wholeExtent[2 * i + 1] = std::max(wholeExtent[2 * i + 1], extent[2 * i + 1]);
+    }
+  }
+
+  // geometry of the first image, of the first process that has one in
+  // collective mode
+  double geometry[15] = { 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+  if (!images.empty())
+  {
+    std::copy_n(images[0]->GetOrigin(), 3, geometry);
+    std::copy_n(images[0]->GetSpacing(), 3, geometry + 3);
+    std::copy_n(images[0]->GetDirectionMatrix()->GetData(), 9, geometry + 6);
+  }
+  if (this->Collective)
+  {
+    vtkMultiProcessController* controller = this->Writer->Controller;
+    for (int i = 0; i < 3; ++i)
+    {
+      wholeExtent[2 * i] = this->AllReduce(wholeExtent[2 * i], vtkCommunicator::MIN_OP);
+      wholeExtent[2 * i + 1] = this->AllReduce(wholeExtent[2 * i + 1], vtkCommunicator::MAX_OP);
+    }
+    const int source = this->AllReduce(
+      images.empty() ? VTK_INT_MAX : controller->GetLocalProcessId(), vtkCommunicator::MIN_OP);
+    if (source != VTK_INT_MAX)
+    {
+      controller->Broadcast(geometry, 15, source);
+    }
+  }
+  if (wholeExtent[1] < wholeExtent[0])
+  {
+    vtkErrorWithObjectMacro(this->Writer, "No image to write.");
+    return false;
+  }
+
+  // vtkHDFReader indexes the datasets with the extent: store the images with
+  // an extent starting at 0, moving the origin accordingly.
+  const double* spacing = geometry + 3;
+  const double* direction = geometry + 6;
+  double origin[3];
+  int shiftedExtent[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    origin[i] = geometry[i];
+    for (int j = 0; j < 3; ++j)
+    {
+      origin[i] += direction[3 * i + j] * wholeExtent[2 * j] * spacing[j];
+    }
+    shiftedExtent[2 * i] = 0;
+    shiftedExtent[2 * i + 1] = wholeExtent[2 * i + 1] - wholeExtent[2 * i];
+  }
+  if (step <= 0)
+  {
+    hid_t root = this->GetGroup("/VTKHDF");
+    if (!this->WriteAttribute(root, "WholeExtent", H5T_NATIVE_INT, 6, shiftedExtent) ||
+      !this->WriteAttribute(root, "Origin", H5T_NATIVE_DOUBLE, 3, origin) ||
+      !this->WriteAttribute(root, "Spacing", H5T_NATIVE_DOUBLE, 3, spacing) ||
+      !this->WriteAttribute(root, "Direction", H5T_NATIVE_DOUBLE, 9, direction))
+    {
+      return false;
+    }
+  }
+
+  // dimensions in C order (z, y, x), flat dimensions removed
+  const int ndims = ::GetNDims(wholeExtent);
+  std::vector<hsize_t> dims[2];
+  for (int i = 0; i < ndims; ++i)
+  {
+    const int d = ndims - 1 - i;
+    dims[vtkDataObject::POINT].push_back(wholeExtent[2 * d + 1] - wholeExtent[2 * d] + 1);
+    dims[vtkDataObject::CELL].push_back(wholeExtent[2 * d + 1] - wholeExtent[2 * d]);
+  }
+
+  // in collective mode, every process takes part in the writes of all the blocks
+  const int numberOfBlocks =
+    this->AllReduce(static_cast<int>(images.size()), vtkCommunicator::MAX_OP);
+  for (int attributeType = vtkDataObject::POINT; attributeType <= vtkDataObject::CELL;
+       ++attributeType)
+  {
+    const hsize_t pointModifier = attributeType == vtkDataObject::POINT ? 1 : 0;
+    std::vector<ArrayInfo> infos = this->GetArrayInfos(parts, attributeType);
+    hid_t group = this->GetGroup(::ARRAY_GROUPS[attributeType]);
+    if (group < 0)
+    {
+      return false;
+    }
+    for (const ArrayInfo& info : infos)
+    {
+      for (int block = 0; block < numberOfBlocks; ++block)
+      {
+        std::vector<hsize_t> start(ndims, 0);
+        std::vector<hsize_t> count(ndims, 0);
+        vtkSmartPointer<vtkDataArray> array;
+        if (block < static_cast<int>(images.size()))
+        {
+          vtkImageData* image = images[block];
+          const int* extent = image->GetExtent();
+          bool empty = false;
+          for (int i = 0; i < ndims; ++i)
+          {
+            const int d = ndims - 1 - i;
+            start[i] = extent[2 * d] - wholeExtent[2 * d];
+            count[i] = extent[2 * d + 1] - extent[2 * d] + pointModifier;
+            empty |= count[i] == 0;
+          }
+          vtkDataArray* source = image->GetAttributes(attributeType)->GetArray(info.Name.c_str());
+          if (!source || source->GetNumberOfComponents() != info.NumberOfComponents)
+          {
+            vtkWarningWithObjectMacro(
+              this->Writer, "Array " << info.Name << " is missing from a piece, using zeros.");
+            source = nullptr;
+          }
+          if (!empty)
+          {
+            const vtkIdType size = attributeType == vtkDataObject::POINT
+              ? image->GetNumberOfPoints()
+              : image->GetNumberOfCells();
+            array = ::Concatenate({ source }, { size }, info.DataType, info.NumberOfComponents);
+          }
+        }
+        if (!this->WriteBlock(group, info.Name.c_str(), this->GetNativeType(info.DataType),
+              dims[attributeType], info.NumberOfComponents > 1 ? info.NumberOfComponents : 0, step,
+              start, count, array ? ::GetData(array) : nullptr))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteUnstructuredGrid(
+  const std::vector<vtkDataSet*>& parts, int step)
+{
+  std::vector<vtkIdType> numberOfPoints;
+  std::vector<vtkIdType> numberOfCells;
+  std::vector<vtkIdType> numberOfConnectivityIds;
+  std::vector<vtkIdType> numberOfOffsets;
+  std::vector<vtkDataArray*> points;
+  std::vector<vtkDataArray*> types;
+  std::vector<vtkDataArray*> offsets;
+  std::vector<vtkDataArray*> connectivity;
+  int pointsType = -1;
+  for (vtkDataSet* part : parts)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(part);
+    vtkCellArray* cells = grid->GetCells();
+    const vtkIdType nCells = cells ? cells->GetNumberOfCells() : 0;
+    numberOfPoints.push_back(grid->GetNumberOfPoints());
+    numberOfCells.push_back(nCells);
+    numberOfConnectivityIds.push_back(cells ? cells->GetNumberOfConnectivityIds() : 0);
+    numberOfOffsets.push_back(nCells + 1);
+    points.push_back(grid->GetPoints() ? grid->GetPoints()->GetData() : nullptr);
+    if (points.back() && pointsType < 0)
+    {
+      pointsType = points.back()->GetDataType();
+    }
+    types.push_back(nCells > 0 ? grid->GetCellTypesArray() : nullptr);
+    offsets.push_back(nCells > 0 ? cells->GetOffsetsArray() : nullptr);
+    connectivity.push_back(nCells > 0 ? cells->GetConnectivityArray() : nullptr);
+  }
+  pointsType = this->AllReduce(pointsType, vtkCommunicator::MAX_OP);
+  if (pointsType < 0)
+  {
+    pointsType = VTK_FLOAT;
+  }
+
+  const std::vector<hsize_t> local = { parts.size(),
+    static_cast<hsize_t>(std::accumulate(numberOfPoints.begin(), numberOfPoints.end(), 0LL)),
+    static_cast<hsize_t>(std::accumulate(numberOfCells.begin(), numberOfCells.end(), 0LL)),
+    static_cast<hsize_t>(
+      std::accumulate(numberOfConnectivityIds.begin(), numberOfConnectivityIds.end(), 0LL)) };
+  std::vector<hsize_t> offset;
+  std::vector<hsize_t> total;
+  this->Distribute(local, offset, total);
+
+  hid_t root = this->GetGroup("/VTKHDF");
+  const hid_t idType = this->GetNativeType(VTK_ID_TYPE);
+  auto pointsArray = ::Concatenate(points, numberOfPoints, pointsType, 3);
+  auto typesArray = ::Concatenate(types, numberOfCells, VTK_UNSIGNED_CHAR, 1);
+  auto offsetsArray = ::Concatenate(offsets, numberOfOffsets, VTK_ID_TYPE, 1);
+  auto connectivityArray = ::Concatenate(connectivity, numberOfConnectivityIds, VTK_ID_TYPE, 1);
+  if (root < 0 ||
+    !this->AppendRows(root, "NumberOfPoints", idType, 0, numberOfPoints.data(), local[0],
+      offset[0], total[0]) ||
+    !this->AppendRows(
+      root, "NumberOfCells", idType, 0, numberOfCells.data(), local[0], offset[0], total[0]) ||
+    !this->AppendRows(root, "NumberOfConnectivityIds", idType, 0,
+      numberOfConnectivityIds.data(), local[0], offset[0], total[0]) ||
+    !this->AppendRows(root, "Points", this->GetNativeType(pointsType), 3,
+      ::GetData(pointsArray), local[1], offset[1], total[1]) ||
+    !this->AppendRows(root, "Types", H5T_NATIVE_UCHAR, 0, ::GetData(typesArray), local[2],
+      offset[2], total[2]) ||
+    !this->AppendRows(root, "Offsets", idType, 0, ::GetData(offsetsArray), local[2] + local[0],
+      offset[2] + offset[0], total[2] + total[0]) ||
+    !this->AppendRows(root, "Connectivity", idType, 0, ::GetData(connectivityArray), local[3],
+      offset[3], total[3]) ||
+    !this->WriteAttributeArrays(parts, vtkDataObject::POINT, offset[1], total[1], step) ||
+    !this->WriteAttributeArrays(parts, vtkDataObject::CELL, offset[2], total[2], step))
+  {
+    return false;
+  }
+  this->StepCounts.Parts = total[0];
+  this->StepCounts.Points = total[1];
+  this->StepCounts.Cells[0] = total[2];
+  this->StepCounts.ConnectivityIds[0] = total[3];
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WritePolyData(const std::vector<vtkDataSet*>& parts, int step)
+{
+  std::vector<vtkIdType> numberOfPoints;
+  std::vector<vtkDataArray*> points;
+  std::vector<vtkIdType> numberOfCells[::NUM_POLY_DATA_TOPOS];
+  std::vector<vtkIdType> numberOfConnectivityIds[::NUM_POLY_DATA_TOPOS];
+  std::vector<vtkIdType> numberOfOffsets[::NUM_POLY_DATA_TOPOS];
+  std::vector<vtkDataArray*> offsets[::NUM_POLY_DATA_TOPOS];
+  std::vector<vtkDataArray*> connectivity[::NUM_POLY_DATA_TOPOS];
+  int pointsType = -1;
+  for (vtkDataSet* part : parts)
+  {
+    vtkPolyData* polyData = vtkPolyData::SafeDownCast(part);
+    numberOfPoints.push_back(polyData->GetNumberOfPoints());
+    points.push_back(polyData->GetPoints() ? polyData->GetPoints()->GetData() : nullptr);
+    if (points.back() && pointsType < 0)
+    {
+      pointsType = points.back()->GetDataType();
+    }
+    for (int topology = 0; topology < ::NUM_POLY_DATA_TOPOS; ++topology)
+    {
+      vtkCellArray* cells = ::GetTopology(polyData, topology);
+      const vtkIdType nCells = cells->GetNumberOfCells();
+      numberOfCells[topology].push_back(nCells);
+      numberOfConnectivityIds[topology].push_back(cells->GetNumberOfConnectivityIds());
+      numberOfOffsets[topology].push_back(nCells + 1);
+      offsets[topology].push_back(nCells > 0 ? cells->GetOffsetsArray() : nullptr);
+      connectivity[topology].push_back(nCells > 0 ? cells->GetConnectivityArray() : nullptr);
+    }
+  }
+  pointsType = this->AllReduce(pointsType, vtkCommunicator::MAX_OP);
+  if (pointsType < 0)
+  {
+    pointsType = VTK_FLOAT;
+  }
+
+  // parts, points, then cells and connectivity ids of each topology
+  std::vector<hsize_t> local = { parts.size(),
+    static_cast<hsize_t>(std::accumulate(numberOfPoints.begin(), numberOfPoints.end(), 0LL)) };
+  for (int topology = 0; topology < ::NUM_POLY_DATA_TOPOS; ++topology)
+  {
+    local.push_back(static_cast<hsize_t>(
+      std::accumulate(numberOfCells[topology].begin(), numberOfCells[topology].end(), 0LL)));
+    local.push_back(static_cast<hsize_t>(std::accumulate(numberOfConnectivityIds[topology].begin(),
+      numberOfConnectivityIds[topology].end(), 0LL)));
+  }
+  std::vector<hsize_t> offset;
+  std::vector<hsize_t> total;
+  this->Distribute(local, offset, total);
+
+  hid_t root = this->GetGroup("/VTKHDF");
+  const hid_t idType = this->GetNativeType(VTK_ID_TYPE);
+  auto pointsArray = ::Concatenate(points, numberOfPoints, pointsType, 3);
+  if (root < 0 ||
+    !this->AppendRows(root, "NumberOfPoints", idType, 0, numberOfPoints.data(), local[0],
+      offset[0], total[0]) ||
+    !this->AppendRows(root, "Points", this->GetNativeType(pointsType), 3,
+      ::GetData(pointsArray), local[1], offset[1], total[1]))
+  {
+    return false;
+  }
+  hsize_t cellOffset = 0;
+  hsize_t cellTotal = 0;
+  for (int topology = 0; topology < ::NUM_POLY_DATA_TOPOS; ++topology)
+  {
+    const std::size_t c = 2 + 2 * topology;
+    hid_t group = this->GetGroup(std::string("/VTKHDF/") + ::POLY_DATA_TOPOS[topology]);
+    auto offsetsArray =
+      ::Concatenate(offsets[topology], numberOfOffsets[topology], VTK_ID_TYPE, 1);
+    auto connectivityArray =
+      ::Concatenate(connectivity[topology], numberOfConnectivityIds[topology], VTK_ID_TYPE, 1);
+    if (group < 0 ||
+      !this->AppendRows(group, "NumberOfCells", idType, 0, numberOfCells[topology].data(),
+        local[0], offset[0], total[0]) ||
+      !this->AppendRows(group, "NumberOfConnectivityIds", idType, 0,
+        numberOfConnectivityIds[topology].data(), local[0], offset[0], total[0]) ||
+      !this->AppendRows(group, "Offsets", idType, 0, ::GetData(offsetsArray),
+        local[c] + local[0], offset[c] + offset[0], total[c] + total[0]) ||
+      !this->AppendRows(group, "Connectivity", idType, 0, ::GetData(connectivityArray),
+        local[c + 1], offset[c + 1], total[c + 1]))
+    {
+      return false;
+    }
+    cellOffset += offset[c];
+    cellTotal += total[c];
+    this->StepCounts.Cells[topology] = total[c];
+    this->StepCounts.ConnectivityIds[topology] = total[c + 1];
+  }
+  if (!this->WriteAttributeArrays(parts, vtkDataObject::POINT, offset[1], total[1], step) ||
+    !this->WriteAttributeArrays(parts, vtkDataObject::CELL, cellOffset, cellTotal, step))
+  {
+    return false;
+  }
+  this->StepCounts.Parts = total[0];
+  this->StepCounts.Points = total[1];
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteAttributeArrays(const std::vector<vtkDataSet*>& parts,
+  int attributeType, hsize_t rankOffset, hsize_t globalRows, int step)
+{
+  std::vector<ArrayInfo> infos = this->GetArrayInfos(parts, attributeType);
+  if (infos.empty())
+  {
+    return true;
+  }
+  hid_t group = this->GetGroup(::ARRAY_GROUPS[attributeType]);
+  hid_t offsetGroup = step >= 0 ? this->GetGroup(::ARRAY_OFFSET_GROUPS[attributeType]) : 0;
+  if (group < 0 || offsetGroup < 0)
+  {
+    return false;
+  }
+  std::vector<vtkIdType> sizes;
+  for (vtkDataSet* part : parts)
+  {
+    sizes.push_back(attributeType == vtkDataObject::POINT ? part->GetNumberOfPoints()
+                                                          : part->GetNumberOfCells());
+  }
+  const hsize_t localRows =
+    static_cast<hsize_t>(std::accumulate(sizes.begin(), sizes.end(), vtkIdType(0)));
+  const hid_t idType = this->GetNativeType(VTK_ID_TYPE);
+  for (const ArrayInfo& info : infos)
+  {
+    std::vector<vtkDataArray*> arrays;
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+      vtkDataArray* array = parts[i]->GetAttributes(attributeType)->GetArray(info.Name.c_str());
+      if (!array || array->GetNumberOfComponents() != info.NumberOfComponents)
+      {
+        if (sizes[i] > 0)
+        {
+          vtkWarningWithObjectMacro(
+            this->Writer, "Array " << info.Name << " is missing from a piece, using zeros.");
+        }
+        array = nullptr;
+      }
+      arrays.push_back(array);
+    }
+    if (step >= 0)
+    {
+      // offset of the values of this time step in the dataset
+      const vtkIdType arrayOffset =
+        static_cast<vtkIdType>(this->GetNumberOfRows(group, info.Name.c_str()));
+      if (!this->AppendRows(offsetGroup, info.Name.c_str(), idType, 0, &arrayOffset,
+            this->IsFirstProcess() ? 1 : 0, 0, 1))
+      {
+        return false;
+      }
+    }
+    auto array = ::Concatenate(arrays, sizes, info.DataType, info.NumberOfComponents);
+    if (!this->AppendRows(group, info.Name.c_str(), this->GetNativeType(info.DataType),
+          info.NumberOfComponents > 1 ? info.NumberOfComponents : 0, ::GetData(array), localRows,
+          rankOffset, globalRows))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteFieldData(vtkFieldData* fieldData, int step)
+{
+  // only the field data of the first process is written
+  vtkSmartPointer<vtkFieldData> data = fieldData;
+  if (this->Collective)
+  {
+    vtkNew<vtkPolyData> holder;
+    if (this->IsFirstProcess() && fieldData)
+    {
+      holder->GetFieldData()->ShallowCopy(fieldData);
+    }
+    this->Writer->Controller->Broadcast(holder, 0);
+    data = holder->GetFieldData();
+  }
+  if (!data || data->GetNumberOfArrays() == 0)
+  {
+    return true;
+  }
+  hid_t group = this->GetGroup(::ARRAY_GROUPS[vtkDataObject::FIELD]);
+  hid_t offsetGroup = step >= 0 ? this->GetGroup(::ARRAY_OFFSET_GROUPS[vtkDataObject::FIELD]) : 0;
+  if (group < 0 || offsetGroup < 0)
+  {
+    return false;
+  }
+  const hsize_t firstProcess = this->IsFirstProcess() ? 1 : 0;
+  const hid_t idType = this->GetNativeType(VTK_ID_TYPE);
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* abstractArray = data->GetAbstractArray(i);
+    if (!abstractArray || !abstractArray->GetName())
+    {
+      continue;
+    }
+    const char* name = abstractArray->GetName();
+    if (vtkStringArray* strings = vtkStringArray::SafeDownCast(abstractArray))
+    {
+      if (step >= 0)
+      {
+        if (step == 0)
+        {
+          vtkWarningWithObjectMacro(
+            this->Writer, "String field array " << name << " is not written with time steps.");
+        }
+        continue;
+      }
+      std::vector<std::string> values(strings->GetNumberOfValues());
+      for (vtkIdType j = 0; j < strings->GetNumberOfValues(); ++j)
+      {
+        values[j] = strings->GetValue(j);
+      }
+      if (!this->WriteStrings(group, name, values))
+      {
+        return false;
+      }
+      continue;
+    }
+    vtkDataArray* array = vtkDataArray::SafeDownCast(abstractArray);
+    if (!array || this->GetNativeType(array->GetDataType()) < 0)
+    {
+      vtkWarningWithObjectMacro(this->Writer, "Cannot write field array " << name << ".");
+      continue;
+    }
+    const hid_t type = this->GetNativeType(array->GetDataType());
+    const vtkIdType numberOfTuples = array->GetNumberOfTuples();
+    const int numberOfComponents = array->GetNumberOfComponents();
+    auto contiguous =
+      ::Concatenate({ array }, { numberOfTuples }, array->GetDataType(), numberOfComponents);
+    if (step < 0)
+    {
+      const hsize_t rows = static_cast<hsize_t>(numberOfTuples);
+      if (!this->AppendRows(group, name, type, numberOfComponents > 1 ? numberOfComponents : 0,
+            ::GetData(contiguous), rows * firstProcess, 0, rows))
+      {
+        return false;
+      }
+      continue;
+    }
+    // one row of all the values per time step
+    const hsize_t width = static_cast<hsize_t>(numberOfTuples * numberOfComponents);
+    if (width == 0)
+    {
+      continue;
+    }
+    const vtkIdType arrayOffset = static_cast<vtkIdType>(this->GetNumberOfRows(group, name));
+    if (!this->AppendRows(offsetGroup, name, idType, 0, &arrayOffset, firstProcess, 0, 1) ||
+      !this->AppendRows(group, name, type, width, ::GetData(contiguous), firstProcess, 0, 1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteSteps(int step, double time)
+{
+  hid_t steps = this->GetGroup("/VTKHDF/Steps");
+  const int numberOfSteps = step + 1;
+  const hsize_t rows = this->IsFirstProcess() ? 1 : 0;
+  if (steps < 0 || !this->WriteAttribute(steps, "NSteps", H5T_NATIVE_INT, 1, &numberOfSteps) ||
+    !this->AppendRows(steps, "Values", H5T_NATIVE_DOUBLE, 0, &time, rows, 0, 1))
+  {
+    return false;
+  }
+  if (this->DataSetType == VTK_IMAGE_DATA)
+  {
+    // image arrays are indexed by the time step
+    return true;
+  }
+
+  const hid_t idType = this->GetNativeType(VTK_ID_TYPE);
+  const vtkIdType partOffset = static_cast<vtkIdType>(this->PreviousCounts.Parts);
+  const vtkIdType numberOfParts = static_cast<vtkIdType>(this->StepCounts.Parts);
+  const vtkIdType pointOffset = static_cast<vtkIdType>(this->PreviousCounts.Points);
+  vtkIdType cellOffsets[::NUM_POLY_DATA_TOPOS];
+  vtkIdType connectivityIdOffsets[::NUM_POLY_DATA_TOPOS];
+  for (int i = 0; i < ::NUM_POLY_DATA_TOPOS; ++i)
+  {
+    cellOffsets[i] = static_cast<vtkIdType>(this->PreviousCounts.Cells[i]);
+    connectivityIdOffsets[i] = static_cast<vtkIdType>(this->PreviousCounts.ConnectivityIds[i]);
+  }
+  // one offset per topology for poly data
+  const hsize_t numberOfTopologies = this->DataSetType == VTK_POLY_DATA ? ::NUM_POLY_DATA_TOPOS : 0;
+  return this->AppendRows(steps, "PartOffsets", idType, 0, &partOffset, rows, 0, 1) &&
+    this->AppendRows(steps, "NumberOfParts", idType, 0, &numberOfParts, rows, 0, 1) &&
+    this->AppendRows(steps, "PointOffsets", idType, 0, &pointOffset, rows, 0, 1) &&
+    this->AppendRows(steps, "CellOffsets", idType, numberOfTopologies, cellOffsets, rows, 0, 1) &&
+    this->AppendRows(
+      steps, "ConnectivityIdOffsets", idType, numberOfTopologies, connectivityIdOffsets, rows, 0, 1);
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkHDFWriter::Implementation::ArrayInfo> vtkHDFWriter::Implementation::GetArrayInfos(
+  const std::vector<vtkDataSet*>& parts, int attributeType)
+{
+  std::vector<ArrayInfo> infos;
+  if (!parts.empty())
+  {
+    vtkDataSetAttributes* attributes = parts[0]->GetAttributes(attributeType);
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = attributes->GetArray(i);
+      if (!array || !array->GetName() || this->GetNativeType(array->GetDataType()) < 0)
+      {
+        continue;
+      }
+      infos.push_back({ array->GetName(), array->GetDataType(), array->GetNumberOfComponents() });
+    }
+  }
+  if (!this->Collective)
+  {
+    return infos;
+  }
+
+  // use the arrays of the first process
+  vtkMultiProcessController* controller = this->Writer->Controller;
+  std::vector<int> values;
+  std::string names;
+  for (const ArrayInfo& info : infos)
+  {
+    values.push_back(info.DataType);
+    values.push_back(info.NumberOfComponents);
+    values.push_back(static_cast<int>(info.Name.size()));
+    names += info.Name;
+  }
+  int sizes[2] = { static_cast<int>(values.size()), static_cast<int>(names.size()) };
+  controller->Broadcast(sizes, 2, 0);
+  values.resize(sizes[0]);
+  names.resize(sizes[1]);
+  if (sizes[0] > 0)
+  {
+    controller->Broadcast(values.data(), sizes[0], 0);
+  }
+  if (sizes[1] > 0)
+  {
+    controller->Broadcast(&names[0], sizes[1], 0);
+  }
+  infos.clear();
+  std::string::size_type position = 0;
+  for (std::size_t i = 0; i + 2 < values.size(); i += 3)
+  {
+    infos.push_back({ names.substr(position, values[i + 2]), values[i], values[i + 1] });
+    position += values[i + 2];
+  }
+  return infos;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::Implementation::Distribute(
+  const std::vector<hsize_t>& local, std::vector<hsize_t>& offsets, std::vector<hsize_t>& totals)
+{
+  offsets.assign(local.size(), 0);
+  totals = local;
+  if (!this->Collective)
+  {
+    return;
+  }
+  vtkMultiProcessController* controller = this->Writer->Controller;
+  const int numberOfProcesses = controller->GetNumberOfProcesses();
+  const int rank = controller->GetLocalProcessId();
+  const std::size_t size = local.size();
+  std::vector<long long> send(local.begin(), local.end());
+  std::vector<long long> received(size * numberOfProcesses);
+  controller->AllGather(send.data(), received.data(), static_cast<vtkIdType>(size));
+  totals.assign(size, 0);
+  for (int process = 0; process < numberOfProcesses; ++process)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      const hsize_t value = static_cast<hsize_t>(received[process * size + i]);
+      if (process < rank)
+      {
+        offsets[i] += value;
+      }
+      totals[i] += value;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::IsFirstProcess() const
+{
+  return !this->Collective || this->Writer->Controller->GetLocalProcessId() == 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::Implementation::AllReduce(int value, int operation)
+{
+  if (!this->Collective)
+  {
+    return value;
+  }
+  int result = value;
+  this->Writer->Controller->AllReduce(&value, &result, 1, operation);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::GetGroup(const std::string& path)
+{
+  auto it = this->Groups.find(path);
+  if (it != this->Groups.end())
+  {
+    return it->second;
+  }
+  hid_t parent = this->File;
+  const std::string::size_type separator = path.find_last_of('/');
+  if (separator != std::string::npos && separator > 0)
+  {
+    parent = this->GetGroup(path.substr(0, separator));
+  }
+  if (parent < 0)
+  {
+    return -1;
+  }
+  const std::string name = path.substr(separator + 1);
+  hid_t group = H5Lexists(parent, name.c_str(), H5P_DEFAULT) > 0
+    ? H5Gopen(parent, name.c_str(), H5P_DEFAULT)
+    : H5Gcreate(parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (group < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create group " << path);
+    return -1;
+  }
+  this->Groups[path] = group;
+  return group;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteAttribute(
+  hid_t object, const char* name, hid_t type, hsize_t size, const void* values)
+{
+  if (H5Aexists(object, name) > 0)
+  {
+    H5Adelete(object, name);
+  }
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+  vtkHDF::ScopedH5AHandle attribute = H5Acreate(object, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+  if (attribute < 0 || H5Awrite(attribute, type, values) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write attribute " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteStringAttribute(
+  hid_t object, const char* name, const std::string& value)
+{
+  if (H5Aexists(object, name) > 0)
+  {
+    H5Adelete(object, name);
+  }
+  // Fixed length string without terminating null character, as expected by
+  // vtkHDFReader.
+  vtkHDF::ScopedH5THandle type = H5Tcopy(H5T_C_S1);
+  H5Tset_size(type, value.size());
+  H5Tset_strpad(type, H5T_STR_NULLPAD);
+  H5Tset_cset(type, H5T_CSET_ASCII);
+  vtkHDF::ScopedH5SHandle space = H5Screate(H5S_SCALAR);
+  vtkHDF::ScopedH5AHandle attribute = H5Acreate(object, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+  if (attribute < 0 || H5Awrite(attribute, type, value.c_str()) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write attribute " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::CreateChunkedProperties(const std::vector<hsize_t>& dims)
+{
+  // Chunks span the fastest varying dimensions, up to about ChunkSize values.
+  std::vector<hsize_t> chunk(dims.size(), 1);
+  hsize_t size = 1;
+  const hsize_t chunkSize = static_cast<hsize_t>(this->Writer->ChunkSize);
+  for (std::size_t i = dims.size(); i-- > 0;)
+  {
+    const hsize_t dim = std::max<hsize_t>(dims[i], 1);
+    if (size * dim <= chunkSize || i == dims.size() - 1)
+    {
+      chunk[i] = dim;
+      size *= dim;
+    }
+    else
+    {
+      chunk[i] = std::max<hsize_t>(chunkSize / size, 1);
+      break;
+    }
+  }
+
+  hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(properties, static_cast<int>(chunk.size()), chunk.data());
+  int level = this->Writer->CompressionLevel;
+#if defined(H5_HAVE_PARALLEL) && !defined(H5_HAVE_PARALLEL_FILTERED_WRITES)
+  if (this->Collective)
+  {
+    level = 0; // filters are not supported with parallel writes
+  }
+#endif
+  if (level > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    H5Pset_shuffle(properties);
+    H5Pset_deflate(properties, static_cast<unsigned int>(level));
+  }
+  return properties;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::AppendRows(hid_t group, const char* name, hid_t type,
+  hsize_t numberOfComponents, const void* data, hsize_t localRows, hsize_t rankOffset,
+  hsize_t globalRows)
+{
+  const int rank = numberOfComponents > 0 ? 2 : 1;
+  hsize_t dims[2] = { 0, numberOfComponents };
+  vtkHDF::ScopedH5DHandle dataset = H5Lexists(group, name, H5P_DEFAULT) > 0
+    ? H5Dopen(group, name, H5P_DEFAULT)
+    : [&]() {
+        const hsize_t maxDims[2] = { H5S_UNLIMITED, numberOfComponents };
+        vtkHDF::ScopedH5SHandle space = H5Screate_simple(rank, dims, maxDims);
+        // chunks of about ChunkSize values
+        std::vector<hsize_t> chunkDims(rank, numberOfComponents);
+        chunkDims[0] = static_cast<hsize_t>(this->Writer->ChunkSize);
+        if (rank == 2)
+        {
+          chunkDims[0] = std::max<hsize_t>(chunkDims[0] / numberOfComponents, 1);
+        }
+        vtkHDF::ScopedH5PHandle properties = this->CreateChunkedProperties(chunkDims);
+        return H5Dcreate(group, name, type, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+      }();
+  if (dataset < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create dataset " << name);
+    return false;
+  }
+
+  {
+    vtkHDF::ScopedH5SHandle space = H5Dget_space(dataset);
+    H5Sget_simple_extent_dims(space, dims, nullptr);
+  }
+  const hsize_t start[2] = { dims[0] + rankOffset, 0 };
+  dims[0] += globalRows;
+  if (H5Dset_extent(dataset, dims) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot extend dataset " << name);
+    return false;
+  }
+  if (localRows == 0 && !this->Collective)
+  {
+    return true;
+  }
+
+  vtkHDF::ScopedH5SHandle fileSpace = H5Dget_space(dataset);
+  const hsize_t count[2] = { localRows, numberOfComponents };
+  vtkHDF::ScopedH5SHandle memorySpace = H5Screate_simple(rank, count, nullptr);
+  if (localRows > 0)
+  {
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+  }
+  else
+  {
+    H5Sselect_none(fileSpace);
+    H5Sselect_none(memorySpace);
+  }
+  const char dummy = 0;
+  if (H5Dwrite(dataset, type, memorySpace, fileSpace, this->TransferProperties,
+        data ? data : &dummy) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write dataset " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteBlock(hid_t group, const char* name, hid_t type,
+  const std::vector<hsize_t>& dims, hsize_t numberOfComponents, int step,
+  const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const void* data)
+{
+  // full dimensions of the dataset: [step,] dims... [, components]
+  std::vector<hsize_t> fileDims;
+  std::vector<hsize_t> maxDims;
+  std::vector<hsize_t> fileStart;
+  std::vector<hsize_t> fileCount;
+  if (step >= 0)
+  {
+    fileDims.push_back(static_cast<hsize_t>(step) + 1);
+    maxDims.push_back(H5S_UNLIMITED);
+    fileStart.push_back(static_cast<hsize_t>(step));
+    fileCount.push_back(1);
+  }
+  fileDims.insert(fileDims.end(), dims.begin(), dims.end());
+  maxDims.insert(maxDims.end(), dims.begin(), dims.end());
+  fileStart.insert(fileStart.end(), start.begin(), start.end());
+  fileCount.insert(fileCount.end(), count.begin(), count.end());
+  if (numberOfComponents > 0)
+  {
+    fileDims.push_back(numberOfComponents);
+    maxDims.push_back(numberOfComponents);
+    fileStart.push_back(0);
+    fileCount.push_back(numberOfComponents);
+  }
+  const int rank = static_cast<int>(fileDims.size());
+
+  vtkHDF::ScopedH5DHandle dataset = H5Lexists(group, name, H5P_DEFAULT) > 0
+    ? H5Dopen(group, name, H5P_DEFAULT)
+    : [&]() {
+        std::vector<hsize_t> chunkDims(fileDims);
+        if (step >= 0)
+        {
+          chunkDims[0] = 1;
+        }
+        vtkHDF::ScopedH5SHandle space = H5Screate_simple(rank, fileDims.data(), maxDims.data());
+        vtkHDF::ScopedH5PHandle properties = this->CreateChunkedProperties(chunkDims);
+        return H5Dcreate(group, name, type, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+      }();
+  if (dataset < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create dataset " << name);
+    return false;
+  }
+  if (step >= 0)
+  {
+    std::vector<hsize_t> currentDims(rank);
+    {
+      vtkHDF::ScopedH5SHandle space = H5Dget_space(dataset);
+      H5Sget_simple_extent_dims(space, currentDims.data(), nullptr);
+    }
+    if (currentDims[0] < fileDims[0] && H5Dset_extent(dataset, fileDims.data()) < 0)
+    {
+      vtkErrorWithObjectMacro(this->Writer, "Cannot extend dataset " << name);
+      return false;
+    }
+  }
+  if (!data && !this->Collective)
+  {
+    return true;
+  }
+
+  vtkHDF::ScopedH5SHandle fileSpace = H5Dget_space(dataset);
+  vtkHDF::ScopedH5SHandle memorySpace = H5Screate_simple(rank, fileCount.data(), nullptr);
+  if (data)
+  {
+    H5Sselect_hyperslab(
+      fileSpace, H5S_SELECT_SET, fileStart.data(), nullptr, fileCount.data(), nullptr);
+  }
+  else
+  {
+    H5Sselect_none(fileSpace);
+    H5Sselect_none(memorySpace);
+  }
+  const char dummy = 0;
+  if (H5Dwrite(dataset, type, memorySpace, fileSpace, this->TransferProperties,
+        data ? data : &dummy) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write dataset " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteStrings(
+  hid_t group, const char* name, const std::vector<std::string>& values)
+{
+  std::vector<const char*> pointers(values.size());
+  std::transform(values.begin(), values.end(), pointers.begin(),
+    [](const std::string& value) { return value.c_str(); });
+  vtkHDF::ScopedH5THandle type = H5Tcopy(H5T_C_S1);
+  H5Tset_size(type, H5T_VARIABLE);
+  const hsize_t size = values.size();
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+  vtkHDF::ScopedH5DHandle dataset =
+    H5Dcreate(group, name, type, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  const char* dummy = "";
+  if (dataset < 0 ||
+    H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, this->TransferProperties,
+      pointers.empty() ? &dummy : pointers.data()) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write dataset " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+hsize_t vtkHDFWriter::Implementation::GetNumberOfRows(hid_t group, const char* name)
+{
+  if (H5Lexists(group, name, H5P_DEFAULT) <= 0)
+  {
+    return 0;
+  }
+  vtkHDF::ScopedH5DHandle dataset = H5Dopen(group, name, H5P_DEFAULT);
+  vtkHDF::ScopedH5SHandle space = H5Dget_space(dataset);
+  const int rank = H5Sget_simple_extent_ndims(space);
+  if (rank <= 0)
+  {
+    return 0;
+  }
+  std::vector<hsize_t> dims(rank);
+  H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+  return dims[0];
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::GetNativeType(int vtkType)
+{
+  return ::GetNativeType(vtkType);
+}
+VTK_ABI_NAMESPACE_END
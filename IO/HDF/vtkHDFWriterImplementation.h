@@ -0,0 +1,234 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriterImplementation.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFWriterImplementation
+ * @brief   Implementation class for vtkHDFWriter
+ *
+ */
+
+#ifndef vtkHDFWriterImplementation_h
+#define vtkHDFWriterImplementation_h
+
+#include "vtkHDFWriter.h"
+#include "vtk_hdf5.h"
+#include <map>
+#include <string>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataSet;
+class vtkFieldData;
+
+/**
+ * Implementation for the vtkHDFWriter. Creates, closes and writes
+ * datasets and attributes in a VTK HDF file. In collective mode, every
+ * process must call the methods modifying the file in the same order and
+ * with the same arguments, except for the data written by each process.
+ */
+class vtkHDFWriter::Implementation
+{
+public:
+  Implementation(vtkHDFWriter* writer);
+  virtual ~Implementation();
+
+  ///@{
+  /**
+   * Creates (truncates) the file. Returns true for success.
+   * The collective version opens the file with the MPI-IO driver on the
+   * given communicator.
+   */
+  bool Create(VTK_FILEPATH const char* fileName);
+#ifdef H5_HAVE_PARALLEL
+  bool CreateCollective(VTK_FILEPATH const char* fileName, MPI_Comm comm);
+#endif
+  ///@}
+
+  /**
+   * Closes the file and releases all the handles.
+   */
+  void Close();
+
+  /**
+   * Returns true if the file is open.
+   */
+  bool IsOpen() const { return this->File >= 0; }
+
+  /**
+   * Returns true if the file is written with collective MPI-IO.
+   */
+  bool IsCollective() const { return this->Collective; }
+
+  /**
+   * Writes the datasets of this process as pieces of a single dataset of
+   * the file, with the field data of the first process. When 'step' is not
+   * negative, the data is appended as that time step, at time 'time'.
+   * The datasets must all be images, all be poly data or all be
+   * unstructured grids.
+   */
+  bool WriteDataSets(
+    const std::vector<vtkDataSet*>& parts, vtkFieldData* fieldData, int step, double time);
+
+  /**
+   * Returns the group with the given absolute path, creating it and its
+   * parents if needed. The handle is owned by this object. Returns a negative
+   * value on error.
+   */
+  hid_t GetGroup(const std::string& path);
+
+  ///@{
+  /**
+   * Writes (or overwrites) an attribute of 'size' values of the given
+   * native type, or a string attribute.
+   */
+  bool WriteAttribute(hid_t object, const char* name, hid_t type, hsize_t size, const void* values);
+  bool WriteStringAttribute(hid_t object, const char* name, const std::string& value);
+  ///@}
+
+  /**
+   * Appends 'globalRows' rows to the dataset 'name' of 'group', creating the
+   * dataset if it does not exist. The dataset is one dimensional when
+   * 'numberOfComponents' is 0, and has 'numberOfComponents' columns
+   * otherwise. This process writes its 'localRows' rows at 'rankOffset' rows
+   * past the previous end of the dataset.
+   */
+  bool AppendRows(hid_t group, const char* name, hid_t type, hsize_t numberOfComponents,
+    const void* data, hsize_t localRows, hsize_t rankOffset, hsize_t globalRows);
+
+  /**
+   * Writes a block of a structured dataset of dimensions 'dims' (slowest
+   * varying first), with 'numberOfComponents' values per tuple if not 0.
+   * When 'step' is not negative, the dataset has an additional unlimited
+   * first dimension for the time steps and the block is written for 'step'.
+   * 'start' and 'count' locate the block in 'dims'. A null 'data' pointer
+   * writes nothing, which lets processes without data take part in
+   * collective writes.
+   */
+  bool WriteBlock(hid_t group, const char* name, hid_t type, const std::vector<hsize_t>& dims,
+    hsize_t numberOfComponents, int step, const std::vector<hsize_t>& start,
+    const std::vector<hsize_t>& count, const void* data);
+
+  /**
+   * Writes a one dimensional dataset of variable length strings.
+   */
+  bool WriteStrings(hid_t group, const char* name, const std::vector<std::string>& values);
+
+  /**
+   * Returns the number of rows of the dataset 'name' of 'group', or 0 if it
+   * does not exist.
+   */
+  hsize_t GetNumberOfRows(hid_t group, const char* name);
+
+  /**
+   * Returns the native HDF5 type for a VTK data type, or a negative value
+   * if the type cannot be written.
+   */
+  static hid_t GetNativeType(int vtkType);
+
+protected:
+  /**
+   * Name, type and number of components of an array to write.
+   */
+  struct ArrayInfo
+  {
+    std::string Name;
+    int DataType;
+    int NumberOfComponents;
+  };
+
+  /**
+   * Number of pieces, points, cells and connectivity ids (per topology for
+   * poly data) written for a time step.
+   */
+  struct Counts
+  {
+    hsize_t Parts = 0;
+    hsize_t Points = 0;
+    hsize_t Cells[4] = { 0, 0, 0, 0 };
+    hsize_t ConnectivityIds[4] = { 0, 0, 0, 0 };
+  };
+
+  ///@{
+  /**
+   * Write the geometry and the point and cell data of the pieces.
+   */
+  bool WriteImageData(const std::vector<vtkDataSet*>& parts, int step);
+  bool WriteUnstructuredGrid(const std::vector<vtkDataSet*>& parts, int step);
+  bool WritePolyData(const std::vector<vtkDataSet*>& parts, int step);
+  ///@}
+
+  /**
+   * Appends the point or cell arrays of the pieces, 'rankOffset' and
+   * 'globalRows' being the same as for AppendRows. When 'step' is not
+   * negative, adds the offset of each array in the 'Steps' group.
+   */
+  bool WriteAttributeArrays(const std::vector<vtkDataSet*>& parts, int attributeType,
+    hsize_t rankOffset, hsize_t globalRows, int step);
+
+  /**
+   * Writes the field data, as static arrays or as one row per time step.
+   */
+  bool WriteFieldData(vtkFieldData* fieldData, int step);
+
+  /**
+   * Appends the time value and the geometry offsets of the time step to the
+   * 'Steps' group.
+   */
+  bool WriteSteps(int step, double time);
+
+  /**
+   * Returns the arrays of the first piece that are written. In collective
+   * mode, the arrays of the first piece of the first process are used.
+   */
+  std::vector<ArrayInfo> GetArrayInfos(const std::vector<vtkDataSet*>& parts, int attributeType);
+
+  /**
+   * Computes, for each of the 'local' counts, the offset of this process and
+   * the total over all the processes.
+   */
+  void Distribute(
+    const std::vector<hsize_t>& local, std::vector<hsize_t>& offsets, std::vector<hsize_t>& totals);
+
+  /**
+   * Returns true if this process writes the data shared by all the processes:
+   * the first process in collective mode, always otherwise.
+   */
+  bool IsFirstProcess() const;
+
+  /**
+   * Returns the result of the reduction of 'value' over all the processes
+   * (the value itself when not collective).
+   */
+  int AllReduce(int value, int operation);
+
+  /**
+   * Creates the dataset creation property list for a chunked dataset with
+   * dimensions 'dims', honoring the chunk size and compression level.
+   */
+  hid_t CreateChunkedProperties(const std::vector<hsize_t>& dims);
+
+private:
+  vtkHDFWriter* Writer;
+  hid_t File = -1;
+  hid_t TransferProperties = H5P_DEFAULT;
+  bool Collective = false;
+  std::map<std::string, hid_t> Groups;
+  int DataSetType = -1;
+  Counts StepCounts;
+  Counts PreviousCounts;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkHDFWriterImplementation.h
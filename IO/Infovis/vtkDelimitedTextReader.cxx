@@ -70,7 +70,8 @@ public:
   DelimitedTextIterator(const vtkIdType max_records, const std::string& record_delimiters,
     const std::string& field_delimiters, const std::string& string_delimiters,
     const std::string& whitespace, const std::string& escape, bool have_headers,
-    bool merg_cons_delimiters, bool use_string_delimeter, vtkTable* const output_table)
+    bool merg_cons_delimiters, bool use_string_delimeter, bool compact_string_storage,
+    vtkTable* const output_table)
     : MaxRecords(max_records)
     , MaxRecordIndex(have_headers ? max_records + 1 : max_records)
     , RecordDelimiters(record_delimiters.begin(), record_delimiters.end())
@@ -87,6 +88,7 @@ public:
     , MergeConsDelims(merg_cons_delimiters)
     , ProcessEscapeSequence(false)
     , UseStringDelimiter(use_string_delimeter)
+    , CompactStringStorage(compact_string_storage)
     , WithinString(0)
   {
   }
@@ -253,7 +255,8 @@ private:
     if (this->CurrentFieldIndex >= this->OutputTable->GetNumberOfColumns() &&
       0 == this->CurrentRecordIndex)
     {
-      vtkAbstractArray* array = vtkStringArray::New();
+      vtkStringArray* array = vtkStringArray::New();
+      array->SetCompactStorage(this->CompactStringStorage);
 
       if (this->HaveHeaders)
       {
@@ -264,8 +267,7 @@ private:
         std::stringstream buffer;
         buffer << "Field " << this->CurrentFieldIndex;
         array->SetName(buffer.str().c_str());
-        vtkArrayDownCast<vtkStringArray>(array)->InsertValue(
-          this->CurrentRecordIndex, this->CurrentField);
+        array->InsertValue(this->CurrentRecordIndex, this->CurrentField);
       }
       this->OutputTable->AddColumn(array);
       array->Delete();
@@ -302,6 +304,7 @@ private:
   bool MergeConsDelims;
   bool ProcessEscapeSequence;
   bool UseStringDelimiter;
+  bool CompactStringStorage;
   vtkTypeUInt32 WithinString;
 };
 
@@ -336,6 +339,8 @@ vtkDelimitedTextReader::vtkDelimitedTextReader()
   this->GeneratePedigreeIds = true;
   this->OutputPedigreeIds = false;
   this->AddTabFieldDelimiter = false;
+  this->CompactStringStorage = false;
+  this->DictionaryEncodingThreshold = 0.0;
   this->FieldDelimiterCharacters = nullptr;
   this->SetFieldDelimiterCharacters(",");
   this->StringDelimiter = '"';
@@ -396,6 +401,9 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputPedigreeIds: " << (this->OutputPedigreeIds ? "true" : "false") << endl;
   os << indent << "AddTabFieldDelimiter: " << (this->AddTabFieldDelimiter ? "true" : "false")
      << endl;
+  os << indent << "CompactStringStorage: " << (this->CompactStringStorage ? "true" : "false")
+     << endl;
+  os << indent << "DictionaryEncodingThreshold: " << this->DictionaryEncodingThreshold << endl;
 }
 
 void vtkDelimitedTextReader::SetInputString(const char* in)
@@ -592,7 +600,7 @@ int vtkDelimitedTextReader::ReadData(vtkTable* output_table)
     DelimitedTextIterator iterator(this->MaxRecords, this->UnicodeRecordDelimiters,
       this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
       this->UnicodeEscapeCharacter, this->HaveHeaders, this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter, output_table);
+      this->UseStringDelimiter, this->CompactStringStorage, output_table);
 
     transCodec->ToUnicode(*input_stream_pt, iterator);
     iterator.ReachedEndOfInput();
@@ -643,6 +651,18 @@ int vtkDelimitedTextReader::ReadData(vtkTable* output_table)
       output_table->ShallowCopy(converter->GetOutputDataObject(0));
       converter->Delete();
     }
+
+    if (this->DictionaryEncodingThreshold > 0.0)
+    {
+      for (vtkIdType i = 0; i < output_table->GetNumberOfColumns(); ++i)
+      {
+        vtkStringArray* column = vtkArrayDownCast<vtkStringArray>(output_table->GetColumn(i));
+        if (column)
+        {
+          column->TryDictionaryEncoding(this->DictionaryEncodingThreshold);
+        }
+      }
+    }
   }
   catch (std::exception& e)
   {
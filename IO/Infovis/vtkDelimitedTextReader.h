@@ -306,6 +306,31 @@ public:
   vtkBooleanMacro(AddTabFieldDelimiter, bool);
   ///@}
 
+  ///@{
+  /**
+   * If on, the string columns of the output table use the compact storage
+   * of vtkStringArray, i.e. all the fields of a column are stored in a
+   * single array of characters, which takes much less memory and time than
+   * one string per field for large files. See
+   * vtkStringArray::SetCompactStorage(). Defaults to off.
+   */
+  vtkSetMacro(CompactStringStorage, bool);
+  vtkGetMacro(CompactStringStorage, bool);
+  vtkBooleanMacro(CompactStringStorage, bool);
+  ///@}
+
+  ///@{
+  /**
+   * If positive, the string columns of the output table whose number of
+   * distinct values is at most this fraction of their number of values are
+   * dictionary encoded, i.e. each distinct value is stored once, e.g. for
+   * columns of labels or categories. See
+   * vtkStringArray::TryDictionaryEncoding(). Defaults to 0, i.e. off.
+   */
+  vtkSetClampMacro(DictionaryEncodingThreshold, double, 0.0, 1.0);
+  vtkGetMacro(DictionaryEncodingThreshold, double);
+  ///@}
+
   /**
    * Returns a human-readable description of the most recent error, if any.
    * Otherwise, returns an empty string.  Note that the result is only valid
@@ -357,6 +382,8 @@ protected:
   bool GeneratePedigreeIds;
   bool OutputPedigreeIds;
   bool AddTabFieldDelimiter;
+  bool CompactStringStorage;
+  double DictionaryEncodingThreshold;
   vtkStdString LastError;
   vtkTypeUInt32 ReplacementCharacter;
 
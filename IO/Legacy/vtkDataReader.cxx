@@ -46,6 +46,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -56,6 +57,7 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
+#include "vtkValueFromString.h"
 #include "vtkVariantArray.h"
 
 #include "vtksys/FStream.hxx"
@@ -1522,10 +1524,212 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+inline bool vtkIsASCIISpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+//------------------------------------------------------------------------------
+// Parse a whole token. Characters are read as integers, like vtkDataReader::Read.
+template <class T>
+bool vtkParseASCIIValue(const char* begin, const char* end, T& value)
+{
+  return vtkValueFromString(begin, end, value) == static_cast<std::size_t>(end - begin);
+}
+
+bool vtkParseASCIIValue(const char* begin, const char* end, char& value)
+{
+  int intValue;
+  if (vtkValueFromString(begin, end, intValue) != static_cast<std::size_t>(end - begin))
+  {
+    return false;
+  }
+  value = static_cast<char>(intValue);
+  return true;
+}
+
+bool vtkParseASCIIValue(const char* begin, const char* end, unsigned char& value)
+{
+  int intValue;
+  if (vtkValueFromString(begin, end, intValue) != static_cast<std::size_t>(end - begin))
+  {
+    return false;
+  }
+  value = static_cast<unsigned char>(intValue);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Read numValues whitespace separated values from the stream. The text is
+// read by blocks, and each block is split in chunks at whitespace that are
+// parsed concurrently: the values of each chunk are counted first, so that
+// they can then be parsed directly at their place in data. The stream is
+// left right after the last value, like when the values are read one by one.
+// Returns false, with the stream back to where it was, if the stream cannot
+// be repositioned or if a value cannot be parsed this way (such as a leading
+// '+'), in which case the values must be read through the stream.
+template <class T>
+bool vtkReadASCIIDataBlocks(istream* is, T* data, vtkIdType numValues)
+{
+  if (numValues <= 0)
+  {
+    return true;
+  }
+  const std::streampos start = is->tellg();
+  if (start == std::streampos(-1))
+  {
+    return false;
+  }
+
+  // Do not read much more than the data, since what follows is read again
+  // from the stream.
+  const size_t blockSize = static_cast<size_t>(
+    std::min<vtkIdType>(std::max<vtkIdType>(16 * numValues, 4096), 1 << 24));
+  const size_t chunkSize = 1 << 16;
+
+  std::vector<char> buffer;
+  std::streamoff bufferStart = 0; // stream offset of buffer[0], relative to start
+  std::streamoff stop = -1;       // stream offset after the last value
+  vtkIdType count = 0;
+  bool valid = true;
+  while (valid && count < numValues)
+  {
+    // Append a new block to what remains of the previous one.
+    size_t previousSize = buffer.size();
+    buffer.resize(previousSize + blockSize);
+    is->read(buffer.data() + previousSize, blockSize);
+    size_t numRead = static_cast<size_t>(is->gcount());
+    buffer.resize(previousSize + numRead);
+    bool last = numRead < blockSize;
+
+    // Keep the last token for the next block, as it may be incomplete.
+    size_t end = buffer.size();
+    if (!last)
+    {
+      while (end > 0 && !vtkIsASCIISpace(buffer[end - 1]))
+      {
+        --end;
+      }
+    }
+
+    // Split at whitespace in chunks.
+    std::vector<size_t> bounds(1, 0);
+    while (bounds.back() < end)
+    {
+      size_t bound = std::min(bounds.back() + chunkSize, end);
+      while (bound < end && !vtkIsASCIISpace(buffer[bound]))
+      {
+        ++bound;
+      }
+      bounds.push_back(bound);
+    }
+    vtkIdType numChunks = static_cast<vtkIdType>(bounds.size()) - 1;
+
+    // Count the values of each chunk.
+    const char* text = buffer.data();
+    std::vector<vtkIdType> offsets(numChunks + 1, 0);
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType endChunk) {
+      for (vtkIdType chunk = begin; chunk < endChunk; ++chunk)
+      {
+        vtkIdType numTokens = 0;
+        bool inToken = false;
+        for (size_t i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+        {
+          bool space = vtkIsASCIISpace(text[i]);
+          numTokens += (!space && !inToken) ? 1 : 0;
+          inToken = !space;
+        }
+        offsets[chunk + 1] = numTokens;
+      }
+    });
+    for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+    {
+      offsets[chunk + 1] += offsets[chunk];
+    }
+
+    // Parse the values of each chunk, up to the last expected value.
+    std::vector<unsigned char> chunkValid(numChunks, 1);
+    std::vector<size_t> chunkStop(numChunks, 0);
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType endChunk) {
+      for (vtkIdType chunk = begin; chunk < endChunk; ++chunk)
+      {
+        vtkIdType index = count + offsets[chunk];
+        size_t i = bounds[chunk];
+        while (index < numValues && i < bounds[chunk + 1])
+        {
+          while (i < bounds[chunk + 1] && vtkIsASCIISpace(text[i]))
+          {
+            ++i;
+          }
+          size_t tokenEnd = i;
+          while (tokenEnd < bounds[chunk + 1] && !vtkIsASCIISpace(text[tokenEnd]))
+          {
+            ++tokenEnd;
+          }
+          if (tokenEnd == i)
+          {
+            break;
+          }
+          if (!vtkParseASCIIValue(text + i, text + tokenEnd, data[index]))
+          {
+            chunkValid[chunk] = 0;
+            break;
+          }
+          ++index;
+          i = tokenEnd;
+          chunkStop[chunk] = tokenEnd;
+        }
+      }
+    });
+
+    vtkIdType numParsed = std::min(offsets[numChunks], numValues - count);
+    for (vtkIdType chunk = 0; chunk < numChunks && valid; ++chunk)
+    {
+      if (offsets[chunk] >= numValues - count)
+      {
+        break;
+      }
+      valid = chunkValid[chunk] != 0;
+      if (offsets[chunk + 1] >= numValues - count)
+      {
+        stop = bufferStart + static_cast<std::streamoff>(chunkStop[chunk]);
+      }
+    }
+    count += numParsed;
+
+    if (last && count < numValues)
+    {
+      valid = false;
+    }
+
+    // Keep the incomplete token for the next block.
+    buffer.erase(buffer.begin(), buffer.begin() + end);
+    bufferStart += static_cast<std::streamoff>(end);
+  }
+
+  is->clear();
+  if (!valid)
+  {
+    is->seekg(start);
+    return false;
+  }
+  is->seekg(start + stop);
+  return !is->fail();
+}
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
+  if (vtkReadASCIIDataBlocks(self->GetIStream(), data, numTuples * numComp))
+  {
+    return 1;
+  }
+
   vtkIdType i, j;
 
   for (i = 0; i < numTuples; i++)
@@ -3190,7 +3394,7 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
     }
     vtkByteSwap::Swap4BERange(data, size);
   }
-  else // ascii
+  else if (!vtkReadASCIIDataBlocks(this->IS, data, size)) // ascii
   {
     for (i = 0; i < size; i++)
     {
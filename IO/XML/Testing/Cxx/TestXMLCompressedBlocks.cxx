@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressedBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the blocks compressed and decompressed concurrently give the
+// same file as a single thread, and that the arrays are read back.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkTesting.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+std::string ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+//------------------------------------------------------------------------------
+bool Write(vtkImageData* image, const std::string& fileName, int compressorType, int dataMode)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressorType(compressorType);
+  // small blocks, so that each array is split in many of them
+  writer->SetBlockSize(1024);
+  writer->SetDataMode(dataMode);
+  writer->EncodeAppendedDataOff();
+  return writer->Write() == 1;
+}
+
+//------------------------------------------------------------------------------
+bool CheckArray(vtkDataArray* array, vtkDataArray* expected)
+{
+  if (!array || array->GetNumberOfValues() != expected->GetNumberOfValues())
+  {
+    std::cerr << "Wrong array " << expected->GetName() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    int nComp = expected->GetNumberOfComponents();
+    if (array->GetComponent(i / nComp, i % nComp) != expected->GetComponent(i / nComp, i % nComp))
+    {
+      std::cerr << "Wrong value in " << expected->GetName() << " at " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLCompressedBlocks(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDirectory = testing->GetTempDirectory();
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkIdType numberOfPoints = image->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfValues(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    values->SetTuple3(i, std::sin(0.01 * i), std::cos(0.02 * i), static_cast<double>(i % 17));
+    ids->SetValue(i, i / 3);
+  }
+  image->GetPointData()->AddArray(values);
+  image->GetPointData()->AddArray(ids);
+
+  const int compressors[3] = { vtkXMLWriterBase::ZLIB, vtkXMLWriterBase::LZ4,
+    vtkXMLWriterBase::LZMA };
+  const int dataModes[2] = { vtkXMLWriterBase::Binary, vtkXMLWriterBase::Appended };
+  for (int compressor : compressors)
+  {
+    for (int dataMode : dataModes)
+    {
+      const std::string suffix = std::to_string(compressor) + "_" + std::to_string(dataMode);
+      const std::string serialFileName = tempDirectory + "/TestXMLCompressedBlocks1_" + suffix;
+      const std::string threadedFileName = tempDirectory + "/TestXMLCompressedBlocks_" + suffix;
+
+      vtkSMPTools::Initialize(1);
+      bool written = ::Write(image, serialFileName + ".vti", compressor, dataMode);
+      vtkSMPTools::Initialize(4);
+      written &= ::Write(image, threadedFileName + ".vti", compressor, dataMode);
+      vtkSMPTools::Initialize();
+      if (!written)
+      {
+        std::cerr << "Cannot write " << threadedFileName << ".vti" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      if (::ReadFile(serialFileName + ".vti") != ::ReadFile(threadedFileName + ".vti"))
+      {
+        std::cerr << "The compressed blocks depend on the number of threads for compressor "
+                  << compressor << " and data mode " << dataMode << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->SetFileName((threadedFileName + ".vti").c_str());
+      reader->Update();
+      vtkPointData* pointData = reader->GetOutput()->GetPointData();
+      if (!::CheckArray(pointData->GetArray("Values"), values) ||
+        !::CheckArray(pointData->GetArray("Ids"), ids))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMappedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Read raw and compressed appended data with MemoryMapAppendedData on, and
+// check that the raw arrays are memory mapped, that the arrays match the ones
+// read without mapping and that modifying them does not change the file.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTesting.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// A reader which tells whether the values of an array are memory mapped.
+class vtkMappingXMLUnstructuredGridReader : public vtkXMLUnstructuredGridReader
+{
+public:
+  static vtkMappingXMLUnstructuredGridReader* New();
+  vtkTypeMacro(vtkMappingXMLUnstructuredGridReader, vtkXMLUnstructuredGridReader);
+
+  using vtkXMLReader::IsMemoryMapped;
+
+protected:
+  vtkMappingXMLUnstructuredGridReader() = default;
+  ~vtkMappingXMLUnstructuredGridReader() override = default;
+
+private:
+  vtkMappingXMLUnstructuredGridReader(const vtkMappingXMLUnstructuredGridReader&) = delete;
+  void operator=(const vtkMappingXMLUnstructuredGridReader&) = delete;
+};
+vtkStandardNewMacro(vtkMappingXMLUnstructuredGridReader);
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkUnstructuredGrid> Read(const std::string& fileName, bool memoryMap)
+{
+  vtkNew<vtkMappingXMLUnstructuredGridReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(memoryMap);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+bool CompareArrays(vtkDataArray* array, vtkDataArray* expected)
+{
+  if (!array || !expected || array->GetDataType() != expected->GetDataType() ||
+    array->GetNumberOfValues() != expected->GetNumberOfValues())
+  {
+    std::cerr << "Wrong array " << (expected ? expected->GetName() : "") << std::endl;
+    return false;
+  }
+  int nComp = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (array->GetComponent(i / nComp, i % nComp) != expected->GetComponent(i / nComp, i % nComp))
+    {
+      std::cerr << "Wrong value in " << expected->GetName() << " at " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareGrids(vtkUnstructuredGrid* output, vtkUnstructuredGrid* expected)
+{
+  if (!CompareArrays(output->GetPoints()->GetData(), expected->GetPoints()->GetData()) ||
+    !CompareArrays(output->GetCells()->GetConnectivityArray(),
+      expected->GetCells()->GetConnectivityArray()) ||
+    !CompareArrays(output->GetCellTypesArray(), expected->GetCellTypesArray()))
+  {
+    return false;
+  }
+  vtkPointData* pointData = expected->GetPointData();
+  for (int i = 0; i < pointData->GetNumberOfArrays(); ++i)
+  {
+    if (!CompareArrays(
+          output->GetPointData()->GetArray(pointData->GetArrayName(i)), pointData->GetArray(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Return true when the arrays of the grid are memory mapped or not, as
+// expected. Single byte values are always aligned, so they are mapped
+// whatever their position in the file, while the other arrays are only
+// mapped when they are aligned.
+bool CheckMapped(vtkUnstructuredGrid* grid, bool mapped)
+{
+  vtkDataArray* bytes = grid->GetPointData()->GetArray("Bytes");
+  if (vtkMappingXMLUnstructuredGridReader::IsMemoryMapped(bytes) != mapped)
+  {
+    std::cerr << "The Bytes array is " << (mapped ? "not " : "") << "memory mapped." << std::endl;
+    return false;
+  }
+  vtkDataArray* arrays[3] = { grid->GetPoints()->GetData(),
+    grid->GetPointData()->GetArray("Ints"), grid->GetPointData()->GetArray("Doubles") };
+  for (vtkDataArray* array : arrays)
+  {
+    if (!mapped && vtkMappingXMLUnstructuredGridReader::IsMemoryMapped(array))
+    {
+      std::cerr << "The array " << array->GetName() << " is memory mapped." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestFile(
+  vtkUnstructuredGrid* input, const std::string& fileName, int compressorType, bool mapped)
+{
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorType(compressorType);
+  if (!writer->Write())
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return false;
+  }
+
+  auto expected = ::Read(fileName, false);
+  auto output = ::Read(fileName, true);
+  if (!::CheckMapped(expected, false) || !::CheckMapped(output, mapped))
+  {
+    std::cerr << "Wrong memory mapping of " << fileName << std::endl;
+    return false;
+  }
+  if (!::CompareGrids(output, expected))
+  {
+    std::cerr << "Wrong memory mapped data in " << fileName << std::endl;
+    return false;
+  }
+
+  // The mapping is private: the values can be modified without changing
+  // the file.
+  vtkDataArray* bytes = output->GetPointData()->GetArray("Bytes");
+  bytes->Fill(255);
+  output->GetPoints()->GetData()->Fill(0.0);
+  auto again = ::Read(fileName, true);
+  if (!::CompareGrids(again, expected))
+  {
+    std::cerr << "The file was modified through the memory mapped arrays." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestXMLMemoryMappedData(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDirectory = testing->GetTempDirectory();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(30);
+  sphere->SetPhiResolution(30);
+  sphere->Update();
+  vtkNew<vtkUnstructuredGrid> input;
+  input->SetPoints(sphere->GetOutput()->GetPoints());
+  input->Allocate(sphere->GetOutput()->GetNumberOfCells());
+  for (vtkIdType i = 0; i < sphere->GetOutput()->GetNumberOfCells(); ++i)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    sphere->GetOutput()->GetPolys()->GetCellAtId(i, npts, pts);
+    input->InsertNextCell(VTK_TRIANGLE, npts, pts);
+  }
+
+  // Single byte values are always aligned, so they are mapped whatever
+  // their position in the file.
+  vtkIdType numberOfPoints = input->GetNumberOfPoints();
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetName("Bytes");
+  bytes->SetNumberOfValues(numberOfPoints);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  ints->SetNumberOfComponents(2);
+  ints->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  doubles->SetNumberOfValues(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    bytes->SetValue(i, static_cast<unsigned char>(i % 256));
+    ints->SetTypedComponent(i, 0, static_cast<int>(i));
+    ints->SetTypedComponent(i, 1, static_cast<int>(-i));
+    doubles->SetValue(i, 0.5 * i);
+  }
+  input->GetPointData()->AddArray(bytes);
+  input->GetPointData()->AddArray(ints);
+  input->GetPointData()->AddArray(doubles);
+
+  bool success = ::TestFile(
+    input, tempDirectory + "/TestXMLMemoryMappedData.vtu", vtkXMLWriterBase::NONE, true);
+  // Compressed data cannot be mapped and are read as usual.
+  success &= ::TestFile(input, tempDirectory + "/TestXMLMemoryMappedDataCompressed.vtu",
+    vtkXMLWriterBase::ZLIB, false);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
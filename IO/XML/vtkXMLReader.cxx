@@ -56,10 +56,21 @@
 #include <cmath>
 #include <functional>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <vector>
 
+#if defined(_WIN32)
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
@@ -141,6 +152,8 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapAppendedData = 0;
+  this->DictionaryEncodingThreshold = 0.0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -236,6 +249,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData << "\n";
+  os << indent << "DictionaryEncodingThreshold: " << this->DictionaryEncodingThreshold << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -727,6 +742,152 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
 
 namespace
 {
+//------------------------------------------------------------------------------
+// Memory mapped regions of files, indexed by the pointer to the array values
+// that they hold. A region is unmapped when its array releases the values.
+struct vtkXMLMappedRegion
+{
+  void* Base;
+  size_t Length;
+};
+
+std::mutex& GetMappedRegionsMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<void*, vtkXMLMappedRegion>& GetMappedRegions()
+{
+  static std::map<void*, vtkXMLMappedRegion> regions;
+  return regions;
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLReleaseMappedRegion(void* values)
+{
+  std::lock_guard<std::mutex> lock(GetMappedRegionsMutex());
+  auto& regions = GetMappedRegions();
+  auto it = regions.find(values);
+  if (it == regions.end())
+  {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(it->second.Base);
+#else
+  munmap(it->second.Base, it->second.Length);
+#endif
+  regions.erase(it);
+}
+
+//------------------------------------------------------------------------------
+// Map length bytes of the file starting at position, with a private copy on
+// write mapping. Returns the address of the first byte, or nullptr.
+void* vtkXMLMapFileRegion(const char* fileName, vtkTypeInt64 position, size_t length)
+{
+  vtkXMLMappedRegion region;
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWide(fileName).c_str(), GENERIC_READ,
+    FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+    position + static_cast<vtkTypeInt64>(length) > fileSize.QuadPart)
+  {
+    CloseHandle(file);
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    return nullptr;
+  }
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  vtkTypeInt64 start = position - position % info.dwAllocationGranularity;
+  region.Length = length + static_cast<size_t>(position - start);
+  region.Base = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(start >> 32),
+    static_cast<DWORD>(start & 0xffffffff), region.Length);
+  CloseHandle(mapping);
+  if (!region.Base)
+  {
+    return nullptr;
+  }
+#else
+  int file = open(fileName, O_RDONLY);
+  if (file < 0)
+  {
+    return nullptr;
+  }
+  struct stat fileStat;
+  if (fstat(file, &fileStat) != 0 ||
+    position + static_cast<vtkTypeInt64>(length) > static_cast<vtkTypeInt64>(fileStat.st_size))
+  {
+    close(file);
+    return nullptr;
+  }
+  vtkTypeInt64 start = position - position % sysconf(_SC_PAGESIZE);
+  region.Length = length + static_cast<size_t>(position - start);
+  region.Base = mmap(
+    nullptr, region.Length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(start));
+  close(file);
+  if (region.Base == MAP_FAILED)
+  {
+    return nullptr;
+  }
+#endif
+
+  void* values = static_cast<char*>(region.Base) + (position - start);
+  std::lock_guard<std::mutex> lock(GetMappedRegionsMutex());
+  GetMappedRegions()[values] = region;
+  return values;
+}
+
+//------------------------------------------------------------------------------
+// Make the array use the values stored in the file when they can be used in
+// place. Returns false when they have to be read.
+bool vtkXMLMapArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xmlparser,
+  const char* fileName, vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues)
+{
+  int dataType = array->GetDataType();
+  if (!vtkArrayDownCast<vtkDataArray>(array) || !array->HasStandardMemoryLayout() ||
+    dataType == VTK_BIT || numValues == 0 || !da->GetAttribute("offset"))
+  {
+    return false;
+  }
+
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  size_t numWords = 0;
+  vtkTypeInt64 position = xmlparser->FindRawAppendedData(offset, dataType, numWords);
+  if (position < 0 || static_cast<size_t>(startIndex + numValues) > numWords)
+  {
+    return false;
+  }
+
+  // The values must be aligned in memory.
+  size_t wordSize = xmlparser->GetWordTypeSize(dataType);
+  position += static_cast<vtkTypeInt64>(startIndex * wordSize);
+  if (position % wordSize != 0)
+  {
+    return false;
+  }
+
+  void* values = vtkXMLMapFileRegion(fileName, position, numValues * wordSize);
+  if (!values)
+  {
+    return false;
+  }
+  array->SetVoidArray(values, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(vtkXMLReleaseMappedRegion);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 template <class iterT>
 int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xmlparser,
@@ -905,6 +1066,19 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
 
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLReader::IsMemoryMapped(vtkAbstractArray* array)
+{
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  if (!dataArray || !dataArray->HasStandardMemoryLayout() || dataArray->GetNumberOfValues() == 0)
+  {
+    return false;
+  }
+  void* values = dataArray->GetVoidPointer(0);
+  std::lock_guard<std::mutex> lock(GetMappedRegionsMutex());
+  return GetMappedRegions().count(values) != 0;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues, FieldType fieldType)
@@ -923,12 +1097,25 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  // Values filling the whole array may be mapped from the file, when it is
+  // read through a stream opened by this reader.
+  if (this->MemoryMapAppendedData && this->FileName && this->FileStream &&
+    this->Stream == this->FileStream && arrayIndex == 0 &&
+    numValues == array->GetNumberOfValues() &&
+    vtkXMLMapArrayValues(da, this->XMLParser, this->FileName, array, startIndex, numValues))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = 1;
+  }
+  else
+  {
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+                                      arrayIndex, static_cast<VTK_TT*>(iter), startIndex,
+                                      numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
@@ -936,6 +1123,13 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
+  // String arrays are encoded once their last values are read
+  vtkStringArray* stringArray = vtkArrayDownCast<vtkStringArray>(array);
+  if (result && stringArray && this->DictionaryEncodingThreshold > 0.0 &&
+    arrayIndex + numValues == array->GetNumberOfValues())
+  {
+    stringArray->TryDictionaryEncoding(this->DictionaryEncodingThreshold);
+  }
   // Marking the array modified is essential, since otherwise, when reading
   // multiple time-steps, the array does not realize that its contents may have
   // changed and does not recompute the array ranges.
@@ -75,6 +75,33 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   ///@}
 
+  ///@{
+  /**
+   * When on, the arrays stored in raw appended data are memory mapped from
+   * the file instead of being read, when their values can be used in
+   * place: no compression, the byte order of this machine and aligned
+   * values. The arrays then share the pages of the file with the operating
+   * system cache, and only the pages that are accessed are loaded. The
+   * mapping is private, so modifying an array does not change the file.
+   * Other arrays are read as usual. Off by default.
+   */
+  vtkSetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkGetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkBooleanMacro(MemoryMapAppendedData, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * If positive, the string arrays whose number of distinct values is at
+   * most this fraction of their number of values are dictionary encoded once
+   * read, i.e. each distinct value is stored once, e.g. for arrays of labels
+   * or categories. See vtkStringArray::TryDictionaryEncoding(). Defaults to
+   * 0, i.e. off.
+   */
+  vtkSetClampMacro(DictionaryEncodingThreshold, double, 0.0, 1.0);
+  vtkGetMacro(DictionaryEncodingThreshold, double);
+  ///@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -206,6 +233,12 @@ protected:
   vtkXMLReader();
   ~vtkXMLReader() override;
 
+  /**
+   * Return whether the values of the array are memory mapped from a file by
+   * a reader, see MemoryMapAppendedData.
+   */
+  static bool IsMemoryMapped(vtkAbstractArray* array);
+
   ///@{
   /**
    * Pipeline execution methods to be defined by subclass.  Called by
@@ -407,6 +440,13 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether raw appended data are memory mapped.
+  vtkTypeBool MemoryMapAppendedData;
+
+  // The fraction of distinct values up to which string arrays are
+  // dictionary encoded.
+  double DictionaryEncodingThreshold;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
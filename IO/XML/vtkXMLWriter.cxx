@@ -43,6 +43,7 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -1017,6 +1018,14 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks that are still pending.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->PendingCompressionData.clear();
+    this->PendingCompressionSizes.clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1379,25 +1388,76 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // The blocks are independent, so they are queued and compressed
+  // concurrently once there are enough of them to keep all the threads
+  // busy.  They are written in order, so the output does not depend on
+  // the number of threads.
+  this->PendingCompressionData.insert(this->PendingCompressionData.end(), data, data + size);
+  this->PendingCompressionSizes.push_back(size);
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  size_t maxPendingBlocks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  if (this->PendingCompressionSizes.size() < maxPendingBlocks)
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  size_t numBlocks = this->PendingCompressionSizes.size();
+  if (numBlocks == 0)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 1;
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  // Find where each block starts in the pending data.
+  std::vector<size_t> offsets(numBlocks, 0);
+  for (size_t i = 1; i < numBlocks; ++i)
+  {
+    offsets[i] = offsets[i - 1] + this->PendingCompressionSizes[i - 1];
+  }
 
-  outputArray->Delete();
+  // Compress the blocks.  The compressors only use their settings, so
+  // the same instance can be shared by the threads.
+  std::vector<std::vector<unsigned char>> outputs(numBlocks);
+  std::vector<size_t> outputSizes(numBlocks, 0);
+  vtkDataCompressor* compressor = this->Compressor;
+  const unsigned char* pendingData = this->PendingCompressionData.data();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      size_t size = this->PendingCompressionSizes[i];
+      std::vector<unsigned char>& output = outputs[i];
+      output.resize(compressor->GetMaximumCompressionSpace(size));
+      outputSizes[i] =
+        compressor->Compress(pendingData + offsets[i], size, output.data(), output.size());
+    }
+  });
+
+  this->PendingCompressionData.clear();
+  this->PendingCompressionSizes.clear();
+
+  // Write the compressed blocks in order and store their sizes in the
+  // compression header.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    if (outputSizes[i] == 0)
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+      return 0;
+    }
+    result = this->DataStream->Write(outputs[i].data(), outputSizes[i]);
+    this->Stream->flush();
+    if (this->Stream->fail())
+    {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    }
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSizes[i]);
+  }
 
   return result;
 }
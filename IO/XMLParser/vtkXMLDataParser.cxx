@@ -21,6 +21,7 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -636,6 +637,51 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(
+  vtkTypeUInt64 firstBlock, size_t numBlocks, unsigned char* buffer, size_t wordSize)
+{
+  // The compressed blocks are stored back to back, so read them all at
+  // once and decompress them concurrently into their place in the buffer.
+  size_t compressedSize = 0;
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    compressedSize += this->BlockCompressedSizes[firstBlock + i];
+  }
+
+  if (!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+  {
+    return 0;
+  }
+
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  vtkDataCompressor* compressor = this->Compressor;
+  const vtkTypeInt64 firstOffset = this->BlockStartOffsets[firstBlock];
+  std::vector<unsigned char> results(numBlocks, 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkTypeUInt64 block = firstBlock + i;
+      size_t uncompressedSize = this->FindBlockSize(block);
+      unsigned char* output = buffer + i * this->BlockUncompressedSize;
+      results[i] = compressor->Uncompress(
+                     readBuffer.data() + (this->BlockStartOffsets[block] - firstOffset),
+                     this->BlockCompressedSizes[block], output, uncompressedSize) > 0;
+
+      // Note that the block size is always an integer multiple of the
+      // word size.
+      this->PerformByteSwap(output, uncompressedSize / wordSize, wordSize);
+    }
+  });
+
+  return std::find(results.begin(), results.end(), 0) == results.end();
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -808,21 +854,24 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in batches large enough to decompress
+    // them concurrently.
+    vtkTypeUInt64 maxBlocksPerBatch =
+      4 * static_cast<vtkTypeUInt64>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock != lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      vtkTypeUInt64 numBlocks = std::min(lastBlock - currentBlock, maxBlocksPerBatch);
+
+      // Read and byte swap these blocks.
+      if (!this->ReadBlocks(currentBlock, numBlocks, outputPointer, wordSize))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += numBlocks * this->BlockUncompressedSize;
+      currentBlock += numBlocks;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -970,6 +1019,43 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::FindRawAppendedData(
+  vtkTypeInt64 offset, int wordType, size_t& numWords)
+{
+  numWords = 0;
+#ifdef VTK_WORDS_BIGENDIAN
+  if (this->ByteOrder != vtkXMLDataParser::BigEndian)
+#else
+  if (this->ByteOrder != vtkXMLDataParser::LittleEndian)
+#endif
+  {
+    return -1;
+  }
+  if (this->Compressor || vtkBase64InputStream::SafeDownCast(this->AppendedDataStream))
+  {
+    return -1;
+  }
+
+  // Read the length of the data.
+  this->DataStream = this->AppendedDataStream;
+  this->DataStream->SetStream(this->Stream);
+  this->SeekG(this->AppendedDataPosition + offset);
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if (r < headerSize)
+  {
+    return -1;
+  }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+
+  numWords = static_cast<size_t>(uh->Get(0) / this->GetWordTypeSize(wordType));
+  return this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize);
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -82,6 +82,16 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Find where the words of the appended data starting at the given
+   * appended data offset are stored in the file, when they can be used in
+   * place: raw encoding, no compression and the byte order of this
+   * machine. Returns the file position of the first word and sets numWords
+   * to the number of words stored, or returns -1 when the data have to be
+   * decoded.
+   */
+  vtkTypeInt64 FindRawAppendedData(vtkTypeInt64 offset, int wordType, size_t& numWords);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -187,6 +197,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(
+    vtkTypeUInt64 firstBlock, size_t numBlocks, unsigned char* buffer, size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -277,6 +277,83 @@ bool TestImageWithDirection()
   return success;
 }
 
+bool TestLineInterpolation()
+{
+  std::cout << "Testing interpolation along lines:" << std::endl;
+
+  int extent[6] = { 0, 19, 0, 14, 0, 9 };
+
+  // an input image with two components of pseudo-random values
+  vtkNew<vtkImageData> input;
+  input->SetExtent(extent);
+  input->AllocateScalars(VTK_SHORT, 2);
+  vtkDataArray* pixels = input->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < pixels->GetNumberOfValues(); ++i)
+  {
+    pixels->SetComponent(i / 2, i % 2, (i * 7919) % 1000 - 500);
+  }
+
+  vtkNew<vtkImageInterpolator> interpolator;
+  interpolator->Initialize(input);
+
+  bool success = true;
+
+  // an oblique line, which goes a little beyond the extent at both ends
+  // to check the border modes
+  const double start[3] = { -0.3, 0.5, 0.25 };
+  const double step[3] = { 0.2071, 0.1347, 0.0931 };
+  const int n = 100;
+
+  const int modes[3] = { VTK_NEAREST_INTERPOLATION, VTK_LINEAR_INTERPOLATION,
+    VTK_CUBIC_INTERPOLATION };
+  const vtkImageBorderMode borders[3] = { VTK_IMAGE_BORDER_CLAMP, VTK_IMAGE_BORDER_REPEAT,
+    VTK_IMAGE_BORDER_MIRROR };
+  for (int mode : modes)
+  {
+    for (vtkImageBorderMode border : borders)
+    {
+      interpolator->SetInterpolationMode(mode);
+      interpolator->SetBorderMode(border);
+      interpolator->Update();
+
+      double values[2 * n];
+      float fvalues[2 * n];
+      const float fstart[3] = { static_cast<float>(start[0]), static_cast<float>(start[1]),
+        static_cast<float>(start[2]) };
+      const float fstep[3] = { static_cast<float>(step[0]), static_cast<float>(step[1]),
+        static_cast<float>(step[2]) };
+      interpolator->InterpolateLineIJK(start, step, values, n);
+      interpolator->InterpolateLineIJK(fstart, fstep, fvalues, n);
+
+      for (int i = 0; i < n; ++i)
+      {
+        double point[3] = { start[0] + i * step[0], start[1] + i * step[1],
+          start[2] + i * step[2] };
+        float fpoint[3] = { fstart[0] + i * fstep[0], fstart[1] + i * fstep[1],
+          fstart[2] + i * fstep[2] };
+        double expectedValue[2];
+        float fexpectedValue[2];
+        interpolator->InterpolateIJK(point, expectedValue);
+        interpolator->InterpolateIJK(fpoint, fexpectedValue);
+        if (!CompareVectorFuzzy("Line value:", &values[2 * i], expectedValue, 2, 1e-6) ||
+          !CompareVectorFuzzy("Float line value:", &fvalues[2 * i], fexpectedValue, 2, 1e-2f))
+        {
+          std::cout << "Mode " << mode << ", border " << border << ", point " << i << "\n";
+          success = false;
+          break;
+        }
+      }
+    }
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+  }
+
+  return success;
+}
+
 }
 
 // Driver Function
@@ -286,6 +363,7 @@ int ImageInterpolator(int, char*[])
 
   success &= TestImageNoDirection();
   success &= TestImageWithDirection();
+  success &= TestLineInterpolation();
 
   return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageResliceLines.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the oblique reslicing of the rows along lines, for the pixels
+// whose slab samples are all within the input bounds, gives the same output
+// as the interpolation of each sample with InterpolateIJK(). The reference
+// reslice uses a non-homogeneous identity transform, which disables the
+// interpolation along lines. The output rows cross the input bounds and are
+// cut by a stencil.
+
+#include "vtkDataArray.h"
+#include "vtkGeneralTransform.h"
+#include "vtkImageData.h"
+#include "vtkImageReslice.h"
+#include "vtkImageStencilData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkROIStencilSource.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+// Compare the output of the two reslices, and check that some rows of the
+// output cross the input bounds within the stencil
+bool CompareOutputs(
+  vtkImageData* output, vtkImageData* expected, vtkImageStencilData* stencil, double background)
+{
+  vtkDataArray* values = output->GetPointData()->GetScalars();
+  vtkDataArray* expectedValues = expected->GetPointData()->GetScalars();
+  if (values->GetNumberOfValues() != expectedValues->GetNumberOfValues())
+  {
+    std::cout << "Different output sizes" << std::endl;
+    return false;
+  }
+
+  int dims[3];
+  output->GetDimensions(dims);
+  vtkIdType numberOfInside = 0;
+  vtkIdType numberOfOutside = 0;
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    for (int c = 0; c < 2; ++c)
+    {
+      const double value = values->GetComponent(ptId, c);
+      const double expectedValue = expectedValues->GetComponent(ptId, c);
+      if (std::abs(value - expectedValue) > 1e-6 * (1.0 + std::abs(expectedValue)))
+      {
+        std::cout << "Point " << ptId << ", component " << c << ": " << value
+                  << " != " << expectedValue << std::endl;
+        return false;
+      }
+    }
+    const int i = static_cast<int>(ptId % dims[0]);
+    const int j = static_cast<int>((ptId / dims[0]) % dims[1]);
+    const int k = static_cast<int>(ptId / (dims[0] * dims[1]));
+    if (stencil->IsInside(i, j, k))
+    {
+      const bool outside = (values->GetComponent(ptId, 0) == background);
+      numberOfOutside += outside;
+      numberOfInside += !outside;
+    }
+  }
+
+  if (numberOfInside == 0 || numberOfOutside == 0)
+  {
+    std::cout << "The output does not cross the input bounds" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int ImageResliceLines(int, char*[])
+{
+  // an input image with two components, with an origin and a spacing
+  vtkNew<vtkImageData> input;
+  input->SetExtent(0, 39, 0, 29, 0, 19);
+  input->SetOrigin(1.0, -2.0, 3.0);
+  input->SetSpacing(0.9, 1.1, 1.3);
+  input->AllocateScalars(VTK_DOUBLE, 2);
+  vtkDataArray* pixels = input->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < pixels->GetNumberOfValues(); ++i)
+  {
+    pixels->SetComponent(i / 2, i % 2, (i * 7919) % 1000);
+  }
+
+  // oblique axes through the center of the input
+  double center[3];
+  input->GetCenter(center);
+  vtkNew<vtkTransform> axes;
+  axes->Translate(center);
+  axes->RotateWXYZ(30.0, 1.0, 1.0, 0.3);
+
+  // the output is larger than the input, so that its rows cross the bounds
+  int outExtent[6] = { 0, 59, 0, 49, 0, 3 };
+  double outSpacing[3] = { 0.8, 0.8, 0.8 };
+  double outOrigin[3] = { -23.6, -19.6, -1.2 };
+  const double background = -1000.0;
+
+  // the stencil covers the slices that the slab adds around the output
+  int stencilExtent[6] = { 0, 59, 0, 49, -3, 6 };
+  vtkNew<vtkROIStencilSource> stencil;
+  stencil->SetShapeToEllipsoid();
+  stencil->SetOutputWholeExtent(stencilExtent);
+  stencil->SetOutputSpacing(outSpacing);
+  stencil->SetOutputOrigin(outOrigin);
+  stencil->SetBounds(-22.0, 21.0, -18.0, 19.0, -2.0, 2.0);
+  stencil->Update();
+
+  // the reference reslice interpolates each sample with InterpolateIJK()
+  vtkNew<vtkGeneralTransform> identity;
+  vtkNew<vtkImageReslice> reslice[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    reslice[i]->SetInputData(input);
+    reslice[i]->SetResliceAxes(axes->GetMatrix());
+    reslice[i]->SetOutputExtent(outExtent);
+    reslice[i]->SetOutputSpacing(outSpacing);
+    reslice[i]->SetOutputOrigin(outOrigin);
+    reslice[i]->SetBackgroundLevel(background);
+    reslice[i]->SetStencilData(stencil->GetOutput());
+    reslice[i]->SetSlabNumberOfSlices(5);
+    reslice[i]->SetSlabSliceSpacingFraction(0.5);
+  }
+  reslice[1]->SetResliceTransform(identity);
+
+  const int modes[3] = { VTK_RESLICE_NEAREST, VTK_RESLICE_LINEAR, VTK_RESLICE_CUBIC };
+  const int slabModes[3] = { VTK_IMAGE_SLAB_MIN, VTK_IMAGE_SLAB_MAX, VTK_IMAGE_SLAB_MEAN };
+  bool success = true;
+  for (int mode : modes)
+  {
+    for (int slabMode : slabModes)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        reslice[i]->SetInterpolationMode(mode);
+        reslice[i]->SetSlabMode(slabMode);
+        reslice[i]->Update();
+      }
+      if (!CompareOutputs(
+            reslice[0]->GetOutput(), reslice[1]->GetOutput(), stencil->GetOutput(), background))
+      {
+        std::cout << "Interpolation mode " << mode << ", slab mode " << slabMode << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
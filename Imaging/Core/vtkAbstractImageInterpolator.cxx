@@ -99,6 +99,8 @@ vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
   this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
   this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
   this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -737,6 +739,8 @@ void vtkAbstractImageInterpolator::Update()
     this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
     this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->LineInterpolationFuncDouble = nullptr;
+    this->LineInterpolationFuncFloat = nullptr;
 
     return;
   }
@@ -812,6 +816,10 @@ void vtkAbstractImageInterpolator::Update()
   // get the functions that will perform the interpolation
   this->GetInterpolationFunc(&this->InterpolationFuncDouble);
   this->GetInterpolationFunc(&this->InterpolationFuncFloat);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncDouble);
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncFloat);
 
   if (this->SlidingWindow)
   {
@@ -888,6 +896,48 @@ double vtkAbstractImageInterpolator::Interpolate(double x, double y, double z, i
   return value;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Interpolate the points of a line, one at a time unless the interpolator
+// provides a line interpolation function
+template <class F>
+void vtkInterpolateLine(vtkInterpolationInfo* info,
+  void (*interpolate)(vtkInterpolationInfo*, const F[3], F*),
+  void (*interpolateLine)(vtkInterpolationInfo*, const F[3], const F[3], F*, int), const F start[3],
+  const F step[3], F* value, int n)
+{
+  if (interpolateLine)
+  {
+    interpolateLine(info, start, step, value, n);
+    return;
+  }
+  const int numscalars = info->NumberOfComponents;
+  for (int i = 0; i < n; i++)
+  {
+    const F point[3] = { start[0] + i * step[0], start[1] + i * step[1], start[2] + i * step[2] };
+    interpolate(info, point, value);
+    value += numscalars;
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const double start[3], const double step[3], double* value, int n)
+{
+  vtkInterpolateLine(this->InterpolationInfo, this->InterpolationFuncDouble,
+    this->LineInterpolationFuncDouble, start, step, value, n);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const float start[3], const float step[3], float* value, int n)
+{
+  vtkInterpolateLine(this->InterpolationInfo, this->InterpolationFuncFloat,
+    this->LineInterpolationFuncFloat, start, step, value, n);
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetInterpolationFunc(
   void (**)(vtkInterpolationInfo*, const double[3], double*))
@@ -912,6 +962,18 @@ void vtkAbstractImageInterpolator::GetRowInterpolationFunc(
 {
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo*, const double[3], const double[3], double*, int))
+{
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo*, const float[3], const float[3], float*, int))
+{
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetSlidingWindowFunc(
   void (**)(vtkInterpolationWeights*, int, int, int, double*, int))
@@ -160,6 +160,20 @@ public:
   bool CheckBoundsIJK(const float x[3]);
   ///@}
 
+  ///@{
+  /**
+   * Interpolate n points evenly spaced along a line in structured coords,
+   * point i being start + i*step, and store their components one after the
+   * other in value.  All the points must be within the bounds checked by
+   * CheckBoundsIJK(), which holds for all the points between two points
+   * that are within bounds.  This is faster than calling InterpolateIJK()
+   * for each point, especially for interpolators which provide a function
+   * that interpolates whole lines.
+   */
+  void InterpolateLineIJK(const double start[3], const double step[3], double* value, int n);
+  void InterpolateLineIJK(const float start[3], const float step[3], float* value, int n);
+  ///@}
+
   ///@{
   /**
    * The border mode (default: clamp).  This controls how out-of-bounds
@@ -306,6 +320,16 @@ protected:
     void (**floatfunc)(vtkInterpolationWeights*, int, int, int, float*, int));
   ///@}
 
+  ///@{
+  /**
+   * Get the line interpolation functions, if any.
+   */
+  virtual void GetLineInterpolationFunc(
+    void (**doublefunc)(vtkInterpolationInfo*, const double[3], const double[3], double*, int));
+  virtual void GetLineInterpolationFunc(
+    void (**floatfunc)(vtkInterpolationInfo*, const float[3], const float[3], float*, int));
+  ///@}
+
   ///@{
   /**
    * Get the sliding window interpolation functions.
@@ -344,6 +368,11 @@ protected:
   void (*RowInterpolationFuncFloat)(
     vtkInterpolationWeights* weights, int idX, int idY, int idZ, float* outPtr, int n);
 
+  void (*LineInterpolationFuncDouble)(
+    vtkInterpolationInfo* info, const double start[3], const double step[3], double* outPtr, int n);
+  void (*LineInterpolationFuncFloat)(
+    vtkInterpolationInfo* info, const float start[3], const float step[3], float* outPtr, int n);
+
 private:
   vtkAbstractImageInterpolator(const vtkAbstractImageInterpolator&) = delete;
   void operator=(const vtkAbstractImageInterpolator&) = delete;
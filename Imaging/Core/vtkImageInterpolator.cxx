@@ -20,6 +20,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkTypeTraits.h"
 
+#include <algorithm>
+
 #include "vtkTemplateAliasMacro.h"
 // turn off 64-bit ints when templating over all types, because
 // they cannot be faithfully represented by doubles
@@ -488,6 +490,142 @@ void vtkImageInterpolatorGetInterpolationFunc(
   }
 }
 
+//------------------------------------------------------------------------------
+// Interpolation along a line, for points that are all within bounds. Only
+// the linear interpolation has a line kernel, the points of the lines are
+// interpolated one at a time for the other modes.
+
+template <class F, class T>
+struct vtkImageNLCLineInterpolate
+{
+  static void Trilinear(
+    vtkInterpolationInfo* info, const F start[3], const F step[3], F* outPtr, int n);
+};
+
+//------------------------------------------------------------------------------
+// Compute the offsets of the two samples along one axis, and the fraction
+// between them, for a block of points along a line
+template <class F, int (*Border)(int, int, int)>
+void vtkImageLineAxisWeights(const vtkInterpolationInfo* info, int axis, F start, F step,
+  int first, int n, vtkIdType* off0, vtkIdType* off1, F* frac)
+{
+  const int minId = info->Extent[2 * axis];
+  const int maxId = info->Extent[2 * axis + 1];
+  const vtkIdType inc = info->Increments[axis];
+  for (int i = 0; i < n; i++)
+  {
+    F f;
+    int id0 = vtkInterpolationMath::Floor(start + (first + i) * step, f);
+    int id1 = id0 + (f != 0);
+    off0[i] = Border(id0, minId, maxId) * inc;
+    off1[i] = Border(id1, minId, maxId) * inc;
+    frac[i] = f;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F>
+void vtkImageLineWeights(const vtkInterpolationInfo* info, int axis, F start, F step, int first,
+  int n, vtkIdType* off0, vtkIdType* off1, F* frac)
+{
+  switch (info->BorderMode)
+  {
+    case VTK_IMAGE_BORDER_REPEAT:
+      vtkImageLineAxisWeights<F, &vtkInterpolationMath::Wrap>(
+        info, axis, start, step, first, n, off0, off1, frac);
+      break;
+
+    case VTK_IMAGE_BORDER_MIRROR:
+      vtkImageLineAxisWeights<F, &vtkInterpolationMath::Mirror>(
+        info, axis, start, step, first, n, off0, off1, frac);
+      break;
+
+    default:
+      vtkImageLineAxisWeights<F, &vtkInterpolationMath::Clamp>(
+        info, axis, start, step, first, n, off0, off1, frac);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCLineInterpolate<F, T>::Trilinear(
+  vtkInterpolationInfo* info, const F start[3], const F step[3], F* outPtr, int n)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  int numscalars = info->NumberOfComponents;
+
+  // The offsets and the weights of a block of points are computed axis by
+  // axis before the samples are summed, which keeps both loops simple
+  // enough for the compiler to vectorize them.
+  const int blockSize = 64;
+  vtkIdType factX0[blockSize], factX1[blockSize];
+  vtkIdType factY0[blockSize], factY1[blockSize];
+  vtkIdType factZ0[blockSize], factZ1[blockSize];
+  F fx[blockSize], fy[blockSize], fz[blockSize];
+
+  for (int first = 0; first < n; first += blockSize)
+  {
+    int m = std::min(blockSize, n - first);
+    vtkImageLineWeights(info, 0, start[0], step[0], first, m, factX0, factX1, fx);
+    vtkImageLineWeights(info, 1, start[1], step[1], first, m, factY0, factY1, fy);
+    vtkImageLineWeights(info, 2, start[2], step[2], first, m, factZ0, factZ1, fz);
+
+    for (int i = 0; i < m; i++)
+    {
+      vtkIdType i00 = factY0[i] + factZ0[i];
+      vtkIdType i01 = factY0[i] + factZ1[i];
+      vtkIdType i10 = factY1[i] + factZ0[i];
+      vtkIdType i11 = factY1[i] + factZ1[i];
+
+      F rx = 1 - fx[i];
+      F ry = 1 - fy[i];
+      F rz = 1 - fz[i];
+
+      F ryrz = ry * rz;
+      F fyrz = fy[i] * rz;
+      F ryfz = ry * fz[i];
+      F fyfz = fy[i] * fz[i];
+
+      const T* inPtr0 = inPtr + factX0[i];
+      const T* inPtr1 = inPtr + factX1[i];
+
+      for (int c = 0; c < numscalars; c++)
+      {
+        *outPtr++ = (rx *
+            (ryrz * inPtr0[i00 + c] + ryfz * inPtr0[i01 + c] + fyrz * inPtr0[i10 + c] +
+              fyfz * inPtr0[i11 + c]) +
+          fx[i] *
+            (ryrz * inPtr1[i00 + c] + ryfz * inPtr1[i01 + c] + fyrz * inPtr1[i10 + c] +
+              fyfz * inPtr1[i11 + c]));
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Get the line interpolation function for the specified data types, or
+// nullptr if the interpolation mode has no line kernel
+template <class F>
+void vtkImageInterpolatorGetLineInterpolationFunc(
+  void (**interpolate)(vtkInterpolationInfo*, const F[3], const F[3], F*, int), int dataType,
+  int interpolationMode)
+{
+  switch (interpolationMode)
+  {
+    case VTK_LINEAR_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(*interpolate = &(vtkImageNLCLineInterpolate<F, VTK_TT>::Trilinear));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+    default:
+      *interpolate = nullptr;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Interpolation for precomputed weights
 
@@ -1023,6 +1161,22 @@ void vtkImageInterpolator::GetInterpolationFunc(
     func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
 }
 
+//------------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(vtkInterpolationInfo*, const double[3], const double[3], double*, int))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
+//------------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(vtkInterpolationInfo*, const float[3], const float[3], float*, int))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
 //------------------------------------------------------------------------------
 void vtkImageInterpolator::GetRowInterpolationFunc(
   void (**func)(vtkInterpolationWeights*, int, int, int, double*, int))
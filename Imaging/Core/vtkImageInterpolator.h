@@ -121,6 +121,17 @@ protected:
     void (**floatfunc)(vtkInterpolationWeights*, int, int, int, float*, int)) override;
   ///@}
 
+  ///@{
+  /**
+   * Get the line interpolation functions.  Only the linear interpolation
+   * has line functions, the other modes interpolate one point at a time.
+   */
+  void GetLineInterpolationFunc(void (**doublefunc)(
+    vtkInterpolationInfo*, const double[3], const double[3], double*, int)) override;
+  void GetLineInterpolationFunc(
+    void (**floatfunc)(vtkInterpolationInfo*, const float[3], const float[3], float*, int)) override;
+  ///@}
+
   int InterpolationMode;
 
 private:
@@ -1955,6 +1955,83 @@ void vtkResliceApplyTransform(
   inPoint[2] = inInvMatrix[6] * x + inInvMatrix[7] * y + inInvMatrix[8] * z;
 }
 
+//------------------------------------------------------------------------------
+// compute the start point of a row of slab samples, for an affine reslice
+template <class F>
+void vtkResliceSlabSamplePoint(const F inPoint1[3], const F xAxis[3], const F zAxis[3], int idX,
+  int sample, int nsamples, double slabSampleSpacing, F inPoint[3])
+{
+  double s = sample - 0.5 * (nsamples - 1);
+  s *= slabSampleSpacing;
+  for (int i = 0; i < 3; i++)
+  {
+    inPoint[i] = inPoint1[i] + idX * xAxis[i] + s * zAxis[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+// check whether all the slab samples of an output pixel are within bounds,
+// for an affine reslice
+template <class F>
+bool vtkResliceSamplesInBounds(vtkAbstractImageInterpolator* interpolator, const F inPoint1[3],
+  const F xAxis[3], const F zAxis[3], int idX, int nsamples, double slabSampleSpacing)
+{
+  for (int sample = 0; sample < nsamples; sample++)
+  {
+    F inPoint[3];
+    vtkResliceSlabSamplePoint(
+      inPoint1, xAxis, zAxis, idX, sample, nsamples, slabSampleSpacing, inPoint);
+    if (!interpolator->CheckBoundsIJK(inPoint))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// interpolate all the slab samples of "n" output pixels that are known to be
+// within bounds, one line of samples at a time, and composite them
+template <class F>
+void vtkResliceInterpolateLine(vtkAbstractImageInterpolator* interpolator,
+  void (*composite)(F*, int, int), const F inPoint1[3], const F xAxis[3], const F zAxis[3],
+  int idX, int nsamples, double slabSampleSpacing, F* slabPtr, F* outPtr, int n)
+{
+  int inComponents = interpolator->GetNumberOfComponents();
+  F inPoint[3];
+  if (nsamples == 1)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      inPoint[i] = inPoint1[i] + idX * xAxis[i];
+    }
+    interpolator->InterpolateLineIJK(inPoint, xAxis, outPtr, n);
+    return;
+  }
+
+  // the samples are stored sample line by sample line, and then gathered
+  // for each pixel in the row buffer (which has room for nsamples extra)
+  for (int sample = 0; sample < nsamples; sample++)
+  {
+    vtkResliceSlabSamplePoint(
+      inPoint1, xAxis, zAxis, idX, sample, nsamples, slabSampleSpacing, inPoint);
+    interpolator->InterpolateLineIJK(inPoint, xAxis, slabPtr + sample * n * inComponents, n);
+  }
+  for (int j = 0; j < n; j++)
+  {
+    F* tmpPtr = outPtr + j * inComponents;
+    for (int sample = 0; sample < nsamples; sample++)
+    {
+      const F* samplePtr = slabPtr + (sample * n + j) * inComponents;
+      for (int c = 0; c < inComponents; c++)
+      {
+        *tmpPtr++ = samplePtr[c];
+      }
+    }
+    composite(outPtr + j * inComponents, inComponents, nsamples);
+  }
+}
+
 //------------------------------------------------------------------------------
 // the main execute function
 template <class F>
@@ -2075,6 +2152,16 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
     floatPtr = new F[inComponents * (outExt[1] - outExt[0] + nsamples)];
   }
 
+  // for affine transformations, the samples of the pixels of each row that
+  // are within bounds are interpolated along lines, which is much faster
+  // than interpolating them one by one
+  bool interpolateLines = !(optimizeNearest || perspective || newtrans);
+  F* slabPtr = nullptr;
+  if (interpolateLines && nsamples > 1)
+  {
+    slabPtr = new F[inComponents * nsamples * (outExt[1] - outExt[0] + 1)];
+  }
+
   // set color for area outside of input volume extent
   void* background;
   vtkAllocBackgroundPixel(
@@ -2146,10 +2233,45 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
         int idX = idXmin;
         F* tmpPtr = floatPtr;
 
+        // find the pixels for which all samples are within bounds, since
+        // the bounds are convex these pixels are contiguous
+        int lineStart = idXmax + 1;
+        int lineEnd = idXmax;
+        if (interpolateLines)
+        {
+          lineStart = idXmin;
+          while (lineStart <= idXmax &&
+            !vtkResliceSamplesInBounds(
+              interpolator, inPoint1, xAxis, zAxis, lineStart, nsamples, slabSampleSpacing))
+          {
+            lineStart++;
+          }
+          while (lineEnd > lineStart &&
+            !vtkResliceSamplesInBounds(
+              interpolator, inPoint1, xAxis, zAxis, lineEnd, nsamples, slabSampleSpacing))
+          {
+            lineEnd--;
+          }
+        }
+
         while (startIdX <= idXmax)
         {
           for (; idX <= idXmax && isInBounds == wasInBounds; idX++)
           {
+            if (idX >= lineStart && idX <= lineEnd)
+            {
+              // interpolate up to the end of the line, unless this pixel
+              // ends the segment of pixels that are out of bounds
+              wasInBounds = ((idX > idXmin) ? wasInBounds : true);
+              int n = (wasInBounds ? lineEnd - idX + 1 : 1);
+              vtkResliceInterpolateLine(interpolator, composite, inPoint1, xAxis, zAxis, idX,
+                nsamples, slabSampleSpacing, slabPtr, tmpPtr, n);
+              tmpPtr += n * inComponents;
+              isInBounds = true;
+              idX += n - 1;
+              continue;
+            }
+
             F inPoint2[4];
             inPoint2[0] = inPoint1[0] + idX * xAxis[0];
             inPoint2[1] = inPoint1[1] + idX * xAxis[1];
@@ -2355,6 +2477,7 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
   {
     delete[] floatPtr;
   }
+  delete[] slabPtr;
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,340 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageGaussianSmooth.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check vtkImageGaussianSmooth:
+// - the radii of the box filters,
+// - the truncated kernel against a direct convolution, including at the
+//   borders of the whole extent and for a sub-extent of the output,
+// - the box filters against the kernel, away from the borders,
+// - that both methods give the same output whatever the number of threads,
+//   the split mode and whether vtkSMPTools is used.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Expose the computation of the radii of the box filters
+class vtkTestImageGaussianSmooth : public vtkImageGaussianSmooth
+{
+public:
+  static vtkTestImageGaussianSmooth* New();
+  vtkTypeMacro(vtkTestImageGaussianSmooth, vtkImageGaussianSmooth);
+  using vtkImageGaussianSmooth::ComputeBoxRadii;
+
+protected:
+  vtkTestImageGaussianSmooth() = default;
+  ~vtkTestImageGaussianSmooth() override = default;
+
+private:
+  vtkTestImageGaussianSmooth(const vtkTestImageGaussianSmooth&) = delete;
+  void operator=(const vtkTestImageGaussianSmooth&) = delete;
+};
+
+vtkStandardNewMacro(vtkTestImageGaussianSmooth);
+
+//------------------------------------------------------------------------------
+// A smooth image of doubles, the sum of a sine along each axis, whose range
+// is about 480.
+vtkSmartPointer<vtkImageData> MakeSmoothImage(int dim)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, dim - 1, 0, dim - 1, 0, dim - 1);
+  image->AllocateScalars(VTK_DOUBLE, 1);
+  double* ptr = static_cast<double*>(image->GetScalarPointer());
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        *ptr++ =
+          100.0 * std::sin(0.5 * i) + 80.0 * std::cos(0.4 * j) + 60.0 * std::sin(0.3 * k + 1.0);
+      }
+    }
+  }
+  return image;
+}
+
+//------------------------------------------------------------------------------
+// An image of pseudo-random floats with two components, whose rows are
+// split into several blocks of lines by the box filters.
+vtkSmartPointer<vtkImageData> MakeNoisyImage()
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 70, -5, 45, 3, 33);
+  image->AllocateScalars(VTK_FLOAT, 2);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    scalars->SetComponent(i / 2, i % 2, ((i * 7919) % 1000) * 0.37);
+  }
+  return image;
+}
+
+//------------------------------------------------------------------------------
+// Convolve the image along the axes like vtkImageGaussianSmooth (the last
+// axis first), with a kernel truncated at the radius and renormalized at
+// the borders of the image.
+std::vector<double> ReferenceSmooth(
+  vtkImageData* image, const double stds[3], const double factors[3], int dimensionality)
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  const double* ptr = static_cast<double*>(image->GetScalarPointer());
+  std::vector<double> values(ptr, ptr + image->GetNumberOfPoints());
+  const vtkIdType incs[3] = { 1, dims[0], static_cast<vtkIdType>(dims[0]) * dims[1] };
+
+  for (int axis = dimensionality - 1; axis >= 0; --axis)
+  {
+    const double s = stds[axis];
+    const int radius = static_cast<int>(s * factors[axis]);
+    std::vector<double> smoothed(values.size());
+    std::vector<double> kernel(2 * radius + 1);
+    for (vtkIdType ptId = 0; ptId < static_cast<vtkIdType>(values.size()); ++ptId)
+    {
+      const int p = static_cast<int>((ptId / incs[axis]) % dims[axis]);
+      const int lo = std::max(-radius, -p);
+      const int hi = std::min(radius, dims[axis] - 1 - p);
+      double sum = 0.0;
+      for (int x = lo; x <= hi; ++x)
+      {
+        kernel[x - lo] = (s == 0.0 ? 1.0 : std::exp(-static_cast<double>(x * x) / (s * s * 2.0)));
+        sum += kernel[x - lo];
+      }
+      for (int x = lo; x <= hi; ++x)
+      {
+        kernel[x - lo] /= sum;
+      }
+      double value = 0.0;
+      for (int x = lo; x <= hi; ++x)
+      {
+        value += kernel[x - lo] * values[ptId + x * incs[axis]];
+      }
+      smoothed[ptId] = value;
+    }
+    values.swap(smoothed);
+  }
+  return values;
+}
+
+//------------------------------------------------------------------------------
+bool TestBoxRadii()
+{
+  struct BoxCase
+  {
+    double StandardDeviation;
+    std::vector<int> Radii;
+  };
+  const BoxCase cases[] = { { 0.0, { 0, 0, 0 } }, { 1.5, { 0, 1, 1, 1 } }, { 2.0, { 1, 1, 2 } },
+    { 2.5, { 2, 2, 2 } }, { 4.0, { 3, 3, 3, 3 } }, { 4.0, { 2, 2, 2, 2, 3, 3 } } };
+
+  vtkNew<vtkTestImageGaussianSmooth> smooth;
+  for (const BoxCase& boxCase : cases)
+  {
+    const int numberOfPasses = static_cast<int>(boxCase.Radii.size());
+    smooth->SetNumberOfBoxPasses(numberOfPasses);
+    std::vector<int> radii(numberOfPasses);
+    const int radius = smooth->ComputeBoxRadii(radii.data(), boxCase.StandardDeviation);
+    int expectedRadius = 0;
+    for (int r : boxCase.Radii)
+    {
+      expectedRadius += r;
+    }
+    if (radii != boxCase.Radii || radius != expectedRadius)
+    {
+      std::cerr << "Wrong box radii for a standard deviation of " << boxCase.StandardDeviation
+                << " with " << numberOfPasses << " passes." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The kernel output, for the whole extent and for a sub-extent, must be the
+// direct convolution of the input.
+bool TestKernel(vtkImageData* input)
+{
+  const double stds[3] = { 2.0, 1.3, 3.0 };
+  const double factors[3] = { 1.5, 2.0, 1.2 };
+  int wholeExtent[6];
+  input->GetExtent(wholeExtent);
+  int dims[3];
+  input->GetDimensions(dims);
+  const int subExtent[6] = { 5, 40, 0, 30, 2, 47 };
+
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputData(input);
+  smooth->SetStandardDeviations(stds[0], stds[1], stds[2]);
+  smooth->SetRadiusFactors(factors[0], factors[1], factors[2]);
+  smooth->SetNumberOfThreads(3);
+  for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+  {
+    smooth->SetDimensionality(dimensionality);
+    const std::vector<double> expected = ReferenceSmooth(input, stds, factors, dimensionality);
+    for (const int* extent : { static_cast<const int*>(wholeExtent), subExtent })
+    {
+      smooth->UpdateExtent(extent);
+      vtkImageData* output = smooth->GetOutput();
+      for (int k = extent[4]; k <= extent[5]; ++k)
+      {
+        for (int j = extent[2]; j <= extent[3]; ++j)
+        {
+          for (int i = extent[0]; i <= extent[1]; ++i)
+          {
+            const double value = output->GetScalarComponentAsDouble(i, j, k, 0);
+            const double expectedValue = expected[i + dims[0] * (j + dims[1] * k)];
+            if (std::abs(value - expectedValue) > 1e-9)
+            {
+              std::cerr << "Kernel output at (" << i << ", " << j << ", " << k << ") in "
+                        << dimensionality << "D: " << value << " != " << expectedValue
+                        << std::endl;
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The box filters must match a kernel that is long enough to be close to a
+// gaussian, within 2.5% of the range of the input, away from the borders.
+bool TestBoxFilters(vtkImageData* input)
+{
+  const double tolerance = 0.025 * 480.0;
+  const double factor = 4.0;
+  int dims[3];
+  input->GetDimensions(dims);
+
+  vtkNew<vtkTestImageGaussianSmooth> smooth;
+  smooth->SetInputData(input);
+  smooth->SetRadiusFactor(factor);
+  for (double s : { 1.5, 2.5, 4.0 })
+  {
+    smooth->SetStandardDeviation(s);
+    smooth->SetSmoothingMethodToKernel();
+    smooth->Update();
+    vtkNew<vtkImageData> expected;
+    expected->DeepCopy(smooth->GetOutput());
+
+    smooth->SetSmoothingMethodToBoxFilters();
+    for (int numberOfPasses : { 3, 4, 6 })
+    {
+      smooth->SetNumberOfBoxPasses(numberOfPasses);
+      smooth->Update();
+      vtkImageData* output = smooth->GetOutput();
+
+      std::vector<int> radii(numberOfPasses);
+      const int margin =
+        std::max(smooth->ComputeBoxRadii(radii.data(), s), static_cast<int>(s * factor));
+      double maxError = 0.0;
+      for (int k = margin; k < dims[2] - margin; ++k)
+      {
+        for (int j = margin; j < dims[1] - margin; ++j)
+        {
+          for (int i = margin; i < dims[0] - margin; ++i)
+          {
+            maxError = std::max(maxError,
+              std::abs(output->GetScalarComponentAsDouble(i, j, k, 0) -
+                expected->GetScalarComponentAsDouble(i, j, k, 0)));
+          }
+        }
+      }
+      if (maxError > tolerance)
+      {
+        std::cerr << "The box filters differ from the kernel by " << maxError
+                  << " for a standard deviation of " << s << " with " << numberOfPasses
+                  << " passes." << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Both methods give the same output with one thread and with several,
+// with or without vtkSMPTools, whatever the split mode.
+bool TestThreads(vtkImageData* input)
+{
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputData(input);
+  smooth->SetStandardDeviations(2.5, 1.7, 3.2);
+  vtkNew<vtkImageData> expected;
+  for (int method : { vtkImageGaussianSmooth::KERNEL, vtkImageGaussianSmooth::BOX_FILTERS })
+  {
+    smooth->SetSmoothingMethod(method);
+    smooth->SetEnableSMP(false);
+    smooth->SetNumberOfThreads(1);
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { smooth->Update(); });
+    expected->DeepCopy(smooth->GetOutput());
+    vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+
+    for (bool smp : { false, true })
+    {
+      for (int splitMode = 0; splitMode <= 2; ++splitMode)
+      {
+        smooth->SetEnableSMP(smp);
+        smooth->SetSplitMode(splitMode);
+        smooth->SetNumberOfThreads(4);
+        // small pieces, so that vtkSMPTools splits the output in many pieces
+        smooth->SetDesiredBytesPerPiece(4096);
+        vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() { smooth->Update(); });
+
+        vtkDataArray* scalars = smooth->GetOutput()->GetPointData()->GetScalars();
+        bool same = scalars->GetNumberOfValues() == expectedScalars->GetNumberOfValues();
+        for (vtkIdType i = 0; same && i < scalars->GetNumberOfValues(); ++i)
+        {
+          same =
+            (scalars->GetComponent(i / 2, i % 2) == expectedScalars->GetComponent(i / 2, i % 2));
+        }
+        if (!same)
+        {
+          std::cerr << smooth->GetSmoothingMethodAsString() << " output depends on the threads"
+                    << " (SMP " << smp << ", split mode " << splitMode << ")." << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestImageGaussianSmooth(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> smoothImage = ::MakeSmoothImage(48);
+  vtkSmartPointer<vtkImageData> noisyImage = ::MakeNoisyImage();
+  bool success = ::TestBoxRadii();
+  success = ::TestKernel(smoothImage) && success;
+  success = ::TestBoxFilters(smoothImage) && success;
+  success = ::TestThreads(noisyImage) && success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
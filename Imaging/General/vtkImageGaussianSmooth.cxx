@@ -18,9 +18,12 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageGaussianSmooth);
@@ -35,6 +38,8 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->SmoothingMethod = KERNEL;
+  this->NumberOfBoxPasses = 3;
 }
 
 //------------------------------------------------------------------------------
@@ -56,6 +61,23 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "StandardDeviations: ( " << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", " << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "SmoothingMethod: " << this->GetSmoothingMethodAsString() << "\n";
+
+  os << indent << "NumberOfBoxPasses: " << this->NumberOfBoxPasses << "\n";
+}
+
+//------------------------------------------------------------------------------
+const char* vtkImageGaussianSmooth::GetSmoothingMethodAsString()
+{
+  switch (this->SmoothingMethod)
+  {
+    case KERNEL:
+      return "Kernel";
+    case BOX_FILTERS:
+      return "BoxFilters";
+  }
+  return "";
 }
 
 //------------------------------------------------------------------------------
@@ -85,6 +107,49 @@ void vtkImageGaussianSmooth::ComputeKernel(double* kernel, int min, int max, dou
   }
 }
 
+//------------------------------------------------------------------------------
+// Compute the radii of the box filters that approximate a gaussian, and
+// return the radius of their combination.  Following Kovesi, the widths
+// of the boxes are w and w + 2, which are both odd, and the number of boxes
+// of each width is chosen so that the sum of their variances, which are
+// (w*w - 1)/12 each, is as close as possible to the variance of the gaussian.
+int vtkImageGaussianSmooth::ComputeBoxRadii(int* radii, double std)
+{
+  int n = this->NumberOfBoxPasses;
+  double variance = std * std;
+
+  int w = static_cast<int>(std::sqrt(12.0 * variance / n + 1.0));
+  w -= (w % 2 == 0);
+
+  // the number of boxes with width w, the others have width w + 2
+  double m = (n * (w * w + 4.0 * w + 3.0) - 12.0 * variance) / (4.0 * w + 4.0);
+  int numSmall = static_cast<int>(std::floor(m + 0.5));
+  numSmall = std::max(0, std::min(n, numSmall));
+
+  int radius = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    radii[i] = (i < numSmall ? w / 2 : w / 2 + 1);
+    radius += radii[i];
+  }
+
+  return radius;
+}
+
+//------------------------------------------------------------------------------
+// Compute how many voxels each output voxel depends on, on each side, along
+// the given axis.
+int vtkImageGaussianSmooth::ComputeRadius(int axis)
+{
+  if (this->SmoothingMethod == BOX_FILTERS)
+  {
+    std::vector<int> radii(this->NumberOfBoxPasses);
+    return this->ComputeBoxRadii(radii.data(), this->StandardDeviations[axis]);
+  }
+
+  return static_cast<int>(this->StandardDeviations[axis] * this->RadiusFactors[axis]);
+}
+
 //------------------------------------------------------------------------------
 int vtkImageGaussianSmooth::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -115,7 +180,7 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int* inExt, int* wholeE
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
   {
-    radius = static_cast<int>(this->StandardDeviations[idx] * this->RadiusFactors[idx]);
+    radius = this->ComputeRadius(idx);
     inExt[idx * 2] -= radius;
     if (inExt[idx * 2] < wholeExtent[idx * 2])
     {
@@ -229,6 +294,147 @@ void vtkImageGaussianSmoothExecute(vtkImageGaussianSmooth* self, int axis, doubl
   }
 }
 
+//------------------------------------------------------------------------------
+// Apply a box filter of the given radius to "m" interleaved lines of "n"
+// samples, with a running sum for each line.  The box is clipped at the
+// ends of the lines, and normalized by the number of samples within it.
+static void vtkImageGaussianSmoothBoxPass(
+  const double* inPtr, double* outPtr, double* sums, int n, int m, int radius)
+{
+  int l;
+  for (l = 0; l < m; ++l)
+  {
+    sums[l] = 0.0;
+  }
+  int last = std::min(radius, n - 1);
+  for (int p = 0; p <= last; ++p)
+  {
+    const double* rowPtr = inPtr + static_cast<size_t>(p) * m;
+    for (l = 0; l < m; ++l)
+    {
+      sums[l] += rowPtr[l];
+    }
+  }
+
+  for (int p = 0; p < n; ++p)
+  {
+    int lo = p - radius;
+    int hi = p + radius;
+    double f = 1.0 / (std::min(hi, n - 1) - std::max(lo, 0) + 1);
+    double* rowPtr = outPtr + static_cast<size_t>(p) * m;
+    for (l = 0; l < m; ++l)
+    {
+      rowPtr[l] = sums[l] * f;
+    }
+
+    // slide the box by one sample
+    if (hi + 1 < n)
+    {
+      const double* addPtr = inPtr + static_cast<size_t>(hi + 1) * m;
+      for (l = 0; l < m; ++l)
+      {
+        sums[l] += addPtr[l];
+      }
+    }
+    if (lo >= 0)
+    {
+      const double* subPtr = inPtr + static_cast<size_t>(lo) * m;
+      for (l = 0; l < m; ++l)
+      {
+        sums[l] -= subPtr[l];
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Smooth along one axis with a sequence of box filters.  The lines along
+// the axis are gathered into a buffer a few at a time, interleaved so that
+// the running sums of neighboring lines are computed together: when the
+// axis is not the X axis, the lines are the voxels and components of an
+// X row, otherwise they are the components of the voxels.  The rounding of
+// the running sums depends on where the lines start, so the lines are
+// always smoothed whole, and the rows of lines are split between threads.
+template <class T>
+void vtkImageGaussianSmoothBoxExecute(vtkImageGaussianSmooth* self, int axis,
+  const std::vector<int>& radii, int inMin, int inMax, vtkImageData* inData, T* inPtr,
+  vtkImageData* outData, int outExt[6], T* outPtr, int* pcount, int total)
+{
+  vtkIdType inIncs[3], outIncs[3];
+  inData->GetIncrements(inIncs);
+  outData->GetIncrements(outIncs);
+  vtkIdType inIncA = inIncs[axis];
+  vtkIdType outIncA = outIncs[axis];
+
+  int numComponents = outData->GetNumberOfScalarComponents();
+  int numLanes = numComponents * (axis == 0 ? 1 : outExt[1] - outExt[0] + 1);
+  int max1 = (axis == 1 ? 1 : outExt[3] - outExt[2] + 1);
+  int max2 = (axis == 2 ? 1 : outExt[5] - outExt[4] + 1);
+  int n = inMax - inMin + 1;
+  int offset = outExt[2 * axis] - inMin;
+  int outLength = outExt[2 * axis + 1] - outExt[2 * axis] + 1;
+
+  // a small number of lines at a time keeps the buffer in the cache
+  const int blockSize = 64;
+  int bufferLanes = std::min(numLanes, blockSize);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(max1) * max2, [&](vtkIdType first, vtkIdType last) {
+    std::vector<double> buffer(2 * static_cast<size_t>(n) * bufferLanes);
+    std::vector<double> sums(bufferLanes);
+
+    for (vtkIdType row = first; !self->AbortExecute && row < last; ++row)
+    {
+      vtkIdType idx1 = row % max1;
+      vtkIdType idx2 = row / max1;
+      T* inPtr1 = inPtr + idx1 * inIncs[1] + idx2 * inIncs[2];
+      T* outPtr1 = outPtr + idx1 * outIncs[1] + idx2 * outIncs[2];
+
+      for (int lane = 0; lane < numLanes; lane += blockSize)
+      {
+        int m = std::min(blockSize, numLanes - lane);
+        double* bufPtr = buffer.data();
+        double* tmpPtr = bufPtr + static_cast<size_t>(n) * m;
+
+        for (int p = 0; p < n; ++p)
+        {
+          const T* inPtrP = inPtr1 + p * inIncA + lane;
+          double* bufPtrP = bufPtr + static_cast<size_t>(p) * m;
+          for (int l = 0; l < m; ++l)
+          {
+            bufPtrP[l] = static_cast<double>(inPtrP[l]);
+          }
+        }
+
+        for (int radius : radii)
+        {
+          if (radius > 0)
+          {
+            vtkImageGaussianSmoothBoxPass(bufPtr, tmpPtr, sums.data(), n, m, radius);
+            std::swap(bufPtr, tmpPtr);
+          }
+        }
+
+        for (int p = 0; p < outLength; ++p)
+        {
+          const double* bufPtrP = bufPtr + static_cast<size_t>(offset + p) * m;
+          T* outPtrP = outPtr1 + p * outIncA + lane;
+          for (int l = 0; l < m; ++l)
+          {
+            outPtrP[l] = static_cast<T>(bufPtrP[l]);
+          }
+        }
+      }
+    }
+  });
+
+  // we finished the axis ... do we update ???
+  if (total)
+  {
+    *pcount += outLength * numLanes * max1 * max2;
+    self->UpdateProgress(static_cast<double>(*pcount) / static_cast<double>(total));
+  }
+}
+
 //------------------------------------------------------------------------------
 template <class T>
 size_t vtkImageGaussianSmoothGetTypeSize(T*)
@@ -259,6 +465,31 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis, vtkImageData* inData, int inE
 
   // Get the correct starting pointer of the output
   outPtr = outData->GetScalarPointerForExtent(outExt);
+
+  if (this->SmoothingMethod == BOX_FILTERS)
+  {
+    // the input needed for this piece of the output (the input extent has
+    // already been clipped to the whole extent)
+    std::vector<int> radii(this->NumberOfBoxPasses);
+    radius = this->ComputeBoxRadii(radii.data(), this->StandardDeviations[axis]);
+    int inMin = std::max(outExt[axis * 2] - radius, inExt[axis * 2]);
+    int inMax = std::min(outExt[axis * 2 + 1] + radius, inExt[axis * 2 + 1]);
+    coords[0] = outExt[0];
+    coords[1] = outExt[2];
+    coords[2] = outExt[4];
+    coords[axis] = inMin;
+    inPtr = inData->GetScalarPointer(coords);
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageGaussianSmoothBoxExecute(this, axis, radii, inMin, inMax, inData,
+        static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<VTK_TT*>(outPtr), pcount,
+        total));
+      default:
+        vtkErrorMacro("Unknown scalar type");
+    }
+    return;
+  }
+
   outData->GetIncrements(outIncs);
   outIncA = outIncs[axis];
 
@@ -339,11 +570,37 @@ void vtkImageGaussianSmooth::ExecuteAxis(int axis, vtkImageData* inData, int inE
   delete[] kernel;
 }
 
+//------------------------------------------------------------------------------
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->SmoothingMethod != BOX_FILTERS)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // The box filters smooth the whole output in one piece, their lines are
+  // split between threads instead (see vtkImageGaussianSmoothBoxExecute)
+  vtkImageData* inData = nullptr;
+  vtkImageData** inPort = &inData;
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, &inPort, &outData);
+
+  int outExt[6];
+  outData->GetExtent(outExt);
+  if (outExt[0] <= outExt[1] && outExt[2] <= outExt[3] && outExt[4] <= outExt[5])
+  {
+    this->ThreadedRequestData(request, inputVector, outputVector, &inPort, &outData, outExt, 0);
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // This method decomposes the gaussian and smooths along each axis.
 void vtkImageGaussianSmooth::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector, vtkImageData*** inData,
-  vtkImageData** outData, int outExt[6], int id)
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
+  vtkImageData*** inData, vtkImageData** outData, int outExt[6], int id)
 {
   int inExt[6];
   int target, count, total, cycle;
@@ -373,12 +630,15 @@ void vtkImageGaussianSmooth::ThreadedRequestData(vtkInformation* vtkNotUsed(requ
     return;
   }
 
-  // Decompose
+  // Decompose, the input needed for this piece is its extent expanded
+  // along the smoothed axes
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
   int wholeExt[6];
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
-  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+  for (int i = 0; i < 6; ++i)
+  {
+    inExt[i] = outExt[i];
+  }
   this->InternalRequestUpdateExtent(inExt, wholeExt);
 
   switch (this->Dimensionality)
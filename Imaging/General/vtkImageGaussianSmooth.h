@@ -18,6 +18,13 @@
  *
  * vtkImageGaussianSmooth implements a convolution of the input image
  * with a gaussian. Supports from one to three dimensional convolutions.
+ *
+ * By default the gaussian is a kernel that is truncated at a radius of
+ * RadiusFactors times the standard deviation, so the cost per voxel grows
+ * with the standard deviation.  For large standard deviations, the
+ * smoothing method can be set to BOX_FILTERS, which approximates the
+ * gaussian with a few box filters applied one after the other, at a cost
+ * per voxel that does not depend on the standard deviation.
  */
 
 #ifndef vtkImageGaussianSmooth_h
@@ -40,6 +47,43 @@ public:
    */
   static vtkImageGaussianSmooth* New();
 
+  enum
+  {
+    KERNEL,
+    BOX_FILTERS
+  };
+
+  ///@{
+  /**
+   * The smoothing method to use.  The default is to convolve with a
+   * gaussian kernel, truncated according to the RadiusFactors.  With
+   * BOX_FILTERS, the gaussian is approximated by NumberOfBoxPasses box
+   * filters whose widths are chosen so that their combined variance
+   * matches the standard deviation.  The RadiusFactors are ignored for
+   * this method, since the box filters have an exact, finite extent.
+   * The box filters always smooth whole lines, which are split between
+   * threads with vtkSMPTools, so their output does not depend on the
+   * number of threads or on the SplitMode.
+   */
+  vtkSetClampMacro(SmoothingMethod, int, KERNEL, BOX_FILTERS);
+  vtkGetMacro(SmoothingMethod, int);
+  void SetSmoothingMethodToKernel() { this->SetSmoothingMethod(KERNEL); }
+  void SetSmoothingMethodToBoxFilters() { this->SetSmoothingMethod(BOX_FILTERS); }
+  virtual const char* GetSmoothingMethodAsString();
+  ///@}
+
+  ///@{
+  /**
+   * The number of box filters applied along each axis for the BOX_FILTERS
+   * method.  The result is closer to a gaussian with more passes, at a
+   * cost that grows with the number of passes.  Three passes give a
+   * piecewise quadratic kernel, whose error is a few percent of the peak
+   * of the gaussian.  The default is 3.
+   */
+  vtkSetClampMacro(NumberOfBoxPasses, int, 1, 16);
+  vtkGetMacro(NumberOfBoxPasses, int);
+  ///@}
+
   ///@{
   /**
    * Sets/Gets the Standard deviation of the gaussian in pixel units.
@@ -85,9 +129,14 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  int SmoothingMethod;
+  int NumberOfBoxPasses;
 
   void ComputeKernel(double* kernel, int min, int max, double std);
+  int ComputeBoxRadii(int* radii, double std);
+  int ComputeRadius(int axis);
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   void InternalRequestUpdateExtent(int*, int*);
   void ExecuteAxis(int axis, vtkImageData* inData, int inExt[6], vtkImageData* outData,
     int outExt[6], int* pcycle, int target, int* pcount, int total, vtkInformation* inInfo);
@@ -0,0 +1,290 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTestUtilities.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMPTestUtilities
+ * @brief   Utility functions used to test threaded filters.
+ *
+ * vtkSMPTestUtilities provides a random grid generator to build inputs, exact
+ * comparisons of arrays, cells and data sets, and CompareThreads() which checks that the output of an algorithm does
+ * not depend on the number of threads it is executed with. The comparison is
+ * skipped, and reported, when the SMP backend is Sequential since both
+ * executions would then run on a single thread.
+ */
+
+#ifndef vtkSMPTestUtilities_h
+#define vtkSMPTestUtilities_h
+
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVariant.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+struct vtkSMPTestUtilities
+{
+  /**
+   * Return true when the SMP backend runs everything on a single thread, in
+   * which case comparing executions with different numbers of threads does not
+   * test anything.
+   */
+  static bool IsSequentialBackend()
+  {
+    return std::strcmp(vtkSMPTools::GetBackend(), "Sequential") == 0;
+  }
+
+  /**
+   * Return a dim x dim grid of points in the (x, y) plane, at random heights
+   * between 0 and bumpHeight, whose cells are created by
+   * addCell(p, r, verts, lines, polys, strips) for each block of step x step
+   * points. p is the id of the lower left point of the block and r a random
+   * value in [0, 1) to choose the kind of its cells. The random sequence is
+   * seeded, so that the same arguments always make the same grid.
+   */
+  template <typename CellGenerator>
+  static vtkSmartPointer<vtkPolyData> MakeRandomGrid(
+    int dim, double bumpHeight, int step, CellGenerator&& addCell)
+  {
+    vtkSmartPointer<vtkMinimalStandardRandomSequence> random =
+      vtkSmartPointer<vtkMinimalStandardRandomSequence>::New();
+    random->SetSeed(1);
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(i, j, bumpHeight * random->GetNextValue());
+      }
+    }
+    vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkCellArray> strips = vtkSmartPointer<vtkCellArray>::New();
+    for (int j = 0; j + step < dim; j += step)
+    {
+      for (int i = 0; i + step < dim; i += step)
+      {
+        addCell(static_cast<vtkIdType>(j) * dim + i, random->GetNextValue(), verts.Get(),
+          lines.Get(), polys.Get(), strips.Get());
+      }
+    }
+    vtkSmartPointer<vtkPolyData> grid = vtkSmartPointer<vtkPolyData>::New();
+    grid->SetPoints(points);
+    grid->SetVerts(verts);
+    grid->SetLines(lines);
+    grid->SetPolys(polys);
+    grid->SetStrips(strips);
+    return grid;
+  }
+
+  /**
+   * Add a vtkIdTypeArray holding the cell ids to the cell data of dataSet.
+   */
+  static void AddCellIds(vtkDataSet* dataSet, const char* name)
+  {
+    vtkSmartPointer<vtkIdTypeArray> cellIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    cellIds->SetName(name);
+    cellIds->SetNumberOfValues(dataSet->GetNumberOfCells());
+    for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+    {
+      cellIds->SetValue(cellId, cellId);
+    }
+    dataSet->GetCellData()->AddArray(cellIds);
+  }
+
+  /**
+   * Return true when both arrays exist and hold exactly the same values.
+   * Otherwise print the name of the array and the first mismatch.
+   */
+  static bool SameArrays(vtkAbstractArray* array, vtkAbstractArray* expected, const char* name)
+  {
+    if (!array || !expected || array->GetNumberOfValues() != expected->GetNumberOfValues() ||
+      array->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+      std::cerr << "Wrong array " << name << std::endl;
+      return false;
+    }
+    vtkDataArray* data = vtkDataArray::SafeDownCast(array);
+    vtkDataArray* expectedData = vtkDataArray::SafeDownCast(expected);
+    const int nComp = expected->GetNumberOfComponents();
+    for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+    {
+      const bool same = data && expectedData
+        ? data->GetComponent(i / nComp, i % nComp) ==
+          expectedData->GetComponent(i / nComp, i % nComp)
+        : array->GetVariantValue(i) == expected->GetVariantValue(i);
+      if (!same)
+      {
+        std::cerr << "Wrong value in " << name << " at " << i << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Return true when both cell arrays have the same offsets and connectivity.
+   */
+  static bool SameCells(vtkCellArray* cells, vtkCellArray* expected, const char* name)
+  {
+    if (!cells || !expected)
+    {
+      std::cerr << "Missing cells " << name << std::endl;
+      return false;
+    }
+    return SameArrays(cells->GetOffsetsArray(), expected->GetOffsetsArray(), name) &&
+      SameArrays(cells->GetConnectivityArray(), expected->GetConnectivityArray(), name);
+  }
+
+  /**
+   * Return true when both field data hold the same arrays, in the same order.
+   */
+  static bool SameFieldData(vtkFieldData* fieldData, vtkFieldData* expected, const char* name)
+  {
+    if (fieldData->GetNumberOfArrays() != expected->GetNumberOfArrays())
+    {
+      std::cerr << "Wrong number of arrays in " << name << std::endl;
+      return false;
+    }
+    for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+    {
+      vtkAbstractArray* array = expected->GetAbstractArray(i);
+      if (!SameArrays(fieldData->GetAbstractArray(i), array,
+            array->GetName() ? array->GetName() : name))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Return true when both data sets have the same points, cells and
+   * attributes. Only point sets, i.e. poly data and unstructured grids, have
+   * their cells compared; other data sets only have their attributes compared.
+   */
+  static bool SameDataSets(vtkDataSet* output, vtkDataSet* expected)
+  {
+    if (!output || !expected || output->GetDataObjectType() != expected->GetDataObjectType())
+    {
+      std::cerr << "Wrong data set type" << std::endl;
+      return false;
+    }
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(output);
+    vtkPointSet* expectedPointSet = vtkPointSet::SafeDownCast(expected);
+    if (expectedPointSet && expectedPointSet->GetPoints() &&
+      (!pointSet->GetPoints() ||
+        !SameArrays(
+          pointSet->GetPoints()->GetData(), expectedPointSet->GetPoints()->GetData(), "Points")))
+    {
+      return false;
+    }
+    vtkPolyData* polyData = vtkPolyData::SafeDownCast(output);
+    vtkPolyData* expectedPolyData = vtkPolyData::SafeDownCast(expected);
+    if (expectedPolyData &&
+      !(SameCells(polyData->GetVerts(), expectedPolyData->GetVerts(), "Verts") &&
+        SameCells(polyData->GetLines(), expectedPolyData->GetLines(), "Lines") &&
+        SameCells(polyData->GetPolys(), expectedPolyData->GetPolys(), "Polys") &&
+        SameCells(polyData->GetStrips(), expectedPolyData->GetStrips(), "Strips")))
+    {
+      return false;
+    }
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(output);
+    vtkUnstructuredGrid* expectedGrid = vtkUnstructuredGrid::SafeDownCast(expected);
+    if (expectedGrid &&
+      !(SameCells(grid->GetCells(), expectedGrid->GetCells(), "Cells") &&
+        SameArrays(grid->GetCellTypesArray(), expectedGrid->GetCellTypesArray(), "Types")))
+    {
+      return false;
+    }
+    return SameFieldData(output->GetPointData(), expected->GetPointData(), "PointData") &&
+      SameFieldData(output->GetCellData(), expected->GetCellData(), "CellData") &&
+      SameFieldData(output->GetFieldData(), expected->GetFieldData(), "FieldData");
+  }
+
+  /**
+   * Execute algorithm with a single thread, then with numberOfThreads threads,
+   * and return true when all its data set outputs are the same. The algorithm
+   * is left up to date with the last execution and the SMP tools are
+   * initialized back to their default number of threads. With the Sequential
+   * backend, the algorithm is only executed and the comparison is skipped.
+   */
+  static bool CompareThreads(vtkAlgorithm* algorithm, const char* name, int numberOfThreads = 4)
+  {
+    if (IsSequentialBackend())
+    {
+      std::cout << name << ": Sequential backend, skipping the thread comparison" << std::endl;
+      algorithm->Modified();
+      algorithm->Update();
+      return true;
+    }
+
+    vtkSMPTools::Initialize(1);
+    algorithm->Modified();
+    algorithm->Update();
+    std::vector<vtkSmartPointer<vtkDataSet>> expected;
+    for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+    {
+      vtkDataSet* output = vtkDataSet::SafeDownCast(algorithm->GetOutputDataObject(port));
+      vtkSmartPointer<vtkDataSet> copy;
+      if (output)
+      {
+        copy.TakeReference(output->NewInstance());
+        copy->DeepCopy(output);
+      }
+      expected.push_back(copy);
+    }
+
+    vtkSMPTools::Initialize(numberOfThreads);
+    algorithm->Modified();
+    algorithm->Update();
+    vtkSMPTools::Initialize();
+
+    bool same = true;
+    for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+    {
+      if (expected[port] &&
+        !SameDataSets(vtkDataSet::SafeDownCast(algorithm->GetOutputDataObject(port)),
+          expected[port]))
+      {
+        std::cerr << name << ": output " << port << " depends on the number of threads"
+                  << std::endl;
+        same = false;
+      }
+    }
+    return same;
+  }
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPTestUtilities.h
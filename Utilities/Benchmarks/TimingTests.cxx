@@ -44,6 +44,11 @@ int main(int argc, char* argv[])
   a.TestsToRun.push_back(new volumeTest("Volume", false));
   a.TestsToRun.push_back(new volumeTest("VolumeWithShading", true));
 
+  a.TestsToRun.push_back(new flyingEdgesTest("FlyingEdgesDouble", VTK_DOUBLE));
+  a.TestsToRun.push_back(new flyingEdgesTest("FlyingEdgesFloat", VTK_FLOAT));
+  a.TestsToRun.push_back(new flyingEdgesTest("FlyingEdgesShort", VTK_SHORT));
+  a.TestsToRun.push_back(new flyingEdgesTest("FlyingEdgesUnsignedChar", VTK_UNSIGNED_CHAR));
+
   a.TestsToRun.push_back(new depthPeelingTest("DepthPeeling", false));
   a.TestsToRun.push_back(new depthPeelingTest("DepthPeelingWithNormals", true));
 
@@ -513,6 +513,109 @@ protected:
   bool WithShading;
 };
 
+/*=========================================================================
+Define a test for contouring volumes with flying edges
+=========================================================================*/
+VTK_ABI_NAMESPACE_END
+#include "vtkFlyingEdges3D.h"
+#include "vtkImageAppendComponents.h"
+#include "vtkImageCast.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class flyingEdgesTest : public vtkRTTest
+{
+public:
+  flyingEdgesTest(const char* name, int scalarType)
+    : vtkRTTest(name)
+  {
+    this->ScalarType = scalarType;
+  }
+
+  const char* GetSummaryResultName() override { return "Mvoxels/sec"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mvoxels"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1, res2, res3;
+    ats->GetSequenceNumbers(res1, res2, res3);
+
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    wavelet->SetWholeExtent(
+      -50 * res1 - 1, 50 * res1, -50 * res2 - 1, 50 * res2, -50 * res3 - 1, 50 * res3);
+
+    // the wavelet ranges from about 37 to 277, it is clamped by 8 bit scalars
+    // but the isovalues lie within their range
+    vtkNew<vtkImageCast> cast;
+    cast->SetInputConnection(wavelet->GetOutputPort());
+    cast->SetOutputScalarType(this->ScalarType);
+    cast->ClampOverflowOn();
+    cast->Update();
+
+    // the same scalars as the first of two interleaved components, which
+    // are strided and so are classified by the scalar loop
+    vtkNew<vtkImageAppendComponents> strided;
+    strided->AddInputConnection(cast->GetOutputPort());
+    strided->AddInputConnection(cast->GetOutputPort());
+    strided->Update();
+
+    vtkNew<vtkFlyingEdges3D> contour;
+    contour->SetInputConnection(cast->GetOutputPort());
+    double firstContourTime;
+    double subsequentContourTime = this->TimeContour(contour, firstContourTime);
+
+    vtkNew<vtkFlyingEdges3D> stridedContour;
+    stridedContour->SetInputConnection(strided->GetOutputPort());
+    stridedContour->SetArrayComponent(0);
+    double firstStridedContourTime;
+    double subsequentStridedContourTime =
+      this->TimeContour(stridedContour, firstStridedContourTime);
+
+    vtkRTTestResult result;
+    result.Results["first contour time"] = firstContourTime;
+    result.Results["subsequent contour time"] = subsequentContourTime;
+    result.Results["first strided contour time"] = firstStridedContourTime;
+    result.Results["subsequent strided contour time"] = subsequentStridedContourTime;
+    result.Results["speedup over strided"] = subsequentStridedContourTime / subsequentContourTime;
+    result.Results["Mvoxels/sec"] = static_cast<double>(res1 * res2 * res3) / subsequentContourTime;
+    result.Results["Mvoxels"] = res1 * res2 * res3;
+    result.Results["Mtriangles"] = contour->GetOutput()->GetNumberOfPolys() * 1.0e-6;
+
+    return result;
+  }
+
+protected:
+  // Returns the average time of the contours after the first one
+  double TimeContour(vtkFlyingEdges3D* contour, double& firstContourTime)
+  {
+    contour->ComputeNormalsOff();
+    contour->SetNumberOfContours(3);
+    contour->SetValue(0, 100.5);
+    contour->SetValue(1, 150.5);
+    contour->SetValue(2, 200.5);
+
+    double startTime = vtkTimerLog::GetUniversalTime();
+    contour->Update();
+    firstContourTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    int contourCount = 20;
+    startTime = vtkTimerLog::GetUniversalTime();
+    for (int i = 0; i < contourCount; i++)
+    {
+      contour->Modified();
+      contour->Update();
+      if ((vtkTimerLog::GetUniversalTime() - startTime) > this->TargetTime * 1.5)
+      {
+        contourCount = i + 1;
+        break;
+      }
+    }
+    return (vtkTimerLog::GetUniversalTime() - startTime) / contourCount;
+  }
+
+  int ScalarType;
+};
+
 /*=========================================================================
 Define a test for depth peeling transluscent geometry.
 =========================================================================*/